@@ -0,0 +1,96 @@
+//=================================================================================================
+/*!
+	\file AliasTable.h
+	Base Library
+	Alias Method Table Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the alias table class used to draw weighted random
+	indices in constant time.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __AliasTable_h
+#define __AliasTable_h
+
+#include "Types.h"
+#include <vector>
+
+
+namespace TCBase
+{
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class AliasTable
+	\brief A table built with Vose's alias method that allows weighted random selection of an
+			index with two random numbers and no searching.
+
+	The table is built once from a set of integer weights, which is linear in the number of
+	entries, and then every draw is constant time. Entries with a weight of zero are never
+	selected.
+*/
+//-------------------------------------------------------------------------------------------------
+class AliasTable
+{
+private:
+
+	/// The probability, scaled by 2^32, that a column keeps its own index instead of its alias
+	std::vector<uint64> m_KeepThreshold;
+
+	/// The index to use for each column when the column's own index is not kept
+	std::vector<uint32> m_Alias;
+
+public:
+
+	/// Build the table from an array of weights
+	void Build( const uint32* pWeights, uint32 numWeights );
+
+	/// Build the table from an array of weights
+	void Build( const std::vector<uint32>& weights )
+	{
+		if( weights.size() == 0 )
+			Clear();
+		else
+			Build( &weights[0], (uint32)weights.size() );
+	}
+
+	/// Build a table where every index is equally likely
+	void BuildUniform( uint32 numEntries );
+
+	/// Clear the table
+	void Clear()
+	{
+		m_KeepThreshold.clear();
+		m_Alias.clear();
+	}
+
+	/// Get if the table has no entries to draw
+	bool IsEmpty() const { return m_Alias.size() == 0; }
+
+	/// Get the number of entries in the table
+	uint32 GetNumEntries() const { return (uint32)m_Alias.size(); }
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	/// Draw an index from the table. The table must not be empty.
+	///	\param columnRand A uniform 32-bit random number used to select the column
+	///	\param coinRand A second uniform 32-bit random number used to pick between the column's
+	///					index and its alias
+	///	\returns The selected index
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	uint32 Draw( uint32 columnRand, uint32 coinRand ) const
+	{
+		// Scale the random number to the column count with a multiply rather than a modulus
+		uint32 colIndex = (uint32)( ((uint64)columnRand * (uint64)m_Alias.size()) >> 32 );
+
+		if( (uint64)coinRand < m_KeepThreshold[colIndex] )
+			return colIndex;
+		return m_Alias[colIndex];
+	}
+};
+
+};
+
+#endif // __AliasTable_h
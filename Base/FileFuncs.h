@@ -121,6 +121,9 @@ namespace TCBase
 	/// Get a file's size
 	uint64 GetFileSize( std::wifstream& inStream );
 
+	/// Get the time a file was last modified
+	uint64 GetFileModTime( const wchar_t* szFullPath );
+
 	/// Get a temporary file name
 	std::wstring GetTmpFileName( const wchar_t* szExt );
 };
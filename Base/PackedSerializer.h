@@ -0,0 +1,82 @@
+//=================================================================================================
+/*!
+	\file PackedSerializer.h
+	Base Library
+	Packed Serializer Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the serializer that stores integers in as few bytes
+	as their values need.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __PackedSerializer_h
+#define __PackedSerializer_h
+
+#include "Serializer.h"
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class PackedSerializer
+	\brief A serializer that stores integers as variable length values.
+
+	Integers are stored 7 bits per byte with the high bit set on every byte but the last, so
+	small values take a single byte. Signed values are zig-zag encoded first so small negative
+	values are small as well. Floats and bytes are stored as they are by the base class and
+	booleans are stored as one byte. The same serializer must be used to read data that was
+	written with it.
+*/
+//-------------------------------------------------------------------------------------------------
+class PackedSerializer : public Serializer
+{
+private:
+
+	/// Write or read an unsigned value 7 bits at a time
+	void AddVarUInt( uint64& obj );
+
+	/// Write or read a signed value zig-zag encoded
+	void AddVarInt( int64& obj );
+
+public:
+
+	/// Constructors
+	PackedSerializer( std::ostream* pOutStream ) : Serializer(pOutStream)
+	{
+	}
+
+	PackedSerializer( std::istream* pInStream ) : Serializer(pInStream)
+	{
+	}
+
+	PackedSerializer( DataBlock* pDataBlock ) : Serializer(pDataBlock)
+	{
+	}
+
+	PackedSerializer( DataBlockOut* pDataBlock ) : Serializer(pDataBlock)
+	{
+	}
+
+	using Serializer::AddData;
+
+	virtual void AddData( int16& obj );
+
+	virtual void AddData( uint16& obj );
+
+	virtual void AddData( int32& obj );
+
+	virtual void AddData( uint32& obj );
+
+	/// Write or read a boolean as one byte
+	virtual void AddData( bool& obj );
+
+	/// Write or read a 64-bit value, which the base serializer does not support
+	void AddData( uint64& obj ) { AddVarUInt( obj ); }
+
+	/// The largest number of bytes a packed value takes
+	static const uint32 MAX_PACKED_SIZE = 10;
+};
+
+#endif // __PackedSerializer_h
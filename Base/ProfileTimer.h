@@ -0,0 +1,123 @@
+//=================================================================================================
+/*!
+	\file ProfileTimer.h
+	Base Library
+	Profile Timer Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the timers used to measure how long sections of code
+	take to run. The timers are only compiled in when PT_PROFILE is defined.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ProfileTimer_h
+#define __ProfileTimer_h
+
+#include "Types.h"
+#include <vector>
+
+
+namespace TCBase
+{
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ProfileTimer
+	\brief Collects the number of calls and time spent in named sections of code.
+
+	Sections are registered once, usually through the PROFILE_SCOPE macro, and then every time
+	the scope is run its duration is added to the section. The sections are stored in a fixed
+	array that never moves and their counters are atomic, so sections can be timed on several
+	threads at once. The totals are shared by the whole process.
+*/
+//-------------------------------------------------------------------------------------------------
+class ProfileTimer
+{
+public:
+
+	/// The most sections that can be registered
+	static const uint32 MAX_SECTIONS = 128;
+
+	/// A copy of the accumulated timing of a section of code
+	struct Section
+	{
+		/// The name of the section
+		const char* szName;
+
+		/// The number of times the section was run
+		uint64 numCalls;
+
+		/// The total time spent in the section in nanoseconds
+		uint64 totalNanosecs;
+
+		/// The longest single run of the section in nanoseconds
+		uint64 maxNanosecs;
+
+		Section( const char* szSectionName ) : szName( szSectionName ),
+												numCalls( 0 ),
+												totalNanosecs( 0 ),
+												maxNanosecs( 0 )
+		{}
+	};
+
+	/// Register a section and get the index used to add samples to it, MAX_SECTIONS if there is
+	/// no room for it
+	static uint32 RegisterSection( const char* szName );
+
+	/// Add a timing sample to a section
+	static void AddSample( uint32 sectionIndex, uint64 nanosecs );
+
+	/// Clear the accumulated timings but keep the registered sections
+	static void Reset();
+
+	/// Get a copy of the registered sections
+	static void GetSections( std::vector<Section>& sections );
+
+	/// Get a high resolution time stamp in nanoseconds
+	static uint64 GetTimeNanosecs();
+};
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ScopedProfileTimer
+	\brief Adds the time between its construction and destruction to a profile section.
+*/
+//-------------------------------------------------------------------------------------------------
+class ScopedProfileTimer
+{
+private:
+
+	/// The section being timed
+	uint32 m_SectionIndex;
+
+	/// The time the scope was entered
+	uint64 m_StartTime;
+
+public:
+
+	ScopedProfileTimer( uint32 sectionIndex ) : m_SectionIndex( sectionIndex ),
+												m_StartTime( ProfileTimer::GetTimeNanosecs() )
+	{}
+
+	~ScopedProfileTimer()
+	{
+		ProfileTimer::AddSample( m_SectionIndex, ProfileTimer::GetTimeNanosecs() - m_StartTime );
+	}
+};
+
+};
+
+
+/// Time the rest of the enclosing scope, only one may be used per scope
+#ifdef PT_PROFILE
+#define PROFILE_SCOPE( szName ) \
+	static const uint32 s_ProfileSectionIndex = TCBase::ProfileTimer::RegisterSection( szName ); \
+	TCBase::ScopedProfileTimer scopedProfileTimer( s_ProfileSectionIndex )
+#else
+#define PROFILE_SCOPE( szName )
+#endif
+
+#endif // __ProfileTimer_h
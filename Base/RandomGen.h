@@ -0,0 +1,143 @@
+//=================================================================================================
+/*!
+	\file RandomGen.h
+	Base Library
+	Random Number Generator Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the seedable pseudo-random number generator used in
+	place of the C runtime's rand().
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __RandomGen_h
+#define __RandomGen_h
+
+#include "Types.h"
+#include "AliasTable.h"
+
+
+namespace TCBase
+{
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class RandomGen
+	\brief A small, fast pseudo-random number generator with explicit state.
+
+	The generator uses the xoshiro128** algorithm. Unlike rand(), each object has its own state
+	so separate games can generate numbers independently on separate threads, and the same seed
+	always produces the same sequence on every platform.
+*/
+//-------------------------------------------------------------------------------------------------
+class RandomGen
+{
+public:
+
+	/// The generator state, exposed so that it can be saved and restored
+	struct State
+	{
+		uint32 s[4];
+	};
+
+private:
+
+	/// The current state
+	State m_State;
+
+	/// Rotate a 32-bit value left
+	static uint32 RotL( uint32 val, int32 numBits )
+	{
+		return (val << numBits) | (val >> (32 - numBits));
+	}
+
+public:
+
+	/// The default constructor, the generator is seeded with 0 until Seed is called
+	RandomGen()
+	{
+		Seed( 0 );
+	}
+
+	/// The constructor to initialize the generator with a seed
+	RandomGen( uint64 seed )
+	{
+		Seed( seed );
+	}
+
+	/// Seed the generator
+	void Seed( uint64 seed );
+
+	/// Create a seed from the current time and a running counter, safe to call from any thread
+	static uint64 GenerateSeed();
+
+	/// Get the current state
+	const State& GetState() const { return m_State; }
+
+	/// Restore a previously retrieved state
+	void SetState( const State& state ) { m_State = state; }
+
+	/// Get the next 32 random bits
+	uint32 NextUInt32()
+	{
+		const uint32 result = RotL( m_State.s[1] * 5, 7 ) * 9;
+		const uint32 t = m_State.s[1] << 9;
+
+		m_State.s[2] ^= m_State.s[0];
+		m_State.s[3] ^= m_State.s[1];
+		m_State.s[1] ^= m_State.s[2];
+		m_State.s[0] ^= m_State.s[3];
+
+		m_State.s[2] ^= t;
+		m_State.s[3] = RotL( m_State.s[3], 11 );
+
+		return result;
+	}
+
+	/// Get a uniformly distributed integer from 0 up to, but not including, a range
+	uint32 NextBelow( uint32 range );
+
+	/// Get a uniformly distributed integer within an inclusive range
+	int32 NextInRange( int32 minVal, int32 maxVal )
+	{
+		if( maxVal <= minVal )
+			return minVal;
+		return minVal + (int32)NextBelow( (uint32)(maxVal - minVal) + 1 );
+	}
+
+	/// Return true with a percent chance from 0 to 100
+	bool Chance( int32 percentChance )
+	{
+		return (int32)NextBelow( 100 ) < percentChance;
+	}
+
+	/// Get a float in the range [0, 1)
+	float32 NextFloat()
+	{
+		// Use the top 24 bits so every value is exactly representable
+		return (float32)(NextUInt32() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	/// Get a float in the range [minVal, maxVal)
+	float32 NextFloatInRange( float32 minVal, float32 maxVal )
+	{
+		return minVal + (maxVal - minVal) * NextFloat();
+	}
+
+	/// Pick an index from an array of weights with a linear walk, best for small arrays that
+	/// change often
+	uint32 NextWeightedIndex( const uint32* pWeights, uint32 numWeights );
+
+	/// Pick an index from a pre-built alias table in constant time
+	uint32 Draw( const AliasTable& table )
+	{
+		uint32 columnRand = NextUInt32();
+		return table.Draw( columnRand, NextUInt32() );
+	}
+};
+
+};
+
+#endif // __RandomGen_h
@@ -0,0 +1,143 @@
+//=================================================================================================
+/*!
+	\file SmallObjectPool.h
+	Base Library
+	Small Object Pool Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the pool used to allocate small, frequently created
+	objects without going to the heap for each one.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __SmallObjectPool_h
+#define __SmallObjectPool_h
+
+#include "Types.h"
+#include <stddef.h>
+
+
+namespace TCBase
+{
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class SmallObjectPool
+	\brief Allocates small objects from free lists of fixed-size chunks.
+
+	Requests are rounded up to a size class and served from that class's free list. When a free
+	list is empty a page of chunks is allocated from the heap, so once a game has warmed up the
+	pool no longer touches the heap. Pages are only returned to the heap by ReleasePages, and
+	requests larger than the biggest size class go straight to the heap.
+
+	The pool has no destructor so objects can still be freed to it while other statics are being
+	destroyed. It is not thread safe, a pool should only be used by one thread.
+
+	In debug builds freed chunks are marked so a second free of the same pointer is caught, and
+	the number of live objects is tracked so leaks can be reported.
+*/
+//-------------------------------------------------------------------------------------------------
+class SmallObjectPool
+{
+public:
+
+	/// The step between size classes in bytes, also the alignment of every chunk
+	static const uint32 SIZE_GRANULARITY = 16;
+
+	/// The number of size classes
+	static const uint32 NUM_SIZE_CLASSES = 16;
+
+	/// The largest request served from the pool
+	static const uint32 MAX_POOLED_SIZE = SIZE_GRANULARITY * NUM_SIZE_CLASSES;
+
+	/// The number of chunks allocated at once when a size class runs out
+	static const uint32 CHUNKS_PER_PAGE = 64;
+
+private:
+
+	/// The header at the start of a free chunk
+	struct FreeChunk
+	{
+		/// The next free chunk of the same size
+		FreeChunk* pNext;
+
+		/// Set to FREED_MARKER while the chunk is free so a double free can be detected
+		uint32 freedMarker;
+	};
+
+	/// The header at the start of every page
+	struct PageHeader
+	{
+		/// The page allocated before this one
+		PageHeader* pNextPage;
+	};
+
+	/// The value stored in a free chunk
+	static const uint32 FREED_MARKER = 0xFEEDF4EE;
+
+	/// The size of the page header, rounded up so the chunks stay aligned
+	static const uint32 PAGE_HEADER_SIZE = ((sizeof(PageHeader) + SIZE_GRANULARITY - 1) / SIZE_GRANULARITY) * SIZE_GRANULARITY;
+
+	/// The name used when reporting leaks
+	const wchar_t* m_szName;
+
+	/// The free list for each size class
+	FreeChunk* m_pFreeLists[ NUM_SIZE_CLASSES ];
+
+	/// The pages allocated for every size class
+	PageHeader* m_pPages;
+
+	/// The number of pages allocated
+	uint32 m_NumPages;
+
+	/// The number of objects allocated and not yet freed
+	uint32 m_NumLive;
+
+	/// The total number of allocations made from the pool
+	uint64 m_NumAllocs;
+
+
+	/// Get the size class for a request size
+	static uint32 GetSizeClass( size_t numBytes )
+	{
+		return (uint32)((numBytes + SIZE_GRANULARITY - 1) / SIZE_GRANULARITY) - 1;
+	}
+
+	/// Allocate a page of chunks for a size class
+	bool AddPage( uint32 sizeClass );
+
+	/// Get if a chunk is in a size class's free list
+	bool IsInFreeList( const void* pMem, uint32 sizeClass ) const;
+
+public:
+
+	/// The constructor, the name must remain valid for the life of the pool
+	SmallObjectPool( const wchar_t* szName );
+
+	/// Allocate memory for an object
+	void* Alloc( size_t numBytes );
+
+	/// Free memory returned by Alloc, the size must be the size that was requested
+	void Free( void* pMem, size_t numBytes );
+
+	/// Output a message if there are objects that have not been freed
+	void ReportLeaks() const;
+
+	/// Return every page to the heap, only done if no objects are still allocated
+	bool ReleasePages();
+
+	/// Get the number of objects allocated and not yet freed
+	uint32 GetNumLive() const { return m_NumLive; }
+
+	/// Get the total number of allocations made from the pool
+	uint64 GetNumAllocs() const { return m_NumAllocs; }
+
+	/// Get the number of pages the pool has taken from the heap
+	uint32 GetNumPages() const { return m_NumPages; }
+};
+
+};
+
+#endif // __SmallObjectPool_h
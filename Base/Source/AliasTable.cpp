@@ -0,0 +1,114 @@
+/*=================================================================================================
+
+	\file AliasTable.cpp
+	Base Library
+	Alias Method Table Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the alias table class.
+
+=================================================================================================*/
+
+#include "../AliasTable.h"
+
+/// The value of a threshold that always keeps the column's own index
+static const uint64 ALWAYS_KEEP = (uint64)1 << 32;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  AliasTable::Build  Public
+///
+///	\param pWeights The array of weights, one per index
+///	\param numWeights The number of weights in the array
+///
+///	Build the alias table from a set of weights. The work is done entirely in integers so the
+///	resulting table is identical on every platform.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TCBase::AliasTable::Build( const uint32* pWeights, uint32 numWeights )
+{
+	Clear();
+	if( !pWeights || numWeights == 0 )
+		return;
+
+	// Total the weights
+	uint64 totalWeight = 0;
+	for( uint32 weightIndex = 0; weightIndex < numWeights; ++weightIndex )
+		totalWeight += pWeights[weightIndex];
+
+	// If nothing can be selected then leave the table empty
+	if( totalWeight == 0 )
+		return;
+
+	m_KeepThreshold.resize( numWeights, 0 );
+	m_Alias.resize( numWeights, 0 );
+
+	// Scale every weight by the number of entries so that the average column holds exactly the
+	// total weight, then split the columns into those below and at or above the average
+	std::vector<uint64> scaledWeights( numWeights );
+	std::vector<uint32> smallIndices;
+	std::vector<uint32> largeIndices;
+	smallIndices.reserve( numWeights );
+	largeIndices.reserve( numWeights );
+	for( uint32 weightIndex = 0; weightIndex < numWeights; ++weightIndex )
+	{
+		scaledWeights[weightIndex] = (uint64)pWeights[weightIndex] * (uint64)numWeights;
+		if( scaledWeights[weightIndex] < totalWeight )
+			smallIndices.push_back( weightIndex );
+		else
+			largeIndices.push_back( weightIndex );
+	}
+
+	// Fill each under-full column with the remainder taken from an over-full column
+	while( smallIndices.size() > 0 && largeIndices.size() > 0 )
+	{
+		uint32 smallIndex = smallIndices.back();
+		smallIndices.pop_back();
+		uint32 largeIndex = largeIndices.back();
+
+		m_KeepThreshold[smallIndex] = (scaledWeights[smallIndex] << 32) / totalWeight;
+		m_Alias[smallIndex] = largeIndex;
+
+		// Take the donated amount away from the large column and reclassify it
+		scaledWeights[largeIndex] -= totalWeight - scaledWeights[smallIndex];
+		if( scaledWeights[largeIndex] < totalWeight )
+		{
+			largeIndices.pop_back();
+			smallIndices.push_back( largeIndex );
+		}
+	}
+
+	// Any columns left over are exactly full
+	for( uint32 index = 0; index < largeIndices.size(); ++index )
+	{
+		m_KeepThreshold[ largeIndices[index] ] = ALWAYS_KEEP;
+		m_Alias[ largeIndices[index] ] = largeIndices[index];
+	}
+	for( uint32 index = 0; index < smallIndices.size(); ++index )
+	{
+		m_KeepThreshold[ smallIndices[index] ] = ALWAYS_KEEP;
+		m_Alias[ smallIndices[index] ] = smallIndices[index];
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  AliasTable::BuildUniform  Public
+///
+///	\param numEntries The number of equally likely entries
+///
+///	Build a table in which every index has the same chance of being drawn.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TCBase::AliasTable::BuildUniform( uint32 numEntries )
+{
+	Clear();
+
+	m_KeepThreshold.resize( numEntries, ALWAYS_KEEP );
+	m_Alias.resize( numEntries );
+	for( uint32 index = 0; index < numEntries; ++index )
+		m_Alias[index] = index;
+}
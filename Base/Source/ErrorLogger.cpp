@@ -8,7 +8,7 @@
 =================================================================================================*/
 
 #include <time.h>
-#include "ErrorLogger.h"
+#include "../ErrorLogger.h"
 using namespace std;
 
 
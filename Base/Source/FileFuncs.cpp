@@ -19,16 +19,25 @@
 #include <direct.h>
 #include <shellapi.h>
 #include <shlobj.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #else
 #include <unistd.h>
+#ifdef __APPLE__
 #include <mach-o/dyld.h>
+#endif
 #include <sys/param.h>
 #define MAX_PATH MAXPATHLEN
+#ifdef __APPLE__
 #include <sys/mount.h>
+#else
+#include <sys/statfs.h>
+#endif
 #include <sys/stat.h>
 #include <dirent.h>
 #include <fnmatch.h>
 #include <stdio.h>
+#include <string.h>
 #include <pwd.h>
 #endif
 #include <errno.h>
@@ -397,11 +406,15 @@ void InitAppPaths()
 	sAppPath = szFullAppPath;
 	
 #else
-	char appPathBuffer[MAX_PATH];
-    readlink("/proc/self/exe", appPathBuffer, MAX_PATH);
-	
+	char appPathBuffer[MAX_PATH] = { 0 };
+#ifdef __APPLE__
 	uint32_t pathLen = MAX_PATH;
 	_NSGetExecutablePath( appPathBuffer, &pathLen);
+#else
+	ssize_t pathLen = readlink( "/proc/self/exe", appPathBuffer, MAX_PATH - 1 );
+	if( pathLen > 0 )
+		appPathBuffer[ pathLen ] = 0;
+#endif
 	
 	sAppPath = TCBase::Widen( appPathBuffer );
 #endif	
@@ -920,6 +933,29 @@ uint64 TCBase::GetFileSize( std::wifstream& inFile )
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  GetFileModTime()  Global
+///	\param szFullPath The full path of the file
+///	\returns The time the file was last modified in seconds since 1970, 0 if the file does not
+///	exist
+///
+///	Get the time a file was last modified without opening it.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint64 TCBase::GetFileModTime( const wchar_t* szFullPath )
+{
+#ifdef WIN32
+	struct _stat64 fileStat;
+	if( _wstat64( szFullPath, &fileStat ) != 0 )
+		return 0;
+#else
+	struct stat fileStat;
+	if( stat( TCBase::Narrow(szFullPath).c_str(), &fileStat ) != 0 )
+		return 0;
+#endif
+	return (uint64)fileStat.st_mtime;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  GetTempFileName()  Global
@@ -202,16 +202,17 @@ MsgLogger::ListenerStream::~ListenerStream()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void MsgLogger::Output( MsgImportance, const wchar_t* szStr, ... )
 {
-	static wchar_t _szMsgBuffer[ 1024 ] = {0};
+	// The buffer is on the stack so messages can be output from several threads at once
+	wchar_t szMsgBuffer[ g_MSG_BUFFER_SIZE + 1 ] = {0};
 
 	// Create the string
 	va_list varArgs;
 	va_start( varArgs, szStr );
-	vswprintf( _szMsgBuffer, g_MSG_BUFFER_SIZE, szStr, varArgs );
+	vswprintf( szMsgBuffer, g_MSG_BUFFER_SIZE, szStr, varArgs );
 	va_end( varArgs );
 
 	// Output the string to the listeners
-	OutputErrorString( _szMsgBuffer );
+	OutputErrorString( szMsgBuffer );
 }
 
 
@@ -229,22 +230,23 @@ void MsgLogger::Output( MsgImportance, const wchar_t* szStr, ... )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void MsgLogger::OutputInfo( int lineNumber, const wchar_t* szFile, MsgImportance level, const wchar_t* szStr, ... )
 {
-	static wchar_t s_szMsgBuffer[ 1024 ] = {0};
+	// The buffer is on the stack so messages can be output from several threads at once
+	wchar_t szMsgBuffer[ g_MSG_BUFFER_SIZE + 1 ] = {0};
 
 	// Create the message string
 	va_list varArgs;
 	va_start( varArgs, szStr );
-	vswprintf( s_szMsgBuffer, g_MSG_BUFFER_SIZE, szStr, varArgs );
+	vswprintf( szMsgBuffer, g_MSG_BUFFER_SIZE, szStr, varArgs );
 	va_end( varArgs );
 
 	// Get the length of the message string
-	size_t strLen = wcslen( s_szMsgBuffer );
+	size_t strLen = wcslen( szMsgBuffer );
 
 	// Append the file info
-	swprintf( (wchar_t*)(s_szMsgBuffer + strLen), (g_MSG_BUFFER_SIZE - strLen) + 1, L" (%s: %s on line %d)", GetLevelString(level), szFile, lineNumber );
+	swprintf( (wchar_t*)(szMsgBuffer + strLen), (g_MSG_BUFFER_SIZE - strLen) + 1, L" (%s: %s on line %d)", GetLevelString(level), szFile, lineNumber );
 
 	// Output the string to the listeners
-	OutputErrorString( s_szMsgBuffer );	
+	OutputErrorString( szMsgBuffer );	
 }
 
 
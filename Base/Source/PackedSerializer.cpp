@@ -0,0 +1,111 @@
+/*=================================================================================================
+
+	\file PackedSerializer.cpp
+	Base Library
+	Packed Serializer Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the packed serializer class.
+
+=================================================================================================*/
+
+#include "../PackedSerializer.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PackedSerializer::AddVarUInt  Private
+///
+///	\param obj The value to write, or the value that is read
+///
+///	Write or read an unsigned value, low bits first, 7 bits per byte. The high bit of each byte is
+///	set if more bytes follow.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedSerializer::AddVarUInt( uint64& obj )
+{
+	if( InWriteMode() )
+	{
+		uint64 val = obj;
+		while( val >= 0x80 )
+		{
+			uint8 curByte = (uint8)(val & 0x7F) | 0x80;
+			AddData_Default( curByte );
+			val >>= 7;
+		}
+
+		uint8 lastByte = (uint8)val;
+		AddData_Default( lastByte );
+	}
+	else
+	{
+		obj = 0;
+		for( uint32 byteIndex = 0; byteIndex < MAX_PACKED_SIZE; ++byteIndex )
+		{
+			uint8 curByte = 0;
+			AddData_Default( curByte );
+
+			obj |= (uint64)(curByte & 0x7F) << (byteIndex * 7);
+			if( (curByte & 0x80) == 0 )
+				break;
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PackedSerializer::AddVarInt  Private
+///
+///	\param obj The value to write, or the value that is read
+///
+///	Write or read a signed value. The sign is moved to the lowest bit so values near zero, either
+///	positive or negative, pack into few bytes.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedSerializer::AddVarInt( int64& obj )
+{
+	uint64 zigZagVal = ((uint64)obj << 1) ^ (uint64)(obj >> 63);
+	AddVarUInt( zigZagVal );
+
+	if( InReadMode() )
+		obj = (int64)(zigZagVal >> 1) ^ -(int64)(zigZagVal & 1);
+}
+
+
+void PackedSerializer::AddData( int16& obj )
+{
+	int64 tempVal = obj;
+	AddVarInt( tempVal );
+	obj = (int16)tempVal;
+}
+
+void PackedSerializer::AddData( uint16& obj )
+{
+	uint64 tempVal = obj;
+	AddVarUInt( tempVal );
+	obj = (uint16)tempVal;
+}
+
+void PackedSerializer::AddData( int32& obj )
+{
+	int64 tempVal = obj;
+	AddVarInt( tempVal );
+	obj = (int32)tempVal;
+}
+
+void PackedSerializer::AddData( uint32& obj )
+{
+	uint64 tempVal = obj;
+	AddVarUInt( tempVal );
+	obj = (uint32)tempVal;
+}
+
+/// A memory stream has no boolean write so the base class writes 4 bytes and reads back 1
+void PackedSerializer::AddData( bool& obj )
+{
+	uint8 tempVal = obj ? 1 : 0;
+	AddData( tempVal );
+	obj = tempVal == 1;
+}
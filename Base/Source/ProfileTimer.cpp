@@ -0,0 +1,147 @@
+/*=================================================================================================
+
+	\file ProfileTimer.cpp
+	Base Library
+	Profile Timer Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the profile timer class.
+
+=================================================================================================*/
+
+#include "../ProfileTimer.h"
+#include "../CriticalSection.h"
+#include <atomic>
+#include <chrono>
+#include <string.h>
+
+
+/// The counters of a registered section, updated by any thread that runs the section
+struct SectionCounters
+{
+	/// The name of the section, set once when the section is registered
+	const char* szName;
+
+	std::atomic<uint64> numCalls;
+	std::atomic<uint64> totalNanosecs;
+	std::atomic<uint64> maxNanosecs;
+};
+
+/// The registered sections, a fixed array so a section never moves while it is being timed. The
+/// counters are zero initialized before any code runs so sections can be registered while other
+/// statics are being initialized.
+static SectionCounters s_Sections[ TCBase::ProfileTimer::MAX_SECTIONS ];
+
+/// The number of registered sections, a section is filled in before it is counted
+static std::atomic<uint32> s_NumSections( 0 );
+
+/// Get the lock that protects section registration
+static TCBase::CriticalSection& GetSectionLock()
+{
+	static TCBase::CriticalSection s_SectionLock;
+	return s_SectionLock;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileTimer::RegisterSection  Static Public
+///
+///	\param szName The name of the section, it must remain valid for the life of the program
+///	\returns The index of the section, MAX_SECTIONS if every section is in use
+///
+///	Register a section of code to be timed. Registering a name a second time returns the index
+///	of the existing section.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 TCBase::ProfileTimer::RegisterSection( const char* szName )
+{
+	GetSectionLock().Enter();
+
+	uint32 numSections = s_NumSections.load();
+	uint32 sectionIndex = 0;
+	for( ; sectionIndex < numSections; ++sectionIndex )
+	{
+		if( strcmp( s_Sections[sectionIndex].szName, szName ) == 0 )
+			break;
+	}
+	if( sectionIndex == numSections && numSections < MAX_SECTIONS )
+	{
+		s_Sections[sectionIndex].szName = szName;
+		s_NumSections.store( numSections + 1 );
+	}
+
+	GetSectionLock().Leave();
+	return sectionIndex;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileTimer::AddSample  Static Public
+///
+///	\param sectionIndex The index of the section returned from RegisterSection
+///	\param nanosecs The duration of the sample in nanoseconds
+///
+///	Add a timing sample to a section. This may be called from any thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TCBase::ProfileTimer::AddSample( uint32 sectionIndex, uint64 nanosecs )
+{
+	if( sectionIndex >= MAX_SECTIONS )
+		return;
+
+	SectionCounters& section = s_Sections[sectionIndex];
+	section.numCalls.fetch_add( 1, std::memory_order_relaxed );
+	section.totalNanosecs.fetch_add( nanosecs, std::memory_order_relaxed );
+
+	// Raise the longest run unless another thread stored a longer one first
+	uint64 maxNanosecs = section.maxNanosecs.load( std::memory_order_relaxed );
+	while( nanosecs > maxNanosecs && !section.maxNanosecs.compare_exchange_weak( maxNanosecs, nanosecs, std::memory_order_relaxed ) )
+	{
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileTimer::Reset  Static Public
+///
+///	Clear the accumulated timings.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TCBase::ProfileTimer::Reset()
+{
+	uint32 numSections = s_NumSections.load();
+	for( uint32 sectionIndex = 0; sectionIndex < numSections; ++sectionIndex )
+	{
+		s_Sections[sectionIndex].numCalls.store( 0 );
+		s_Sections[sectionIndex].totalNanosecs.store( 0 );
+		s_Sections[sectionIndex].maxNanosecs.store( 0 );
+	}
+}
+
+
+/// Get a copy of the registered sections
+void TCBase::ProfileTimer::GetSections( std::vector<Section>& sections )
+{
+	sections.clear();
+
+	uint32 numSections = s_NumSections.load();
+	for( uint32 sectionIndex = 0; sectionIndex < numSections; ++sectionIndex )
+	{
+		Section section( s_Sections[sectionIndex].szName );
+		section.numCalls = s_Sections[sectionIndex].numCalls.load();
+		section.totalNanosecs = s_Sections[sectionIndex].totalNanosecs.load();
+		section.maxNanosecs = s_Sections[sectionIndex].maxNanosecs.load();
+		sections.push_back( section );
+	}
+}
+
+
+/// Get a high resolution time stamp in nanoseconds
+uint64 TCBase::ProfileTimer::GetTimeNanosecs()
+{
+	return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
@@ -0,0 +1,131 @@
+/*=================================================================================================
+
+	\file RandomGen.cpp
+	Base Library
+	Random Number Generator Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the random number generator class.
+
+=================================================================================================*/
+
+#include "../RandomGen.h"
+#include <time.h>
+#include <atomic>
+
+
+/// The number of seeds generated, atomic since game fields on worker threads generate seeds
+static std::atomic<uint32> s_SeedCounter( 0 );
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RandomGen::Seed  Public
+///
+///	\param seed The seed value
+///
+///	Seed the generator. The 64-bit seed is expanded with SplitMix64 so that similar seeds, such
+///	as consecutive times, still produce unrelated sequences.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TCBase::RandomGen::Seed( uint64 seed )
+{
+	for( int32 wordIndex = 0; wordIndex < 4; wordIndex += 2 )
+	{
+		seed += 0x9E3779B97F4A7C15ull;
+		uint64 mixed = seed;
+		mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+		mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+		mixed = mixed ^ (mixed >> 31);
+
+		m_State.s[wordIndex] = (uint32)mixed;
+		m_State.s[wordIndex + 1] = (uint32)(mixed >> 32);
+	}
+
+	// The all-zero state would only ever produce zeros
+	if( (m_State.s[0] | m_State.s[1] | m_State.s[2] | m_State.s[3]) == 0 )
+		m_State.s[0] = 1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RandomGen::GenerateSeed  Static Public
+///
+///	\returns A seed that differs between calls and between runs
+///
+///	Create a seed for a new session. This may be called from any thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint64 TCBase::RandomGen::GenerateSeed()
+{
+	uint64 seed = (uint64)time( NULL );
+	seed = (seed << 20) ^ (uint64)clock();
+	seed ^= (uint64)(s_SeedCounter.fetch_add( 1, std::memory_order_relaxed ) + 1) * 0x9E3779B97F4A7C15ull;
+	return seed;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RandomGen::NextBelow  Public
+///
+///	\param range The number of possible values
+///	\returns A value from 0 up to, but not including, the range or 0 if the range is 0
+///
+///	Get a uniformly distributed integer. This uses a multiply and shift instead of a modulus and
+///	rejects the few values that would bias the result.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 TCBase::RandomGen::NextBelow( uint32 range )
+{
+	if( range == 0 )
+		return 0;
+
+	uint64 scaled = (uint64)NextUInt32() * (uint64)range;
+	uint32 lowBits = (uint32)scaled;
+	if( lowBits < range )
+	{
+		// Reject values from the partial interval at the bottom of the range
+		uint32 threshold = (uint32)(0 - range) % range;
+		while( lowBits < threshold )
+		{
+			scaled = (uint64)NextUInt32() * (uint64)range;
+			lowBits = (uint32)scaled;
+		}
+	}
+
+	return (uint32)(scaled >> 32);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RandomGen::NextWeightedIndex  Public
+///
+///	\param pWeights The array of weights
+///	\param numWeights The number of weights in the array
+///	\returns The selected index or numWeights if all of the weights are 0
+///
+///	Pick an index from an array of weights.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 TCBase::RandomGen::NextWeightedIndex( const uint32* pWeights, uint32 numWeights )
+{
+	uint32 totalWeight = 0;
+	for( uint32 weightIndex = 0; weightIndex < numWeights; ++weightIndex )
+		totalWeight += pWeights[weightIndex];
+	if( totalWeight == 0 )
+		return numWeights;
+
+	uint32 randValue = NextBelow( totalWeight );
+	for( uint32 weightIndex = 0; weightIndex < numWeights; ++weightIndex )
+	{
+		if( randValue < pWeights[weightIndex] )
+			return weightIndex;
+		randValue -= pWeights[weightIndex];
+	}
+
+	return numWeights - 1;
+}
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <string.h>
 #include "../StringFuncs.h"
 
 
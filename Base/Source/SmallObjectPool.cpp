@@ -0,0 +1,226 @@
+/*=================================================================================================
+
+	\file SmallObjectPool.cpp
+	Base Library
+	Small Object Pool Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the small object pool class.
+
+=================================================================================================*/
+
+#include "../SmallObjectPool.h"
+#include "../MsgLogger.h"
+#include "../TCAssert.h"
+#include <new>
+#include <string.h>
+
+using namespace TCBase;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::SmallObjectPool  Public
+///
+///	\param szName The name of the pool used when reporting leaks
+///
+///	The constructor.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+SmallObjectPool::SmallObjectPool( const wchar_t* szName ) : m_szName( szName ),
+															m_pPages( NULL ),
+															m_NumPages( 0 ),
+															m_NumLive( 0 ),
+															m_NumAllocs( 0 )
+{
+	for( uint32 sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass )
+		m_pFreeLists[ sizeClass ] = NULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::AddPage  Private
+///
+///	\param sizeClass The size class that needs more chunks
+///	\returns True if the page was allocated, false otherwise
+///
+///	Allocate a page of chunks from the heap and add them to a size class's free list.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SmallObjectPool::AddPage( uint32 sizeClass )
+{
+	const uint32 chunkSize = (sizeClass + 1) * SIZE_GRANULARITY;
+	uint8* pPageMem = (uint8*)::operator new( PAGE_HEADER_SIZE + chunkSize * CHUNKS_PER_PAGE, std::nothrow );
+	if( !pPageMem )
+		return false;
+
+	// Link the page so it is known to the pool
+	PageHeader* pPage = (PageHeader*)pPageMem;
+	pPage->pNextPage = m_pPages;
+	m_pPages = pPage;
+	++m_NumPages;
+
+	// Add the chunks to the free list from last to first so they are handed out in address order
+	uint8* pChunks = pPageMem + PAGE_HEADER_SIZE;
+	for( int32 chunkIndex = (int32)CHUNKS_PER_PAGE - 1; chunkIndex >= 0; --chunkIndex )
+	{
+		FreeChunk* pChunk = (FreeChunk*)(pChunks + chunkIndex * chunkSize);
+		pChunk->pNext = m_pFreeLists[ sizeClass ];
+		pChunk->freedMarker = FREED_MARKER;
+		m_pFreeLists[ sizeClass ] = pChunk;
+	}
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::IsInFreeList  Private
+///
+///	\param pMem The memory to find
+///	\param sizeClass The size class to search
+///	\returns True if the memory is a free chunk in the size class
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SmallObjectPool::IsInFreeList( const void* pMem, uint32 sizeClass ) const
+{
+	for( const FreeChunk* pChunk = m_pFreeLists[ sizeClass ]; pChunk; pChunk = pChunk->pNext )
+	{
+		if( pChunk == pMem )
+			return true;
+	}
+
+	return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::Alloc  Public
+///
+///	\param numBytes The size of the object
+///	\returns The memory for the object, an exception is thrown if there is not enough memory
+///
+///	Allocate memory for an object. This is intended to be called from a class's operator new.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void* SmallObjectPool::Alloc( size_t numBytes )
+{
+	// Large objects come from the heap
+	if( numBytes == 0 || numBytes > MAX_POOLED_SIZE )
+		return ::operator new( numBytes );
+
+	uint32 sizeClass = GetSizeClass( numBytes );
+	if( !m_pFreeLists[ sizeClass ] && !AddPage( sizeClass ) )
+		throw std::bad_alloc();
+
+	// Take the first free chunk
+	FreeChunk* pChunk = m_pFreeLists[ sizeClass ];
+	m_pFreeLists[ sizeClass ] = pChunk->pNext;
+	pChunk->freedMarker = 0;
+
+	++m_NumLive;
+	++m_NumAllocs;
+	return pChunk;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::Free  Public
+///
+///	\param pMem The memory returned by Alloc
+///	\param numBytes The size passed to Alloc
+///
+///	Free memory for an object. This is intended to be called from a class's operator delete.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SmallObjectPool::Free( void* pMem, size_t numBytes )
+{
+	if( !pMem )
+		return;
+
+	// Large objects came from the heap
+	if( numBytes == 0 || numBytes > MAX_POOLED_SIZE )
+	{
+		::operator delete( pMem );
+		return;
+	}
+
+	uint32 sizeClass = GetSizeClass( numBytes );
+	FreeChunk* pChunk = (FreeChunk*)pMem;
+
+#ifdef _DEBUG
+	// The marker is only a hint since a live object may happen to store the same value, so
+	// make sure the chunk really is free before reporting it
+	if( pChunk->freedMarker == FREED_MARKER && IsInFreeList( pChunk, sizeClass ) )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Object freed twice in the %s pool.", m_szName );
+		TCBREAKX( L"Object freed twice in a small object pool." );
+		return;
+	}
+
+	// Fill the freed memory so use after free stands out
+	memset( pChunk, 0xDD, (sizeClass + 1) * SIZE_GRANULARITY );
+#endif
+
+	pChunk->pNext = m_pFreeLists[ sizeClass ];
+	pChunk->freedMarker = FREED_MARKER;
+	m_pFreeLists[ sizeClass ] = pChunk;
+
+	TCASSERTX( m_NumLive > 0, L"More objects were freed to a small object pool than allocated." );
+	--m_NumLive;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::ReportLeaks  Public
+///
+///	Output an error if any objects allocated from the pool have not been freed. Call this at a
+///	point when every object from the pool should have been freed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SmallObjectPool::ReportLeaks() const
+{
+	if( m_NumLive == 0 )
+		return;
+
+	MSG_LOGGER_OUT( MsgLogger::MI_Error, L"%u objects allocated from the %s pool were not freed.", m_NumLive, m_szName );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SmallObjectPool::ReleasePages  Public
+///
+///	\returns True if the pages were freed, false if objects are still allocated from the pool
+///
+///	Return every page to the heap, such as before a pool that is not a static is destroyed. The
+///	pages are kept if any object is still allocated since the object's memory is in a page.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SmallObjectPool::ReleasePages()
+{
+	if( m_NumLive > 0 )
+	{
+		ReportLeaks();
+		return false;
+	}
+
+	while( m_pPages )
+	{
+		PageHeader* pNextPage = m_pPages->pNextPage;
+		::operator delete( m_pPages );
+		m_pPages = pNextPage;
+	}
+	m_NumPages = 0;
+
+	for( uint32 sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass )
+		m_pFreeLists[ sizeClass ] = NULL;
+
+	return true;
+}
@@ -17,6 +17,7 @@
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <string.h>
 #include "../ISerializer.h"
 
 #ifndef WIN32
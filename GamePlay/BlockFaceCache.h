@@ -0,0 +1,157 @@
+//=================================================================================================
+/*!
+	\file BlockFaceCache.h
+	Game Play Library
+	Block Face Cache Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the cache of block text and pre-rendered block faces
+	used by the multiplication game fields.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __BlockFaceCache_h
+#define __BlockFaceCache_h
+
+#include "Base/Types.h"
+#include "Math/Box2i.h"
+#include "GameDefines.h"
+#include <vector>
+#include <map>
+#include <set>
+
+class TCImage;
+class RefSprite;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class BlockFaceCache
+	\brief Caches the text for block values and the faces of blocks with their text drawn on.
+
+	The text for a value is formatted and measured once and shared by every block with that
+	value. A face is a block sprite with a value's text composited onto it, rendered once into an
+	atlas page so the block can be drawn as a single image instead of a sprite followed by a
+	string of characters.
+
+	Faces are rendered through the graphics manager's temporary render target, so they must be
+	rendered on the main thread. Faces needed soon are queued, such as when the product filter
+	changes, and a few are rendered each frame by RenderQueuedFaces so a new filter never stalls a
+	frame. Faces are not available if the graphics manager can not create blank images.
+*/
+//-------------------------------------------------------------------------------------------------
+class BlockFaceCache
+{
+public:
+
+	/// The size of the text buffer for a value
+	static const int32 TEXT_BUF_SIZE = 16;
+
+	/// The largest value with text
+	static const int32 MAX_VALUE = 9999;
+
+	/// The dimensions of an atlas page
+	static const int32 PAGE_SIZE = 1024;
+
+	/// The most atlas pages that are created
+	static const uint32 MAX_PAGES = 4;
+
+	/// The text drawn on blocks with a value
+	struct ValueText
+	{
+		/// The text
+		wchar_t szText[ TEXT_BUF_SIZE ];
+
+		/// The offset from the top left of the block to the top left of the text
+		Vector2i textOffset;
+
+		/// If the offset was centered using the block font, false if the font was not loaded
+		bool isCentered;
+	};
+
+	/// A pre-rendered face
+	struct Face
+	{
+		/// The atlas page holding the face
+		const TCImage* pPage;
+
+		/// The location of the face on the page
+		Box2i srcRect;
+	};
+
+private:
+
+	/// The key for a face, the block sprite and the value
+	typedef std::pair< const RefSprite*, int32 > FaceKey;
+
+	/// The text for each value, indexed by value and created when first needed
+	std::vector<ValueText*> m_ValueTexts;
+
+	/// The rendered faces
+	std::map< FaceKey, Face > m_Faces;
+
+	/// The faces waiting to be rendered
+	std::vector< FaceKey > m_QueuedFaces;
+
+	/// The queued faces, used to avoid queuing a face twice
+	std::set< FaceKey > m_QueuedFaceSet;
+
+	/// The atlas pages
+	std::vector<TCImage*> m_Pages;
+
+	/// The position on the last page where the next face is placed
+	Point2i m_PenPos;
+
+	/// The height of the tallest face in the current row of the last page
+	int32 m_RowHeight;
+
+	/// If the graphics manager could not create a page, faces are not rendered once this is set
+	bool m_PagesUnavailable;
+
+
+	/// The default constructor, private to enforce the singleton
+	BlockFaceCache() : m_RowHeight( 0 ),
+						m_PagesUnavailable( false )
+	{}
+
+	/// Find space on a page for a face, creating a page if needed
+	TCImage* AllocFaceRect( const Vector2i& faceSize, Point2i& facePos );
+
+	/// Render a face into the atlas
+	bool RenderFace( const FaceKey& faceKey );
+
+	/// Queue a face to be rendered if it has not been rendered
+	void QueueFace( const FaceKey& faceKey );
+
+public:
+
+	/// The destructor
+	~BlockFaceCache();
+
+	/// Get the instance of the cache
+	static BlockFaceCache& Get();
+
+	/// Get the text for a value, formatting it the first time the value is used
+	const ValueText& GetValueText( int32 value );
+
+	/// Format the text for every value so GetValueText no longer changes the cache, which must be
+	/// done before blocks are created on more than one thread
+	void BuildValueTexts();
+
+	/// Get the face for a block sprite and value, NULL if it has not been rendered yet in which
+	/// case it is queued
+	const Face* GetFace( const RefSprite* pSprite, int32 value );
+
+	/// Queue the faces of the products in a product array, both normal and highlighted
+	void QueueProducts( const GameDefines::ProductArray& products );
+
+	/// Render up to a number of queued faces
+	void RenderQueuedFaces( uint32 maxFaces );
+
+	/// Get the number of rendered faces
+	uint32 GetNumFaces() const { return (uint32)m_Faces.size(); }
+};
+
+#endif // __BlockFaceCache_h
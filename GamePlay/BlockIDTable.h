@@ -0,0 +1,122 @@
+//=================================================================================================
+/*!
+	\file BlockIDTable.h
+	Game Play Library
+	Block ID Table Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the table game fields use to look up blocks by the
+	IDs stored in instructions.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __BlockIDTable_h
+#define __BlockIDTable_h
+
+#include "Base/Types.h"
+#include <vector>
+
+class GameFieldBlock;
+class Serializer;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class BlockIDTable
+	\brief A slot map from block IDs to blocks.
+
+	A block ID holds the index of the block's slot in the table in its low bits and the slot's
+	generation in its high bits. Looking up an ID is a single array access, and since a slot's
+	generation changes when its block is removed, IDs of removed blocks never find the block that
+	reuses the slot. The IDs only depend on the order blocks are added and removed, so a field
+	replaying the same instructions gives its blocks the same IDs.
+*/
+//-------------------------------------------------------------------------------------------------
+class BlockIDTable
+{
+public:
+
+	/// The number of bits in an ID used for the slot index
+	static const uint32 SLOT_BITS = 16;
+
+	/// The mask for the slot index in an ID
+	static const uint32 SLOT_MASK = (1 << SLOT_BITS) - 1;
+
+	/// The ID that is never given to a block
+	static const uint32 INVALID_ID = 0;
+
+private:
+
+	/// A slot in the table
+	struct Slot
+	{
+		/// The block in the slot, NULL if the slot is free
+		GameFieldBlock* pBlock;
+
+		/// The generation of the slot, increased whenever the slot's block is removed
+		uint32 generation;
+	};
+
+	/// The slots
+	std::vector<Slot> m_Slots;
+
+	/// The indices of the free slots, the most recently freed last
+	std::vector<uint32> m_FreeSlots;
+
+	/// The number of blocks in the table
+	uint32 m_NumBlocks;
+
+public:
+
+	/// The default constructor
+	BlockIDTable() : m_NumBlocks( 0 )
+	{}
+
+	/// Add a block and get its ID
+	uint32 Add( GameFieldBlock* pBlock );
+
+	/// Remove the block with an ID
+	void Remove( uint32 blockID );
+
+	/// Remove every block, the IDs of the removed blocks remain invalid
+	void Clear();
+
+	/// Save/load the slot generations and free slots, loading removes every block so they must
+	/// be put back with Place
+	void SerializeState( Serializer& serializer );
+
+	/// Put a block back in the slot of an ID when restoring the table's state
+	bool Place( uint32 blockID, GameFieldBlock* pBlock );
+
+	/// Get the block with an ID, NULL if no block in the table has the ID
+	GameFieldBlock* Find( uint32 blockID ) const
+	{
+		uint32 slotIndex = GetSlotIndex( blockID );
+		if( slotIndex >= m_Slots.size() || m_Slots[ slotIndex ].generation != GetGeneration( blockID ) )
+			return 0;
+
+		return m_Slots[ slotIndex ].pBlock;
+	}
+
+	/// Get the block at an index of the blocks in the table, ordered by slot
+	GameFieldBlock* GetBlockByIndex( uint32 blockIndex ) const;
+
+	/// Get the number of blocks in the table
+	uint32 GetNumBlocks() const { return m_NumBlocks; }
+
+	/// Get the number of slots, used with GetBlockInSlot to go through every block
+	uint32 GetNumSlots() const { return (uint32)m_Slots.size(); }
+
+	/// Get the block in a slot, NULL if the slot is free
+	GameFieldBlock* GetBlockInSlot( uint32 slotIndex ) const { return m_Slots[ slotIndex ].pBlock; }
+
+	/// Get the slot index stored in an ID
+	static uint32 GetSlotIndex( uint32 blockID ) { return blockID & SLOT_MASK; }
+
+	/// Get the generation stored in an ID
+	static uint32 GetGeneration( uint32 blockID ) { return blockID >> SLOT_BITS; }
+};
+
+#endif // __BlockIDTable_h
@@ -0,0 +1,190 @@
+//=================================================================================================
+/*!
+	\file EquationSolver.h
+	Game Play Library
+	Equation Solver Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the class that finds the equations that can be made
+	from the blocks on a game field.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __EquationSolver_h
+#define __EquationSolver_h
+
+#include "Base/Types.h"
+
+class GameFieldBlock;
+class GameFieldAdd;
+class GameFieldMultBase;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class EquationSolver
+	\brief Counts and finds the block combinations that make a sum or product.
+
+	The solver is given the blocks that can be used in an equation, up to one for each bit of a
+	block mask, and solves for a target value with a subset dynamic program. The states are the
+	sums from 0 up to the target, or the divisors of the target product, and for each prefix of
+	the blocks a bit set of the states reachable by one or more and by two or more of the blocks
+	is kept. This makes counting the solutions and finding one a few thousand operations, so it
+	can be done every frame.
+
+	Every equation in the game needs at least two blocks so single blocks that equal the target
+	are not solutions. The last solve is kept so finding a solution after counting them is free.
+*/
+//-------------------------------------------------------------------------------------------------
+class EquationSolver
+{
+public:
+
+	/// The type of equation to solve
+	enum EEquationType
+	{
+		ET_Sum,
+		ET_Product
+	};
+
+	/// The most blocks the solver looks at, more than the cells on the field
+	static const uint32 MAX_BLOCKS = 64;
+
+	/// The most states, which limits the largest sum that can be solved
+	static const uint32 MAX_STATES = 512;
+
+	/// A set of the solver's blocks, bit N is the Nth block added
+	typedef uint64 BlockMask;
+
+private:
+
+	/// The number of words in a state set
+	static const uint32 STATE_WORDS = MAX_STATES / 64;
+
+	/// A set of states, one bit for each state index
+	struct StateSet
+	{
+		uint64 bits[ STATE_WORDS ];
+
+		void Clear()
+		{
+			for( uint32 wordIndex = 0; wordIndex < STATE_WORDS; ++wordIndex )
+				bits[wordIndex] = 0;
+		}
+
+		bool Has( uint32 stateIndex ) const { return (bits[ stateIndex >> 6 ] & ((uint64)1 << (stateIndex & 63))) != 0; }
+
+		void Add( uint32 stateIndex ) { bits[ stateIndex >> 6 ] |= (uint64)1 << (stateIndex & 63); }
+	};
+
+	/// The blocks that can be used in an equation
+	GameFieldBlock* m_Blocks[ MAX_BLOCKS ];
+
+	/// The value of each block, stored so solving does not touch the blocks
+	int32 m_Values[ MAX_BLOCKS ];
+
+	/// The number of blocks
+	uint32 m_NumBlocks;
+
+	/// The blocks that are the targets of equations, such as the product blocks
+	GameFieldBlock* m_Targets[ MAX_BLOCKS ];
+
+	/// The number of targets
+	uint32 m_NumTargets;
+
+	/// If the tables hold a solve of the current blocks
+	bool m_IsSolved;
+
+	/// The type of the equation last solved
+	EEquationType m_SolvedType;
+
+	/// The target value last solved
+	int32 m_SolvedTarget;
+
+	/// The value of each state, the sum for a sum or the divisor, ascending, for a product. State
+	/// 0 is always the empty equation.
+	int32 m_StateValues[ MAX_STATES ];
+
+	/// The number of states
+	uint32 m_NumStates;
+
+	/// The indices of the blocks that can be part of the last solve's equation
+	uint8 m_UsedBlocks[ MAX_BLOCKS ];
+
+	/// The number of used blocks
+	uint32 m_NumUsedBlocks;
+
+	/// The number of combinations of one or more used blocks that reach each state
+	uint64 m_Counts[ MAX_STATES ];
+
+	/// The states reached by one or more of the first N used blocks
+	StateSet m_Reach[ MAX_BLOCKS + 1 ];
+
+	/// The states reached by two or more of the first N used blocks
+	StateSet m_Reach2[ MAX_BLOCKS + 1 ];
+
+
+	/// Build the tables for a target, false if the target can't be solved by the solver
+	bool Solve( EEquationType type, int32 target );
+
+	/// Get the index of the state with a value, -1 if there is none
+	int32 FindState( int32 stateValue ) const;
+
+	/// Get the state reached by adding a block to a state, -1 if it passes the target
+	int32 GetNextState( uint32 stateIndex, int32 blockValue ) const;
+
+	/// Get the state that a block was added to in order to reach a state, -1 if there is none
+	int32 GetPrevState( uint32 stateIndex, int32 blockValue ) const;
+
+public:
+
+	/// The default constructor
+	EquationSolver() : m_NumBlocks( 0 ),
+						m_NumTargets( 0 ),
+						m_IsSolved( false ),
+						m_SolvedType( ET_Sum ),
+						m_SolvedTarget( 0 ),
+						m_NumStates( 0 ),
+						m_NumUsedBlocks( 0 )
+	{}
+
+	/// Remove the blocks and targets
+	void Clear();
+
+	/// Add a block that can be used in an equation, false if the solver is full
+	bool AddBlock( GameFieldBlock* pBlock );
+
+	/// Add a block that is the target of an equation
+	bool AddTarget( GameFieldBlock* pBlock );
+
+	/// Load the summands of an addition field, the sum block is the target
+	void LoadSumField( GameFieldAdd* pField );
+
+	/// Load the factors and products on a product field
+	void LoadProductField( GameFieldMultBase* pField, GameFieldBlock* pComboBlock );
+
+	/// Count the combinations of blocks that make a value
+	uint64 CountSolutions( EEquationType type, int32 target );
+
+	/// Find a combination of blocks that makes a value, 0 if there is none
+	BlockMask FindSolution( EEquationType type, int32 target );
+
+	/// Count the targets that can be made from the blocks
+	uint32 CountSolvableTargets( EEquationType type );
+
+	/// Get the number of blocks
+	uint32 GetNumBlocks() const { return m_NumBlocks; }
+
+	/// Get a block by index, the index of its bit in a block mask
+	GameFieldBlock* GetBlock( uint32 blockIndex ) const { return blockIndex < m_NumBlocks ? m_Blocks[blockIndex] : 0; }
+
+	/// Get the number of targets
+	uint32 GetNumTargets() const { return m_NumTargets; }
+
+	/// Get a target by index
+	GameFieldBlock* GetTarget( uint32 targetIndex ) const { return targetIndex < m_NumTargets ? m_Targets[targetIndex] : 0; }
+};
+
+#endif // __EquationSolver_h
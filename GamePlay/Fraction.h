@@ -1,5 +1,33 @@
+//=================================================================================================
+/*!
+	\file Fraction.h
+	Game Play Library
+	Fraction Header
+	\author Taylor Clark
+	\date October 19, 2026
+
+	This header contains the definition for the fraction object and its exact arithmetic.
+*/
+//=================================================================================================
+
 #pragma once
+#ifndef __Fraction_h
+#define __Fraction_h
+
+#include "Base/Types.h"
+#include <string>
+
 
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class Fraction
+	\brief A numerator and denominator.
+
+	A fraction keeps the terms it was made with, so 2/4 stays 2/4 for display, and GetReduced is
+	used to get the lowest terms. Comparisons cross multiply in 64 bits so they are exact and
+	can't overflow for any 32 bit terms.
+*/
+//-------------------------------------------------------------------------------------------------
 class Fraction
 {
 public:
@@ -20,4 +48,30 @@ public:
 
 	int32 Numerator;
 	int32 Denominator;
-};
\ No newline at end of file
+
+	/// Get the greatest common divisor of two numbers, which is never negative
+	static int32 GetGCD( int32 lhs, int32 rhs );
+
+	/// Get the fraction in lowest terms with a positive denominator
+	Fraction GetReduced() const;
+
+	/// Get if two fractions have the same value, false if either has a 0 denominator
+	bool IsEquivalent( const Fraction& rhs ) const
+	{
+		if( Denominator == 0 || rhs.Denominator == 0 )
+			return false;
+
+		return (int64)Numerator * (int64)rhs.Denominator == (int64)rhs.Numerator * (int64)Denominator;
+	}
+
+	/// Compare the value of two fractions, -1 if this is less, 0 if equal and 1 if greater
+	int32 Compare( const Fraction& rhs ) const;
+
+	/// Get if the decimal form of the fraction ends within a number of places
+	bool IsDecimalWithin( int32 numPlaces ) const;
+
+	/// Get the decimal form of the fraction cut off at a number of places
+	std::wstring GetDecimalText( int32 numPlaces ) const;
+};
+
+#endif // __Fraction_h
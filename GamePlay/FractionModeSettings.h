@@ -18,10 +18,21 @@
 #include "Base/Types.h"
 #include <vector>
 #include <list>
-#include <map>
-#include <set>
+#include <string>
 #include "Fraction.h"
+#include "Base/RandomGen.h"
 
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class FractionModeSettings
+	\brief The fractions and block values used by a fraction difficulty.
+
+	The settings for every difficulty are built once, the first time they are requested, and
+	include everything the fraction logic looks up while playing: each fraction's lowest terms,
+	its decimal text, the block values its equivalents use, and the numerator and denominator
+	pairs that solve it. This keeps generating blocks and checking equations to array lookups.
+*/
+//-------------------------------------------------------------------------------------------------
 class FractionModeSettings
 {
 public:
@@ -29,12 +40,27 @@ public:
 	{
 		Fraction FractionValue;
 
+		/// The fraction in lowest terms, used to match equivalent fractions
+		Fraction ReducedValue;
+
+		/// If the fraction's decimal form fits in the difficulty's decimal places
+		bool HasShortDecimal;
+
+		/// The decimal form of the fraction, empty if it doesn't fit
+		std::wstring DecimalText;
+
 		/// The values used by this fraction and all equivalent fractions up to the difficulty's
-		/// maximum value
-		std::set<int32> ValuesUpToMax;
+		/// maximum value, sorted ascendingly
+		std::vector<int32> ValuesUpToMax;
 
-		/// The number of times each fraction value is used
-		std::map<int32, uint8> ValueScalars;
+		/// The number of times each value in ValuesUpToMax is used
+		std::vector<uint8> ValueScalars;
+
+		/// The numerator and denominator values that are equivalent to the fraction
+		std::vector<Fraction> SolutionPairs;
+
+		FractionInfo() : HasShortDecimal( false )
+		{}
 	};
 
 	/// The fractions that can be presented to the user
@@ -52,14 +78,26 @@ public:
 
 	void InitValuesFromFractions( std::list<Fraction> fractions );
 
+	/// Build the settings for every difficulty
+	static void PopulateFractionModes( std::vector<FractionModeSettings>& modes );
+
 public:
 
+	/// The most fractions a difficulty uses
+	static const uint32 MAX_FRACTIONS = 32;
+
 	FractionModeSettings() : DecimalPlaces(1), MaxValue(1)
 	{}
 
 	FractionModeSettings( int32 decimalPlaces, int32 exclusiveMaxValue, std::list<Fraction> fractions );
 
-	Fraction GetRandomFraction( uint32 fractionIndex ) const;
+	Fraction GetRandomFraction( uint32 fractionIndex, TCBase::RandomGen& random ) const;
+
+	/// Get the index of the first fraction equivalent to a fraction, -1 if there is none
+	int32 FindFractionIndex( const Fraction& fraction ) const;
+
+	/// Get the settings for a difficulty, they are built the first time this is called
+	static const FractionModeSettings& GetForDifficulty( int32 difficulty );
 };
 
 #endif // __FractionModeSettings_h
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "GameGUILayout.h"
 #include "GameDefines.h"
 #include <stdio.h>
+#include <map>
 #include "PlayerProfile.h"
 //#include "Network/IPAddress.h"
 //#include "GameNetMsgs.h"
@@ -0,0 +1,108 @@
+//=================================================================================================
+/*!
+	\file GameContext.h
+	Game Play Library
+	Game Context Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the context that lets several headless games run at
+	once on different threads.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __GameContext_h
+#define __GameContext_h
+
+#include "Base/SmallObjectPool.h"
+#include "GameMgr.h"
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class GameContext
+	\brief Holds the per-game state that is otherwise shared by the whole process.
+
+	The gameplay code reaches the game manager through GameMgr::Get() and allocates its blocks
+	and instructions from shared pools, so only one game can run at a time. A context owns its
+	own game manager and pools, and while it is bound to a thread, GameMgr::Get() and the pools
+	used by that thread are the context's. This lets a tool, such as the replay verifier,
+	simulate a game on each of several threads.
+
+	A context's games are always headless since the GUI, audio and graphics managers are still
+	shared. Every block and instruction allocated while a context is bound must be freed while
+	it is bound, which is the case as long as the context's games are started, updated and
+	cleared with the context bound. A context is bound to one thread at a time.
+*/
+//-------------------------------------------------------------------------------------------------
+class GameContext
+{
+private:
+
+	/// The pool the blocks of the context's games are allocated from
+	TCBase::SmallObjectPool m_BlockPool;
+
+	/// The pool the instructions of the context's games are allocated from
+	TCBase::SmallObjectPool m_InstructionPool;
+
+	/// The game manager, declared after the pools so it is destroyed before them
+	GameMgr m_GameMgr;
+
+	/// Contexts are not copied
+	GameContext( const GameContext& );
+	GameContext& operator=( const GameContext& );
+
+public:
+
+	//---------------------------------------------------------------------------------------------
+	/*!
+		\class Scope
+		\brief Binds a context to the calling thread for the life of the object.
+	*/
+	//---------------------------------------------------------------------------------------------
+	class Scope
+	{
+	private:
+
+		/// The context that was bound before this one
+		GameContext* m_pPrevContext;
+
+	public:
+
+		/// The constructor binds the context
+		Scope( GameContext& context ) : m_pPrevContext( GameContext::GetCurrent() )
+		{
+			GameContext::SetCurrent( &context );
+		}
+
+		/// The destructor binds the previous context again
+		~Scope()
+		{
+			GameContext::SetCurrent( m_pPrevContext );
+		}
+	};
+
+	/// The default constructor
+	GameContext();
+
+	/// The destructor, frees the context's game and its pools
+	~GameContext();
+
+	/// Get the context bound to the calling thread, NULL if there is none
+	static GameContext* GetCurrent();
+
+	/// Bind a context to the calling thread, NULL to use the process wide state
+	static void SetCurrent( GameContext* pContext );
+
+	/// Get the context's game manager
+	GameMgr& GetGameMgr() { return m_GameMgr; }
+
+	/// Get the pool the context's blocks are allocated from
+	TCBase::SmallObjectPool& GetBlockPool() { return m_BlockPool; }
+
+	/// Get the pool the context's instructions are allocated from
+	TCBase::SmallObjectPool& GetInstructionPool() { return m_InstructionPool; }
+};
+
+#endif // __GameContext_h
@@ -115,6 +115,58 @@ namespace GameDefines
 		uint32 maxNumFactors;
 	};
 
+	/// Adjustments to the difficulty tables, used by the calibration tool to measure how the game
+	/// responds to each parameter. The default values leave the tables unchanged.
+	struct DifficultyTuning
+	{
+		DifficultyTuning() : maxValueScale( 1.0f ),
+							maxNumFactorsOffset( 0 ),
+							maxPrimeIndexOffset( 0 ),
+							sumRangeScale( 1.0f )
+		{}
+
+		/// Get if the tuning changes anything
+		bool IsDefault() const
+		{
+			return maxValueScale == 1.0f && maxNumFactorsOffset == 0 && maxPrimeIndexOffset == 0 && sumRangeScale == 1.0f;
+		}
+
+		/// Apply the product adjustments to a filter made from the difficulty table
+		void ApplyToFilter( ProductSubsetFilter& filter ) const
+		{
+			filter.maxValue = (int32)( (float32)filter.maxValue * maxValueScale );
+
+			int32 maxNumFactors = (int32)filter.maxNumFactors + maxNumFactorsOffset;
+			filter.maxNumFactors = maxNumFactors < 2 ? 2 : (uint32)maxNumFactors;
+
+			// The usable primes are every prime up to the highest one set
+			int32 maxPrimeIndex = 0;
+			for( uint32 primeIndex = 0; primeIndex < NUM_PRIMES; ++primeIndex )
+			{
+				if( filter.useablePrimes & (1 << primeIndex) )
+					maxPrimeIndex = (int32)primeIndex;
+			}
+			maxPrimeIndex += maxPrimeIndexOffset;
+			if( maxPrimeIndex < 1 )
+				maxPrimeIndex = 1;
+			else if( maxPrimeIndex >= (int32)NUM_PRIMES )
+				maxPrimeIndex = (int32)NUM_PRIMES - 1;
+			filter.SetMaxPrimeByIndex( (uint32)maxPrimeIndex );
+		}
+
+		/// The scale applied to the largest product
+		float32 maxValueScale;
+
+		/// The number added to the most prime factors in a product
+		int32 maxNumFactorsOffset;
+
+		/// The number added to the index of the largest usable prime
+		int32 maxPrimeIndexOffset;
+
+		/// The scale applied to the range of sums above the smallest sum in addition games
+		float32 sumRangeScale;
+	};
+
 	/// The type of Prime Time gameplay mode
 	enum EPrimeTimeGameMode
 	{
@@ -163,6 +215,10 @@ namespace GameDefines
 	static const int32 BLOCK_WIDTH = 55;
 	static const int32 BLOCK_HEIGHT = 55;
 
+	/// The length of a game simulation tick in seconds, the game is always updated in steps of
+	/// this size regardless of the frame rate
+	static const float32 SIM_TICK_TIME = 1.0f / 120.0f;
+
 	/// Initialize the game data
 	bool InitializeBaseObjects();
 
@@ -15,18 +15,19 @@
 #define __GameField_h
 
 #include <list>
-#include <map>
 #include "Base/Types.h"
 #include "GUI/GUIControl.h"
 #include "Math/Box2i.h"
 #include "GamePlay/AnimSprite.h"
 #include "Resource/ResourceMgr.h"
 #include "GameFieldBlock.h"
+#include "BlockIDTable.h"
 
 class GameMgr;
 class GameFieldInstruction;
 class PIIToggleBlockSelect;
 class InstructionStream;
+class Serializer;
 
 
 //-------------------------------------------------------------------------------------------------
@@ -55,8 +56,8 @@ public:
 	/// The playing field bounding box in screen coordinates, the position is the top left
 	Box2i m_FieldBox;
 
-	/// The list of selected blocks
-	BlockList m_SelBlocks;
+	/// The list of selected blocks, in the order they were selected
+	BlockSelection m_SelBlocks;
 
 	/// The offset from the playing field at which to draw the border
 	Vector2i m_BorderOffset;
@@ -82,12 +83,15 @@ public:
 	/// The source for game field instructions
 	InstructionStream* m_pInstStream;
 
-	/// The map of block IDs to blocks, used by instructions
-	std::map< uint32, GameFieldBlock* > m_BlockIDMap;
+	/// The table of block IDs to blocks, used by instructions
+	BlockIDTable m_BlockIDs;
 
-	/// The ID of the next block
-	uint32 m_NextBlockID;
 
+	/// Add a block to the ID table and give the block its ID
+	void AddBlockID( GameFieldBlock* pBlock ) { pBlock->m_BlockID = m_BlockIDs.Add( pBlock ); }
+
+	/// Remove a block from the ID table, the block keeps its old ID
+	void RemoveBlockID( GameFieldBlock* pBlock ) { m_BlockIDs.Remove( pBlock->GetID() ); }
 
 	/// Get if a block is selected
 	bool IsBlockSelected( GameFieldBlock* pBlock, BlockList::const_iterator* pSaveBlockIter = NULL ) const;
@@ -109,12 +113,18 @@ public:
 	/// Allow derived classes to update
 	virtual void SubclassUpdate( float frameTime ) = 0;
 
+	/// Store the block positions at the start of a simulation tick for interpolated drawing
+	virtual void StorePrevPositions() {}
+
+	/// Save/load the blocks and any other state of a derived class, blocks must be put back in
+	/// the ID table with m_BlockIDs.Place when loading
+	virtual bool SubclassSerializeState( Serializer& ) { return false; }
+
 public:
 
 	GameField() : m_LowestY( 0.0f ),
 					m_FieldElapsedTime( 0.0f ),
-					m_pInstStream( 0 ),
-					m_NextBlockID( 1 )
+					m_pInstStream( 0 )
 	{
 	}
 
@@ -142,6 +152,12 @@ public:
 	/// Get the list of selected blocks
 	const BlockList& GetSelectedBlocks() const { return m_SelBlocks; }
 
+	/// Get the block with an ID, NULL if there is no block on the field with the ID
+	GameFieldBlock* GetBlockByID( uint32 blockID ) const { return m_BlockIDs.Find( blockID ); }
+
+	/// Get the number of blocks on the field
+	uint32 GetNumBlocks() const { return m_BlockIDs.GetNumBlocks(); }
+
 	/// Receive a mouse click
 	void ClickAtPoint( const Point2i& cursorPos, GUIDefines::EMouseButtons btn );
 
@@ -157,6 +173,9 @@ public:
 	/// Clear the field
 	virtual void ClearField() = 0;
 
+	/// Save/load the complete state of the field for a game state snapshot
+	bool SerializeState( Serializer& serializer );
+
 	/// Get the field box
 	Box2i GetFieldRect() const { return m_FieldBox; }
 
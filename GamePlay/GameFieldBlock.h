@@ -15,7 +15,12 @@
 #define __GameFieldBlock_h
 
 #include "Base/Types.h"
+#include "Base/SmallObjectPool.h"
+#include "Base/Serializer.h"
 #include "Graphics2D/RefSprite.h"
+#include "BlockIDTable.h"
+#include <list>
+#include <vector>
 
 
 //-------------------------------------------------------------------------------------------------
@@ -35,6 +40,10 @@ public:
 	/// the field and increases upwards
 	float32 yPos;
 
+	/// The Y position at the start of the last simulation tick, used to draw the block between
+	/// ticks
+	float32 prevYPos;
+
 	/// The speed at which this block is falling
 	float32 yFallingSpeed;
 
@@ -44,7 +53,8 @@ public:
 	/// If this block is falling
 	bool isFalling;
 
-	/// The unique ID of this block
+	/// The ID of this block, given by the game field's block ID table when the block is added to
+	/// the field
 	uint32 m_BlockID;
 
 	/// The size of the text buffer for block display text
@@ -61,18 +71,26 @@ public:
 	/// The default constructor
 	GameFieldBlock( int32 value ) : m_Value( value ),
 						yPos(0.0f),
+						prevYPos(0.0f),
 						colIndex(0),
 						yFallingSpeed(0.0f),
 						isFalling( false ),
-						m_BlockID( 0 )
+						m_BlockID( BlockIDTable::INVALID_ID )
 	{
-		static uint32 s_NextBlockID = 1;
-		m_BlockID = s_NextBlockID++;
 	}
 
 	/// The destructor, virtual to ensure derived classes are freed properly
 	virtual ~GameFieldBlock() {}
 
+	/// Allocate blocks from the block pool since they are created and freed throughout a game
+	static void* operator new( size_t numBytes ) { return GetPool().Alloc( numBytes ); }
+
+	/// Free a block to the block pool, the size is that of the derived class being freed
+	static void operator delete( void* pMem, size_t numBytes ) { GetPool().Free( pMem, numBytes ); }
+
+	/// Get the pool that blocks are allocated from
+	static TCBase::SmallObjectPool& GetPool();
+
 	/// Get the text to be displayed on the block
 	virtual const wchar_t* GetText() const { return (wchar_t*)0; }
 
@@ -82,6 +100,17 @@ public:
 	/// Get the block's unique ID
 	uint32 GetID() const { return m_BlockID; }
 
+	/// Save/load the block's position and movement for a game state snapshot. The value and ID
+	/// are stored by the field since they are needed to create the block.
+	virtual void SerializeState( Serializer& serializer )
+	{
+		serializer.AddData( yPos );
+		serializer.AddData( prevYPos );
+		serializer.AddData( yFallingSpeed );
+		serializer.AddData( colIndex );
+		serializer.AddData( isFalling );
+	}
+
 	/// Get the offset from the top left of the block to the top left of the text in screen
 	/// coordinates
 	virtual Vector2i GetTextOffset() const { return Vector2i(); }
@@ -106,4 +135,85 @@ public:
 	}
 };
 
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class BlockSelection
+	\brief An ordered list of blocks that also tracks which blocks it holds in a bit set.
+
+	The bit set is indexed by the block ID table slot of each block so testing if a block is in
+	the list does not search it. The blocks must be in a field's ID table while they are in the
+	list, and only the modifying methods declared here may be used so the bits stay in sync.
+*/
+//-------------------------------------------------------------------------------------------------
+class BlockSelection : public BlockList
+{
+private:
+
+	/// A bit for each ID table slot, set if the block in the slot is in the list
+	std::vector<uint32> m_SlotBits;
+
+	/// Set or clear the bit for a block
+	void SetBlockBit( const GameFieldBlock* pBlock, bool isSet )
+	{
+		uint32 slotIndex = BlockIDTable::GetSlotIndex( pBlock->GetID() );
+		uint32 wordIndex = slotIndex / 32;
+		if( wordIndex >= m_SlotBits.size() )
+		{
+			if( !isSet )
+				return;
+			m_SlotBits.resize( wordIndex + 1, 0 );
+		}
+
+		if( isSet )
+			m_SlotBits[ wordIndex ] |= (1u << (slotIndex % 32));
+		else
+			m_SlotBits[ wordIndex ] &= ~(1u << (slotIndex % 32));
+	}
+
+public:
+
+	/// Determine if a block is in this list
+	bool ContainsBlock( const GameFieldBlock* pTestBlock ) const
+	{
+		if( !pTestBlock )
+			return false;
+
+		uint32 slotIndex = BlockIDTable::GetSlotIndex( pTestBlock->GetID() );
+		uint32 wordIndex = slotIndex / 32;
+		if( wordIndex >= m_SlotBits.size() )
+			return false;
+		return (m_SlotBits[ wordIndex ] & (1u << (slotIndex % 32))) != 0;
+	}
+
+	/// Add a block to the end of the list
+	void push_back( GameFieldBlock* pBlock )
+	{
+		BlockList::push_back( pBlock );
+		SetBlockBit( pBlock, true );
+	}
+
+	/// Remove the block at the end of the list
+	void pop_back()
+	{
+		SetBlockBit( back(), false );
+		BlockList::pop_back();
+	}
+
+	/// Remove a block from the list
+	iterator erase( iterator iterBlock )
+	{
+		SetBlockBit( *iterBlock, false );
+		return BlockList::erase( iterBlock );
+	}
+
+	/// Remove all of the blocks. The blocks are not accessed so this is safe to call after the
+	/// blocks have been freed.
+	void clear()
+	{
+		m_SlotBits.assign( m_SlotBits.size(), 0 );
+		BlockList::clear();
+	}
+};
+
 #endif // __GameFieldBlock_h
\ No newline at end of file
@@ -57,15 +57,17 @@ private:
 		// Create the text string
 		swprintf( m_TextChars, TEXT_BUF_SIZE, L"%d", m_Value );
 
-		// Get the text offset
-		m_TextOffset.x = (boxWidth - GameDefines::GetBlockTextFont()->CalcStringWidth( m_TextChars )) / 2;
-		m_TextOffset.y = (GameDefines::BLOCK_HEIGHT - GameDefines::GetBlockTextFont()->GetCharHeight()) / 2;
+		// Get the text offset, the font is not loaded when running without graphics
+		if( GameDefines::GetBlockTextFont().GetObj() )
+		{
+			m_TextOffset.x = (boxWidth - GameDefines::GetBlockTextFont()->CalcStringWidth( m_TextChars )) / 2;
+			m_TextOffset.y = (GameDefines::BLOCK_HEIGHT - GameDefines::GetBlockTextFont()->GetCharHeight()) / 2;
+		}
 	}
 
 	/// The constructor to initialize the block data
-	GameFieldBlockAdd( uint32 blockID, int32 value, bool isSum = false ) : GameFieldBlock( value )
+	GameFieldBlockAdd( int32 value, bool isSum = false ) : GameFieldBlock( value )
 	{
-		m_BlockID = blockID;
 		SetValue( value, isSum );
 	}
 
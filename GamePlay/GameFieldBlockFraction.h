@@ -40,6 +40,9 @@ public:
 	GameFieldBlockFraction( int32 value ) : GameFieldBlockMultBase( value )
 	{
 	}
+
+	/// Get the type of block
+	virtual EBlockType GetBlockType() const { return BT_Fraction; }
 };
 
 #endif // __GameFieldBlockFraction_h
\ No newline at end of file
@@ -15,7 +15,8 @@
 #define __GameFieldBlockMultBase_h
 
 #include "GameFieldBlock.h"
-#include <stdio.h>
+#include "BlockFaceCache.h"
+#include "Resource/ResourceMgr.h"
 
 
 //-------------------------------------------------------------------------------------------------
@@ -28,47 +29,97 @@ class GameFieldBlockMultBase : public GameFieldBlock
 {
 public:
 
+	/// The most columns a block can span
+	static const int32 MAX_WIDTH = 2;
+
+	/// The types of multiplication field blocks, used to create the right type of block when
+	/// loading a game state snapshot
+	enum EBlockType
+	{
+		BT_MultBase = 0,
+		BT_Product,
+		BT_Factor,
+		BT_Fraction
+	};
+
 	/// The size of the block in tiles
 	Vector2i size;
 
+	/// The index of this block within each column it spans, from the left-most column. These are
+	/// kept up to date by the game field so the blocks above and below can be found directly.
+	int32 colSlots[MAX_WIDTH];
+
 	/// The sprite for this block
 	RefSpriteHndl sprite;
 
+protected:
+
+	/// The text for the block's value shared by every block with the value, NULL if the block
+	/// doesn't display text
+	const BlockFaceCache::ValueText* m_pValueText;
+
 public:
 
 	/// The default constructor
 	GameFieldBlockMultBase( int32 value ) : GameFieldBlock( value ),
 															size(1,1)
 	{
-		// Clear the text buffer
-		for( int charIndex = 0; charIndex < TEXT_BUF_SIZE; ++charIndex )
-			m_TextChars[ charIndex ] = 0;
+		for( int32 slotIndex = 0; slotIndex < MAX_WIDTH; ++slotIndex )
+			colSlots[ slotIndex ] = -1;
 
 		// If the value is more than 2 digits then increse the width
 		if( value > 99 )
 			size.x = 2;
 
 		// Make sure the value doesn't exceed what can fit
-		if( m_Value > 9999 )
-			m_Value = 9999;
-
-		// Create the text string
-		swprintf( m_TextChars, TEXT_BUF_SIZE, L"%d", m_Value );
+		if( m_Value > BlockFaceCache::MAX_VALUE )
+			m_Value = BlockFaceCache::MAX_VALUE;
 
-		// Center the number text
-		m_TextOffset.x = ((GameDefines::BLOCK_WIDTH * size.x) - GameDefines::GetBlockTextFont()->CalcStringWidth( m_TextChars )) / 2;
-		m_TextOffset.y = ((GameDefines::BLOCK_HEIGHT * size.y) - GameDefines::GetBlockTextFont()->GetCharHeight()) / 2;
+		// Use the cached text so blocks don't format and measure their value when created
+		m_pValueText = &BlockFaceCache::Get().GetValueText( m_Value );
 	}
 
 	/// Get the text to be displayed on the block
 	virtual const wchar_t* GetText() const
 	{
-		return m_TextChars;
+		if( !m_pValueText )
+			return 0;
+		return m_pValueText->szText;
 	}
 
 	/// Get the offset from the top left of the block to the top left of the text in screen
 	/// coordinates
-	virtual Vector2i GetTextOffset() const { return m_TextOffset; }
+	virtual Vector2i GetTextOffset() const
+	{
+		if( !m_pValueText )
+			return Vector2i();
+		return m_pValueText->textOffset;
+	}
+
+	/// Get the type of block
+	virtual EBlockType GetBlockType() const { return BT_MultBase; }
+
+	/// Save/load the block's position, movement, size and sprite for a game state snapshot
+	virtual void SerializeState( Serializer& serializer )
+	{
+		GameFieldBlock::SerializeState( serializer );
+
+		serializer.AddData( size.x );
+		serializer.AddData( size.y );
+
+		// Store the sprite by its resource ID, 0 if the block has no sprite
+		ResourceID spriteResID = 0;
+		if( sprite.GetObj() )
+			spriteResID = sprite.GetObj()->GetResID();
+		serializer.AddData( spriteResID );
+		if( serializer.InReadMode() )
+		{
+			if( spriteResID != 0 )
+				sprite = ResourceMgr::Get().GetRefSprite( spriteResID );
+			else
+				sprite = RefSpriteHndl( 0 );
+		}
+	}
 };
 
 #endif // __GameFieldBlockMultBase_h
\ No newline at end of file
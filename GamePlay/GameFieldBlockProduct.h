@@ -38,15 +38,14 @@ public:
 	{
 		// Only products need text
 		if( !m_IsProduct )
-		{
-			// Clear the text buffer
-			for( int charIndex = 0; charIndex < TEXT_BUF_SIZE; ++charIndex )
-				m_TextChars[ charIndex ] = 0;
-		}
+			m_pValueText = 0;
 	}
 
 	/// Get if this block is a product block
 	bool IsProductBlock() const { return m_IsProduct; }
+
+	/// Get the type of block
+	virtual EBlockType GetBlockType() const { return m_IsProduct ? BT_Product : BT_Factor; }
 };
 
 #endif // __GameFieldBlockProduct_h
\ No newline at end of file
@@ -48,6 +48,9 @@ private:
 
 	float32 GetColumnOffsets(int32 offsets[]) const;
 
+	/// Save/load the blocks and the ceiling for a game state snapshot
+	virtual bool SubclassSerializeState( Serializer& serializer );
+
 public:
 
 	/// The default constructor
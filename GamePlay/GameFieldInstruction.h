@@ -21,6 +21,7 @@
 
 #include "Base/Types.h"
 #include "Base/Serializer.h"
+#include "Base/SmallObjectPool.h"
 
 
 /// The enum defining the possible instructions that can be processed by the game field
@@ -63,6 +64,16 @@ public:
 	/// The destructor, virtual to ensure subclasses are cleaned up properly
 	virtual ~GameFieldInstruction() {}
 
+	/// Allocate instructions from the instruction pool since one is created for nearly every
+	/// player action and field event
+	static void* operator new( size_t numBytes ) { return GetPool().Alloc( numBytes ); }
+
+	/// Free an instruction to the instruction pool, the size is that of the derived class
+	static void operator delete( void* pMem, size_t numBytes ) { GetPool().Free( pMem, numBytes ); }
+
+	/// Get the pool that instructions are allocated from
+	static TCBase::SmallObjectPool& GetPool();
+
 	/// Get the type of instruction this object represents
 	virtual EGameFieldInstruction GetType() const = 0;
 
@@ -86,6 +97,10 @@ public:
 		SubclassSerialize( serializer );
 	}
 
+	/// Pack only the instruction's data, used by replays which store the type and timing of
+	/// instructions themselves
+	void SerializePayload( Serializer& serializer ) { SubclassSerialize( serializer ); }
+
 	/// Create an instuction based on the type ID
 	static GameFieldInstruction* CreateInstruction( EGameFieldInstruction instTypeID );
 };
@@ -15,6 +15,8 @@
 #define __GameFieldMultBase_h
 
 #include "GameField.h"
+#include <vector>
+#include "Base/RandomGen.h"
 
 class GameFieldBlock;
 class GameMgr;
@@ -22,6 +24,7 @@ class GameFieldBlockMultBase;
 class PIIToggleBlockSelect;
 
 typedef std::list<GameFieldBlockMultBase*> MultBlockList;
+typedef std::vector<GameFieldBlockMultBase*> MultBlockColumn;
 
 //-------------------------------------------------------------------------------------------------
 /*!
@@ -43,9 +46,10 @@ protected:
 	float32 m_PushUpSpeed;
 
 	/// The columns of blocks, ordered from bottom to top
-	/// This is a list of all blocks within this column.  If a block spans multiple columns then it
-	/// will be in multiple column lists.  These lists will never have a NULL value in them.
-	MultBlockList m_Cols[FIELD_WIDTH];
+	/// This is an array of all blocks within this column.  If a block spans multiple columns then
+	/// it will be in multiple column arrays.  These arrays will never have a NULL value in them and
+	/// each block stores its index within them in its colSlots member.
+	MultBlockColumn m_Cols[FIELD_WIDTH];
 
 	/// The list of all unique blocks in this game field
 	MultBlockList m_ActiveBlocks;
@@ -56,9 +60,20 @@ protected:
 	/// The time at which the game field was last shaken
 	float32 m_LastShakeTime;
 
+	/// The offset currently applied to the field box to shake the field
+	Vector2i m_FieldShakeOffset;
+
+	/// The random number generator used for the shake effect, kept separate from the game
+	/// logic's generator so that drawing the field never changes which blocks are generated
+	TCBase::RandomGen m_ShakeRandom;
+
 	/// The height of each column in percent of field height
 	float32 m_ColumnHeight[FIELD_WIDTH];
 
+	/// The blocks drawn without a pre-rendered face whose text still needs to be drawn, mutable
+	/// since it is filled while drawing
+	mutable std::vector<const GameFieldBlockMultBase*> m_TextBlocks;
+
 	
 	/// Move the blocks up
 	void MoveBlocksUp( float moveAmt );
@@ -72,6 +87,15 @@ protected:
 	/// Check for block collision in a specfic column
 	void Update_CheckForCollision_Column( GameFieldBlockMultBase* pFirstBlock, int32 colIndex );
 
+	/// Add a block to the top or bottom of a column
+	void AddBlockToCol( GameFieldBlockMultBase* pBlock, int32 colIndex, bool atBottom );
+
+	/// Remove a block from a column
+	void RemoveBlockFromCol( int32 colIndex, int32 slotIndex );
+
+	/// Update the stored column index of the blocks in a column starting at a slot
+	void UpdateColSlots( int32 colIndex, int32 startSlotIndex );
+
 	/// The recursive function to update blocks above a newly falling block
 	void Recurse_UpdateFalling( GameFieldBlockMultBase* pBlock );
 
@@ -87,13 +111,34 @@ protected:
 	/// Update the game field
 	virtual void SubclassUpdate( float frameTime );
 
+	/// Store the block positions at the start of a simulation tick
+	virtual void StorePrevPositions();
+
+	/// Get the Y position at which to draw a block, blended between the last two ticks
+	float32 GetDrawYPos( const GameFieldBlock* pBlock ) const;
+
+	/// Get the sprite to draw for a block
+	const RefSprite* GetBlockDrawSprite( const GameFieldBlockMultBase* pBlock, const Point2i& blockPos, const Point2i& cursorScreenPos ) const;
+
+	/// Save/load the blocks, columns and field movement for a game state snapshot
+	virtual bool SubclassSerializeState( Serializer& serializer );
+
+	/// Save/load a block's type, value, ID and state, creating the block when loading
+	GameFieldBlockMultBase* SerializeBlockState( Serializer& serializer, GameFieldBlockMultBase* pBlock );
+
 public:
 
 	/// The default constructor
 	GameFieldMultBase() : m_PushUpSpeed( 1.0f ),
 						m_IsFieldDone( false ),
-						m_LastShakeTime( 0.0f )
+						m_LastShakeTime( 0.0f ),
+						m_FieldShakeOffset( 0, 0 ),
+						m_ShakeRandom( TCBase::RandomGen::GenerateSeed() )
 	{
+		// Reserve enough room for a full column plus the blocks entering it so adding blocks
+		// during play never allocates
+		for( int32 colIndex = 0; colIndex < FIELD_WIDTH; ++colIndex )
+			m_Cols[colIndex].reserve( FIELD_HEIGHT * 2 );
 	}
 
 	/// The destructor
@@ -121,8 +166,11 @@ public:
 	/// Get the danger level for the field
 	float32 GetDangerLevel() const;
 
-	/// Get the iterator of a block within a column
-	MultBlockList::iterator FindBlockInCol( GameFieldBlockMultBase* pBlock, MultBlockList& blockCol );
+	/// Get the index of a block within a column
+	int32 FindBlockInCol( const GameFieldBlockMultBase* pBlock, int32 colIndex ) const;
+
+	/// Get the blocks in a column, ordered from bottom to top
+	const MultBlockColumn& GetColumn( int32 colIndex ) const { return m_Cols[colIndex]; }
 
 	/// Clear the field
 	virtual void ClearField();
@@ -132,6 +180,9 @@ public:
 
 	/// Get the y-position of the bottom most block on the field
 	float32 GetBottomMostBlockY() const { return m_LowestY; }
+
+	/// Get the list of all unique blocks in the field
+	const MultBlockList& GetActiveBlocks() const { return m_ActiveBlocks; }
 };
 
 #endif // __GameFieldMultBase_h
\ No newline at end of file
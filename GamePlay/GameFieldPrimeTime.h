@@ -77,6 +77,12 @@ private:
 	/// Update the game field
 	virtual void SubclassUpdate( float frameTime );
 
+	/// Create the combo block without adding it to the ID table
+	void CreateComboBlock( int32 blockValue );
+
+	/// Save/load the blocks, the combo block and the comboable blocks for a game state snapshot
+	virtual bool SubclassSerializeState( Serializer& serializer );
+
 public:
 	
 	/// The default constructor
@@ -16,11 +16,13 @@
 
 #include "Base/Types.h"
 #include "GameDefines.h"
+#include "Base/RandomGen.h"
 
 class GameFieldBlock;
 class GameField;
 class PlayerProfile;
 class GUILayoutInGame;
+class Serializer;
 
 
 //-------------------------------------------------------------------------------------------------
@@ -64,6 +66,9 @@ protected:
 	/// Allow a subclass to update data if needed
 	virtual void SubclassUpdate( float32 ) {}
 
+	/// Save/load a derived class's data for a game state snapshot
+	virtual bool SubclassSerializeState( Serializer& ) { return true; }
+
 	/// Is the game over
 	virtual bool IsGameOver() = 0;
 
@@ -76,6 +81,13 @@ protected:
 	/// The time limit
 	uint32 m_TimeLimit;
 
+	/// The seed used to initialize the random number generator for this game
+	uint64 m_Seed;
+
+	/// The random number generator used for all gameplay decisions, mutable since drawing a
+	/// number does not change the logical state of the game
+	mutable TCBase::RandomGen m_Random;
+
 	static float32 GetPushUpSpeed( int32 level );
 
 public:
@@ -84,7 +96,8 @@ public:
 	GameLogic() : m_GameType( GameDefines::GT_Error ),
 					m_pGameGUILayout( 0 ),
 					m_SecondCount( 0.0f ),
-					m_TimeLimit( 0 )
+					m_TimeLimit( 0 ),
+					m_Seed( 0 )
 	{
 	}
 
@@ -92,7 +105,7 @@ public:
 	virtual ~GameLogic(){}
 
 	/// Initialize the logic
-	bool Init( GameDefines::EGameType gameType, uint32 timeLimit = 0 );
+	bool Init( GameDefines::EGameType gameType, uint32 timeLimit, uint64 seed );
 
 	/// Close the logic
 	virtual void Term() {}
@@ -100,6 +113,12 @@ public:
 	/// Update the game logic
 	virtual void Update( float32 frameTime );
 
+	/// Get if the logic and its field can save and restore their state for game state snapshots
+	virtual bool CanSerializeState() const { return false; }
+
+	/// Save/load the complete state of the logic and its field for a game state snapshot
+	bool SerializeState( Serializer& serializer );
+
 	/// A message handler for when a block is selected
 	virtual EBlockSelAction OnBlockSelect( GameFieldBlock* pBlock ) = 0;
 
@@ -109,11 +128,17 @@ public:
 	/// Get the game type
 	GameDefines::EGameType GetGameType() const { return m_GameType; }
 
+	/// Get the seed used to initialize the random number generator
+	uint64 GetSeed() const { return m_Seed; }
+
 	/// Get the game field
 	virtual GameField* GetGameField() = 0;
 
 	/// Get the logic type
 	virtual ELogicType GetLogicType() const = 0;
+
+	/// Get the current score
+	virtual uint32 GetScore() const { return 0; }
 };
 
 #endif // __GameLogic_h
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "GameLogic.h"
 #include "GameDefines.h"
 #include "GameSessionStatsAdd.h"
+#include "EquationSolver.h"
 #include <vector>
 #include <list>
 
@@ -80,6 +81,9 @@ protected:
 
 	bool _isInPractice10Mode;
 
+	/// The solver used to check that a generated sum can be made from the field
+	EquationSolver m_Solver;
+
 
 	/// Initialize the summands to generate
 	void InitNumbers();
@@ -87,6 +91,9 @@ protected:
 	/// Generate a sum
 	virtual int32 GenerateSum();
 
+	/// Pick a random sum within the range
+	int32 RollSum();
+
 	/// Initialize a derived class's data
 	virtual bool SubclassInit();
 
@@ -135,6 +142,12 @@ public:
 
 	/// Get the session stats
 	const GameSessionStatsAdd& GetSessionStats() const { return m_CurSessionStats; }
+
+	/// Get the current score
+	virtual uint32 GetScore() const { return m_CurSessionStats.m_Score; }
+
+	/// Count the combinations of blocks on the field that make the sum block
+	uint64 CountSumSolutions();
 };
 
 #endif // __GameLogicAdd_h
\ No newline at end of file
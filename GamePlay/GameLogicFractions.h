@@ -55,6 +55,9 @@ private:
 
 	int32 GetNextFractionBlockValue(int32 maxBlockWidth) const;
 
+	/// Get the number of blocks on the field with a fraction's value, scaled by its use
+	uint8 GetScaledValueCount( const FractionModeSettings::FractionInfo& fraction, uint32 valueIndex ) const;
+
 protected:
 	
 	/// Get the next fraction for the player to solve
@@ -103,6 +106,9 @@ public:
 
 	/// Get the session stats
 	const GameSessionStatsFractions& GetSessionStats() const { return _curSessionStats; }
+
+	/// Get the current score
+	virtual uint32 GetScore() const { return _curSessionStats.m_Score; }
 };
 
 #endif // __GameLogicFractions_h
\ No newline at end of file
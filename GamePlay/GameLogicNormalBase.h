@@ -16,9 +16,9 @@
 #define __GameLogicNormalBase_h
 
 #include "GameLogic.h"
+#include "GameField.h"
 #include "Audio/SoundMusic.h"
 
-class GameField;
 class GameFieldBlockMultBase;
 
 
@@ -43,15 +43,24 @@ protected:
 	/// The raise sound channel, -1 if it is not playing
 	SoundInstance _playingRaiseSound;
 
+	/// The null-terminated row of blocks returned by GenerateBlocksToFieldWidth, a member
+	/// instead of a static so games on different threads don't share it
+	GameFieldBlockMultBase* m_GeneratedRow[ GameField::FIELD_WIDTH + 1 ];
+
 	/// Allow a subclass to update data if needed
 	virtual void SubclassUpdate( float32 frameTime );
 
+	/// Save/load the level and push speed state for a game state snapshot
+	virtual bool SubclassSerializeState( Serializer& serializer );
+
 public:
 
 	/// The default constructor
 	GameLogicNormalBase() : m_IsPushAccelerated( false ),
 							m_CurrentLevel( 1 )
 	{
+		for( int32 blockIndex = 0; blockIndex <= GameField::FIELD_WIDTH; ++blockIndex )
+			m_GeneratedRow[ blockIndex ] = 0;
 	}
 
 	/// A message handler called when the users presses the keyboard key to speed up block
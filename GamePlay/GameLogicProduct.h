@@ -21,6 +21,8 @@
 #include "GUI/MsgBox.h"
 #include "GameSessionStatsMult.h"
 #include "GameFieldBlock.h"
+#include "ProductBlockSampler.h"
+#include "EquationSolver.h"
 
 class GameFieldMultBase;
 class GameFieldBlockMultBase;
@@ -57,8 +59,8 @@ protected:
 	/// The current session's statistics
 	GameSessionStatsMult m_CurSessionStats;
 
-	/// The current array of products that can be generated
-	std::vector<GameDefines::ProductEntry> m_GeneratableProducts;
+	/// The sampler used to draw the products and primes that can be generated
+	ProductBlockSampler m_BlockSampler;
 
 	/// The message box for moving to the next ceiling level
 	//MsgBox* m_pNextLevelMsgBox;
@@ -86,9 +88,14 @@ protected:
 	/// completely clear able.
 	int32 m_PrimeOffsets[ GameDefines::NUM_PRIMES ];
 
-	/// The current range to use when generating a weighted prime.  This value is calculated by
-	/// the sum of the weights in the current range of generatable primes.
-	uint32 m_PrimeRandRange;
+	/// The number of blocks generated this game
+	uint32 m_NumBlocksGenerated;
+
+	/// The number of times a drawn product could not be used and a prime was generated instead
+	uint32 m_NumProductFallbacks;
+
+	/// The solver used to find the products on the field that can be cleared
+	EquationSolver m_Solver;
 
 
 	/// Generate a new block
@@ -109,6 +116,9 @@ protected:
 	/// Setup the ceiling field
 	void SetupCeilingField();
 
+	/// Load the factors and products on the field into the solver
+	void LoadSolver();
+
 	/// The message box for callback when the ceiling mode goes up a level
 	static void OnNextLevelMBCallback( MsgBox::EMsgBoxReturn retVal, void* pUserData );
 
@@ -117,14 +127,19 @@ protected:
 	/// Initialize a derived class's data
 	virtual bool SubclassInit();
 
+	/// Save/load the score, level, product generation and field for a game state snapshot
+	virtual bool SubclassSerializeState( Serializer& serializer );
+
 public:
 
 	/// The default constructor
 	GameLogicProduct() : GameLogicNormalBase(),
 							m_NumProducts( 0 ),
 							m_NumPrimes( 0 ),
-							m_PrimeRandRange( 1 ),
+							m_NumBlocksGenerated( 0 ),
+							m_NumProductFallbacks( 0 ),
 							m_NumCompletedEquations( 0 ),
+							m_IsGameDone( false ),
 							m_Score( 0 ),
 							m_ComboCount( 0 ),
 							m_pGameFieldMult( 0 ),
@@ -163,8 +178,28 @@ public:
 	/// Get the logic type
 	virtual ELogicType GetLogicType() const { return LT_Product; }
 
+	/// Get if the logic can save and restore its state, which the tutorials can not since they
+	/// are scripted
+	virtual bool CanSerializeState() const
+	{
+		GameDefines::EGameType gameMod = (GameDefines::EGameType)(m_GameType & GameDefines::GT_Mask_Mod);
+		return gameMod != GameDefines::GT_Mod_Tutorial && gameMod != GameDefines::GT_Mod_Tutorial2;
+	}
+
 	/// Get the session stats
 	const GameSessionStatsMult& GetSessionStats() const { return m_CurSessionStats; }
+
+	/// Get the current score
+	virtual uint32 GetScore() const { return m_CurSessionStats.m_Score; }
+
+	/// Get the number of blocks generated this game
+	uint32 GetNumBlocksGenerated() const { return m_NumBlocksGenerated; }
+
+	/// Get the number of product draws that had to fall back to generating a prime
+	uint32 GetNumProductFallbacks() const { return m_NumProductFallbacks; }
+
+	/// Count the products on the field that can be cleared with the factors on the field
+	uint32 CountSolvableProducts();
 };
 
 #endif // __GameLogicProduct_h
\ No newline at end of file
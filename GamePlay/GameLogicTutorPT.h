@@ -32,13 +32,30 @@ class GameLogicTutorPT : public GameLogicTutorBase< GameLogicProduct >
 
 protected:
 
+	/// The step the hint note was last built for
+	uint32 m_HintStepIndex;
+
+	/// The number of factors that could be clicked when the hint note was last built
+	uint32 m_HintNumBlocks;
+
+	/// The note text with the factors of the product to clear
+	std::wstring m_sHintNote;
+
+
 	/// Initialize a derived class's data
 	virtual bool SubclassInit();
 
+	/// Allow a subclass to update data if needed
+	virtual void SubclassUpdate( float32 frameTime );
+
+	/// Show the factors of the product to clear in the tutorial note
+	void UpdateHintNote();
+
 public:
 	
 	/// The default constructor
-	GameLogicTutorPT()
+	GameLogicTutorPT() : m_HintStepIndex( (uint32)-1 ),
+						m_HintNumBlocks( 0 )
 	{}
 
 	/// The destructor
@@ -20,10 +20,13 @@
 #include "GameDefines.h"
 #include "Audio/AudioMgr.h"
 #include "GUI/MsgBox.h"
+#include <string>
 
 class GameField;
 class GameLogic;
 class PlayerProfile;
+class Serializer;
+class InstructionStreamReplay;
 
 typedef void (*MsgBoxCallback)( MsgBox::EMsgBoxReturn retVal, void* pUserData );
 
@@ -38,6 +41,9 @@ typedef void (*MsgBoxCallback)( MsgBox::EMsgBoxReturn retVal, void* pUserData );
 //-------------------------------------------------------------------------------------------------
 class GameMgr
 {
+	/// A game context owns its own game manager
+	friend class GameContext;
+
 private:
 	/// The amount of time played in seconds
 	float32 m_TimePlayed;
@@ -69,6 +75,33 @@ private:
 	/// The time limit
 	uint32 m_TimeLimit;
 
+	/// The seed for the random number generator of the current game
+	uint64 m_GameSeed;
+
+	/// How far the current frame is between the last simulation tick and the next, from 0 to 1
+	float32 m_TickBlend;
+
+	/// If games are being run without graphics, audio or a user interface
+	bool m_IsHeadless;
+
+	/// The product filter the current game was started with
+	GameDefines::ProductSubsetFilter m_GameFilter;
+
+	/// The adjustments to the difficulty tables, which are not stored in replays
+	GameDefines::DifficultyTuning m_DiffTuning;
+
+	/// The directory games are recorded to, empty if games are not recorded
+	std::wstring m_sReplayDir;
+
+	/// The version of the game stored in recorded games
+	uint32 m_ReplayBuild;
+
+	/// The replay file the current game is playing, empty if the game is not a replay
+	std::wstring m_sReplayFile;
+
+	/// Set while StartReplay starts a game so the game plays the replay file
+	bool m_IsStartingReplay;
+
 	/// The active message box
 	MsgBox* m_pMsgBox;
 
@@ -79,7 +112,8 @@ private:
 	void* m_pMsgBoxUserData;
 
 
-	/// The default constructor, private since this class is a singleton
+	/// The default constructor, private since there is one instance for the process and one for
+	/// each game context
 	GameMgr() : m_TimePlayed( 0.0f ),
 				m_IsInGame( false ),
 				m_pGameLogic(0),
@@ -90,6 +124,11 @@ private:
 				m_IsPaused( false ),
 				m_GameDiff( GameDefines::GPDL_4 ),
 				m_TimeLimit( 0 ),
+				m_GameSeed( 0 ),
+				m_TickBlend( 0.0f ),
+				m_IsHeadless( false ),
+				m_ReplayBuild( 0 ),
+				m_IsStartingReplay( false ),
 				m_pMsgBox( 0 ),
 				m_MsgBoxCallbackFunc( 0 ),
 				m_pMsgBoxUserData( 0 )
@@ -103,18 +142,18 @@ public:
 	/// The overlay background music
 	MusicStreamHndl _bgmOverlay;
 
-	/// The accessor for the one and only instance of the class
-	static GameMgr& Get()
-	{
-		static GameMgr s_Mgr;
-		return s_Mgr;
-	}
+	/// The accessor for the instance of the class, the game manager of the game context bound to
+	/// the calling thread if there is one
+	static GameMgr& Get();
 
 	/// The default destructor
 	~GameMgr(){ Clear(); }
 
 	/// Initialize a new game
 	void StartGame( GameDefines::EGameType gameType, GameDefines::ProductSubsetFilter filter = GameDefines::ProductSubsetFilter() );
+
+	/// Initialize a new game with a specific random seed
+	void StartGame( GameDefines::EGameType gameType, uint64 seed, GameDefines::ProductSubsetFilter filter = GameDefines::ProductSubsetFilter() );
 	
 	/// End the current game
 	void EndGame(){ m_GameEndFlagged = true; }
@@ -161,6 +200,58 @@ public:
 	/// Set the timelimit
 	uint32 GetTimeLimit() const { return m_TimeLimit; }
 
+	/// Get the seed for the random number generator of the current game
+	uint64 GetGameSeed() const { return m_GameSeed; }
+
+	/// Set how far the frame being drawn is between the last simulation tick and the next
+	void SetTickBlend( float32 tickBlend ) { m_TickBlend = tickBlend; }
+
+	/// Get how far the frame being drawn is between the last simulation tick and the next
+	float32 GetTickBlend() const { return m_TickBlend; }
+
+	/// Set if games are run without graphics, audio or a user interface, such as by a simulator
+	void SetHeadless( bool isHeadless ) { m_IsHeadless = isHeadless; }
+
+	/// Get if games are run without graphics, audio or a user interface
+	bool IsHeadless() const { return m_IsHeadless; }
+
+	/// Get the product filter the current game was started with
+	const GameDefines::ProductSubsetFilter& GetGameFilter() const { return m_GameFilter; }
+
+	/// Set the adjustments to the difficulty tables used by the games that are started after
+	void SetDiffTuning( const GameDefines::DifficultyTuning& diffTuning ) { m_DiffTuning = diffTuning; }
+
+	/// Get the adjustments to the difficulty tables
+	const GameDefines::DifficultyTuning& GetDiffTuning() const { return m_DiffTuning; }
+
+	/// Set the directory games are recorded to, an empty string stops recording
+	void SetReplayDir( const wchar_t* szReplayDir, uint32 buildVersion )
+	{
+		m_sReplayDir = szReplayDir ? szReplayDir : L"";
+		m_ReplayBuild = buildVersion;
+	}
+
+	/// Get the directory games are recorded to, empty if games are not recorded
+	const std::wstring& GetReplayDir() const { return m_sReplayDir; }
+
+	/// Get the version of the game stored in recorded games
+	uint32 GetReplayBuild() const { return m_ReplayBuild; }
+
+	/// Start playing a recorded game
+	bool StartReplay( const wchar_t* szReplayFile );
+
+	/// Move a replay to a point in the game
+	bool SeekReplay( float32 gameTime );
+
+	/// Get the replay file the current game is playing, empty if the game is not a replay
+	const std::wstring& GetReplayFile() const { return m_sReplayFile; }
+
+	/// Get the instruction stream playing the current replay, NULL if the game is not a replay
+	InstructionStreamReplay* GetReplayStream();
+
+	/// Save/load the complete state of the current game for a replay snapshot
+	bool SerializeGameState( Serializer& serializer );
+
 	/// Get the gameplay type
 	GameDefines::EGameType GetGameType() const;
 
@@ -4,7 +4,7 @@
 	Game Play Library
 	Auto-Generated Game Network Message Header
 	\author The NetMsgGen application, but that is by Taylor Clark
-	\date Thu Oct 05 18:01:43 2006
+	\date Mon Oct 19 09:41:26 2026
 
 
 	This file is auto-generated contains the definitions for the game network message objects.  It
@@ -18,6 +18,9 @@
 #define __GameNetMsgs_h
 
 #include "Network/NetMsg.h"
+#include "Network/NetMsgPool.h"
+#include "Network/NetWire.h"
+#include "Network/NetworkMgr.h"
 #include "GameDefines.h"
 
 /// The game network message IDs
@@ -31,9 +34,14 @@ enum EGameNetMsgIDs
 	GNMI_GameInfo,
 	GNMI_StartGameQuery,
 	GNMI_StartGameResponse,
+	GNMI_ServerReady,
+	GNMI_ClientReady,
 	GNMI_COUNT
 };
 
+/// The message family ID of the game network messages, 'PTGM'
+const uint32 GAME_NET_MSG_FAMILY_ID = 0x5054474D;
+
 
 //-------------------------------------------------------------------------------------------------
 /*!
@@ -54,45 +62,95 @@ public:
 
 	std::wstring m_sHostName;
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 7;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 131077;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = false;
+
 	/// The default constructor
-	NetMsgGameRunning()
+	NetMsgGameRunning() : m_ServerListenPort( (uint16)0 ),
+				m_GameType( (GameDefines::EGameType)0 ),
+				m_HostDiff( (GameDefines::EGameplayDiffLevel)0 )
 	{
 	}
 
-	/// Create this message upon receiving data
-	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const
+	{
+		return 5 + NetWire::GetStringSize( m_sHostName );
+	}
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgGameRunning& msg, uint8* pOut, uint8* pOutEnd )
 	{
-		// Ensure the data block contains the right amount of data (Calculated during message
-		// generation)
-		if( dataBlock.GetRemainingBytes() < 6 )
+		if( (uint32)(pOutEnd - pOut) < msg.GetWireSize()
+			|| msg.m_sHostName.length() > NetWire::MAX_STRING_CHARS )
 			return 0;
 
-		// Create the new message and fill in the data
-		NetMsgGameRunning* pNewMsg = new NetMsgGameRunning();
-		pNewMsg->m_ServerListenPort = (uint16)dataBlock.ReadUint16();
-		pNewMsg->m_GameType = (GameDefines::EGameType)dataBlock.ReadUint16();
-		pNewMsg->m_HostDiff = (GameDefines::EGameplayDiffLevel)dataBlock.ReadUint8();
-		pNewMsg->m_sHostName = dataBlock.ReadString();
+		NetWire::WriteUint16( pOut, (uint16)msg.m_ServerListenPort );
+		NetWire::WriteUint16( pOut, (uint16)msg.m_GameType );
+		NetWire::WriteUint8( pOut, (uint8)msg.m_HostDiff );
+		NetWire::WriteString( pOut, msg.m_sHostName );
+		return pOut;
+	}
 
-		// Return the message
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgGameRunning& msg, const uint8* pIn, const uint8* pInEnd )
+	{
+		if( (uint32)(pInEnd - pIn) < MIN_WIRE_SIZE )
+			return false;
+
+		msg.m_ServerListenPort = (uint16)NetWire::ReadUint16( pIn );
+		msg.m_GameType = (GameDefines::EGameType)NetWire::ReadUint16( pIn );
+		msg.m_HostDiff = (GameDefines::EGameplayDiffLevel)NetWire::ReadUint8( pIn );
+		if( !NetWire::ReadString( pIn, pInEnd, msg.m_sHostName ) )
+			return false;
+		return pIn == pInEnd;
+	}
+
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgGameRunning* pNewMsg = NetMsgPool<NetMsgGameRunning>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
 		return pNewMsg;
 	}
 
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
 	/// Fill in a buffer with the message data
 	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const
 	{
-		uint32 startPos = dataOut.GetCurPosition();
-
-		dataOut.WriteVal16( (uint16)m_ServerListenPort );
-		dataOut.WriteVal8( (uint8)m_GameType );
-		dataOut.WriteVal8( (uint8)m_HostDiff );
-		dataOut.WriteString( m_sHostName );
+		uint8* pOut = dataOut.GetCurData();
+		uint8* pOutEnd = Encode( *this, pOut, pOut + dataOut.GetRemainingBytes() );
+		if( !pOutEnd )
+			throw( "Buffer overflow" );
 
-		return dataOut.GetCurPosition() - startPos;
+		dataOut.Skip( (uint32)(pOutEnd - pOut) );
+		return (uint32)(pOutEnd - pOut);
 	}
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_GameRunning; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
 
@@ -109,39 +167,82 @@ public:
 	/// The port the server was listening on before closing
 	uint16 m_ServerListenPort;
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 2;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 2;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
 	/// The default constructor
-	NetMsgGameClosed()
+	NetMsgGameClosed() : m_ServerListenPort( (uint16)0 )
 	{
 	}
 
-	/// Create this message upon receiving data
-	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgGameClosed& msg, uint8* pOut, uint8* pOutEnd )
 	{
-		// Ensure the data block contains the right amount of data (Calculated during message
-		// generation)
-		if( dataBlock.GetRemainingBytes() < 2 )
+		if( (uint32)(pOutEnd - pOut) < msg.GetWireSize() )
 			return 0;
 
-		// Create the new message and fill in the data
-		NetMsgGameClosed* pNewMsg = new NetMsgGameClosed();
-		pNewMsg->m_ServerListenPort = (uint16)dataBlock.ReadUint16();
+		NetWire::WriteUint16( pOut, (uint16)msg.m_ServerListenPort );
+		return pOut;
+	}
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgGameClosed& msg, const uint8* pIn, const uint8* pInEnd )
+	{
+		if( (uint32)(pInEnd - pIn) < MIN_WIRE_SIZE )
+			return false;
 
-		// Return the message
+		msg.m_ServerListenPort = (uint16)NetWire::ReadUint16( pIn );
+		return pIn == pInEnd;
+	}
+
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgGameClosed* pNewMsg = NetMsgPool<NetMsgGameClosed>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
 		return pNewMsg;
 	}
 
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
 	/// Fill in a buffer with the message data
 	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const
 	{
-		uint32 startPos = dataOut.GetCurPosition();
+		uint8* pOut = dataOut.GetCurData();
+		uint8* pOutEnd = Encode( *this, pOut, pOut + dataOut.GetRemainingBytes() );
+		if( !pOutEnd )
+			throw( "Buffer overflow" );
 
-		dataOut.WriteVal16( (uint16)m_ServerListenPort );
-
-		return dataOut.GetCurPosition() - startPos;
+		dataOut.Skip( (uint32)(pOutEnd - pOut) );
+		return (uint32)(pOutEnd - pOut);
 	}
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_GameClosed; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
 
@@ -155,17 +256,49 @@ class NetMsgSendMeYourInfo : public NetMsg
 {
 public:
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 0;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 0;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
 	/// The default constructor
 	NetMsgSendMeYourInfo()
 	{
 	}
 
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgSendMeYourInfo&, uint8* pOut, uint8* ) { return pOut; }
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgSendMeYourInfo&, const uint8* pIn, const uint8* pInEnd ) { return pIn == pInEnd; }
+
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgSendMeYourInfo* pNewMsg = NetMsgPool<NetMsgSendMeYourInfo>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
+		return pNewMsg;
+	}
+
 	/// Create this message upon receiving data
 	static NetMsg* CreateMsg( NetDataBlock dataBlock )
 	{
-		if( dataBlock.GetRemainingBytes() > 0 )
-			return 0;
-		return new NetMsgSendMeYourInfo();
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
 	}
 
 	/// Fill in a buffer with the message data
@@ -173,6 +306,9 @@ public:
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_SendMeYourInfo; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
 
@@ -193,43 +329,92 @@ public:
 
 	bool m_IsReady;
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 4;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 131074;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = false;
+
 	/// The default constructor
-	NetMsgPlayerInfo()
+	NetMsgPlayerInfo() : m_CurDiff( (GameDefines::EGameplayDiffLevel)0 ),
+				m_IsReady( false )
 	{
 	}
 
-	/// Create this message upon receiving data
-	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const
 	{
-		// Ensure the data block contains the right amount of data (Calculated during message
-		// generation)
-		if( dataBlock.GetRemainingBytes() < 4 )
+		return 2 + NetWire::GetStringSize( m_sPlayerName );
+	}
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgPlayerInfo& msg, uint8* pOut, uint8* pOutEnd )
+	{
+		if( (uint32)(pOutEnd - pOut) < msg.GetWireSize()
+			|| msg.m_sPlayerName.length() > NetWire::MAX_STRING_CHARS )
 			return 0;
 
-		// Create the new message and fill in the data
-		NetMsgPlayerInfo* pNewMsg = new NetMsgPlayerInfo();
-		pNewMsg->m_sPlayerName = dataBlock.ReadString();
-		pNewMsg->m_CurDiff = (GameDefines::EGameplayDiffLevel)dataBlock.ReadUint8();
-		pNewMsg->m_IsReady = dataBlock.ReadUint8() != 0;
+		NetWire::WriteString( pOut, msg.m_sPlayerName );
+		NetWire::WriteUint8( pOut, (uint8)msg.m_CurDiff );
+		NetWire::WriteUint8( pOut, msg.m_IsReady ? 1 : 0 );
+		return pOut;
+	}
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgPlayerInfo& msg, const uint8* pIn, const uint8* pInEnd )
+	{
+		if( (uint32)(pInEnd - pIn) < MIN_WIRE_SIZE )
+			return false;
+
+		if( !NetWire::ReadString( pIn, pInEnd - 2, msg.m_sPlayerName ) )
+			return false;
+		msg.m_CurDiff = (GameDefines::EGameplayDiffLevel)NetWire::ReadUint8( pIn );
+		msg.m_IsReady = NetWire::ReadUint8( pIn ) != 0;
+		return pIn == pInEnd;
+	}
 
-		// Return the message
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgPlayerInfo* pNewMsg = NetMsgPool<NetMsgPlayerInfo>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
 		return pNewMsg;
 	}
 
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
 	/// Fill in a buffer with the message data
 	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const
 	{
-		uint32 startPos = dataOut.GetCurPosition();
+		uint8* pOut = dataOut.GetCurData();
+		uint8* pOutEnd = Encode( *this, pOut, pOut + dataOut.GetRemainingBytes() );
+		if( !pOutEnd )
+			throw( "Buffer overflow" );
 
-		dataOut.WriteString( m_sPlayerName );
-		dataOut.WriteVal8( (uint8)m_CurDiff );
-		dataOut.WriteVal8( (uint8)m_IsReady );
-
-		return dataOut.GetCurPosition() - startPos;
+		dataOut.Skip( (uint32)(pOutEnd - pOut) );
+		return (uint32)(pOutEnd - pOut);
 	}
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_PlayerInfo; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
 
@@ -249,41 +434,85 @@ public:
 	/// The time limit for the game
 	uint16 m_TimeLimit;
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 4;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 4;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
 	/// The default constructor
-	NetMsgGameInfo()
+	NetMsgGameInfo() : m_GameType( (GameDefines::EGameType)0 ),
+				m_TimeLimit( (uint16)0 )
 	{
 	}
 
-	/// Create this message upon receiving data
-	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgGameInfo& msg, uint8* pOut, uint8* pOutEnd )
 	{
-		// Ensure the data block contains the right amount of data (Calculated during message
-		// generation)
-		if( dataBlock.GetRemainingBytes() < 3 )
+		if( (uint32)(pOutEnd - pOut) < msg.GetWireSize() )
 			return 0;
 
-		// Create the new message and fill in the data
-		NetMsgGameInfo* pNewMsg = new NetMsgGameInfo();
-		pNewMsg->m_GameType = (GameDefines::EGameType)dataBlock.ReadUint16();
-		pNewMsg->m_TimeLimit = (uint16)dataBlock.ReadUint16();
+		NetWire::WriteUint16( pOut, (uint16)msg.m_GameType );
+		NetWire::WriteUint16( pOut, (uint16)msg.m_TimeLimit );
+		return pOut;
+	}
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgGameInfo& msg, const uint8* pIn, const uint8* pInEnd )
+	{
+		if( (uint32)(pInEnd - pIn) < MIN_WIRE_SIZE )
+			return false;
+
+		msg.m_GameType = (GameDefines::EGameType)NetWire::ReadUint16( pIn );
+		msg.m_TimeLimit = (uint16)NetWire::ReadUint16( pIn );
+		return pIn == pInEnd;
+	}
 
-		// Return the message
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgGameInfo* pNewMsg = NetMsgPool<NetMsgGameInfo>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
 		return pNewMsg;
 	}
 
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
 	/// Fill in a buffer with the message data
 	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const
 	{
-		uint32 startPos = dataOut.GetCurPosition();
-
-		dataOut.WriteVal8( (uint8)m_GameType );
-		dataOut.WriteVal16( (uint16)m_TimeLimit );
+		uint8* pOut = dataOut.GetCurData();
+		uint8* pOutEnd = Encode( *this, pOut, pOut + dataOut.GetRemainingBytes() );
+		if( !pOutEnd )
+			throw( "Buffer overflow" );
 
-		return dataOut.GetCurPosition() - startPos;
+		dataOut.Skip( (uint32)(pOutEnd - pOut) );
+		return (uint32)(pOutEnd - pOut);
 	}
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_GameInfo; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
 
@@ -297,17 +526,49 @@ class NetMsgStartGameQuery : public NetMsg
 {
 public:
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 0;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 0;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
 	/// The default constructor
 	NetMsgStartGameQuery()
 	{
 	}
 
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgStartGameQuery&, uint8* pOut, uint8* ) { return pOut; }
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgStartGameQuery&, const uint8* pIn, const uint8* pInEnd ) { return pIn == pInEnd; }
+
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgStartGameQuery* pNewMsg = NetMsgPool<NetMsgStartGameQuery>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
+		return pNewMsg;
+	}
+
 	/// Create this message upon receiving data
 	static NetMsg* CreateMsg( NetDataBlock dataBlock )
 	{
-		if( dataBlock.GetRemainingBytes() > 0 )
-			return 0;
-		return new NetMsgStartGameQuery();
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
 	}
 
 	/// Fill in a buffer with the message data
@@ -315,6 +576,9 @@ public:
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_StartGameQuery; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
 
@@ -331,39 +595,291 @@ public:
 	/// If the client is allowing the start
 	bool m_AllowStart;
 
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 1;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 1;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
 	/// The default constructor
-	NetMsgStartGameResponse()
+	NetMsgStartGameResponse() : m_AllowStart( false )
 	{
 	}
 
-	/// Create this message upon receiving data
-	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgStartGameResponse& msg, uint8* pOut, uint8* pOutEnd )
 	{
-		// Ensure the data block contains the right amount of data (Calculated during message
-		// generation)
-		if( dataBlock.GetRemainingBytes() < 1 )
+		if( (uint32)(pOutEnd - pOut) < msg.GetWireSize() )
 			return 0;
 
-		// Create the new message and fill in the data
-		NetMsgStartGameResponse* pNewMsg = new NetMsgStartGameResponse();
-		pNewMsg->m_AllowStart = dataBlock.ReadUint8() != 0;
+		NetWire::WriteUint8( pOut, msg.m_AllowStart ? 1 : 0 );
+		return pOut;
+	}
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgStartGameResponse& msg, const uint8* pIn, const uint8* pInEnd )
+	{
+		if( (uint32)(pInEnd - pIn) < MIN_WIRE_SIZE )
+			return false;
+
+		msg.m_AllowStart = NetWire::ReadUint8( pIn ) != 0;
+		return pIn == pInEnd;
+	}
 
-		// Return the message
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgStartGameResponse* pNewMsg = NetMsgPool<NetMsgStartGameResponse>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
 		return pNewMsg;
 	}
 
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
 	/// Fill in a buffer with the message data
 	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const
 	{
-		uint32 startPos = dataOut.GetCurPosition();
+		uint8* pOut = dataOut.GetCurData();
+		uint8* pOutEnd = Encode( *this, pOut, pOut + dataOut.GetRemainingBytes() );
+		if( !pOutEnd )
+			throw( "Buffer overflow" );
 
-		dataOut.WriteVal8( (uint8)m_AllowStart );
-
-		return dataOut.GetCurPosition() - startPos;
+		dataOut.Skip( (uint32)(pOutEnd - pOut) );
+		return (uint32)(pOutEnd - pOut);
 	}
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const { return GNMI_StartGameResponse; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
 };
 
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgServerReady
+*/
+//-------------------------------------------------------------------------------------------------
+class NetMsgServerReady : public NetMsg
+{
+public:
+
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 0;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 0;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
+	/// The default constructor
+	NetMsgServerReady()
+	{
+	}
+
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgServerReady&, uint8* pOut, uint8* ) { return pOut; }
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgServerReady&, const uint8* pIn, const uint8* pInEnd ) { return pIn == pInEnd; }
+
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgServerReady* pNewMsg = NetMsgPool<NetMsgServerReady>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
+		return pNewMsg;
+	}
+
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
+	/// Fill in a buffer with the message data
+	virtual uint32 StoreInBuffer( NetDataBlockOut& ) const { return 0; }
+
+	/// Get the message type ID
+	virtual uint16 GetMsgTypeID() const { return GNMI_ServerReady; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgClientReady
+*/
+//-------------------------------------------------------------------------------------------------
+class NetMsgClientReady : public NetMsg
+{
+public:
+
+	/// The fewest bytes the message data takes, with its strings empty
+	static const uint32 MIN_WIRE_SIZE = 0;
+
+	/// The most bytes the message data takes, with its strings as long as they can be
+	static const uint32 MAX_WIRE_SIZE = 0;
+
+	/// If the message data always takes MIN_WIRE_SIZE bytes
+	static const bool IS_FIXED_SIZE = true;
+
+	/// The default constructor
+	NetMsgClientReady()
+	{
+	}
+
+	/// Get the number of bytes the message data takes
+	uint32 GetWireSize() const { return MIN_WIRE_SIZE; }
+
+	/// Write a message's data into a buffer, returning the end of the data or NULL if it does not
+	/// fit
+	static uint8* Encode( const NetMsgClientReady&, uint8* pOut, uint8* ) { return pOut; }
+
+	/// Read a message's data into a message, returning false if the data is bad or is not exactly
+	/// the message's size
+	static bool Decode( NetMsgClientReady&, const uint8* pIn, const uint8* pInEnd ) { return pIn == pInEnd; }
+
+	/// Create this message from its data, returning NULL if the data is bad
+	static NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )
+	{
+		// Take a message from the pool and fill in the data, returning it to the pool if the data
+		// is bad
+		NetMsgClientReady* pNewMsg = NetMsgPool<NetMsgClientReady>::Get().Alloc();
+		if( !Decode( *pNewMsg, pData, pDataEnd ) )
+		{
+			NetMsg::Release( pNewMsg );
+			return 0;
+		}
+		return pNewMsg;
+	}
+
+	/// Create this message upon receiving data
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		return DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+	}
+
+	/// Fill in a buffer with the message data
+	virtual uint32 StoreInBuffer( NetDataBlockOut& ) const { return 0; }
+
+	/// Get the message type ID
+	virtual uint16 GetMsgTypeID() const { return GNMI_ClientReady; }
+
+	/// Get the message family ID
+	virtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }
+};
+
+
+/// Write the data of a game message into a buffer, returning the end of the data or NULL if the
+/// message is not the game message the ID is for or the data does not fit
+inline uint8* EncodeGameNetMsg( uint16 msgID, const NetMsg& msg, uint8* pOut, uint8* pOutEnd )
+{
+	// Check the message's type before it is cast to it
+	if( msg.GetMsgFamilyID() != GAME_NET_MSG_FAMILY_ID || msg.GetMsgTypeID() != msgID )
+		return 0;
+
+	switch( msgID )
+	{
+	case GNMI_GameRunning:
+		return NetMsgGameRunning::Encode( static_cast<const NetMsgGameRunning&>( msg ), pOut, pOutEnd );
+	case GNMI_GameClosed:
+		return NetMsgGameClosed::Encode( static_cast<const NetMsgGameClosed&>( msg ), pOut, pOutEnd );
+	case GNMI_SendMeYourInfo:
+		return NetMsgSendMeYourInfo::Encode( static_cast<const NetMsgSendMeYourInfo&>( msg ), pOut, pOutEnd );
+	case GNMI_PlayerInfo:
+		return NetMsgPlayerInfo::Encode( static_cast<const NetMsgPlayerInfo&>( msg ), pOut, pOutEnd );
+	case GNMI_GameInfo:
+		return NetMsgGameInfo::Encode( static_cast<const NetMsgGameInfo&>( msg ), pOut, pOutEnd );
+	case GNMI_StartGameQuery:
+		return NetMsgStartGameQuery::Encode( static_cast<const NetMsgStartGameQuery&>( msg ), pOut, pOutEnd );
+	case GNMI_StartGameResponse:
+		return NetMsgStartGameResponse::Encode( static_cast<const NetMsgStartGameResponse&>( msg ), pOut, pOutEnd );
+	case GNMI_ServerReady:
+		return NetMsgServerReady::Encode( static_cast<const NetMsgServerReady&>( msg ), pOut, pOutEnd );
+	case GNMI_ClientReady:
+		return NetMsgClientReady::Encode( static_cast<const NetMsgClientReady&>( msg ), pOut, pOutEnd );
+	default:
+		break;
+	}
+	return 0;
+}
+
+/// Create a game message from its data, returning NULL if the ID is not a game message's or the
+/// data is bad
+inline NetMsg* DecodeGameNetMsg( uint16 msgID, const uint8* pData, const uint8* pDataEnd )
+{
+	switch( msgID )
+	{
+	case GNMI_GameRunning:
+		return NetMsgGameRunning::DecodeMsg( pData, pDataEnd );
+	case GNMI_GameClosed:
+		return NetMsgGameClosed::DecodeMsg( pData, pDataEnd );
+	case GNMI_SendMeYourInfo:
+		return NetMsgSendMeYourInfo::DecodeMsg( pData, pDataEnd );
+	case GNMI_PlayerInfo:
+		return NetMsgPlayerInfo::DecodeMsg( pData, pDataEnd );
+	case GNMI_GameInfo:
+		return NetMsgGameInfo::DecodeMsg( pData, pDataEnd );
+	case GNMI_StartGameQuery:
+		return NetMsgStartGameQuery::DecodeMsg( pData, pDataEnd );
+	case GNMI_StartGameResponse:
+		return NetMsgStartGameResponse::DecodeMsg( pData, pDataEnd );
+	case GNMI_ServerReady:
+		return NetMsgServerReady::DecodeMsg( pData, pDataEnd );
+	case GNMI_ClientReady:
+		return NetMsgClientReady::DecodeMsg( pData, pDataEnd );
+	default:
+		break;
+	}
+	return 0;
+}
+
+/// Register the game messages so the network manager encodes and decodes them with the switches
+inline void RegisterGameNetMsgs()
+{
+	NetworkMgr::Get().RegisterNetMsg( GNMI_GameRunning, NetMsgGameRunning::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_GameClosed, NetMsgGameClosed::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_SendMeYourInfo, NetMsgSendMeYourInfo::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_PlayerInfo, NetMsgPlayerInfo::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_GameInfo, NetMsgGameInfo::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_StartGameQuery, NetMsgStartGameQuery::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_StartGameResponse, NetMsgStartGameResponse::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_ServerReady, NetMsgServerReady::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+	NetworkMgr::Get().RegisterNetMsg( GNMI_ClientReady, NetMsgClientReady::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );
+}
+
 #endif // __GameNetMsgs_h
\ No newline at end of file
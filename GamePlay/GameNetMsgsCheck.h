@@ -0,0 +1,163 @@
+//=================================================================================================
+/*!
+	\file GameNetMsgsCheck.h
+	Game Play Library
+	Auto-Generated Game Network Message Check Header
+	\author The NetMsgGen application, but that is by Taylor Clark
+	\date Mon Oct 19 09:41:26 2026
+
+
+	This file is auto-generated contains the checks and benchmark of the game network message encoding.  It
+	should not be editted directly, but rather the source file should be altered and this file
+	regenerated.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __GameNetMsgsCheck_h
+#define __GameNetMsgsCheck_h
+
+#include "GameNetMsgs.h"
+#include "Network/NetMsgCheck.h"
+
+
+/// Fill in a NetMsgGameRunning with random data
+inline void RandomizeNetMsg( NetMsgGameRunning& msg, TCBase::RandomGen& randGen )
+{
+	msg.m_ServerListenPort = (uint16)(randGen.NextUInt32() & 0xFFFF);
+	msg.m_GameType = (GameDefines::EGameType)(randGen.NextUInt32() & 0xFFFF);
+	msg.m_HostDiff = (GameDefines::EGameplayDiffLevel)(randGen.NextUInt32() & 0xFF);
+	RandomizeNetMsgString( msg.m_sHostName, randGen );
+}
+
+/// Compare the data of two NetMsgGameRunning messages
+inline bool AreNetMsgsEqual( const NetMsgGameRunning& msg1, const NetMsgGameRunning& msg2 )
+{
+	return msg1.m_ServerListenPort == msg2.m_ServerListenPort
+		&& msg1.m_GameType == msg2.m_GameType
+		&& msg1.m_HostDiff == msg2.m_HostDiff
+		&& msg1.m_sHostName == msg2.m_sHostName;
+}
+
+/// Fill in a NetMsgGameClosed with random data
+inline void RandomizeNetMsg( NetMsgGameClosed& msg, TCBase::RandomGen& randGen )
+{
+	msg.m_ServerListenPort = (uint16)(randGen.NextUInt32() & 0xFFFF);
+}
+
+/// Compare the data of two NetMsgGameClosed messages
+inline bool AreNetMsgsEqual( const NetMsgGameClosed& msg1, const NetMsgGameClosed& msg2 )
+{
+	return msg1.m_ServerListenPort == msg2.m_ServerListenPort;
+}
+
+/// Fill in a NetMsgSendMeYourInfo with random data
+inline void RandomizeNetMsg( NetMsgSendMeYourInfo&, TCBase::RandomGen& ) {}
+
+/// Compare the data of two NetMsgSendMeYourInfo messages
+inline bool AreNetMsgsEqual( const NetMsgSendMeYourInfo&, const NetMsgSendMeYourInfo& ) { return true; }
+
+/// Fill in a NetMsgPlayerInfo with random data
+inline void RandomizeNetMsg( NetMsgPlayerInfo& msg, TCBase::RandomGen& randGen )
+{
+	RandomizeNetMsgString( msg.m_sPlayerName, randGen );
+	msg.m_CurDiff = (GameDefines::EGameplayDiffLevel)(randGen.NextUInt32() & 0xFF);
+	msg.m_IsReady = randGen.Chance( 50 );
+}
+
+/// Compare the data of two NetMsgPlayerInfo messages
+inline bool AreNetMsgsEqual( const NetMsgPlayerInfo& msg1, const NetMsgPlayerInfo& msg2 )
+{
+	return msg1.m_sPlayerName == msg2.m_sPlayerName
+		&& msg1.m_CurDiff == msg2.m_CurDiff
+		&& msg1.m_IsReady == msg2.m_IsReady;
+}
+
+/// Fill in a NetMsgGameInfo with random data
+inline void RandomizeNetMsg( NetMsgGameInfo& msg, TCBase::RandomGen& randGen )
+{
+	msg.m_GameType = (GameDefines::EGameType)(randGen.NextUInt32() & 0xFFFF);
+	msg.m_TimeLimit = (uint16)(randGen.NextUInt32() & 0xFFFF);
+}
+
+/// Compare the data of two NetMsgGameInfo messages
+inline bool AreNetMsgsEqual( const NetMsgGameInfo& msg1, const NetMsgGameInfo& msg2 )
+{
+	return msg1.m_GameType == msg2.m_GameType
+		&& msg1.m_TimeLimit == msg2.m_TimeLimit;
+}
+
+/// Fill in a NetMsgStartGameQuery with random data
+inline void RandomizeNetMsg( NetMsgStartGameQuery&, TCBase::RandomGen& ) {}
+
+/// Compare the data of two NetMsgStartGameQuery messages
+inline bool AreNetMsgsEqual( const NetMsgStartGameQuery&, const NetMsgStartGameQuery& ) { return true; }
+
+/// Fill in a NetMsgStartGameResponse with random data
+inline void RandomizeNetMsg( NetMsgStartGameResponse& msg, TCBase::RandomGen& randGen )
+{
+	msg.m_AllowStart = randGen.Chance( 50 );
+}
+
+/// Compare the data of two NetMsgStartGameResponse messages
+inline bool AreNetMsgsEqual( const NetMsgStartGameResponse& msg1, const NetMsgStartGameResponse& msg2 )
+{
+	return msg1.m_AllowStart == msg2.m_AllowStart;
+}
+
+/// Fill in a NetMsgServerReady with random data
+inline void RandomizeNetMsg( NetMsgServerReady&, TCBase::RandomGen& ) {}
+
+/// Compare the data of two NetMsgServerReady messages
+inline bool AreNetMsgsEqual( const NetMsgServerReady&, const NetMsgServerReady& ) { return true; }
+
+/// Fill in a NetMsgClientReady with random data
+inline void RandomizeNetMsg( NetMsgClientReady&, TCBase::RandomGen& ) {}
+
+/// Compare the data of two NetMsgClientReady messages
+inline bool AreNetMsgsEqual( const NetMsgClientReady&, const NetMsgClientReady& ) { return true; }
+
+
+/// Check that every game message decodes to the message it was encoded from and that bad data is
+/// rejected, returning the number of failed checks
+inline uint32 CheckGameNetMsgs( uint64 seed, uint32 numIterations )
+{
+	TCBase::RandomGen randGen( seed );
+	uint32 numFailures = 0;
+	numFailures += NetMsgChecker<NetMsgGameRunning>::CheckRoundTrips( L"GameRunning", GNMI_GameRunning, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgGameRunning>::Fuzz( L"GameRunning", GNMI_GameRunning, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgGameClosed>::CheckRoundTrips( L"GameClosed", GNMI_GameClosed, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgGameClosed>::Fuzz( L"GameClosed", GNMI_GameClosed, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgSendMeYourInfo>::CheckRoundTrips( L"SendMeYourInfo", GNMI_SendMeYourInfo, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgSendMeYourInfo>::Fuzz( L"SendMeYourInfo", GNMI_SendMeYourInfo, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgPlayerInfo>::CheckRoundTrips( L"PlayerInfo", GNMI_PlayerInfo, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgPlayerInfo>::Fuzz( L"PlayerInfo", GNMI_PlayerInfo, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgGameInfo>::CheckRoundTrips( L"GameInfo", GNMI_GameInfo, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgGameInfo>::Fuzz( L"GameInfo", GNMI_GameInfo, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgStartGameQuery>::CheckRoundTrips( L"StartGameQuery", GNMI_StartGameQuery, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgStartGameQuery>::Fuzz( L"StartGameQuery", GNMI_StartGameQuery, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgStartGameResponse>::CheckRoundTrips( L"StartGameResponse", GNMI_StartGameResponse, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgStartGameResponse>::Fuzz( L"StartGameResponse", GNMI_StartGameResponse, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgServerReady>::CheckRoundTrips( L"ServerReady", GNMI_ServerReady, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgServerReady>::Fuzz( L"ServerReady", GNMI_ServerReady, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgClientReady>::CheckRoundTrips( L"ClientReady", GNMI_ClientReady, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	numFailures += NetMsgChecker<NetMsgClientReady>::Fuzz( L"ClientReady", GNMI_ClientReady, DecodeGameNetMsg, randGen, numIterations );
+	return numFailures;
+}
+
+/// Measure encoding and decoding every game message and log the times
+inline void BenchmarkGameNetMsgs( uint64 seed, uint32 numIterations )
+{
+	TCBase::RandomGen randGen( seed );
+	NetMsgChecker<NetMsgGameRunning>::Benchmark( L"GameRunning", GNMI_GameRunning, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgGameClosed>::Benchmark( L"GameClosed", GNMI_GameClosed, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgSendMeYourInfo>::Benchmark( L"SendMeYourInfo", GNMI_SendMeYourInfo, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgPlayerInfo>::Benchmark( L"PlayerInfo", GNMI_PlayerInfo, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgGameInfo>::Benchmark( L"GameInfo", GNMI_GameInfo, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgStartGameQuery>::Benchmark( L"StartGameQuery", GNMI_StartGameQuery, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgStartGameResponse>::Benchmark( L"StartGameResponse", GNMI_StartGameResponse, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgServerReady>::Benchmark( L"ServerReady", GNMI_ServerReady, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+	NetMsgChecker<NetMsgClientReady>::Benchmark( L"ClientReady", GNMI_ClientReady, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );
+}
+
+#endif // __GameNetMsgsCheck_h
\ No newline at end of file
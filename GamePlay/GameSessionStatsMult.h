@@ -17,6 +17,7 @@
 #include "Base/Types.h"
 #include "ProfileSubsetInGame.h"
 #include <time.h>
+#include <string.h>
 
 
 //-------------------------------------------------------------------------------------------------
@@ -61,6 +61,13 @@ public:
 
 	/// Get if there are any tasks to be handled during the current game update
 	virtual bool HasPendingInstructions() const = 0;
+
+	/// Called at the end of the game field's update once the field's state is complete for the
+	/// tick
+	virtual void PostUpdate() {}
+
+	/// Called when the game ends, before the logic is closed
+	virtual void OnGameEnd() {}
 };
 
 #endif // __InstructionStream_h
\ No newline at end of file
@@ -16,11 +16,11 @@
 
 #include "InstructionStream.h"
 #include <list>
-#include <fstream>
+#include <string>
+#include <vector>
 #include "GameField.h"
 
-class Serializer;
-class DataBlockOut;
+class ReplayWriter;
 typedef std::list< GameFieldInstruction* > InstructionList;
 
 
@@ -33,26 +33,48 @@ typedef std::list< GameFieldInstruction* > InstructionList;
 //-------------------------------------------------------------------------------------------------
 class InstructionStreamPlay : public InstructionStream
 {
+public:
+
+	/// The number of ticks between game state snapshots, 5 seconds of game time
+	static const uint32 SNAPSHOT_INTERVAL_TICKS = 600;
+
+	/// The size of the buffer game state snapshots are written to
+	static const uint32 SNAPSHOT_BUFFER_SIZE = 64 * 1024;
+
 private:
 
 	/// The list of instructions to be processed at update
 	InstructionList m_PendingInstructions;
 
-	/// The stream of recorded instructions
-	std::ofstream m_OutFile;
-	Serializer* m_pOutStream;
+	/// The writer recording the handled instructions, NULL if the game is not being recorded
+	ReplayWriter* m_pReplayWriter;
+
+	/// The number of updates, used to time the recorded instructions
+	uint32 m_CurTick;
+
+	/// The tick the next game state snapshot is recorded on
+	uint32 m_NextSnapshotTick;
+
+	/// The buffer game state snapshots are written to, allocated when a game is recorded
+	std::vector<uint8> m_SnapshotBuffer;
 
 public:
 
 	/// The default constructor
-	InstructionStreamPlay() : m_pOutStream( 0 )
+	InstructionStreamPlay() : m_pReplayWriter( 0 ),
+								m_CurTick( 0 ),
+								m_NextSnapshotTick( 0 )
 	{
 	}
 
 	/// The destructor
 	~InstructionStreamPlay();
 
-	void Init( bool recordGame );
+	/// Initialize the stream, recording the game to a directory if it is not empty
+	void Init( const std::wstring& sReplayDir );
+
+	/// Allow for calculation based on frame detlta
+	virtual void Update( float32, float32 ) { ++m_CurTick; }
 
 	/// Add an instruction to handled at the next possible time
 	virtual void AddPendingInstruction( GameFieldInstruction* pInst ){ m_PendingInstructions.push_back( pInst ); }
@@ -76,6 +98,12 @@ public:
 
 	/// Get if there are any tasks to be handled during the current game update
 	virtual bool HasPendingInstructions() const { return m_PendingInstructions.size() > 0; }
+
+	/// Record a game state snapshot if it is time for one
+	virtual void PostUpdate();
+
+	/// Record the results of the game
+	virtual void OnGameEnd();
 };
 
 #endif // __InstructionStreamPlay_h
\ No newline at end of file
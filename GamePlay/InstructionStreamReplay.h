@@ -15,12 +15,11 @@
 #define __InstructionStreamReplay_h
 
 #include "InstructionStream.h"
+#include "ReplayHeader.h"
 #include <list>
-#include <fstream>
+#include <vector>
 #include "Base/TCAssert.h"
 
-class Serializer;
-class DataBlockOut;
 typedef std::list< GameFieldInstruction* > InstructionList;
 
 
@@ -28,28 +27,191 @@ typedef std::list< GameFieldInstruction* > InstructionList;
 /*!
 	\class InstructionStreamReplay
 	\brief Represents a stream of game field instructions loaded from a recorded game.
+
+	The instructions are released on the same update tick they were handled on when the game was
+	recorded. Instructions the game field generates while replaying are discarded since the
+	recorded ones replace them.
+
+	The replay file is kept in memory so the game state snapshots in it can be restored to seek
+	through the replay. Restoring a snapshot sets the stream to the snapshot's tick so the
+	instructions recorded after the snapshot are released next.
+
+	When verification is enabled, the state of the game at the end of each snapshot's tick is
+	compared to the snapshot by hashing both, so a replay that no longer plays the same game is
+	caught at the first snapshot that differs.
 */
 //-------------------------------------------------------------------------------------------------
 class InstructionStreamReplay : public InstructionStream
 {
+private:
+
+	/// A recorded instruction
+	struct Record
+	{
+		/// The update tick the instruction was handled on
+		uint32 tick;
+
+		/// The instruction
+		GameFieldInstruction* pInst;
+	};
+
+	/// A recorded game state snapshot
+	struct Snapshot
+	{
+		/// The update tick the state is from
+		uint32 tick;
+
+		/// The index of the first record after the snapshot
+		uint32 nextRecordIndex;
+
+		/// The offset of the state data in the file data
+		uint32 dataOffset;
+
+		/// The size of the state data
+		uint32 dataSize;
+
+		/// The hash of the state data, used to verify the replay
+		uint64 dataHash;
+	};
+
+public:
+
+	/// The results of the game recorded in the replay's summary
+	struct Summary
+	{
+		/// The update tick the game ended on
+		uint32 tick;
+
+		/// The final score
+		uint32 score;
+
+		/// The number of blocks on the field when the game ended
+		uint32 numBlocks;
+
+		Summary() : tick( 0 ),
+					score( 0 ),
+					numBlocks( 0 )
+		{}
+	};
+
+	/// The results of verifying the snapshots against the simulated game
+	struct VerifyResults
+	{
+		/// The number of snapshots compared to the game
+		uint32 numChecked;
+
+		/// The number of snapshots that did not match the game
+		uint32 numMismatched;
+
+		/// The tick of the first snapshot that did not match
+		uint32 firstMismatchTick;
+
+		VerifyResults() : numChecked( 0 ),
+							numMismatched( 0 ),
+							firstMismatchTick( 0 )
+		{}
+	};
+
 private:
 
 	/// The list of instructions to be processed at update
 	InstructionList m_PendingInstructions;
 
-	InstructionList m_AllInstructions;
+	/// The recorded instructions in the order they were handled
+	std::vector<Record> m_Records;
 
-	InstructionList::iterator m_PrevFrameIter;
+	/// The game state snapshots, ordered by tick
+	std::vector<Snapshot> m_Snapshots;
+
+	/// The contents of the replay file, kept for the snapshot data
+	std::vector<uint8> m_FileData;
+
+	/// The index of the next record to release
+	uint32 m_NextRecordIndex;
+
+	/// The number of updates
+	uint32 m_CurTick;
+
+	/// The header of the replay file
+	ReplayHeader m_Header;
+
+	/// The summary of the recorded game
+	Summary m_Summary;
+
+	/// If the replay has a summary
+	bool m_HasSummary;
+
+	/// If the game is compared to the snapshots as it is simulated
+	bool m_IsVerifying;
+
+	/// The index of the next snapshot to compare to the game
+	uint32 m_NextVerifyIndex;
+
+	/// The results of comparing the game to the snapshots
+	VerifyResults m_VerifyResults;
+
+	/// The buffer the game's state is written to for verification
+	std::vector<uint8> m_VerifyBuffer;
+
+
+	/// Get the last snapshot at or before a tick, NULL if there is none
+	const Snapshot* FindSnapshot( uint32 tick ) const;
 
 public:
 
 	/// The default constructor
-	InstructionStreamReplay()
+	InstructionStreamReplay() : m_NextRecordIndex( 0 ),
+								m_CurTick( 0 ),
+								m_HasSummary( false ),
+								m_IsVerifying( false ),
+								m_NextVerifyIndex( 0 )
 	{
-		m_PrevFrameIter = m_AllInstructions.begin();
 	}
 
-	void Init( Serializer& serializer );
+	/// The destructor
+	~InstructionStreamReplay();
+
+	/// Load the instructions from a replay file
+	bool Init( const wchar_t* szReplayFile );
+
+	/// Read the header of a replay file
+	static bool ReadHeader( const wchar_t* szReplayFile, ReplayHeader& header );
+
+	/// Get the tick of the last snapshot at or before a tick, false if there is none
+	bool FindSnapshotTick( uint32 tick, uint32& snapshotTick ) const;
+
+	/// Restore the game state from the last snapshot at or before a tick
+	bool RestoreSnapshot( uint32 tick );
+
+	/// Get the number of updates since the start of the replay
+	uint32 GetCurTick() const { return m_CurTick; }
+
+	/// Get the header of the loaded replay
+	const ReplayHeader& GetHeader() const { return m_Header; }
+
+	/// Get if the replay has a summary of the recorded game, replays before version 3 do not
+	bool HasSummary() const { return m_HasSummary; }
+
+	/// Get the summary of the recorded game
+	const Summary& GetSummary() const { return m_Summary; }
+
+	/// Compare the game to the snapshots as it is simulated from the start
+	void EnableVerification();
+
+	/// Get the results of comparing the game to the snapshots
+	const VerifyResults& GetVerifyResults() const { return m_VerifyResults; }
+
+	/// Get the number of snapshots in the replay
+	uint32 GetNumSnapshots() const { return (uint32)m_Snapshots.size(); }
+
+	/// Get the tick a snapshot was recorded on
+	uint32 GetSnapshotTick( uint32 snapshotIndex ) const { return m_Snapshots[ snapshotIndex ].tick; }
+
+	/// Compare the game to a snapshot recorded on the current tick when verifying
+	virtual void PostUpdate();
+
+	/// Get if every recorded instruction has been released
+	bool IsFinished() const { return m_NextRecordIndex >= m_Records.size() && m_PendingInstructions.empty(); }
 
 	/// Add an instruction to handled at the next possible time
 	virtual void AddPendingInstruction( GameFieldInstruction* pInst );
@@ -74,6 +236,7 @@ public:
 	/// method if they are no longer needed.
 	virtual void ProcessHandledInstruction( GameFieldInstruction* ){}
 
+	/// Get if there are any tasks to be handled during the current game update
 	virtual bool HasPendingInstructions() const { return m_PendingInstructions.size() > 0; }
 };
 
@@ -0,0 +1,161 @@
+//=================================================================================================
+/*!
+	\file PlayerBot.h
+	Game Play Library
+	Player Bot Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the automated player used to test long sessions.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __PlayerBot_h
+#define __PlayerBot_h
+
+#include <vector>
+#include "Base/Types.h"
+#include "Base/RandomGen.h"
+
+class GameField;
+class GameFieldBlock;
+class GameFieldMultBase;
+class GameFieldAdd;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class PlayerBot
+	\brief An automated player that plays the current game through the player input path.
+
+	The bot looks at the blocks on the active game field, plans an equation and then selects the
+	blocks one at a time by sending the same toggle-selection and clear-selection instructions
+	that mouse clicks create. How well it plays is controlled by how many equations it looks at,
+	how long it takes to react and click, and how often it clicks the wrong block.
+*/
+//-------------------------------------------------------------------------------------------------
+class PlayerBot
+{
+public:
+
+	/// The settings that control how well the bot plays
+	struct Settings
+	{
+		/// The percent, from 0 to 100, of the possible equations the bot looks at before giving
+		/// up and waiting to look again
+		int32 skill;
+
+		/// The average time in seconds the bot waits before starting an equation
+		float32 reactionTime;
+
+		/// The average time in seconds between clicks within an equation
+		float32 clickTime;
+
+		/// The percent chance, from 0 to 100, that a click selects a random block instead of
+		/// the planned one
+		int32 errorRate;
+
+		Settings() : skill( 75 ),
+					reactionTime( 1.0f ),
+					clickTime( 0.25f ),
+					errorRate( 5 )
+		{}
+	};
+
+private:
+
+	/// The settings
+	Settings m_Settings;
+
+	/// The random number generator for the bot's choices, separate from the game's so the bot
+	/// never changes which blocks the game generates
+	TCBase::RandomGen m_Random;
+
+	/// The IDs of the blocks to select for the planned equation, in order
+	std::vector<uint32> m_PlannedClicks;
+
+	/// The index of the next block to select in the planned equation
+	uint32 m_NextClickIndex;
+
+	/// The time until the bot acts again
+	float32 m_TimeToNextAction;
+
+	/// The number of selection instructions sent
+	uint32 m_NumClicks;
+
+	/// The number of planned clicks that were replaced with a random block
+	uint32 m_NumErrors;
+
+	/// The number of equations the bot planned
+	uint32 m_NumEquationsPlanned;
+
+	/// The blocks that can be used to build an equation, reused between plans
+	std::vector<GameFieldBlock*> m_CandidateBlocks;
+
+	/// The blocks that could complete an equation, reused between plans
+	std::vector<GameFieldBlock*> m_TargetBlocks;
+
+	/// The blocks chosen for the equation being planned
+	std::vector<GameFieldBlock*> m_ChosenBlocks;
+
+	/// The number of search steps left for the current plan
+	int32 m_SearchStepsLeft;
+
+
+	/// Get a time around an average so the bot's actions don't line up with the game updates
+	float32 GetVariedTime( float32 avgTime )
+	{
+		return m_Random.NextFloatInRange( 0.5f, 1.5f ) * avgTime;
+	}
+
+	/// Get if a block has moved onto the visible part of a product field
+	static bool IsBlockOnField( const GameFieldMultBase* pField, const GameFieldBlock* pBlock );
+
+	/// Plan an equation on a product field
+	bool PlanProductEquation( GameFieldMultBase* pField );
+
+	/// Plan an equation on an addition field
+	bool PlanSumEquation( GameFieldAdd* pField );
+
+	/// Plan selecting a random block
+	bool PlanRandomClick( GameField* pField );
+
+	/// Find the factor blocks that multiply to a product
+	bool FindFactors( int32 remainingProduct, uint32 startIndex );
+
+	/// Find the summand blocks that add to a sum
+	bool FindSummands( int32 remainingSum, uint32 startIndex );
+
+	/// Select the next block in the planned equation
+	void ClickNextBlock( GameField* pField );
+
+public:
+
+	/// The default constructor
+	PlayerBot() : m_NextClickIndex( 0 ),
+					m_TimeToNextAction( 0.0f ),
+					m_NumClicks( 0 ),
+					m_NumErrors( 0 ),
+					m_NumEquationsPlanned( 0 ),
+					m_SearchStepsLeft( 0 )
+	{
+	}
+
+	/// Initialize the bot for a new game
+	void Init( const Settings& settings, uint64 seed );
+
+	/// Update the bot, this should be called before the game manager is updated
+	void Update( float32 frameTime );
+
+	/// Get the number of selection instructions sent
+	uint32 GetNumClicks() const { return m_NumClicks; }
+
+	/// Get the number of clicks that selected a random block instead of the planned one
+	uint32 GetNumErrors() const { return m_NumErrors; }
+
+	/// Get the number of equations the bot planned
+	uint32 GetNumEquationsPlanned() const { return m_NumEquationsPlanned; }
+};
+
+#endif // __PlayerBot_h
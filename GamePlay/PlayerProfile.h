@@ -20,6 +20,8 @@
 #include <map>
 #include "Base/FourCC.h"
 #include "GameDefines.h"
+#include "ProfileJournal.h"
+#include "ProfileIndex.h"
 
 
 class ProfileSubset;
@@ -36,6 +38,10 @@ class Serializer;
 	\brief Represents a player profile
 
 	This class defines a player profile object that store miscellaneous stats.
+
+	The profile file is a snapshot of the subsets and the changes since the snapshot are
+	appended to a journal, see ProfileJournal. Opening a profile reads the snapshot and then
+	applies the journal's records in order.
 */
 //-------------------------------------------------------------------------------------------------
 class PlayerProfile
@@ -51,6 +57,16 @@ public:
 	/// The profile file fourCC code
  	static const FourCC FOURCC_PROFILE;
 
+	/// The profile journal file extension with the leading .
+	static const wchar_t* JOURNAL_EXT;
+
+	/// The extension added to a profile file path while a new snapshot is written
+	static const wchar_t* SNAPSHOT_TEMP_EXT;
+
+	/// The fourCC of the block in the profile file that stores the snapshot generation, older
+	/// versions of the game keep it as an unknown subset
+	static const FourCC FOURCC_GENERATION;
+
 private:
 
 	/// The player name
@@ -64,17 +80,51 @@ private:
 	typedef std::map<FourCC,DataBlock> PackedSubsetMap;
 	PackedSubsetMap m_PackedSubsets;
 
+	/// The generation of the profile file's snapshot, increased every time it is written
+	uint32 m_Generation;
+
+	/// The journal of changes since the snapshot
+	ProfileJournal m_Journal;
+
+	/// The checksum of the last saved data of each subset that is journaled whole
+	typedef std::map<FourCC,uint32> ChecksumMap;
+	ChecksumMap m_SavedChecksums;
+
+	/// If the profile was opened to be read only, it is never written
+	bool m_IsReadOnly;
+
 	/// Load/save the profile data
 	//bool TransferData_Old( Serializer& serializer );
 
 	/// Load/save the profile data
 	bool TransferData( Serializer& serializer );
 
+	/// Read the snapshot and apply the journal's records
+	bool ReadFiles( const std::wstring& sSnapshotPath );
+
+	/// Apply the journal's records to the profile that was read from the snapshot
+	void ReplayJournal();
+
+	/// Apply a journal record to the profile
+	void ApplyJournalRecord( const ProfileJournal::Record& record );
+
+	/// Get the checksum of the data of every subset that is journaled whole
+	void StoreSavedChecksums();
+
+	/// Serialize a subset to memory
+	static void SerializeSubset( ProfileSubset* pSubset, std::string& sData );
+
+	/// Store the profile's summary in the profile index
+	void UpdateIndex();
+
 public:
 
 	/// The default constructor, private so the caller needs to use the OpenProfile() function
-	PlayerProfile( const wchar_t* szName ) : m_sName( szName )
+	PlayerProfile( const wchar_t* szName ) : m_sName( szName ),
+											m_Generation( 0 ),
+											m_IsReadOnly( false )
 	{
+		m_Journal.SetFile( GetJournalPathFromName( szName ).c_str() );
 	}
 
 	/// The default destructor
@@ -83,21 +133,39 @@ public:
 	/// Get a profile data subset
 	ProfileSubset* GetSubset( FourCC subsetID );
 
-	/// Store a profile's data to file
+	/// Append the profile's changes to the journal
 	void SaveToFile();
 
+	/// Write the whole profile to a new snapshot and empty the journal
+	bool Compact();
+
 	/// Get the player's name
 	const std::wstring& GetName() const { return m_sName; }
 
+	/// Summarize the profile for the profile index
+	ProfileIndex::Summary BuildSummary();
+
 	/// Get all known profiles
 	static std::list<std::wstring> GetAllProfileNames();
 
+	/// Get the summaries of all known profiles, the most recently played first
+	static std::list<ProfileIndex::Summary> GetAllProfileSummaries();
+
 	/// Open or create a player profile
 	static PlayerProfile* OpenProfile( const wchar_t* szProfileName );
 
+	/// Open an existing player profile to read without changing its files
+	static PlayerProfile* OpenProfileReadOnly( const wchar_t* szProfileName );
+
+	/// Get if the profile was opened to be read only
+	bool IsReadOnly() const { return m_IsReadOnly; }
+
 	/// Get a profile file path based on a profile name
 	static std::wstring GetFilePathFromName( const wchar_t* szProfileName );
 
+	/// Get a profile journal file path based on a profile name
+	static std::wstring GetJournalPathFromName( const wchar_t* szProfileName );
+
 	/// Test if a name is a valid profile name
 	static bool IsValidProfileName( const wchar_t* szName );
 
@@ -0,0 +1,88 @@
+//=================================================================================================
+/*!
+	\file ProductBlockSampler.h
+	Game Play Library
+	Product Block Sampler Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the class used by the product modes to pick the
+	value of newly generated blocks.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ProductBlockSampler_h
+#define __ProductBlockSampler_h
+
+#include "GameDefines.h"
+#include "Base/RandomGen.h"
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ProductBlockSampler
+	\brief Draws products and weighted primes for new blocks in constant time.
+
+	The alias tables are rebuilt whenever the product filter changes so that generating a block
+	never has to walk the prime weights or retry a product that does not fit the space left in
+	the row.
+*/
+//-------------------------------------------------------------------------------------------------
+class ProductBlockSampler
+{
+private:
+
+	/// The products that can be generated
+	GameDefines::ProductArray m_Products;
+
+	/// The indices into the product array of the products that fit on a single-width block
+	std::vector<uint32> m_NarrowProductIndices;
+
+	/// The table used to draw from all of the products
+	TCBase::AliasTable m_ProductTable;
+
+	/// The table used to draw from the single-width products
+	TCBase::AliasTable m_NarrowProductTable;
+
+	/// The table used to draw a prime index using the prime weights
+	TCBase::AliasTable m_PrimeTable;
+
+public:
+
+	/// The largest product that fits on a single-width block
+	static const int32 MAX_NARROW_PRODUCT = 99;
+
+	/// Set the products and primes that can be generated
+	void SetProducts( const GameDefines::ProductArray& products, uint32 useablePrimes );
+
+	/// Get the products that can be generated
+	const GameDefines::ProductArray& GetProducts() const { return m_Products; }
+
+	/// Get if a product fitting the passed-in width can be drawn
+	bool CanDrawProduct( int32 maxWidth ) const
+	{
+		if( maxWidth < 2 )
+			return !m_NarrowProductTable.IsEmpty();
+		return !m_ProductTable.IsEmpty();
+	}
+
+	/// Draw the index of a product that fits within a width. CanDrawProduct must be true.
+	uint32 DrawProductIndex( int32 maxWidth, TCBase::RandomGen& random ) const
+	{
+		if( maxWidth < 2 )
+			return m_NarrowProductIndices[ random.Draw( m_NarrowProductTable ) ];
+		return random.Draw( m_ProductTable );
+	}
+
+	/// Draw a prime index weighted by GameDefines::PRIME_WEIGHTS
+	uint32 DrawPrimeIndex( TCBase::RandomGen& random ) const
+	{
+		// Fall back to 2 if no primes are allowed
+		if( m_PrimeTable.IsEmpty() )
+			return 0;
+		return random.Draw( m_PrimeTable );
+	}
+};
+
+#endif // __ProductBlockSampler_h
@@ -0,0 +1,178 @@
+//=================================================================================================
+/*!
+	\file ProfileBatchLoader.h
+	Game Play Library
+	Profile Batch Loader Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the object that reads many player profiles in
+	parallel and totals their statistics for a class report.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ProfileBatchLoader_h
+#define __ProfileBatchLoader_h
+
+#include "Base/Types.h"
+#include "Base/CriticalSection.h"
+#include "GameDefines.h"
+#include <string>
+#include <list>
+#include <vector>
+
+class PlayerProfile;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ProfileBatchLoader
+	\brief Reads profiles on worker threads and merges their statistics into class totals.
+
+	Start returns right away and the workers take profiles from a shared queue, opening each one
+	read only, summarizing it into a ProfileSnapshot and then dropping the profile. The class
+	totals and the snapshots finished since the last call can be collected at any time, so a
+	screen can show the report filling in while the rest of the profiles are read.
+*/
+//-------------------------------------------------------------------------------------------------
+class ProfileBatchLoader
+{
+public:
+
+	/// The statistics of a profile or of the class
+	struct Stats
+	{
+		/// The number of profiles
+		uint32 numProfiles;
+
+		/// The number of games played
+		uint32 numSessions;
+
+		/// The total time played in seconds
+		float64 timeOnTask;
+
+		/// The number of equations cleared
+		uint64 numEqsCleared;
+
+		/// The number of erroneous equations
+		uint64 numEqsFailed;
+
+		/// The number of times each prime was used in a valid equation
+		uint64 validCounts[ GameDefines::NUM_PRIMES ];
+
+		/// The number of times each prime was used in an erroneous equation
+		uint64 errorCounts[ GameDefines::NUM_PRIMES ];
+
+		/// The number of games played at each difficulty level
+		uint32 difficultyCounts[ GameDefines::GPDL_COUNT ];
+
+		Stats() { Clear(); }
+
+		/// Reset the statistics
+		void Clear();
+
+		/// Add another set of statistics to these
+		void Merge( const Stats& stats );
+
+		/// Get the fraction of a prime's uses that were valid, 0 if it was not used
+		float64 GetPrimeAccuracy( uint32 primeIndex ) const;
+
+		/// Get the average time played per profile in seconds
+		float64 GetAvgTimeOnTask() const { return numProfiles > 0 ? timeOnTask / (float64)numProfiles : 0.0; }
+	};
+
+	/// The statistics of one profile
+	struct ProfileSnapshot
+	{
+		/// The profile name
+		std::wstring sName;
+
+		/// The profile's statistics
+		Stats stats;
+	};
+
+private:
+
+	/// The names of the profiles to read
+	std::vector<std::wstring> m_ProfileNames;
+
+	/// The index of the next profile to hand to a worker, guarded by m_Lock
+	uint32 m_NextProfileIndex;
+
+	/// The number of workers that have not finished, guarded by m_Lock
+	uint32 m_NumRunningWorkers;
+
+	/// The number of profiles read, guarded by m_Lock
+	uint32 m_NumLoaded;
+
+	/// The number of profiles that could not be read, guarded by m_Lock
+	uint32 m_NumFailed;
+
+	/// If the workers should stop taking profiles, guarded by m_Lock
+	bool m_IsCanceled;
+
+	/// The totals of the profiles read so far, guarded by m_Lock
+	Stats m_ClassStats;
+
+	/// The snapshots finished since they were last collected, guarded by m_Lock
+	std::vector<ProfileSnapshot> m_NewSnapshots;
+
+	/// The lock for the queue and results
+	TCBase::CriticalSection m_Lock;
+
+
+	/// Take the next profile from the queue, false if there are none left or the load was canceled
+	bool TakeNextProfile( uint32& profileIndex );
+
+	/// Read profiles until the queue is empty, this runs on a worker thread
+	void RunWorker();
+
+#ifdef WIN32
+	friend void ProfileBatchLoadThreadProc( void* pParam );
+#else
+	friend void* ProfileBatchLoadThreadProc( void* pParam );
+#endif
+
+public:
+
+	/// The default constructor
+	ProfileBatchLoader() : m_NextProfileIndex( 0 ),
+							m_NumRunningWorkers( 0 ),
+							m_NumLoaded( 0 ),
+							m_NumFailed( 0 ),
+							m_IsCanceled( false )
+	{}
+
+	/// The destructor, stops the workers
+	~ProfileBatchLoader();
+
+	/// Start reading profiles with a number of worker threads, 0 to use one for each core
+	bool Start( const std::list<std::wstring>& profileNames, uint32 numThreads );
+
+	/// Get if the workers are still reading profiles
+	bool IsRunning();
+
+	/// Wait for the workers to finish
+	void Wait();
+
+	/// Wait up to a number of milliseconds for the workers to finish, true if they finished
+	bool WaitFor( uint32 numMS );
+
+	/// Stop the workers after the profiles they are reading and wait for them
+	void Cancel();
+
+	/// Get the number of profiles read, that failed and in total along with the class totals so far
+	void GetProgress( uint32& numLoaded, uint32& numFailed, uint32& numProfiles, Stats& classStats );
+
+	/// Move the snapshots finished since the last call into a list
+	void TakeNewSnapshots( std::vector<ProfileSnapshot>& snapshots );
+
+	/// Summarize a profile's sessions
+	static void BuildSnapshot( PlayerProfile* pProfile, ProfileSnapshot& snapshot );
+
+	/// Get the number of processor cores, at least 1
+	static uint32 GetNumCores();
+};
+
+#endif // __ProfileBatchLoader_h
@@ -0,0 +1,156 @@
+//=================================================================================================
+/*!
+	\file ProfileIndex.h
+	Game Play Library
+	Profile Index Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the index of player profile summaries.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ProfileIndex_h
+#define __ProfileIndex_h
+
+#include "Base/Types.h"
+#include "Base/FourCC.h"
+#include "GameDefines.h"
+#include <string>
+#include <list>
+#include <map>
+
+class Serializer;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ProfileIndex
+	\brief A file in the profile directory with a short summary of every profile.
+
+	Listing profiles with more than their names, such as in the profile picker, would otherwise
+	mean opening and reading every profile. A profile updates its summary in the index every time
+	it is saved, and each summary stores the modification time and size of the profile's snapshot
+	and journal when it was made. Refresh compares those to the files so a profile changed by
+	another copy of the game, added or removed is the only one that is read again.
+
+	The index is only a cache of the profiles, so if it is missing or damaged it is rebuilt.
+*/
+//-------------------------------------------------------------------------------------------------
+class ProfileIndex
+{
+public:
+
+	/// The index file fourCC code
+	static const FourCC FOURCC_INDEX;
+
+	/// The index file name in the profile directory
+	static const wchar_t* INDEX_FILE_NAME;
+
+	/// The summary of a profile
+	struct Summary
+	{
+		/// The profile name
+		std::wstring sName;
+
+		/// The modification time of the profile file when the summary was made
+		uint32 profileModTime;
+
+		/// The size of the profile file when the summary was made
+		uint32 profileSize;
+
+		/// The modification time of the journal file when the summary was made
+		uint32 journalModTime;
+
+		/// The size of the journal file when the summary was made
+		uint32 journalSize;
+
+		/// The number of multiplication sessions
+		uint32 numMultSessions;
+
+		/// The number of addition sessions
+		uint32 numAddSessions;
+
+		/// The total time played in seconds
+		float32 totalTimePlayed;
+
+		/// The time the last session started in seconds since 1970, 0 if no games were played
+		uint32 lastPlayedTime;
+
+		/// The type of game of the last session, GT_Error if no games were played
+		GameDefines::EGameType lastGameType;
+
+		/// The highest multiplication score
+		uint32 multHighScore;
+
+		/// The highest addition score
+		uint32 addHighScore;
+
+		Summary() : profileModTime( 0 ),
+					profileSize( 0 ),
+					journalModTime( 0 ),
+					journalSize( 0 ),
+					numMultSessions( 0 ),
+					numAddSessions( 0 ),
+					totalTimePlayed( 0 ),
+					lastPlayedTime( 0 ),
+					lastGameType( GameDefines::GT_Error ),
+					multHighScore( 0 ),
+					addHighScore( 0 )
+		{}
+
+		/// Store the modification times and sizes of the profile's files
+		void StoreFileStamps();
+
+		/// Get if the profile's files changed since the summary was made
+		bool IsStale() const;
+
+		/// Get the number of games played
+		uint32 GetNumSessions() const { return numMultSessions + numAddSessions; }
+
+		/// Transfer the summary
+		void Serialize( Serializer& serializer );
+	};
+
+private:
+
+	/// The file version
+	static const uint32 FILE_VERSION = 1;
+
+	/// The summaries keyed by profile name
+	typedef std::map<std::wstring,Summary> SummaryMap;
+	SummaryMap m_Summaries;
+
+	/// If the summaries changed since the index was loaded
+	bool m_HasChanges;
+
+	/// Get the index file path
+	static std::wstring GetFilePath();
+
+public:
+
+	/// The default constructor
+	ProfileIndex() : m_HasChanges( false )
+	{}
+
+	/// Read the index file, false if it is missing or damaged
+	bool Load();
+
+	/// Write the index file if the summaries changed
+	bool Save();
+
+	/// Add or replace a profile's summary
+	void SetSummary( const Summary& summary );
+
+	/// Remove a profile's summary
+	void RemoveSummary( const wchar_t* szName );
+
+	/// Bring the summaries up to date with the profile directory
+	void Refresh();
+
+	/// Get the summaries, the most recently played first
+	std::list<Summary> GetSummaries() const;
+};
+
+#endif // __ProfileIndex_h
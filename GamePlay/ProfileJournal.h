@@ -0,0 +1,127 @@
+//=================================================================================================
+/*!
+	\file ProfileJournal.h
+	Game Play Library
+	Profile Journal Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the append-only journal of player profile changes.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ProfileJournal_h
+#define __ProfileJournal_h
+
+#include "Base/Types.h"
+#include "Base/FourCC.h"
+#include <string>
+#include <vector>
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ProfileJournal
+	\brief The file of changes made to a profile since its last snapshot.
+
+	A profile is stored as a snapshot file, written whole, and a journal that the changes since
+	the snapshot are appended to. Saving a profile only appends the new records, so it takes the
+	same time no matter how many sessions the profile holds, and the profile is compacted into a
+	new snapshot when the journal grows past MAX_FILE_SIZE.
+
+	The journal starts with the generation of the snapshot it belongs to. A snapshot is written
+	to a temporary file, renamed over the old one and then the journal is restarted with the new
+	generation, so a journal left over from a crash between the steps is ignored rather than
+	applied twice. Every record has a checksum and reading stops at the first record that is
+	short or does not match, which is the record that was being written if the game stopped.
+*/
+//-------------------------------------------------------------------------------------------------
+class ProfileJournal
+{
+public:
+
+	/// The journal file fourCC code
+	static const FourCC FOURCC_JOURNAL;
+
+	/// The size the journal grows to before the profile is compacted into a new snapshot
+	static const uint32 MAX_FILE_SIZE = 256 * 1024;
+
+	/// The largest record that will be read, larger lengths are treated as damage
+	static const uint32 MAX_RECORD_SIZE = 16 * 1024 * 1024;
+
+	/// The type of a record
+	enum ERecordType
+	{
+		/// The whole subset, replacing the subset from the snapshot and earlier records
+		RT_Subset = 1,
+
+		/// The changes to a subset written by its SerializeChanges
+		RT_Changes = 2
+	};
+
+	/// A record in the journal
+	struct Record
+	{
+		/// The type of record
+		ERecordType recordType;
+
+		/// The subset the record belongs to
+		FourCC subsetID;
+
+		/// The serialized subset or changes
+		std::string sData;
+
+		Record() : recordType( RT_Subset )
+		{}
+	};
+
+private:
+
+	/// The file version
+	static const uint32 FILE_VERSION = 1;
+
+	/// The size of the file header, the fourCC, version and generation
+	static const uint32 HEADER_SIZE = 12;
+
+	/// The size of a record header, the type, subset, data length and checksum
+	static const uint32 RECORD_HEADER_SIZE = 16;
+
+	/// The journal file path
+	std::wstring m_sFilePath;
+
+	/// The size of the valid part of the journal file, 0 if the journal can't be appended to
+	uint32 m_FileSize;
+
+public:
+
+	/// The default constructor
+	ProfileJournal() : m_FileSize( 0 )
+	{}
+
+	/// Set the journal file
+	void SetFile( const wchar_t* szFilePath ) { m_sFilePath = szFilePath; m_FileSize = 0; }
+
+	/// Read the records of a journal that belongs to a snapshot generation
+	bool ReadRecords( uint32 generation, std::vector<Record>& records );
+
+	/// Empty the journal and start it for a snapshot generation
+	bool Reset( uint32 generation );
+
+	/// Append records to the journal
+	bool Append( const std::vector<Record>& records );
+
+	/// Get if records can be appended, which needs a journal that was read without damage or reset
+	bool IsOpen() const { return m_FileSize > 0; }
+
+	/// Get the size of the valid part of the journal file
+	uint32 GetFileSize() const { return m_FileSize; }
+
+	/// Get the size a record takes in the journal file
+	static uint32 GetRecordSize( const Record& record ) { return RECORD_HEADER_SIZE + (uint32)record.sData.size(); }
+
+	/// Update a CRC-32 checksum with more data, start with a checksum of 0
+	static uint32 UpdateChecksum( uint32 checksum, const uint8* pData, uint32 dataLen );
+};
+
+#endif // __ProfileJournal_h
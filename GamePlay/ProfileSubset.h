@@ -38,6 +38,19 @@ public:
 
 	/// Load/save the subset data
 	virtual bool Serialize( Serializer& serializer ) = 0;
+
+	/// Get if the subset saves its changes to the profile journal, otherwise the whole subset is
+	/// journaled when it differs from the last save
+	virtual bool IsJournaled() const { return false; }
+
+	/// Get if the subset has changes that have not been saved
+	virtual bool HasUnsavedChanges() const { return false; }
+
+	/// Save the changes since the last save or apply saved changes
+	virtual bool SerializeChanges( Serializer& ) { return false; }
+
+	/// Mark the subset's changes as saved
+	virtual void MarkSaved() {}
 };
 
 #endif // __ProfileSubset_h
\ No newline at end of file
@@ -31,6 +31,45 @@ public:
 
 	static const FourCC SUBSET_ID;
 
+	/// The totals of every stored session, kept up to date as sessions are stored
+	struct Totals
+	{
+		/// The number of sessions
+		uint32 numSessions;
+
+		/// The total length of the sessions in seconds
+		float32 duration;
+
+		/// The number of equations cleared
+		uint32 numEqsCleared;
+
+		/// The number of erroneous equations
+		uint32 numEqsFailed;
+
+		/// The number of summands cleared
+		uint32 summandsCleared;
+
+		/// The highest score achieved
+		uint32 highScore;
+
+		/// The most equations cleared in a 5 minute game
+		uint32 mostClearedIn5Mins;
+
+		/// The number of sessions played at each difficulty level
+		uint32 difficultyCounts[ GameDefines::GPDL_COUNT ];
+
+		Totals() { Clear(); }
+
+		/// Reset the totals to no sessions
+		void Clear();
+
+		/// Add a session to the totals
+		void AddSession( const GameSessionStatsAdd& session );
+
+		/// Transfer the totals
+		void Serialize( Serializer& serializer, bool hasDifficultyCounts );
+	};
+
 private:
 
 	/// The list of recent sessions sorted with the most recent sessions at the front of the list
@@ -40,8 +79,23 @@ private:
 	/// The iterator for stepping through sessions
 	SessionList::iterator m_SessionIter;
 
+	/// The number of sessions at the front of the list that have not been saved
+	uint32 m_NumUnsavedSessions;
+
+	/// The totals of the sessions
+	Totals m_Totals;
+
+	/// Rebuild the totals from the sessions
+	void RebuildTotals();
+
 public:
 
+	/// The default constructor
+	ProfileSubsetAddition() : m_NumUnsavedSessions( 0 )
+	{
+		m_SessionIter = m_Sessions.end();
+	}
+
 	/// Load/save the subset data
 	virtual bool Serialize( Serializer& serializer );
 
@@ -51,6 +105,18 @@ public:
 	/// Get the FourCC for this subset
 	virtual FourCC GetSubsetFourCC() const { return GetSubsetFourCC_Static(); }
 
+	/// The sessions are saved to the profile journal as they are played
+	virtual bool IsJournaled() const { return true; }
+
+	/// Get if there are sessions that have not been saved
+	virtual bool HasUnsavedChanges() const { return m_NumUnsavedSessions > 0; }
+
+	/// Save the sessions played since the last save or add saved sessions
+	virtual bool SerializeChanges( Serializer& serializer );
+
+	/// Mark the sessions as saved
+	virtual void MarkSaved() { m_NumUnsavedSessions = 0; }
+
 	/// Store a game session to the profile
 	virtual void StoreSession( const GameSessionStatsAdd& sessionStats );
 
@@ -82,6 +148,9 @@ public:
 
 	/// Get the number of sessions
 	uint32 GetNumSessions() const { return (uint32)m_Sessions.size(); }
+
+	/// Get the totals of every session
+	const Totals& GetTotals() const { return m_Totals; }
 };
 
 #endif // __ProfileSubsetAddition_h
\ No newline at end of file
@@ -16,7 +16,9 @@
 
 #include "ProfileSubsetInGame.h"
 #include <list>
+#include <vector>
 #include "GameSessionStatsMult.h"
+#include "SessionHistoryMult.h"
 
 class GameFieldBlock;
 
@@ -27,6 +29,11 @@ class GameFieldBlock;
 	\brief Represents a profile subset for multiplication
 
 	This class defines a player profile object that store miscellaneous stats.
+
+	The saved sessions are split into pages of SESSIONS_PER_PAGE sessions behind a directory of
+	page lengths. Loading the subset reads only the totals and the directory, and a page is decoded
+	into the session list the first time the iteration reaches it, so starting a game or showing
+	the last game played does not depend on how many sessions the profile holds.
 */
 //-------------------------------------------------------------------------------------------------
 class ProfileSubsetMultiplication : public ProfileSubsetInGame
@@ -46,8 +53,75 @@ public:
 	static const uint32 PRO_SESS_DIFFINC_VAL_MASK = 0x00000F00;
 	static const uint32 PRO_SESS_DIFFINC_VAL_OFFSET = 8;
 
+	/// The totals of every stored session, kept up to date as sessions are stored
+	struct Totals
+	{
+		/// The number of sessions
+		uint32 numSessions;
+
+		/// The total length of the sessions in seconds
+		float32 duration;
+
+		/// The number of equations cleared
+		uint32 numEqsCleared;
+
+		/// The number of erroneous equations
+		uint32 numEqsFailed;
+
+		/// The number of blocks cleared
+		uint32 numBlocksCleared;
+
+		/// The number of occurances a prime factor was used in a valid equation
+		uint32 validCounts[ GameDefines::NUM_PRIMES ];
+
+		/// The number of occurances a prime factor was used in a erroneous equation
+		uint32 errorCounts[ GameDefines::NUM_PRIMES ];
+
+		/// The highest score achieved
+		uint32 highScore;
+
+		/// The number of sessions played at each difficulty level
+		uint32 difficultyCounts[ GameDefines::GPDL_COUNT ];
+
+		Totals() { Clear(); }
+
+		/// Reset the totals to no sessions
+		void Clear();
+
+		/// Add a session to the totals
+		void AddSession( const GameSessionStatsMult& session );
+
+		/// Transfer the totals
+		void Serialize( Serializer& serializer, uint32 numPrimes, bool hasDifficultyCounts );
+
+		/// Get the number of prime factors used in valid equations
+		uint32 GetNumFactorsCleared() const
+		{
+			uint32 numFactors = 0;
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+				numFactors += validCounts[ primeIndex ];
+			return numFactors;
+		}
+	};
+
 private:
 
+	/// The number of sessions written to each page
+	static const uint32 SESSIONS_PER_PAGE = 64;
+
+	/// A page of saved sessions that has not been decoded
+	struct PackedPage
+	{
+		/// The number of sessions in the page
+		uint32 numSessions;
+
+		/// The offset of the page in the packed page data
+		uint32 dataOffset;
+
+		/// The length of the page in bytes
+		uint32 dataLen;
+	};
+
 	struct PTSettings
 	{
 		/// The gameplay difficulty
@@ -57,17 +131,67 @@ private:
 		uint32 m_TimeLimit;
 	};
 
-	/// The list of recent sessions sorted with the most recent sessions at the front of the list
+	/// The list of recent sessions sorted with the most recent sessions at the front of the list,
+	/// the sessions in the packed pages follow the decoded ones
 	typedef std::list< GameSessionStatsMult > SessionList;
 	SessionList m_Sessions;
 
 	/// The iterator for stepping through sessions
 	SessionList::iterator m_SessionIter;
 
+	/// The number of sessions at the front of the list that have not been saved
+	uint32 m_NumUnsavedSessions;
+
+	/// The pages of older sessions that have not been decoded, the most recent first
+	std::vector<PackedPage> m_PackedPages;
+
+	/// The index of the next page to decode
+	uint32 m_NextPackedPage;
+
+	/// The data of the packed pages
+	std::vector<uint8> m_PackedPageData;
+
+	/// The number of sessions in the packed pages that have not been decoded
+	uint32 m_NumPackedSessions;
+
+	/// The number of primes the packed pages were saved with
+	uint32 m_PackedNumPrimes;
+
+	/// The totals of the sessions
+	Totals m_Totals;
+
+	/// The sessions stored a column per field and sorted by start time
+	SessionHistoryMult m_History;
+
+	/// If the history holds every session, it is built when it is first used
+	bool m_HasHistory;
+
+	/// Decode the next packed page onto the end of the session list, false if there are none left
+	bool DecodeNextPage();
+
+	/// Decode every packed page
+	void DecodeAllPages();
+
+	/// Free the packed pages
+	void ClearPackedPages();
+
+	/// Transfer the sessions as pages behind a directory
+	bool SerializePages( Serializer& serializer, uint32 numSessions, uint32 numPrimes );
+
+	/// Rebuild the totals from the sessions
+	void RebuildTotals();
+
+	/// Rebuild the history from the sessions
+	void RebuildHistory();
+
 public:
 
 	/// The default constructor
-	ProfileSubsetMultiplication()
+	ProfileSubsetMultiplication() : m_NumUnsavedSessions( 0 ),
+									m_NextPackedPage( 0 ),
+									m_NumPackedSessions( 0 ),
+									m_PackedNumPrimes( GameDefines::NUM_PRIMES ),
+									m_HasHistory( true )
 	{
 		m_SessionIter = m_Sessions.end();
 	}
@@ -81,37 +205,35 @@ public:
 	/// Get the FourCC for this subset
 	virtual FourCC GetSubsetFourCC() const { return SUBSET_ID; }
 
+	/// The sessions are saved to the profile journal as they are played
+	virtual bool IsJournaled() const { return true; }
+
+	/// Get if there are sessions that have not been saved
+	virtual bool HasUnsavedChanges() const { return m_NumUnsavedSessions > 0; }
+
+	/// Save the sessions played since the last save or add saved sessions
+	virtual bool SerializeChanges( Serializer& serializer );
+
+	/// Mark the sessions as saved
+	virtual void MarkSaved() { m_NumUnsavedSessions = 0; }
+
 	/// Store a game session to the profile
 	void StoreSession( const GameSessionStatsMult& sessionStats );
 
 	/// Start iterating at the first session
-	const GameSessionStatsMult* GetFirstSession()
-	{
-		m_SessionIter = m_Sessions.begin();
-		if( m_SessionIter == m_Sessions.end() )
-			return 0;
-		return &(*m_SessionIter);
-	}
-
-	/// Step through the sessions
-	const GameSessionStatsMult* GetNextSession()
-	{
-		// If the iterator is already at the end
-		if( m_SessionIter == m_Sessions.end() )
-			return 0;
+	const GameSessionStatsMult* GetFirstSession();
 
-		// Step forward
-		m_SessionIter++;
+	/// Step through the sessions, decoding the older sessions as they are reached
+	const GameSessionStatsMult* GetNextSession();
 
-		// If the iterator reached the end
-		if( m_SessionIter == m_Sessions.end() )
-			return 0;
+	/// Get the number of sessions
+	uint32 GetNumSessions() const { return (uint32)m_Sessions.size() + m_NumPackedSessions; }
 
-		return &(*m_SessionIter);
-	}
+	/// Get the totals of every session
+	const Totals& GetTotals() const { return m_Totals; }
 
-	/// Get the number of sessions
-	uint32 GetNumSessions() const { return (uint32)m_Sessions.size(); }
+	/// Get the sessions sorted by start time for charting, this decodes every session the first time
+	const SessionHistoryMult& GetHistory();
 };
 
 #endif // __ProfileSubsetMultiplication_h
\ No newline at end of file
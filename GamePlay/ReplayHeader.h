@@ -0,0 +1,132 @@
+//=================================================================================================
+/*!
+	\file ReplayHeader.h
+	Game Play Library
+	Replay Header Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the header at the start of a recorded game.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ReplayHeader_h
+#define __ReplayHeader_h
+
+#include "Base/Types.h"
+#include "Base/FourCC.h"
+#include "Base/PackedSerializer.h"
+#include "GameDefines.h"
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\struct ReplayHeader
+	\brief The information needed to start the game a replay file recorded.
+
+	A replay file is written with a PackedSerializer. It starts with this header and is followed
+	by one record for each instruction the game field handled, in order, until the end of the
+	file. A record is the number of simulation ticks since the previous record, the instruction
+	type ID and then the instruction's data. Since the game is simulated in fixed ticks, the tick
+	an instruction was handled on is all that is needed to replay it at the same point in the
+	game.
+
+	Since version 2, a snapshot of the complete game state is recorded periodically so a replay
+	can jump to any point without simulating the game from the start. A snapshot record uses the
+	SNAPSHOT_RECORD_ID type ID, which no instruction uses, followed by the size of the state data
+	and the data written by GameMgr::SerializeGameState at the end of the record's tick.
+
+	Since version 3, a summary record is written when the game ends. It uses the
+	SUMMARY_RECORD_ID type ID and holds the final score and the number of blocks on the field so
+	a replay can be verified by simulating it and comparing the results. The snapshots are
+	verified the same way by comparing the state of the simulated game to the recorded state.
+
+	Since version 4, booleans in snapshots are stored as one byte. Earlier versions wrote them
+	as four bytes, which can't be read back, so the snapshots in those files are ignored.
+*/
+//-------------------------------------------------------------------------------------------------
+struct ReplayHeader
+{
+	/// The version of the replay format this code reads and writes
+	static const uint32 CUR_VERSION = 4;
+
+	/// The first version with snapshots that can be restored
+	static const uint32 RESTORABLE_SNAPSHOT_VERSION = 4;
+
+	/// The type ID of a game state snapshot record
+	static const uint8 SNAPSHOT_RECORD_ID = 0;
+
+	/// The type ID of the summary record written when the game ends
+	static const uint8 SUMMARY_RECORD_ID = 255;
+
+	/// The default constructor
+	ReplayHeader() : version( CUR_VERSION ),
+					gameType( GameDefines::GT_Error ),
+					gameDiff( GameDefines::GPDL_4 ),
+					timeLimit( 0 ),
+					seed( 0 ),
+					buildVersion( 0 ),
+					tickTime( GameDefines::SIM_TICK_TIME )
+	{}
+
+	/// Get the ID at the start of every replay file
+	static FourCC GetFileID() { return FourCC( 'P', 'T', 'R', 'P' ); }
+
+	/// Save/load the header, returns false if the data being read is not a replay this code can
+	/// read
+	bool Serialize( PackedSerializer& serializer )
+	{
+		int32 fileID = GetFileID().ToInt32();
+		serializer.AddData( fileID );
+		if( fileID != GetFileID().ToInt32() )
+			return false;
+
+		// Version 1 is the same format without snapshots and version 2 is without the summary
+		serializer.AddData( version );
+		if( version == 0 || version > CUR_VERSION )
+			return false;
+
+		uint32 tempVal = (uint32)gameType;
+		serializer.AddData( tempVal );
+		gameType = (GameDefines::EGameType)tempVal;
+
+		tempVal = (uint32)gameDiff;
+		serializer.AddData( tempVal );
+		gameDiff = (GameDefines::EGameplayDiffLevel)tempVal;
+
+		serializer.AddData( timeLimit );
+		serializer.AddData( seed );
+		filter.Serialize( serializer );
+		serializer.AddData( buildVersion );
+		serializer.AddData( tickTime );
+
+		return true;
+	}
+
+	/// The version of the replay format
+	uint32 version;
+
+	/// The type of game
+	GameDefines::EGameType gameType;
+
+	/// The gameplay difficulty
+	GameDefines::EGameplayDiffLevel gameDiff;
+
+	/// The time limit in seconds, 0 for none
+	uint32 timeLimit;
+
+	/// The random seed the game was started with
+	uint64 seed;
+
+	/// The product filter for practice games
+	GameDefines::ProductSubsetFilter filter;
+
+	/// The version of the game that recorded the replay
+	uint32 buildVersion;
+
+	/// The length of a simulation tick in seconds
+	float32 tickTime;
+};
+
+#endif // __ReplayHeader_h
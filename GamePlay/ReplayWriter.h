@@ -0,0 +1,146 @@
+//=================================================================================================
+/*!
+	\file ReplayWriter.h
+	Game Play Library
+	Replay Writer Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the class that records game field instructions to a
+	replay file.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ReplayWriter_h
+#define __ReplayWriter_h
+
+#include "Base/Types.h"
+#include "Base/CriticalSection.h"
+#include "Base/XPThreads.h"
+#include "ReplayHeader.h"
+#include <vector>
+#include <fstream>
+
+class GameFieldInstruction;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ReplayWriter
+	\brief Records game field instructions to a replay file without blocking the game.
+
+	Instructions are packed into a fixed buffer on the game's thread, which never allocates or
+	touches the disk. When the buffer is nearly full, or a second of game time has passed since
+	the last flush, the buffer is appended to the pending data under a lock. A writer thread
+	takes the pending data every WRITE_INTERVAL_MS and writes it to the file, so a slow disk
+	only delays the writer thread. Snapshots of the game state are recorded the same way.
+*/
+//-------------------------------------------------------------------------------------------------
+class ReplayWriter
+{
+public:
+
+	/// The size of the buffer records are packed into
+	static const uint32 BUFFER_SIZE = 32 * 1024;
+
+	/// The largest size of a record, the buffer is flushed when less than this is free
+	static const uint32 MAX_RECORD_SIZE = 4 * 1024;
+
+	/// The most ticks between flushes so little is lost if the game exits unexpectedly
+	static const uint32 FLUSH_INTERVAL_TICKS = 120;
+
+	/// How long the writer thread sleeps between writes
+	static const uint32 WRITE_INTERVAL_MS = 50;
+
+	/// How long End waits for the writer thread before logging that it is slow to finish
+	static const uint32 END_TIMEOUT_MS = 5000;
+
+private:
+
+	/// The buffer records are packed into
+	uint8 m_FillBuffer[ BUFFER_SIZE ];
+
+	/// The number of bytes in the fill buffer
+	uint32 m_FillSize;
+
+	/// The data waiting to be written by the writer thread, guarded by m_DataLock
+	std::vector<uint8> m_PendingData;
+
+	/// The data being written by the writer thread, only used by the writer thread
+	std::vector<uint8> m_WriteData;
+
+	/// The lock for the pending data
+	TCBase::CriticalSection m_DataLock;
+
+	/// The replay file, only used by the writer thread once it is running
+	std::ofstream m_OutFile;
+
+	/// The writer thread
+	XPThreads m_WriteThread;
+
+	/// If the writer thread is running
+	volatile bool m_IsThreadRunning;
+
+	/// Set to tell the writer thread to write the remaining data and close the file
+	volatile bool m_StopRequested;
+
+	/// If a replay is being recorded
+	bool m_IsRecording;
+
+	/// The tick of the last recorded instruction
+	uint32 m_PrevTick;
+
+	/// The tick the fill buffer was last flushed on
+	uint32 m_FlushTick;
+
+	/// The number of bytes recorded
+	uint32 m_NumBytesRecorded;
+
+
+	/// Move the fill buffer to the pending data for the writer thread
+	void Flush();
+
+	/// Flush the fill buffer if another record might not fit or it has been a while
+	void CheckFlush( uint32 tick );
+
+	/// Write the pending data to the file on a regular interval until a stop is requested
+	void RunWriteThread();
+
+#ifdef WIN32
+	friend void ReplayWriteThreadProc( void* pParam );
+#else
+	friend void* ReplayWriteThreadProc( void* pParam );
+#endif
+
+public:
+
+	/// The default constructor
+	ReplayWriter();
+
+	/// The destructor
+	~ReplayWriter();
+
+	/// Create the replay file, write the header and start the writer thread
+	bool Begin( const wchar_t* szFilePath, ReplayHeader& header );
+
+	/// Record an instruction handled by a game field
+	void RecordInstruction( GameFieldInstruction* pInst, uint32 tick );
+
+	/// Record a snapshot of the game state
+	void RecordSnapshot( const uint8* pStateData, uint32 dataSize, uint32 tick );
+
+	/// Record the results of the game when it ends
+	void RecordSummary( uint32 score, uint32 numBlocks, uint32 tick );
+
+	/// Write the remaining data and close the file
+	void End();
+
+	/// Get if a replay is being recorded
+	bool IsRecording() const { return m_IsRecording; }
+
+	/// Get the number of bytes recorded, including bytes not yet written to the file
+	uint32 GetNumBytesRecorded() const { return m_NumBytesRecorded; }
+};
+
+#endif // __ReplayWriter_h
@@ -0,0 +1,171 @@
+//=================================================================================================
+/*!
+	\file SessionHistoryMult.h
+	Game Play Library
+	Multiplication Session History Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the column store of multiplication game sessions.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __SessionHistoryMult_h
+#define __SessionHistoryMult_h
+
+#include "Base/Types.h"
+#include "GameDefines.h"
+#include <time.h>
+#include <vector>
+
+class GameSessionStatsMult;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class SessionHistoryMult
+	\brief The multiplication sessions of a profile stored a column per field for charting.
+
+	The sessions are kept sorted by start time with each field in its own array, so a chart
+	finds the sessions in a time range with a binary search and then only reads the columns it
+	plots. Downsample splits a time range into a fixed number of buckets and totals a column into
+	them, which keeps the cost of a chart to the sessions in its range no matter how many sessions
+	the profile holds.
+*/
+//-------------------------------------------------------------------------------------------------
+class SessionHistoryMult
+{
+public:
+
+	/// The columns that can be downsampled
+	enum EColumn
+	{
+		C_Duration,
+		C_Score,
+		C_NumEqsCleared,
+		C_NumEqsFailed,
+		C_NumBlocksCleared,
+		C_Difficulty,
+		C_MaxCombo,
+		C_COUNT
+	};
+
+	/// A bucket of a downsampled column
+	struct Bucket
+	{
+		/// The time the bucket starts at
+		time_t startTime;
+
+		/// The number of sessions in the bucket
+		uint32 numSessions;
+
+		/// The total of the column over the sessions
+		float64 total;
+
+		/// The largest value of the column, 0 if the bucket is empty
+		float64 maxValue;
+
+		Bucket() : startTime( 0 ),
+					numSessions( 0 ),
+					total( 0.0 ),
+					maxValue( 0.0 )
+		{}
+
+		/// Get the average value of the column, 0 if the bucket is empty
+		float64 GetAverage() const { return numSessions > 0 ? total / (float64)numSessions : 0.0; }
+	};
+
+	/// A bucket of a prime factor's usage
+	struct PrimeBucket
+	{
+		/// The time the bucket starts at
+		time_t startTime;
+
+		/// The number of sessions in the bucket
+		uint32 numSessions;
+
+		/// The number of times the prime was used in a valid equation
+		uint64 validCount;
+
+		/// The number of times the prime was used in an erroneous equation
+		uint64 errorCount;
+
+		PrimeBucket() : startTime( 0 ),
+						numSessions( 0 ),
+						validCount( 0 ),
+						errorCount( 0 )
+		{}
+
+		/// Get the fraction of the prime's uses that were valid, 0 if it was not used
+		float64 GetAccuracy() const
+		{
+			uint64 numUses = validCount + errorCount;
+			return numUses > 0 ? (float64)validCount / (float64)numUses : 0.0;
+		}
+	};
+
+private:
+
+	/// The start time of each session, sorted ascendingly
+	std::vector<time_t> m_StartTimes;
+
+	/// The length of each session in seconds
+	std::vector<float32> m_Durations;
+
+	/// The score of each session
+	std::vector<uint32> m_Scores;
+
+	/// The number of equations cleared in each session
+	std::vector<uint32> m_NumEqsCleared;
+
+	/// The number of erroneous equations in each session
+	std::vector<uint32> m_NumEqsFailed;
+
+	/// The number of blocks cleared in each session
+	std::vector<uint32> m_NumBlocksCleared;
+
+	/// The gameplay difficulty of each session
+	std::vector<uint8> m_Difficulties;
+
+	/// The largest combo of each session
+	std::vector<uint32> m_MaxCombos;
+
+	/// The number of times each prime was used in a valid equation in each session
+	std::vector<uint32> m_ValidCounts[ GameDefines::NUM_PRIMES ];
+
+	/// The number of times each prime was used in an erroneous equation in each session
+	std::vector<uint32> m_ErrorCounts[ GameDefines::NUM_PRIMES ];
+
+
+	/// Get the range of buckets for a time range, false if the range or bucket count is empty
+	bool GetBucketRange( time_t startTime, time_t endTime, uint32 numBuckets, uint32& firstIndex, uint32& endIndex, time_t& bucketLen ) const;
+
+public:
+
+	/// Get the start time of a session as a time value
+	static time_t GetStartTime( const GameSessionStatsMult& session );
+
+	/// Remove every session
+	void Clear();
+
+	/// Reserve space for a number of sessions
+	void Reserve( uint32 numSessions );
+
+	/// Add a session, keeping the sessions sorted by start time
+	void AddSession( const GameSessionStatsMult& session );
+
+	/// Get the number of sessions
+	uint32 GetNumSessions() const { return (uint32)m_StartTimes.size(); }
+
+	/// Get the index of the first session that starts at or after a time
+	uint32 FindFirstSession( time_t startTime ) const;
+
+	/// Total a column into buckets of equal length that cover a time range
+	void Downsample( EColumn column, time_t startTime, time_t endTime, uint32 numBuckets, std::vector<Bucket>& buckets ) const;
+
+	/// Total a prime factor's usage into buckets of equal length that cover a time range
+	void DownsamplePrime( uint32 primeIndex, time_t startTime, time_t endTime, uint32 numBuckets, std::vector<PrimeBucket>& buckets ) const;
+};
+
+#endif // __SessionHistoryMult_h
@@ -0,0 +1,330 @@
+/*=================================================================================================
+
+	\file BlockFaceCache.cpp
+	Game Play Library
+	Block Face Cache Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the block face cache class.
+
+=================================================================================================*/
+
+#include "../BlockFaceCache.h"
+#include "Graphics2D/GraphicsMgr.h"
+#include "Graphics2D/RefSprite.h"
+#include "Graphics2D/TCFont.h"
+#include "Graphics2D/TCImage.h"
+#include "Resource/ResourceMgr.h"
+#include "Base/ProfileTimer.h"
+#include <stdio.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::~BlockFaceCache  Public
+///
+///	The destructor.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+BlockFaceCache::~BlockFaceCache()
+{
+	for( uint32 valueIndex = 0; valueIndex < m_ValueTexts.size(); ++valueIndex )
+		delete m_ValueTexts[ valueIndex ];
+	m_ValueTexts.clear();
+
+	for( uint32 pageIndex = 0; pageIndex < m_Pages.size(); ++pageIndex )
+		delete m_Pages[ pageIndex ];
+	m_Pages.clear();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::Get  Public
+///
+///	\returns The instance of the cache
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+BlockFaceCache& BlockFaceCache::Get()
+{
+	static BlockFaceCache s_Cache;
+	return s_Cache;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::GetValueText  Public
+///
+///	\param value The value on the block, clamped to MAX_VALUE
+///	\returns The text for the value, which stays valid for the life of the cache
+///
+///	Get the text drawn on a block and the offset that centers it on the block. The text is
+///	formatted and measured the first time a value is used.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const BlockFaceCache::ValueText& BlockFaceCache::GetValueText( int32 value )
+{
+	if( value < 0 )
+		value = 0;
+	if( value > MAX_VALUE )
+		value = MAX_VALUE;
+
+	if( (int32)m_ValueTexts.size() <= value )
+		m_ValueTexts.resize( value + 1, 0 );
+
+	// Create the text string the first time the value is used
+	ValueText* pValueText = m_ValueTexts[ value ];
+	if( !pValueText )
+	{
+		pValueText = new ValueText();
+		swprintf( pValueText->szText, TEXT_BUF_SIZE, L"%d", value );
+		pValueText->isCentered = false;
+		m_ValueTexts[ value ] = pValueText;
+	}
+
+	// Center the number text, the font is not loaded when running without graphics so the text is
+	// centered once the font is available
+	if( !pValueText->isCentered && GameDefines::GetBlockTextFont().GetObj() )
+	{
+		// Values with more than 2 digits are on double width blocks
+		int32 blockWidth = GameDefines::BLOCK_WIDTH;
+		if( value > 99 )
+			blockWidth *= 2;
+
+		const TCFont* pFont = GameDefines::GetBlockTextFont().GetObj();
+		pValueText->textOffset.x = (blockWidth - pFont->CalcStringWidth( pValueText->szText )) / 2;
+		pValueText->textOffset.y = (GameDefines::BLOCK_HEIGHT - pFont->GetCharHeight()) / 2;
+		pValueText->isCentered = true;
+	}
+
+	return *pValueText;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::BuildValueTexts  Public
+///
+///	Format the text for every value up to MAX_VALUE. Blocks get their text when they are created,
+///	so the texts must all exist before games are played on worker threads.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockFaceCache::BuildValueTexts()
+{
+	m_ValueTexts.reserve( MAX_VALUE + 1 );
+	for( int32 value = 0; value <= MAX_VALUE; ++value )
+		GetValueText( value );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::GetFace  Public
+///
+///	\param pSprite The sprite of the block
+///	\param value The value drawn on the block
+///	\returns The face, NULL if the face has not been rendered
+///
+///	Get the pre-rendered face for a block. If the face has not been rendered it is queued so it
+///	is available on a later frame.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const BlockFaceCache::Face* BlockFaceCache::GetFace( const RefSprite* pSprite, int32 value )
+{
+	FaceKey faceKey( pSprite, value );
+	std::map< FaceKey, Face >::const_iterator iterFace = m_Faces.find( faceKey );
+	if( iterFace != m_Faces.end() )
+		return &iterFace->second;
+
+	QueueFace( faceKey );
+	return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::QueueFace  Private
+///
+///	\param faceKey The sprite and value of the face
+///
+///	Queue a face to be rendered unless it has been rendered or is already queued.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockFaceCache::QueueFace( const FaceKey& faceKey )
+{
+	if( m_PagesUnavailable || !faceKey.first )
+		return;
+
+	if( m_Faces.find( faceKey ) != m_Faces.end() || m_QueuedFaceSet.find( faceKey ) != m_QueuedFaceSet.end() )
+		return;
+
+	m_QueuedFaces.push_back( faceKey );
+	m_QueuedFaceSet.insert( faceKey );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::QueueProducts  Public
+///
+///	\param products The products that can be generated
+///
+///	Queue the faces for products, in both the normal and highlighted states, so they are
+///	rendered before the blocks appear. This is called when the product filter changes.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockFaceCache::QueueProducts( const GameDefines::ProductArray& products )
+{
+	const RefSprite* pNarrowSprite = ResourceMgr::Get().GetRefSprite( RESID_SPRITE_PRODUCT_BLOCK ).GetObj();
+	const RefSprite* pNarrowHiliteSprite = ResourceMgr::Get().GetRefSprite( RESID_SPRITE_PRODUCT_BLOCK_HILITED ).GetObj();
+	const RefSprite* pWideSprite = ResourceMgr::Get().GetRefSprite( RESID_SPRITE_DOUBLE_PRODUCT_BLOCK ).GetObj();
+	const RefSprite* pWideHiliteSprite = ResourceMgr::Get().GetRefSprite( RESID_SPRITE_DBL_PRDCT_BLOCK_HILITED ).GetObj();
+
+	for( uint32 productIndex = 0; productIndex < products.size(); ++productIndex )
+	{
+		int32 value = products[ productIndex ].product;
+		if( value > 99 )
+		{
+			QueueFace( FaceKey( pWideSprite, value ) );
+			QueueFace( FaceKey( pWideHiliteSprite, value ) );
+		}
+		else
+		{
+			QueueFace( FaceKey( pNarrowSprite, value ) );
+			QueueFace( FaceKey( pNarrowHiliteSprite, value ) );
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::RenderQueuedFaces  Public
+///
+///	\param maxFaces The most faces to render
+///
+///	Render queued faces into the atlas. This is called once a frame so the queue is worked
+///	through over a number of frames.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockFaceCache::RenderQueuedFaces( uint32 maxFaces )
+{
+	if( m_QueuedFaces.empty() )
+		return;
+
+	PROFILE_SCOPE( "BlockFaceCache::RenderQueuedFaces" );
+
+	for( uint32 faceIndex = 0; faceIndex < maxFaces && !m_QueuedFaces.empty(); ++faceIndex )
+	{
+		FaceKey faceKey = m_QueuedFaces.back();
+		m_QueuedFaces.pop_back();
+		m_QueuedFaceSet.erase( faceKey );
+
+		RenderFace( faceKey );
+	}
+
+	// If no more faces can be stored then stop trying
+	if( m_PagesUnavailable )
+	{
+		m_QueuedFaces.clear();
+		m_QueuedFaceSet.clear();
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::RenderFace  Private
+///
+///	\param faceKey The sprite and value of the face
+///	\returns True if the face was rendered, false otherwise
+///
+///	Draw a block sprite and the text for a value onto an atlas page.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool BlockFaceCache::RenderFace( const FaceKey& faceKey )
+{
+	const RefSprite* pSprite = faceKey.first;
+	const TCFont* pFont = GameDefines::GetBlockTextFont().GetObj();
+	if( !g_pGraphicsMgr || !pSprite || !pSprite->GetImage() || !pFont )
+		return false;
+
+	// Find room for the face
+	const Box2i& spriteRect = pSprite->GetSrcRect();
+	Point2i facePos;
+	TCImage* pPage = AllocFaceRect( spriteRect.size, facePos );
+	if( !pPage )
+		return false;
+
+	// Draw the block with its text on top
+	const ValueText& valueText = GetValueText( faceKey.second );
+	g_pGraphicsMgr->SetTempRenderTarget( pPage );
+	g_pGraphicsMgr->DrawSprite( facePos, pSprite );
+	g_pGraphicsMgr->DrawFontText( pFont, valueText.szText, facePos + valueText.textOffset );
+	g_pGraphicsMgr->ClearTempRenderTarget();
+
+	Face newFace;
+	newFace.pPage = pPage;
+	newFace.srcRect = Box2i( facePos, spriteRect.size );
+	m_Faces[ faceKey ] = newFace;
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockFaceCache::AllocFaceRect  Private
+///
+///	\param faceSize The dimensions of the face
+///	\param facePos Filled in with the top left of the face on the page
+///	\returns The page for the face, NULL if there is no room and no more pages can be created
+///
+///	Find room for a face. Faces are placed left to right in rows down the last page, and a page
+///	is created when the last page is full.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+TCImage* BlockFaceCache::AllocFaceRect( const Vector2i& faceSize, Point2i& facePos )
+{
+	if( faceSize.x > PAGE_SIZE || faceSize.y > PAGE_SIZE )
+		return 0;
+
+	// If the face doesn't fit on this row then move to the next
+	if( !m_Pages.empty() && m_PenPos.x + faceSize.x > PAGE_SIZE )
+	{
+		m_PenPos.x = 0;
+		m_PenPos.y += m_RowHeight;
+		m_RowHeight = 0;
+	}
+
+	// If the face doesn't fit on the page then start a new one
+	if( m_Pages.empty() || m_PenPos.y + faceSize.y > PAGE_SIZE )
+	{
+		if( m_Pages.size() >= MAX_PAGES )
+		{
+			m_PagesUnavailable = true;
+			return 0;
+		}
+
+		// Not every graphics manager supports creating images
+		TCImage* pNewPage = g_pGraphicsMgr->CreateBlankImage( Vector2i( PAGE_SIZE, PAGE_SIZE ) );
+		if( !pNewPage )
+		{
+			m_PagesUnavailable = true;
+			return 0;
+		}
+
+		m_Pages.push_back( pNewPage );
+		m_PenPos = Point2i( 0, 0 );
+		m_RowHeight = 0;
+	}
+
+	facePos = m_PenPos;
+	m_PenPos.x += faceSize.x;
+	if( faceSize.y > m_RowHeight )
+		m_RowHeight = faceSize.y;
+
+	return m_Pages.back();
+}
@@ -0,0 +1,244 @@
+/*=================================================================================================
+
+	\file BlockIDTable.cpp
+	Game Play Library
+	Block ID Table Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the block ID table class.
+
+=================================================================================================*/
+
+#include "../BlockIDTable.h"
+#include "Base/TCAssert.h"
+#include "Base/Serializer.h"
+#include <algorithm>
+
+/// The largest generation that fits in an ID
+static const uint32 MAX_GENERATION = 0xFFFFFFFF >> BlockIDTable::SLOT_BITS;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockIDTable::Add  Public
+///
+///	\param pBlock The block to add
+///	\returns The ID of the block, INVALID_ID if the table is full
+///
+///	Add a block to the table, reusing the most recently freed slot if there is one.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 BlockIDTable::Add( GameFieldBlock* pBlock )
+{
+	uint32 slotIndex = 0;
+	if( !m_FreeSlots.empty() )
+	{
+		slotIndex = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+	}
+	else
+	{
+		if( m_Slots.size() > SLOT_MASK )
+		{
+			TCBREAKX( L"The block ID table is full." );
+			return INVALID_ID;
+		}
+
+		// New slots start at generation 1 so no ID is ever 0
+		Slot newSlot;
+		newSlot.pBlock = 0;
+		newSlot.generation = 1;
+		slotIndex = (uint32)m_Slots.size();
+		m_Slots.push_back( newSlot );
+	}
+
+	m_Slots[ slotIndex ].pBlock = pBlock;
+	++m_NumBlocks;
+
+	return (m_Slots[ slotIndex ].generation << SLOT_BITS) | slotIndex;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockIDTable::Remove  Public
+///
+///	\param blockID The ID of the block to remove
+///
+///	Remove a block from the table. Removing an ID that is not in the table does nothing.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockIDTable::Remove( uint32 blockID )
+{
+	if( !Find( blockID ) )
+		return;
+
+	// Move the slot to the next generation so the removed ID can not find the slot's next block
+	uint32 slotIndex = GetSlotIndex( blockID );
+	Slot& slot = m_Slots[ slotIndex ];
+	slot.pBlock = 0;
+	slot.generation = slot.generation == MAX_GENERATION ? 1 : slot.generation + 1;
+
+	m_FreeSlots.push_back( slotIndex );
+	--m_NumBlocks;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockIDTable::GetBlockByIndex  Public
+///
+///	\param blockIndex The index of the block, less than the number of blocks in the table
+///	\returns The block, NULL if the index is not less than the number of blocks
+///
+///	Get a block by its position among the blocks in the table, such as to choose a random block.
+///	This walks the slots so it is linear in the size of the table.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GameFieldBlock* BlockIDTable::GetBlockByIndex( uint32 blockIndex ) const
+{
+	for( uint32 slotIndex = 0; slotIndex < m_Slots.size(); ++slotIndex )
+	{
+		if( !m_Slots[ slotIndex ].pBlock )
+			continue;
+
+		if( blockIndex == 0 )
+			return m_Slots[ slotIndex ].pBlock;
+		--blockIndex;
+	}
+
+	return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockIDTable::Clear  Public
+///
+///	Remove every block from the table. The slots are kept and moved to their next generation so
+///	IDs handed out before the clear stay invalid.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockIDTable::Clear()
+{
+	// Free the slots from the last to the first so the next blocks added use the first slots
+	for( int32 slotIndex = (int32)m_Slots.size() - 1; slotIndex >= 0; --slotIndex )
+	{
+		Slot& slot = m_Slots[ slotIndex ];
+		if( !slot.pBlock )
+			continue;
+
+		slot.pBlock = 0;
+		slot.generation = slot.generation == MAX_GENERATION ? 1 : slot.generation + 1;
+		m_FreeSlots.push_back( (uint32)slotIndex );
+	}
+
+	m_NumBlocks = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockIDTable::SerializeState  Public
+///
+///	\param serializer The serializer that reads and writes data
+///
+///	Save/load the generation of every slot and the order of the free slots so the blocks added
+///	after loading get the same IDs they got when the state was saved. The blocks are not stored,
+///	when loading every slot is left empty and the blocks are put back with Place. If the loaded
+///	free slots are not distinct empty slots of the table, the table is left empty.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlockIDTable::SerializeState( Serializer& serializer )
+{
+	uint32 numSlots = (uint32)m_Slots.size();
+	serializer.AddData( numSlots );
+	if( serializer.InReadMode() )
+	{
+		if( numSlots > SLOT_MASK + 1 )
+		{
+			TCBREAKX( L"The block ID table state has too many slots." );
+			numSlots = 0;
+		}
+
+		Slot emptySlot;
+		emptySlot.pBlock = 0;
+		emptySlot.generation = 1;
+		m_Slots.assign( numSlots, emptySlot );
+		m_NumBlocks = 0;
+	}
+
+	for( uint32 slotIndex = 0; slotIndex < numSlots; ++slotIndex )
+		serializer.AddData( m_Slots[ slotIndex ].generation );
+
+	uint32 numFreeSlots = (uint32)m_FreeSlots.size();
+	serializer.AddData( numFreeSlots );
+	if( serializer.InReadMode() )
+	{
+		if( numFreeSlots > numSlots )
+		{
+			TCBREAKX( L"The block ID table state has more free slots than slots." );
+			m_Slots.clear();
+			m_FreeSlots.clear();
+			return;
+		}
+
+		m_FreeSlots.resize( numFreeSlots );
+	}
+
+	for( uint32 freeIndex = 0; freeIndex < numFreeSlots; ++freeIndex )
+		serializer.AddData( m_FreeSlots[ freeIndex ] );
+
+	if( !serializer.InReadMode() )
+		return;
+
+	// Each free slot must be an empty slot of the table and be free once, otherwise Add would
+	// give out a slot that is in use
+	std::vector<bool> isSlotFree( numSlots, false );
+	for( uint32 freeIndex = 0; freeIndex < numFreeSlots; ++freeIndex )
+	{
+		uint32 slotIndex = m_FreeSlots[ freeIndex ];
+		if( slotIndex >= numSlots || m_Slots[ slotIndex ].pBlock || isSlotFree[ slotIndex ] )
+		{
+			TCBREAKX( L"The block ID table state has an invalid free slot." );
+			m_Slots.clear();
+			m_FreeSlots.clear();
+			return;
+		}
+		isSlotFree[ slotIndex ] = true;
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BlockIDTable::Place  Public
+///
+///	\param blockID The ID the block had when the table's state was saved
+///	\param pBlock The block
+///	\returns True if the block was placed, false if the ID's slot does not exist, has a different
+///				generation, already has a block or is free
+///
+///	Put a block back in its slot after loading the table's state. Checking the free slots is
+///	linear but a field only has a few, and this is only used when restoring a snapshot.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool BlockIDTable::Place( uint32 blockID, GameFieldBlock* pBlock )
+{
+	uint32 slotIndex = GetSlotIndex( blockID );
+	if( !pBlock || slotIndex >= m_Slots.size() )
+		return false;
+
+	Slot& slot = m_Slots[ slotIndex ];
+	if( slot.pBlock || slot.generation != GetGeneration( blockID ) )
+		return false;
+
+	// A block in a free slot would be replaced by the next block added
+	if( std::find( m_FreeSlots.begin(), m_FreeSlots.end(), slotIndex ) != m_FreeSlots.end() )
+		return false;
+
+	slot.pBlock = pBlock;
+	++m_NumBlocks;
+	return true;
+}
@@ -0,0 +1,449 @@
+/*=================================================================================================
+
+	\file EquationSolver.cpp
+	Game Play Library
+	Equation Solver Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the equation solver.
+
+=================================================================================================*/
+
+#include "../EquationSolver.h"
+#include "../GameDefines.h"
+#include "../GameFieldAdd.h"
+#include "../GameFieldMultBase.h"
+#include "../GameFieldBlockAdd.h"
+#include "../GameFieldBlockProduct.h"
+#include "Base/TCAssert.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::Clear  Public
+///
+///	Remove the blocks and targets.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void EquationSolver::Clear()
+{
+	m_NumBlocks = 0;
+	m_NumTargets = 0;
+	m_IsSolved = false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::AddBlock  Public
+///
+///	\param pBlock The block that can be used in an equation
+///	\returns True if the block was added, false if the solver already has the most blocks
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool EquationSolver::AddBlock( GameFieldBlock* pBlock )
+{
+	if( !pBlock || m_NumBlocks >= MAX_BLOCKS )
+		return false;
+
+	m_Blocks[ m_NumBlocks ] = pBlock;
+	m_Values[ m_NumBlocks ] = pBlock->GetValue();
+	m_NumBlocks++;
+	m_IsSolved = false;
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::AddTarget  Public
+///
+///	\param pBlock The block that is the target of an equation
+///	\returns True if the block was added, false if the solver already has the most targets
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool EquationSolver::AddTarget( GameFieldBlock* pBlock )
+{
+	if( !pBlock || m_NumTargets >= MAX_BLOCKS )
+		return false;
+
+	m_Targets[ m_NumTargets++ ] = pBlock;
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::LoadSumField  Public
+///
+///	\param pField The addition field
+///
+///	Replace the blocks with the summands on an addition field. The sum block, if there is one,
+///	is the only target.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void EquationSolver::LoadSumField( GameFieldAdd* pField )
+{
+	Clear();
+
+	GameFieldBlock* pSumBlock = pField->GetSumBlock();
+	if( pSumBlock )
+		AddTarget( pSumBlock );
+
+	const BlockIDTable& blockIDs = pField->m_BlockIDs;
+	for( uint32 slotIndex = 0; slotIndex < blockIDs.GetNumSlots(); ++slotIndex )
+	{
+		GameFieldBlock* pBlock = blockIDs.GetBlockInSlot( slotIndex );
+		if( pBlock && pBlock != pSumBlock && pBlock->GetValue() > 0 )
+			AddBlock( pBlock );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::LoadProductField  Public
+///
+///	\param pField The product field
+///	\param pComboBlock The Prime Time combo block, which can be used as a factor, or NULL
+///
+///	Replace the blocks with the factors on a product field and the targets with its products.
+///	Only the blocks that have moved onto the visible part of the field are loaded since the
+///	others can't be clicked.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void EquationSolver::LoadProductField( GameFieldMultBase* pField, GameFieldBlock* pComboBlock )
+{
+	Clear();
+
+	// New rows are pushed up from below the field and new blocks drop in from above it
+	const float32 HALF_BLOCK = (float32)GameDefines::BLOCK_HEIGHT * 0.5f;
+	const float32 FIELD_TOP = (float32)pField->GetFieldRect().size.y - HALF_BLOCK;
+
+	const MultBlockList& activeBlocks = pField->GetActiveBlocks();
+	for( MultBlockList::const_iterator iterBlock = activeBlocks.begin(); iterBlock != activeBlocks.end(); ++iterBlock )
+	{
+		GameFieldBlockProduct* pBlock = (GameFieldBlockProduct*)*iterBlock;
+		if( pBlock->GetValue() <= 1 || pBlock->yPos < -HALF_BLOCK || pBlock->yPos > FIELD_TOP )
+			continue;
+
+		if( pBlock->IsProductBlock() )
+			AddTarget( pBlock );
+		else
+			AddBlock( pBlock );
+	}
+
+	if( pComboBlock && pComboBlock->GetValue() > 1 )
+		AddBlock( pComboBlock );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::FindState  Private
+///
+///	\param stateValue The sum or divisor
+///	\returns The index of the state, -1 if the value is not a state
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 EquationSolver::FindState( int32 stateValue ) const
+{
+	if( m_SolvedType == ET_Sum )
+		return (stateValue >= 0 && stateValue < (int32)m_NumStates) ? stateValue : -1;
+
+	// The divisors are sorted so search for the value
+	int32 lowIndex = 0;
+	int32 highIndex = (int32)m_NumStates - 1;
+	while( lowIndex <= highIndex )
+	{
+		int32 midIndex = (lowIndex + highIndex) / 2;
+		if( m_StateValues[midIndex] == stateValue )
+			return midIndex;
+
+		if( m_StateValues[midIndex] < stateValue )
+			lowIndex = midIndex + 1;
+		else
+			highIndex = midIndex - 1;
+	}
+
+	return -1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::GetNextState  Private
+///
+///	\param stateIndex The state the block is added to
+///	\param blockValue The value of the block
+///	\returns The index of the state reached, which is always above the state added to, or -1 if
+///	the block takes the equation past the target
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 EquationSolver::GetNextState( uint32 stateIndex, int32 blockValue ) const
+{
+	if( m_SolvedType == ET_Sum )
+	{
+		uint32 nextIndex = stateIndex + (uint32)blockValue;
+		return nextIndex < m_NumStates ? (int32)nextIndex : -1;
+	}
+
+	int32 nextValue = m_StateValues[stateIndex] * blockValue;
+	if( (m_SolvedTarget % nextValue) != 0 )
+		return -1;
+	return FindState( nextValue );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::GetPrevState  Private
+///
+///	\param stateIndex The state that was reached
+///	\param blockValue The value of the block
+///	\returns The index of the state the block was added to, -1 if the block can't reach the
+///	state
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 EquationSolver::GetPrevState( uint32 stateIndex, int32 blockValue ) const
+{
+	if( m_SolvedType == ET_Sum )
+		return stateIndex >= (uint32)blockValue ? (int32)(stateIndex - (uint32)blockValue) : -1;
+
+	int32 stateValue = m_StateValues[stateIndex];
+	if( (stateValue % blockValue) != 0 )
+		return -1;
+	return FindState( stateValue / blockValue );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::Solve  Private
+///
+///	\param type The type of equation
+///	\param target The sum or product to make
+///	\returns True if the tables were built, false if the target can't be solved by the solver
+///
+///	Build the states for a target and, for each prefix of the blocks that can be in the
+///	equation, the states they reach and the number of combinations that reach each state. The
+///	target is always the last state.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool EquationSolver::Solve( EEquationType type, int32 target )
+{
+	// If this is the last target solved then the tables are still valid
+	if( m_IsSolved && m_SolvedType == type && m_SolvedTarget == target )
+		return m_NumStates > 0;
+
+	m_IsSolved = true;
+	m_SolvedType = type;
+	m_SolvedTarget = target;
+	m_NumStates = 0;
+	m_NumUsedBlocks = 0;
+
+	// Every sum up to the target is a state
+	if( type == ET_Sum )
+	{
+		if( target <= 0 || target >= (int32)MAX_STATES )
+			return false;
+
+		for( int32 sum = 0; sum <= target; ++sum )
+			m_StateValues[ m_NumStates++ ] = sum;
+	}
+	// Every divisor of the target is a state, they are found in pairs below and above the square
+	// root
+	else
+	{
+		if( target <= 1 )
+			return false;
+
+		int32 highDivisors[ MAX_STATES ];
+		uint32 numHighDivisors = 0;
+		for( int32 divisor = 1; divisor * divisor <= target; ++divisor )
+		{
+			if( (target % divisor) != 0 )
+				continue;
+
+			if( m_NumStates + numHighDivisors + 2 > MAX_STATES )
+			{
+				m_NumStates = 0;
+				return false;
+			}
+
+			m_StateValues[ m_NumStates++ ] = divisor;
+			if( divisor * divisor != target )
+				highDivisors[ numHighDivisors++ ] = target / divisor;
+		}
+
+		while( numHighDivisors > 0 )
+			m_StateValues[ m_NumStates++ ] = highDivisors[ --numHighDivisors ];
+	}
+
+	// Only the blocks that divide the product, or fit in the sum, can be in the equation
+	for( uint32 blockIndex = 0; blockIndex < m_NumBlocks; ++blockIndex )
+	{
+		int32 value = m_Values[blockIndex];
+		bool canUse = (type == ET_Sum) ? (value > 0 && value <= target) : (value > 1 && (target % value) == 0);
+		if( canUse )
+			m_UsedBlocks[ m_NumUsedBlocks++ ] = (uint8)blockIndex;
+	}
+
+	// State 0 is reached by the empty equation
+	for( uint32 stateIndex = 0; stateIndex < m_NumStates; ++stateIndex )
+		m_Counts[stateIndex] = 0;
+	m_Counts[0] = 1;
+	m_Reach[0].Clear();
+	m_Reach2[0].Clear();
+
+	for( uint32 usedIndex = 0; usedIndex < m_NumUsedBlocks; ++usedIndex )
+	{
+		int32 value = m_Values[ m_UsedBlocks[usedIndex] ];
+		const StateSet& prevReach = m_Reach[usedIndex];
+		StateSet& reach = m_Reach[usedIndex + 1];
+		StateSet& reach2 = m_Reach2[usedIndex + 1];
+		reach = prevReach;
+		reach2 = m_Reach2[usedIndex];
+
+		// Go from the highest state down so the block is only added once to each combination
+		for( int32 stateIndex = (int32)m_NumStates - 1; stateIndex >= 0; --stateIndex )
+		{
+			if( m_Counts[stateIndex] == 0 )
+				continue;
+
+			int32 nextState = GetNextState( (uint32)stateIndex, value );
+			if( nextState < 0 )
+				continue;
+
+			m_Counts[nextState] += m_Counts[stateIndex];
+
+			reach.Add( (uint32)nextState );
+			if( stateIndex > 0 )
+				reach2.Add( (uint32)nextState );
+		}
+	}
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::CountSolutions  Public
+///
+///	\param type The type of equation
+///	\param target The sum or product to make
+///	\returns The number of combinations of two or more blocks that make the target
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint64 EquationSolver::CountSolutions( EEquationType type, int32 target )
+{
+	if( !Solve( type, target ) )
+		return 0;
+
+	// Take out the blocks that are the target by themselves
+	uint64 numSolutions = m_Counts[ m_NumStates - 1 ];
+	for( uint32 usedIndex = 0; usedIndex < m_NumUsedBlocks; ++usedIndex )
+	{
+		if( m_Values[ m_UsedBlocks[usedIndex] ] == target )
+			numSolutions--;
+	}
+
+	return numSolutions;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::FindSolution  Public
+///
+///	\param type The type of equation
+///	\param target The sum or product to make
+///	\returns The blocks of a combination of two or more blocks that makes the target, 0 if
+///	there is none
+///
+///	Walk back from the target through the reach tables, taking a block whenever the blocks
+///	before it can still complete the equation.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+EquationSolver::BlockMask EquationSolver::FindSolution( EEquationType type, int32 target )
+{
+	if( !Solve( type, target ) )
+		return 0;
+
+	uint32 stateIndex = m_NumStates - 1;
+	if( !m_Reach2[ m_NumUsedBlocks ].Has( stateIndex ) )
+		return 0;
+
+	BlockMask solution = 0;
+	uint32 numTaken = 0;
+	for( uint32 usedIndex = m_NumUsedBlocks; usedIndex > 0; --usedIndex )
+	{
+		uint32 blockIndex = m_UsedBlocks[usedIndex - 1];
+		int32 prevState = GetPrevState( stateIndex, m_Values[blockIndex] );
+
+		// The block can be taken if it finishes an equation of two or more blocks or the blocks
+		// before it can make the rest of the equation
+		bool canTake = false;
+		if( prevState == 0 )
+			canTake = numTaken > 0;
+		else if( prevState > 0 )
+			canTake = m_Reach[usedIndex - 1].Has( (uint32)prevState );
+
+		if( canTake )
+		{
+			solution |= (BlockMask)1 << blockIndex;
+			numTaken++;
+			if( prevState == 0 )
+				return solution;
+
+			stateIndex = (uint32)prevState;
+		}
+	}
+
+	// The reach tables guarantee a solution is found
+	TCASSERTX( false, L"The equation solver did not find a solution it reached." );
+	return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  EquationSolver::CountSolvableTargets  Public
+///
+///	\param type The type of equation
+///	\returns The number of targets that can be made from the blocks
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 EquationSolver::CountSolvableTargets( EEquationType type )
+{
+	bool isSolvable[ MAX_BLOCKS ];
+	uint32 numSolvable = 0;
+	for( uint32 targetIndex = 0; targetIndex < m_NumTargets; ++targetIndex )
+	{
+		int32 target = m_Targets[targetIndex]->GetValue();
+
+		// Many targets share a value so only solve each value once
+		int32 sameIndex = -1;
+		for( uint32 prevIndex = 0; prevIndex < targetIndex; ++prevIndex )
+		{
+			if( m_Targets[prevIndex]->GetValue() == target )
+			{
+				sameIndex = (int32)prevIndex;
+				break;
+			}
+		}
+
+		if( sameIndex >= 0 )
+			isSolvable[targetIndex] = isSolvable[sameIndex];
+		else
+			isSolvable[targetIndex] = CountSolutions( type, target ) > 0;
+
+		if( isSolvable[targetIndex] )
+			numSolvable++;
+	}
+
+	return numSolvable;
+}
@@ -0,0 +1,174 @@
+/*=================================================================================================
+
+	\file Fraction.cpp
+	Game Play Library
+	Fraction Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the fraction arithmetic.
+
+=================================================================================================*/
+
+#include "../Fraction.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Fraction::GetGCD  Static Public
+///
+///	\param lhs The first number
+///	\param rhs The second number
+///	\returns The greatest common divisor, 0 if both numbers are 0
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 Fraction::GetGCD( int32 lhs, int32 rhs )
+{
+	// Work with unsigned values so the most negative number can't overflow
+	uint32 a = lhs < 0 ? (uint32)0 - (uint32)lhs : (uint32)lhs;
+	uint32 b = rhs < 0 ? (uint32)0 - (uint32)rhs : (uint32)rhs;
+	while( b != 0 )
+	{
+		uint32 remainder = a % b;
+		a = b;
+		b = remainder;
+	}
+
+	return (int32)a;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Fraction::GetReduced  Public
+///
+///	\returns The fraction in lowest terms with a positive denominator, a 0 denominator is left
+///	as is
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+Fraction Fraction::GetReduced() const
+{
+	int32 gcd = GetGCD( Numerator, Denominator );
+	if( gcd == 0 || Denominator == 0 )
+		return *this;
+
+	Fraction reduced( Numerator / gcd, Denominator / gcd );
+	if( reduced.Denominator < 0 )
+	{
+		reduced.Numerator = -reduced.Numerator;
+		reduced.Denominator = -reduced.Denominator;
+	}
+
+	return reduced;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Fraction::Compare  Public
+///
+///	\param rhs The fraction to compare to
+///	\returns -1 if this fraction is less than the other, 0 if they are equal, and 1 if this
+///	fraction is greater
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 Fraction::Compare( const Fraction& rhs ) const
+{
+	// Cross multiply with positive denominators so the sign of the result is the comparison
+	int64 lhsNumerator = Denominator < 0 ? -(int64)Numerator : (int64)Numerator;
+	int64 lhsDenominator = Denominator < 0 ? -(int64)Denominator : (int64)Denominator;
+	int64 rhsNumerator = rhs.Denominator < 0 ? -(int64)rhs.Numerator : (int64)rhs.Numerator;
+	int64 rhsDenominator = rhs.Denominator < 0 ? -(int64)rhs.Denominator : (int64)rhs.Denominator;
+
+	int64 lhsValue = lhsNumerator * rhsDenominator;
+	int64 rhsValue = rhsNumerator * lhsDenominator;
+	if( lhsValue < rhsValue )
+		return -1;
+	if( lhsValue > rhsValue )
+		return 1;
+	return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Fraction::IsDecimalWithin  Public
+///
+///	\param numPlaces The number of places after the decimal point
+///	\returns True if the decimal form of the fraction ends within the places, false if it is
+///	longer or repeats
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Fraction::IsDecimalWithin( int32 numPlaces ) const
+{
+	Fraction reduced = GetReduced();
+	if( reduced.Denominator == 0 )
+		return false;
+
+	// The decimal ends if the remainder reaches 0 within the places
+	int64 remainder = (int64)reduced.Numerator % (int64)reduced.Denominator;
+	if( remainder < 0 )
+		remainder = -remainder;
+	for( int32 placeIndex = 0; placeIndex < numPlaces && remainder != 0; ++placeIndex )
+		remainder = (remainder * 10) % (int64)reduced.Denominator;
+
+	return remainder == 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Fraction::GetDecimalText  Public
+///
+///	\param numPlaces The most places after the decimal point
+///	\returns The decimal form of the fraction without trailing zeros, such as 0.25
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::wstring Fraction::GetDecimalText( int32 numPlaces ) const
+{
+	Fraction reduced = GetReduced();
+	if( reduced.Denominator == 0 )
+		return std::wstring();
+
+	int64 numerator = reduced.Numerator;
+	int64 denominator = reduced.Denominator;
+
+	std::wstring sText;
+	if( numerator < 0 )
+	{
+		sText = L"-";
+		numerator = -numerator;
+	}
+
+	// Write the whole part, least significant digit first
+	int64 wholePart = numerator / denominator;
+	std::wstring sWholeDigits;
+	do
+	{
+		sWholeDigits.insert( sWholeDigits.begin(), (wchar_t)(L'0' + (wholePart % 10)) );
+		wholePart /= 10;
+	}while( wholePart > 0 );
+	sText += sWholeDigits;
+
+	// Write the places with long division
+	std::wstring sPlaces;
+	int64 remainder = numerator % denominator;
+	for( int32 placeIndex = 0; placeIndex < numPlaces && remainder != 0; ++placeIndex )
+	{
+		remainder *= 10;
+		sPlaces += (wchar_t)(L'0' + (remainder / denominator));
+		remainder %= denominator;
+	}
+
+	// Trim the trailing zeros
+	while( !sPlaces.empty() && sPlaces[ sPlaces.length() - 1 ] == L'0' )
+		sPlaces.erase( sPlaces.length() - 1 );
+
+	if( !sPlaces.empty() )
+	{
+		sText += L".";
+		sText += sPlaces;
+	}
+
+	return sText;
+}
@@ -1,15 +1,16 @@
 #include "../FractionModeSettings.h"
-#include <stdarg.h>
+#include "../GameDefines.h"
+#include "Base/TCAssert.h"
 #include <set>
-#include <stdlib.h>
+#include <map>
 
-Fraction FractionModeSettings::GetRandomFraction( uint32 fractionIndex ) const
+Fraction FractionModeSettings::GetRandomFraction( uint32 fractionIndex, TCBase::RandomGen& random ) const
 {
 	Fraction simplifiedValue = AvailableFractions[ fractionIndex ].FractionValue;
 
 	int32 maxScalar = MaxValue / simplifiedValue.Denominator;
 
-	int32 scalar = (rand() % maxScalar) + 1;
+	int32 scalar = random.NextInRange( 1, maxScalar );
 
 	return Fraction( simplifiedValue, scalar );
 }
@@ -21,8 +22,16 @@ void FractionModeSettings::InitValuesFromFractions(std::list<Fraction> fractions
 		FractionInfo newInfo;
 
 		newInfo.FractionValue = *iterFraction;
+		newInfo.ReducedValue = iterFraction->GetReduced();
+
+		// Store the decimal text now so it isn't figured out every time a fraction is shown
+		newInfo.HasShortDecimal = newInfo.FractionValue.IsDecimalWithin( DecimalPlaces );
+		if( newInfo.HasShortDecimal )
+			newInfo.DecimalText = newInfo.FractionValue.GetDecimalText( DecimalPlaces );
 
 		// Find all of the multiples for this fraction up to the max value
+		std::set<int32> valuesUpToMax;
+		std::map<int32, uint8> valueScalars;
 		int scalar = 1;
 		for(;;)
 		{
@@ -33,26 +42,46 @@ void FractionModeSettings::InitValuesFromFractions(std::list<Fraction> fractions
 				break;
 
 			// If we already know we're using this value then update the scalar
-			if( newInfo.ValuesUpToMax.find(fractionMultiple.Numerator) != newInfo.ValuesUpToMax.end() )
-				newInfo.ValueScalars[fractionMultiple.Numerator]++;
+			if( valuesUpToMax.find(fractionMultiple.Numerator) != valuesUpToMax.end() )
+				valueScalars[fractionMultiple.Numerator]++;
 			else
 			{
-				newInfo.ValuesUpToMax.insert(fractionMultiple.Numerator);
-				newInfo.ValueScalars[fractionMultiple.Numerator] = 1;
+				valuesUpToMax.insert(fractionMultiple.Numerator);
+				valueScalars[fractionMultiple.Numerator] = 1;
 			}
 
 			// Now for the denominator
-			if( newInfo.ValuesUpToMax.find(fractionMultiple.Denominator) != newInfo.ValuesUpToMax.end() )
-				newInfo.ValueScalars[fractionMultiple.Denominator]++;
+			if( valuesUpToMax.find(fractionMultiple.Denominator) != valuesUpToMax.end() )
+				valueScalars[fractionMultiple.Denominator]++;
 			else
 			{
-				newInfo.ValuesUpToMax.insert(fractionMultiple.Denominator);
-				newInfo.ValueScalars[fractionMultiple.Denominator] = 1;
+				valuesUpToMax.insert(fractionMultiple.Denominator);
+				valueScalars[fractionMultiple.Denominator] = 1;
+			}
+		}
+
+		// Store the values in arrays so they can be picked by index
+		for( std::set<int32>::const_iterator iterValue = valuesUpToMax.begin(); iterValue != valuesUpToMax.end(); ++iterValue )
+		{
+			newInfo.ValuesUpToMax.push_back( *iterValue );
+			newInfo.ValueScalars.push_back( valueScalars[*iterValue] );
+		}
+
+		// Store every pair of values that makes an equivalent fraction
+		for( uint32 numeratorIndex = 0; numeratorIndex < newInfo.ValuesUpToMax.size(); ++numeratorIndex )
+		{
+			for( uint32 denominatorIndex = numeratorIndex + 1; denominatorIndex < newInfo.ValuesUpToMax.size(); ++denominatorIndex )
+			{
+				Fraction valuePair( newInfo.ValuesUpToMax[numeratorIndex], newInfo.ValuesUpToMax[denominatorIndex] );
+				if( valuePair.IsEquivalent( newInfo.FractionValue ) )
+					newInfo.SolutionPairs.push_back( valuePair );
 			}
 		}
 
 		AvailableFractions.push_back( newInfo );
 	}
+
+	TCASSERTX( AvailableFractions.size() <= MAX_FRACTIONS, L"A fraction difficulty has more fractions than the logic can track." );
 }
 
 
@@ -61,4 +90,166 @@ FractionModeSettings::FractionModeSettings( int32 decimalPlaces, int32 exclusive
 	MaxValue( exclusiveMaxValue )
 {
 	InitValuesFromFractions( fractions );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  FractionModeSettings::FindFractionIndex  Public
+///
+///	\param fraction The fraction to find
+///	\returns The index of the first available fraction equivalent to the fraction, -1 if there
+///	is none
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FractionModeSettings::FindFractionIndex( const Fraction& fraction ) const
+{
+	Fraction reduced = fraction.GetReduced();
+	for( uint32 fractionIndex = 0; fractionIndex < AvailableFractions.size(); ++fractionIndex )
+	{
+		const Fraction& curReduced = AvailableFractions[fractionIndex].ReducedValue;
+		if( curReduced.Numerator == reduced.Numerator && curReduced.Denominator == reduced.Denominator )
+			return (int32)fractionIndex;
+	}
+
+	return -1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  FractionModeSettings::GetForDifficulty  Static Public
+///
+///	\param difficulty The gameplay difficulty, which is clamped to the valid difficulties
+///	\returns The settings for the difficulty
+///
+///	Get the settings for a difficulty. The settings for every difficulty are built on the first
+///	call, so this is called before games are run on several threads.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const FractionModeSettings& FractionModeSettings::GetForDifficulty( int32 difficulty )
+{
+	static std::vector<FractionModeSettings> s_FractionModes;
+	if( s_FractionModes.empty() )
+	{
+		s_FractionModes.resize( (int32)GameDefines::GPDL_COUNT );
+		PopulateFractionModes( s_FractionModes );
+	}
+
+	if( difficulty < 0 )
+		difficulty = 0;
+	else if( difficulty >= (int32)s_FractionModes.size() )
+		difficulty = (int32)s_FractionModes.size() - 1;
+
+	return s_FractionModes[ difficulty ];
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  FractionModeSettings::PopulateFractionModes  Static Private
+///
+///	\param modes The settings to fill in, one for each difficulty
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void FractionModeSettings::PopulateFractionModes( std::vector<FractionModeSettings>& modes )
+{
+	int32 minDiffOffset = (int32)GameDefines::GPDL_Pre3;
+
+	for( int32 diffValue = (int32)GameDefines::GPDL_Pre3; diffValue < (int32)GameDefines::GPDL_5; ++diffValue )
+	{
+		std::list<Fraction> fractions;
+		fractions.push_back( Fraction(1,3) );
+
+		int32 maxValue = 9;
+		if( diffValue < (int32)GameDefines::GPDL_3 )
+		{
+			fractions.push_back( Fraction(1,2) );
+		}
+		else
+		{
+			fractions.push_back( Fraction(2,4) );
+		
+			if( diffValue == (int32)GameDefines::GPDL_3 )
+				maxValue = 13;
+			else if( diffValue == (int32)GameDefines::GPDL_4 )
+			{
+				maxValue = 16;
+				fractions.push_back( Fraction(1,4) );
+			}
+		}
+
+		modes[diffValue - minDiffOffset] = FractionModeSettings(1, maxValue, fractions );
+	}
+
+	for( int32 diffValue = (int32)GameDefines::GPDL_5; diffValue < (int32)GameDefines::GPDL_8; ++diffValue )
+	{
+		std::list<Fraction> fractions;
+		fractions.push_back( Fraction(1,5) );
+		fractions.push_back( Fraction(1,6) );
+		fractions.push_back( Fraction(2,6) );
+		fractions.push_back( Fraction(3,6) );
+		fractions.push_back( Fraction(4,6) );
+		fractions.push_back( Fraction(2,8) );
+		fractions.push_back( Fraction(6,9) );
+
+		int32 maxValue = 30;
+
+		if( diffValue >= (int32)GameDefines::GPDL_6 )
+		{
+			maxValue = 36;
+			fractions.push_back( Fraction(6,8) );
+		}
+		
+		// Not an else if because we want to add on to the previous if statement
+		if( diffValue == (int32)GameDefines::GPDL_7 )
+		{
+			maxValue = 41;
+			fractions.push_back( Fraction(5,6) );
+		}
+
+		modes[diffValue - minDiffOffset] = FractionModeSettings(2, maxValue, fractions );
+	}
+
+	for( int32 diffValue = (int32)GameDefines::GPDL_8; diffValue <= (int32)GameDefines::GPDL_Secret2; ++diffValue )
+	{
+		std::list<Fraction> fractions;
+		fractions.push_back( Fraction(1,8) );
+		fractions.push_back( Fraction(3,8) );
+		fractions.push_back( Fraction(5,8) );
+		fractions.push_back( Fraction(7,8) );
+		fractions.push_back( Fraction(1,7) );
+		fractions.push_back( Fraction(2,7) );
+		fractions.push_back( Fraction(3,7) );
+		fractions.push_back( Fraction(4,7) );
+		fractions.push_back( Fraction(6,7) );
+		fractions.push_back( Fraction(1,9) );
+		fractions.push_back( Fraction(2,9) );
+		fractions.push_back( Fraction(4,9) );
+		fractions.push_back( Fraction(5,9) );
+		
+		
+
+		int32 maxValue = 54;
+
+		if( diffValue >= (int32)GameDefines::GPDL_Post8 )
+		{
+			maxValue = 61;
+			fractions.push_back( Fraction(5,7) );
+		}
+
+		if( diffValue >= (int32)GameDefines::GPDL_Secret1 )
+		{
+			maxValue = 110;
+			fractions.push_back( Fraction(7,9) );
+		}
+
+		if( diffValue >= (int32)GameDefines::GPDL_Secret2 )
+		{
+			maxValue = 150;
+			fractions.push_back( Fraction(8,9) );
+		}
+
+		modes[diffValue - minDiffOffset] = FractionModeSettings(3, maxValue, fractions );
+	}	
 }
\ No newline at end of file
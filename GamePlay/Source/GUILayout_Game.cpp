@@ -2153,6 +2153,11 @@ void GUILayoutProfileSelection::Update( float32 frameTime )
 				}
 				else
 				{
+					// Remove the profile's journal along with it
+					std::wstring sJournalFile = PlayerProfile::GetJournalPathFromName( sSelectedProfileName.c_str() );
+					if( TCBase::DoesFileExist( sJournalFile.c_str() ) )
+						TCBase::TCDeleteFile( sJournalFile.c_str() );
+
 					PopulateProfileList();
 
 					// Clear the selection to ensure the rename/delete buttons are hidden
@@ -2211,6 +2216,12 @@ void GUILayoutProfileSelection::Update( float32 frameTime )
 					// Otherwise update the list
 					else
 					{
+						// Move the profile's journal along with it
+						std::wstring sOldJournalFile = PlayerProfile::GetJournalPathFromName( sSelectedProfileName.c_str() );
+						std::wstring sNewJournalFile = PlayerProfile::GetJournalPathFromName( sNewProfileName.c_str() );
+						if( TCBase::DoesFileExist( sOldJournalFile.c_str() ) )
+							TCBase::RenameFile( sOldJournalFile.c_str(), sNewJournalFile.c_str() );
+
 						PopulateProfileList();
 
 						// Select the newly renamed profile
@@ -2239,7 +2250,7 @@ void GUILayoutProfileSelection::Update( float32 frameTime )
 //
 //  GUILayoutProfileSelection::PopulateProfileList  Private
 ///
-///	Populate the profile list with all known profiles.
+///	Populate the profile list with all known profiles, the most recently played first.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GUILayoutProfileSelection::PopulateProfileList()
@@ -2247,11 +2258,11 @@ void GUILayoutProfileSelection::PopulateProfileList()
 	if( !m_pProfileList )
 		return;
 
-	// Get the profiles
+	// Get the profiles from the index so the profiles are not read
 	m_pProfileList->ClearStrings();
-	std::list<std::wstring> profiles = PlayerProfile::GetAllProfileNames();
-	for( std::list<std::wstring>::iterator iterProfile = profiles.begin(); iterProfile != profiles.end(); ++iterProfile )
-		m_pProfileList->AddString( iterProfile->c_str() );
+	std::list<ProfileIndex::Summary> profiles = PlayerProfile::GetAllProfileSummaries();
+	for( std::list<ProfileIndex::Summary>::iterator iterProfile = profiles.begin(); iterProfile != profiles.end(); ++iterProfile )
+		m_pProfileList->AddString( iterProfile->sName.c_str() );
 
 	m_pProfileList->ReformatControl();
 }
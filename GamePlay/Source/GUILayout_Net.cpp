@@ -142,14 +142,8 @@ void GUILayoutMultiplayType::OnActivate()
 	if( m_pHelpLabel )
 		m_pHelpLabel->SetText( L"" );
 
-	// Register the network messages
-	NetworkMgr::Get().RegisterNetMsg( GNMI_GameRunning, NetMsgGameRunning::CreateMsg );
-	NetworkMgr::Get().RegisterNetMsg( GNMI_GameClosed, NetMsgGameClosed::CreateMsg );
-	NetworkMgr::Get().RegisterNetMsg( GNMI_SendMeYourInfo, NetMsgSendMeYourInfo::CreateMsg );
-	NetworkMgr::Get().RegisterNetMsg( GNMI_PlayerInfo, NetMsgPlayerInfo::CreateMsg );
-	NetworkMgr::Get().RegisterNetMsg( GNMI_GameInfo, NetMsgGameInfo::CreateMsg );
-	NetworkMgr::Get().RegisterNetMsg( GNMI_StartGameQuery, NetMsgStartGameQuery::CreateMsg );
-	NetworkMgr::Get().RegisterNetMsg( GNMI_StartGameResponse, NetMsgStartGameResponse::CreateMsg );
+	// The network messages are registered by the application when the network manager is
+	// initialized
 }
 
 
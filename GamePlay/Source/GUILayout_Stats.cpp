@@ -296,9 +296,9 @@ void GUILayoutViewStats::UpdateStats_Main()
 		// Get the number of games played
 		uint32 numGamesPlayed = 0;
 		if( pMultSub )
-			numGamesPlayed += pMultSub->GetNumSessions();
+			numGamesPlayed += pMultSub->GetTotals().numSessions;
 		if( pAddSub )
-			numGamesPlayed += pAddSub->GetNumSessions();
+			numGamesPlayed += pAddSub->GetTotals().numSessions;
 
 		//TODO localize
 		m_pStatNameLabels[0]->SetText( L"Number of games played:" );
@@ -314,27 +314,9 @@ void GUILayoutViewStats::UpdateStats_Main()
 		// Get the total time played
 		float32 fTotalTimePlayedSecs = 0;
 		if( pMultSub )
-		{
-			const GameSessionStatsMult* pCurMultSession = pMultSub->GetFirstSession();
-			while( pCurMultSession )
-			{
-				fTotalTimePlayedSecs += pCurMultSession->m_Duration;
-
-				// Get the next session
-				pCurMultSession = pMultSub->GetNextSession();
-			}
-		}
+			fTotalTimePlayedSecs += pMultSub->GetTotals().duration;
 		if( pAddSub )
-		{
-			const GameSessionStatsAdd* pCurAddSession = pAddSub->GetFirstSession();
-			while( pCurAddSession )
-			{
-				fTotalTimePlayedSecs += pCurAddSession->m_Duration;
-
-				// Get the next session
-				pCurAddSession = pAddSub->GetNextSession();
-			}
-		}
+			fTotalTimePlayedSecs += pAddSub->GetTotals().duration;
 
 		uint32 totalTimePlayedSecs = (uint32)fTotalTimePlayedSecs;
 		const uint32 BUF_SIZE = 32;
@@ -376,6 +358,7 @@ void GUILayoutViewStats::UpdateStats_Mult()
 	ProfileSubsetMultiplication* pMultSub = reinterpret_cast<ProfileSubsetMultiplication*>( pPlayerProfile->GetSubset( ProfileSubsetMultiplication::SUBSET_ID ) );
 	if( !pMultSub )
 		return;
+	const ProfileSubsetMultiplication::Totals& multTotals = pMultSub->GetTotals();
 	uint32 labelIndex = 0;
 
 	// Get the average equation size
@@ -384,20 +367,8 @@ void GUILayoutViewStats::UpdateStats_Mult()
 		//TODO localize
 		m_pStatNameLabels[labelIndex]->SetText( L"Average number of factors per equation:" );
 
-		// Go through the sessions
-		uint32 blockCount = 0;
-		uint32 numClearedEqs = 0;
-		const GameSessionStatsMult* pCurMultSession = pMultSub->GetFirstSession();
-		while( pCurMultSession )
-		{
-			// Add up the blocks used this session and the number of equations cleared
-			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
-				blockCount += pCurMultSession->m_ValidCounts[ primeIndex ];
-			numClearedEqs += pCurMultSession->m_NumEqsCleared;
-
-			// Get the next session
-			pCurMultSession = pMultSub->GetNextSession();
-		}
+		uint32 blockCount = multTotals.GetNumFactorsCleared();
+		uint32 numClearedEqs = multTotals.numEqsCleared;
 
 		// Get the average equation size
 		uint32 avgEqSize = 0;
@@ -414,17 +385,8 @@ void GUILayoutViewStats::UpdateStats_Mult()
 		//TODO localize
 		m_pStatNameLabels[labelIndex]->SetText( L"Average equations per minute:" );
 
-		uint32 numClearedEqs = 0;
-		float32 duration = 0;
-		const GameSessionStatsMult* pCurMultSession = pMultSub->GetFirstSession();
-		while( pCurMultSession )
-		{
-			numClearedEqs += pCurMultSession->m_NumEqsCleared;
-			duration += pCurMultSession->m_Duration;
-
-			// Get the next session
-			pCurMultSession = pMultSub->GetNextSession();
-		}
+		uint32 numClearedEqs = multTotals.numEqsCleared;
+		float32 duration = multTotals.duration;
 
 		// Calculate the value
 		uint32 avgEqsPerMin = 0;
@@ -441,18 +403,8 @@ void GUILayoutViewStats::UpdateStats_Mult()
 		//TODO localize
 		m_pStatNameLabels[labelIndex]->SetText( L"Number of mistakes made:" );
 
-		uint32 numFailedEqs = 0;
-		const GameSessionStatsMult* pCurMultSession = pMultSub->GetFirstSession();
-		while( pCurMultSession )
-		{
-			numFailedEqs += pCurMultSession->m_NumEqsFailed;
-			
-			// Get the next session
-			pCurMultSession = pMultSub->GetNextSession();
-		}
-
 		// Set the text
-		m_pStatValueLabels[labelIndex++]->SetText( TCBase::EasyUIToA(numFailedEqs) );
+		m_pStatValueLabels[labelIndex++]->SetText( TCBase::EasyUIToA(multTotals.numEqsFailed) );
 	}
 }
 
@@ -467,6 +419,7 @@ void GUILayoutViewStats::UpdateStats_Add()
 	ProfileSubsetAddition* pAddSub = reinterpret_cast<ProfileSubsetAddition*>( pPlayerProfile->GetSubset( ProfileSubsetAddition::SUBSET_ID ) );
 	if( !pAddSub )
 		return;
+	const ProfileSubsetAddition::Totals& addTotals = pAddSub->GetTotals();
 	uint32 labelIndex = 0;
 	// Get the average equation size
 	if( m_pStatNameLabels[labelIndex] && m_pStatValueLabels[labelIndex] )
@@ -474,18 +427,8 @@ void GUILayoutViewStats::UpdateStats_Add()
 		//TODO localize
 		m_pStatNameLabels[labelIndex]->SetText( L"Average sum size:" );
 
-		// Go through the sessions
-		uint32 numClearedEqs = 0;
-		uint32 numSummandsEqs = 0;
-		const GameSessionStatsAdd* pCurAddSession = pAddSub->GetFirstSession();
-		while( pCurAddSession )
-		{
-			numClearedEqs += pCurAddSession->m_NumEqsCleared;
-			numSummandsEqs += pCurAddSession->m_SummandsCleared;
-
-			// Get the next session
-			pCurAddSession = pAddSub->GetNextSession();
-		}
+		uint32 numClearedEqs = addTotals.numEqsCleared;
+		uint32 numSummandsEqs = addTotals.summandsCleared;
 
 		// Get the average equation size
 		uint32 avgEqSize = 0;
@@ -502,18 +445,8 @@ void GUILayoutViewStats::UpdateStats_Add()
 		//TODO localize
 		m_pStatNameLabels[labelIndex]->SetText( L"Mistakes made:" );
 
-		uint32 numInvalidEqs = 0;
-		const GameSessionStatsAdd* pCurAddSession = pAddSub->GetFirstSession();
-		while( pCurAddSession )
-		{
-			numInvalidEqs += pCurAddSession->m_NumEqsFailed;
-
-			// Get the next session
-			pCurAddSession = pAddSub->GetNextSession();
-		}
-
 		// Set the text
-		m_pStatValueLabels[labelIndex++]->SetText( TCBase::EasyUIToA(numInvalidEqs) );
+		m_pStatValueLabels[labelIndex++]->SetText( TCBase::EasyUIToA(addTotals.numEqsFailed) );
 	}
 
 	// Display the most number of sums cleared in 5 minutes
@@ -523,22 +456,8 @@ void GUILayoutViewStats::UpdateStats_Add()
 		//TODO 5 minutes? Should be 3, I guess...
 		m_pStatNameLabels[labelIndex]->SetText( L"Most sums cleared in 5 minutes:" );
 
-		uint32 maxCleared = 0;
-		const GameSessionStatsAdd* pCurAddSession = pAddSub->GetFirstSession();
-		while( pCurAddSession )
-		{
-			if( pCurAddSession->m_TimeLimit == 5 * 60 )
-			{
-				if( pCurAddSession->m_NumEqsCleared > maxCleared )
-					maxCleared = pCurAddSession->m_NumEqsCleared;
-			}
-
-			// Get the next session
-			pCurAddSession = pAddSub->GetNextSession();
-		}
-
 		// Set the text
-		m_pStatValueLabels[labelIndex++]->SetText( TCBase::EasyUIToA(maxCleared) );
+		m_pStatValueLabels[labelIndex++]->SetText( TCBase::EasyUIToA(addTotals.mostClearedIn5Mins) );
 	}
 }
 
@@ -0,0 +1,71 @@
+/*=================================================================================================
+
+	\file GameContext.cpp
+	Game Play Library
+	Game Context Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the game context class.
+
+=================================================================================================*/
+
+#include "../GameContext.h"
+
+#ifdef WIN32
+#define THREAD_LOCAL __declspec( thread )
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+
+/// The context bound to each thread
+static THREAD_LOCAL GameContext* s_pCurContext = 0;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameContext::GameContext  Public
+///
+///	The default constructor.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GameContext::GameContext() : m_BlockPool( L"game field block" ),
+								m_InstructionPool( L"game field instruction" )
+{
+	m_GameMgr.SetHeadless( true );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameContext::~GameContext  Public
+///
+///	The destructor. The game is freed with the context bound so its blocks and instructions are
+///	returned to the context's pools, then the pools' pages are returned to the heap.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GameContext::~GameContext()
+{
+	{
+		Scope scope( *this );
+		m_GameMgr.Clear();
+	}
+
+	m_BlockPool.ReleasePages();
+	m_InstructionPool.ReleasePages();
+}
+
+
+/// Get the context bound to the calling thread
+GameContext* GameContext::GetCurrent()
+{
+	return s_pCurContext;
+}
+
+
+/// Bind a context to the calling thread
+void GameContext::SetCurrent( GameContext* pContext )
+{
+	s_pCurContext = pContext;
+}
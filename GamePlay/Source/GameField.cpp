@@ -19,9 +19,11 @@
 #include "Base/MsgLogger.h"
 #include "Base/TCAssert.h"
 #include "Base/NumFuncs.h"
+#include "Base/ProfileTimer.h"
 #include <math.h>
 #include "Graphics2D/GraphicsDefines.h"
 #include "../GameMgr.h"
+#include "../GameContext.h"
 #include "../GameLogic.h"
 #include "Audio/AudioMgr.h"
 #include "../PIIToggleBlockSelect.h"
@@ -30,9 +32,32 @@
 #include "../InstructionStreamPlay.h"
 #include "../InstructionStreamReplay.h"
 #include "Base/FileFuncs.h"
+#include "Base/Serializer.h"
 #include <fstream>
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldBlock::GetPool  Static Public
+///
+///	\returns The pool that game field blocks are allocated from
+///
+///	Get the block pool, the pool of the game context bound to the calling thread if there is one.
+///	The process wide pool is a function static so it exists before the first block is created,
+///	and the pool has no destructor so blocks freed during shutdown are still safe.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+TCBase::SmallObjectPool& GameFieldBlock::GetPool()
+{
+	GameContext* pContext = GameContext::GetCurrent();
+	if( pContext )
+		return pContext->GetBlockPool();
+
+	static TCBase::SmallObjectPool s_BlockPool( L"game field block" );
+	return s_BlockPool;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  GameField::IsBlockSelected  Private
@@ -46,6 +71,16 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool GameField::IsBlockSelected( GameFieldBlock* pBlock, BlockList::const_iterator* pSaveBlockIter ) const
 {
+	// The selection's bit set answers the test, the list only needs searching for the iterator
+	if( !m_SelBlocks.ContainsBlock( pBlock ) )
+	{
+		if( pSaveBlockIter )
+			*pSaveBlockIter = m_SelBlocks.end();
+		return false;
+	}
+	if( !pSaveBlockIter )
+		return true;
+
 	// Go through the currently selected blocks
 	for( BlockList::const_iterator iterBlock = m_SelBlocks.begin(); iterBlock != m_SelBlocks.end(); ++iterBlock )
 	{
@@ -71,6 +106,16 @@ bool GameField::IsBlockSelected( GameFieldBlock* pBlock, BlockList::const_iterat
 
 bool GameField::IsBlockSelected( GameFieldBlock* pBlock, BlockList::iterator* pSaveBlockIter )
 {
+	// The selection's bit set answers the test, the list only needs searching for the iterator
+	if( !m_SelBlocks.ContainsBlock( pBlock ) )
+	{
+		if( pSaveBlockIter )
+			*pSaveBlockIter = m_SelBlocks.end();
+		return false;
+	}
+	if( !pSaveBlockIter )
+		return true;
+
 	// Go through the currently selected blocks
 	for( BlockList::iterator iterBlock = m_SelBlocks.begin(); iterBlock != m_SelBlocks.end(); ++iterBlock )
 	{
@@ -108,21 +153,19 @@ bool GameField::Init()
 	if( m_pInstStream )
 		delete m_pInstStream;
 
-	//if( TCBase::DoesFileExist( L"c:\\TestGame.dat" ) )
-	//{
-	//	m_pInstStream = new InstructionStreamReplay();
-
-	//	std::ifstream inFile( L"c:\\TestGame.dat", std::ios_base::in | std::ios_base::binary );
-	//	Serializer serializer( &inFile );
-	//	((InstructionStreamReplay*)m_pInstStream)->Init( serializer );
-
-	//	inFile.close();
-	//	//_wremove( L"c:\\TestGame.dat" );
-	//}
-	//else
+	// If the game is a replay then play the recorded instructions
+	const std::wstring& sReplayFile = GameMgr::Get().GetReplayFile();
+	if( !sReplayFile.empty() )
+	{
+		InstructionStreamReplay* pReplayStream = new InstructionStreamReplay();
+		if( !pReplayStream->Init( sReplayFile.c_str() ) )
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to load replay %s, the game will have no input.", sReplayFile.c_str() );
+		m_pInstStream = pReplayStream;
+	}
+	else
 	{
 		m_pInstStream = new InstructionStreamPlay();
-		((InstructionStreamPlay*)m_pInstStream)->Init( false );
+		((InstructionStreamPlay*)m_pInstStream)->Init( GameMgr::Get().GetReplayDir() );
 	}
 
 	m_pInstStream->m_pGameField = this;
@@ -169,9 +212,14 @@ void GameField::SendInstruction( GameFieldInstruction* pInstruction )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameField::Update( float frameTime )
 {
+	PROFILE_SCOPE( "GameField::Update" );
+
 	if( GameMgr::Get().IsPaused() )
 		return;
 
+	// Keep where the blocks were so drawing can blend toward where they end up
+	StorePrevPositions();
+
 	// Update the block selection sprite animation
 	m_SelBracketSprite.Update( frameTime );
 	m_WideSelBracketSprite.Update( frameTime );
@@ -203,6 +251,66 @@ void GameField::Update( float frameTime )
 
 	// Allow derived classes to update
 	SubclassUpdate( frameTime );
+
+	// The field's state is complete for this tick
+	m_pInstStream->PostUpdate();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameField::SerializeState  Public
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the field doesn't support state
+///				snapshots or the data is invalid
+///
+///	Save/load the complete state of the field so a replay can jump to the point the state was
+///	saved at. Loading clears the field first and the blocks are selected last since the derived
+///	classes create the blocks.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameField::SerializeState( Serializer& serializer )
+{
+	if( serializer.InReadMode() )
+		ClearField();
+
+	serializer.AddData( m_FieldElapsedTime );
+	serializer.AddData( m_LowestY );
+	m_BlockIDs.SerializeState( serializer );
+
+	if( !SubclassSerializeState( serializer ) )
+		return false;
+
+	// The selected blocks by ID, in the order they were selected
+	uint32 numSelBlocks = (uint32)m_SelBlocks.size();
+	serializer.AddData( numSelBlocks );
+	if( serializer.InReadMode() )
+	{
+		for( uint32 selIndex = 0; selIndex < numSelBlocks; ++selIndex )
+		{
+			uint32 blockID = 0;
+			serializer.AddData( blockID );
+
+			GameFieldBlock* pBlock = m_BlockIDs.Find( blockID );
+			if( !pBlock )
+			{
+				MSG_LOGGER_OUT( MsgLogger::MI_Error, L"A game state snapshot selects a block that is not on the field." );
+				return false;
+			}
+			m_SelBlocks.push_back( pBlock );
+		}
+	}
+	else
+	{
+		for( BlockList::iterator iterBlock = m_SelBlocks.begin(); iterBlock != m_SelBlocks.end(); ++iterBlock )
+		{
+			uint32 blockID = (*iterBlock)->GetID();
+			serializer.AddData( blockID );
+		}
+	}
+
+	return true;
 }
 
 
@@ -249,10 +357,7 @@ bool GameField::HandleInstruction( GameFieldInstruction* pInstruction )
 					++iterBlockID )
 			{
 				// Get the block that was clicked on
-				if( m_BlockIDMap.find( *iterBlockID ) == m_BlockIDMap.end() )
-					continue;
-
-				GameFieldBlock* pRemoveBlock = (GameFieldBlock*)m_BlockIDMap[ *iterBlockID ];
+				GameFieldBlock* pRemoveBlock = m_BlockIDs.Find( *iterBlockID );
 				if( !pRemoveBlock )
 					continue;
 
@@ -325,9 +430,7 @@ void GameField::ClickAtPoint( const Point2i& cursorPos, GUIDefines::EMouseButton
 void GameField::Update_HandleClick( PIIToggleBlockSelect* pInstruction )
 {
 	// Get the block that was clicked on
-	if( m_BlockIDMap.find( pInstruction->GetBlockID() ) == m_BlockIDMap.end() )
-		return;
-	GameFieldBlock* pClickBlock = (GameFieldBlock*)m_BlockIDMap[ pInstruction->GetBlockID() ];
+	GameFieldBlock* pClickBlock = m_BlockIDs.Find( pInstruction->GetBlockID() );
 	if( !pClickBlock )
 		return;
 
@@ -383,7 +486,8 @@ void GameField::Update_HandleClick( PIIToggleBlockSelect* pInstruction )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 BlockList GameField::GetBlocksInRectangle( const Box2i& box )
 {
-	BlockList retList;
+	// Use a selection so testing if a block was already found does not search the list
+	BlockSelection retList;
 
 	for( int curX = box.Left(); curX <= box.Right(); curX += GameDefines::BLOCK_WIDTH )
 	{
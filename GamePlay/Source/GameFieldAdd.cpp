@@ -17,6 +17,7 @@
 #include "../GameMgr.h"
 #include "../GameLogicAdd.h"
 #include "Base/TCAssert.h"
+#include "Base/ProfileTimer.h"
 #include "../GFISetSum.h"
 #include "../GFIAddSummands.h"
 #include "GUI/GUIMgr.h"
@@ -77,6 +78,8 @@ bool GameFieldAdd::IsGameOver() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldAdd::SubclassUpdate( float frameTime )
 {
+	PROFILE_SCOPE( "GameFieldAdd::SubclassUpdate" );
+
 	// Go through the columns that need updating
 	const float32 fallAccel = GRAVITY_ACCEL * frameTime;
 	for( int32 halfIndex = 0; halfIndex < 2; ++halfIndex )
@@ -142,7 +145,7 @@ bool GameFieldAdd::HandleInstruction( GameFieldInstruction* pInstruction )
 				iterSummand != pAddInst->m_SummandValues.end();
 				++iterSummand )
 			{
-				GameFieldBlockAdd* pNewBlock = new GameFieldBlockAdd( m_NextBlockID++, *iterSummand );
+				GameFieldBlockAdd* pNewBlock = new GameFieldBlockAdd( *iterSummand );
 				newBlocks.push_back( pNewBlock );
 			}
 
@@ -170,8 +173,8 @@ void GameFieldAdd::RemoveBlock( GameFieldBlock* pRemBlock )
 	if( !pRemBlock )
 		return;
 
-	// Remove the block from the ID map
-	m_BlockIDMap.erase( pRemBlock->GetID() );
+	// Remove the block from the ID table
+	RemoveBlockID( pRemBlock );
 
 	// If the block is selected then remove it from the selected list
 	BlockList::iterator iterSelBlock;
@@ -605,6 +608,9 @@ void GameFieldAdd::Draw() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldAdd::ClearField()
 {
+	// Clear the selection before the blocks are freed
+	m_SelBlocks.clear();
+
 	// Go through the blocks
 	for( int32 halfIndex = 0; halfIndex < 2; ++halfIndex )
 	{
@@ -623,10 +629,10 @@ void GameFieldAdd::ClearField()
 	}
 
 	// Clear the remaining data
-	m_SelBlocks.clear();
 	if( m_pSumBlock )
 		delete m_pSumBlock;
 	m_pSumBlock = 0;
+	m_BlockIDs.Clear();
 }
 
 
@@ -639,7 +645,7 @@ void GameFieldAdd::ClearField()
 void GameFieldAdd::SetSumBlock( int32 sumValue )
 {
 	// Create the new sum block
-	GameFieldBlockAdd* pBlock = new GameFieldBlockAdd( m_NextBlockID++, sumValue, true );
+	GameFieldBlockAdd* pBlock = new GameFieldBlockAdd( sumValue, true );
 
 	// Remove the current sum block, if any
 	if( m_pSumBlock )
@@ -647,7 +653,7 @@ void GameFieldAdd::SetSumBlock( int32 sumValue )
 
 	// Store the new block
 	m_pSumBlock = pBlock;
-	m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(m_pSumBlock->GetID(),m_pSumBlock) );
+	AddBlockID( m_pSumBlock );
 }
 
 
@@ -706,8 +712,8 @@ void GameFieldAdd::AddBlocks( const AddBlockList& blocks )
 				m_UpdateCols[ colIndex ] = true;
 				++m_NumBlocks;
 
-				// Store the block in the ID map
-				m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(pNewBlock->GetID(),pNewBlock) );
+				// Store the block in the ID table
+				AddBlockID( pNewBlock );
 
 				// Step to the next block
 				++iterBlock;
@@ -35,7 +35,7 @@ float32 GameFieldCeiling::GetColumnOffsets(int32 offsets[]) const
 
 		// Get the top block for this column that is not falling
 		GameFieldBlockProduct* pTopBlock = NULL;
-		for( MultBlockList::const_reverse_iterator iterBlock = m_Cols[columnIndex].rbegin(); iterBlock != m_Cols[columnIndex].rend(); ++iterBlock )
+		for( MultBlockColumn::const_reverse_iterator iterBlock = m_Cols[columnIndex].rbegin(); iterBlock != m_Cols[columnIndex].rend(); ++iterBlock )
 		{
 			GameFieldBlockProduct* pCurBlock = static_cast<GameFieldBlockProduct*>(*iterBlock);
 			if( pCurBlock->isFalling )
@@ -194,6 +194,36 @@ void GameFieldCeiling::SetOffsets( int32 offsets[FIELD_WIDTH] )
 	 _lowestBlockBottom = (float32)( m_FieldBox.size.y - (maxOffset * GameDefines::BLOCK_HEIGHT) );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldCeiling::SubclassSerializeState  Private
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the data is invalid
+///
+///	Save/load the field's blocks and the ceiling offsets for a game state snapshot.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameFieldCeiling::SubclassSerializeState( Serializer& serializer )
+{
+	if( !GameFieldMultBase::SubclassSerializeState( serializer ) )
+		return false;
+
+	int32 offsets[FIELD_WIDTH];
+	for( int32 colIndex = 0; colIndex < FIELD_WIDTH; ++colIndex )
+	{
+		offsets[colIndex] = m_CeilingOffset[colIndex];
+		serializer.AddData( offsets[colIndex] );
+	}
+
+	// Set the offsets through SetOffsets so the lowest ceiling is updated
+	if( serializer.InReadMode() )
+		SetOffsets( offsets );
+
+	serializer.AddData( m_IsVictory );
+	return true;
+}
+
 /// Initialize the field
 bool GameFieldCeiling::Init()
 {
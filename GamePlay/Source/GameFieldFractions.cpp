@@ -77,9 +77,9 @@ bool GameFieldFractions::Init()
 	pNumeratorPlaceholderBlock = new GameFieldBlockMultBase( 1 );
 	pDenominatorPlaceholderBlock = new GameFieldBlockMultBase( 1 );
 
-	// Add the placeholder blocks to the ID map
-	m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(pNumeratorPlaceholderBlock->GetID(),pNumeratorPlaceholderBlock) );
-	m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(pDenominatorPlaceholderBlock->GetID(),pDenominatorPlaceholderBlock) );
+	// Add the placeholder blocks to the ID table
+	AddBlockID( pNumeratorPlaceholderBlock );
+	AddBlockID( pDenominatorPlaceholderBlock );
 
 	return GameFieldMultBase::Init();
 }
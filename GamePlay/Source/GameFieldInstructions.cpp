@@ -7,6 +7,20 @@
 #include "../PIIClearSelection.h"
 #include "../PIISetPushSpeed.h"
 #include "../GFISetSum.h"
+#include "../GameContext.h"
+
+/// Get the pool that instructions are allocated from, the pool of the game context bound to the
+/// calling thread if there is one. The process wide pool is a function static so it exists
+/// before the first instruction is created.
+TCBase::SmallObjectPool& GameFieldInstruction::GetPool()
+{
+	GameContext* pContext = GameContext::GetCurrent();
+	if( pContext )
+		return pContext->GetInstructionPool();
+
+	static TCBase::SmallObjectPool s_InstructionPool( L"game field instruction" );
+	return s_InstructionPool;
+}
 
 GameFieldInstruction* GameFieldInstruction::CreateInstruction( EGameFieldInstruction instTypeID )
 {
@@ -80,7 +94,7 @@ void GFIRemoveBlocks::SubclassSerialize( Serializer& serializer )
 	{
 		m_RemovedBlockIDs.clear();
 		uint32 blockID = 0;
-		for( int blockIndex = 0; blockIndex < numBlocks; ++numBlocks )
+		for( int blockIndex = 0; blockIndex < numBlocks; ++blockIndex )
 		{
 			serializer.AddData( blockID );
 
@@ -92,35 +106,32 @@ void GFIRemoveBlocks::SubclassSerialize( Serializer& serializer )
 /// Serialize the instruction to a memory stream
 void GFIAddSummands::SubclassSerialize( Serializer& serializer )
 {
-	serializer.AddListData( m_SummandValues );
-
-	//// Write the number of blocks
-	//int numBlocks = (int)m_SummandValues.size();
-	//serializer.AddData( numBlocks );
-
-	//// If this instruction is being written out
-	//if( serializer.InWriteMode() )
-	//{
-	//	// Go through the removed blocks
-	//	for( std::list<int32>::iterator iterSummandValue = m_SummandValues.begin();
-	//			iterSummandValue != m_SummandValues.end();
-	//			++iterSummandValue )
-	//	{
-	//		int32 blockID = *iterSummandValue;
-	//		serializer.AddData( blockID );
-	//	}
-	//}
-	//// Else read the summand values
-	//else
-	//{
-	//	m_SummandValues.clear();
-	//	int32 summandValue = 0;
-	//	
-	//	for( int32 blockIndex = 0; blockIndex < numBlocks; ++numBlocks )
-	//	{
-	//		serializer.AddData( summandValue );
-
-	//		m_SummandValues.push_back( summandValue );
-	//	}
-	//}
+	// Write the number of summands, each value is serialized on its own so a packed serializer
+	// can pack them
+	uint32 numSummands = (uint32)m_SummandValues.size();
+	serializer.AddData( numSummands );
+
+	// If this instruction is being written out
+	if( serializer.InWriteMode() )
+	{
+		for( std::list<int32>::iterator iterSummandValue = m_SummandValues.begin();
+				iterSummandValue != m_SummandValues.end();
+				++iterSummandValue )
+		{
+			int32 summandValue = *iterSummandValue;
+			serializer.AddData( summandValue );
+		}
+	}
+	// Else read the summand values
+	else
+	{
+		m_SummandValues.clear();
+		int32 summandValue = 0;
+		for( uint32 summandIndex = 0; summandIndex < numSummands; ++summandIndex )
+		{
+			serializer.AddData( summandValue );
+
+			m_SummandValues.push_back( summandValue );
+		}
+	}
 }
\ No newline at end of file
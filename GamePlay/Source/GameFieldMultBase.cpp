@@ -19,16 +19,22 @@
 #include "Base/MsgLogger.h"
 #include "Base/TCAssert.h"
 #include "Base/NumFuncs.h"
+#include "Base/ProfileTimer.h"
 #include <math.h>
 #include "Graphics2D/GraphicsDefines.h"
 #include "../GameFieldBlockMultBase.h"
 #include "../GameFieldBlockProduct.h"
+#include "../GameFieldBlockFraction.h"
 #include "../GameMgr.h"
 #include "../GameLogic.h"
 #include "../PIISetPushSpeed.h"
+#include "../BlockFaceCache.h"
 
 const float32 GRAVITY_ACCEL = 700.0f;
 
+/// The most block faces rendered into the face cache each frame
+const uint32 FACES_RENDERED_PER_FRAME = 16;
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -108,6 +114,7 @@ void GameFieldMultBase::DropNewBlock( GameFieldBlockMultBase* pNewBlock )
 
 	// Set the block's data
 	pNewBlock->yPos = (float32)m_FieldBox.size.y;
+	pNewBlock->prevYPos = pNewBlock->yPos;
 	pNewBlock->yFallingSpeed = 0.0f;
 	pNewBlock->isFalling = true;
 
@@ -124,12 +131,12 @@ void GameFieldMultBase::DropNewBlock( GameFieldBlockMultBase* pNewBlock )
 	// Add it to the unique list
 	m_ActiveBlocks.push_back( pNewBlock );
 
-	// Store the block in the ID map
-	m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(pNewBlock->GetID(),pNewBlock) );
+	// Store the block in the ID table
+	AddBlockID( pNewBlock );
 
 	// Add the block to each column it is in.
 	for( int colIndex = pNewBlock->colIndex; colIndex < endColIndex; ++colIndex )
-		m_Cols[colIndex].push_back( pNewBlock );
+		AddBlockToCol( pNewBlock, colIndex, false );
 }
 
 
@@ -157,19 +164,22 @@ void GameFieldMultBase::DropNewBlocks( GameFieldBlockMultBase** ppNewBlocks )
 		
 		// Set the block's data
 		pCurBlock->yPos = (float32)m_FieldBox.size.y;
+		pCurBlock->prevYPos = pCurBlock->yPos;
 		pCurBlock->yFallingSpeed = 0.0f;
 		pCurBlock->isFalling = true;
 
 		// Add it to the unique list
 		m_ActiveBlocks.push_back( pCurBlock );
 
-		// Store the block in the ID map
-		m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(pCurBlock->GetID(),pCurBlock) );
+		// Store the block in the ID table
+		AddBlockID( pCurBlock );
 
-		// Add the block to each column it is in
+		// Add the block to each column it is in, the column slots are relative to the block's
+		// column so it must match where it is placed
+		TCASSERT( pCurBlock->colIndex == colIndex );
 		int32 endColIndex = colIndex + pCurBlock->size.x;
 		for( int curColIndex = colIndex; curColIndex < endColIndex; ++curColIndex )
-			m_Cols[curColIndex].push_back( pCurBlock );
+			AddBlockToCol( pCurBlock, curColIndex, false );
 
 		// Advance the column index
 		colIndex += pCurBlock->size.x;
@@ -230,18 +240,19 @@ void GameFieldMultBase::PushNewBlocks( GameFieldBlockMultBase** ppNewBlocks )
 
 		// Set the block's data
 		pCurBlock->yPos = newRowYPos;
+		pCurBlock->prevYPos = newRowYPos;
 		pCurBlock->yFallingSpeed = 0.0f;
 		pCurBlock->isFalling = false;
 
 		// Add the block to the active list
 		m_ActiveBlocks.push_back( (GameFieldBlockMultBase*)pCurBlock );
 
-		// Store the block in the ID map
-		m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(pCurBlock->GetID(),pCurBlock) );
+		// Store the block in the ID table
+		AddBlockID( pCurBlock );
 
 		// Add the block to the columns it is in
 		for( int colIndex = 0; colIndex < pCurBlock->size.x; ++colIndex )
-			m_Cols[ pCurBlock->colIndex + colIndex ].push_front( pCurBlock );
+			AddBlockToCol( pCurBlock, pCurBlock->colIndex + colIndex, true );
 	}
 }
 
@@ -267,21 +278,23 @@ GameFieldBlock* GameFieldMultBase::GetBlockAtPos( const Point2i& fieldPos )
 	if( clickedColIndex < 0 || clickedColIndex >= FIELD_WIDTH )
 		return NULL;
 
-	// Get the column list
-	MultBlockList& blockCol = m_Cols[ clickedColIndex ];
+	// Get the column array
+	const MultBlockColumn& blockCol = m_Cols[ clickedColIndex ];
 
 	// Go through blocks
 	float32 floatMouseY = (float32)fieldPos.y;
-	for( MultBlockList::iterator iterBlock = blockCol.begin(); iterBlock != blockCol.end(); ++iterBlock )
+	for( uint32 slotIndex = 0; slotIndex < blockCol.size(); ++slotIndex )
 	{
+		GameFieldBlockMultBase* pCurBlock = blockCol[ slotIndex ];
+
 		// If the block's bottom is above the mouse then no need to continue checking
-		if( (*iterBlock)->yPos > floatMouseY )
+		if( pCurBlock->yPos > floatMouseY )
 			return NULL;
 
 		// If the top of the box is above the mouse then the mouse is in the box
-		float32 blockTopY = ((*iterBlock)->yPos + (GameDefines::BLOCK_HEIGHT * (*iterBlock)->size.y));
+		float32 blockTopY = (pCurBlock->yPos + (GameDefines::BLOCK_HEIGHT * pCurBlock->size.y));
 		if( blockTopY > floatMouseY )
-			return *iterBlock;
+			return pCurBlock;
 	}
 
 	// There was no block at this position
@@ -304,32 +317,97 @@ GameFieldMultBase::~GameFieldMultBase()
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
-//  GameFieldMultBase::FindBlockInCol  Private
+//  GameFieldMultBase::FindBlockInCol  Public
 ///
 ///	\param pBlock The block that is to be found
-///	\param blockCol The column block list to search within
-///	\returns An iterator of the block in the list or the column list end iterator if the block
-///				could not be found in the column.
+///	\param colIndex The index of the column to search within
+///	\returns The index of the block in the column array or -1 if the block could not be found in
+///				the column.
 ///
-///	Get the iterator of a block within a column.  This function must be used with care as
-///	iterators can become invalid if list contents change.
+///	Get the index of a block within a column.  The block stores its own index so this does not
+///	need to search the column.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-MultBlockList::iterator GameFieldMultBase::FindBlockInCol( GameFieldBlockMultBase* pBlock, MultBlockList& blockCol )
+int32 GameFieldMultBase::FindBlockInCol( const GameFieldBlockMultBase* pBlock, int32 colIndex ) const
 {
-	if( !pBlock )
-		return blockCol.end();
-	
-	// Go through the blocks in this column
-	for( MultBlockList::iterator iterBlock = blockCol.begin(); iterBlock != blockCol.end(); ++iterBlock )
+	if( !pBlock || colIndex < pBlock->colIndex || colIndex >= pBlock->colIndex + pBlock->size.x )
+		return -1;
+
+	// Make sure the stored index is still correct
+	int32 slotIndex = pBlock->colSlots[ colIndex - pBlock->colIndex ];
+	const MultBlockColumn& blockCol = m_Cols[ colIndex ];
+	if( slotIndex < 0 || slotIndex >= (int32)blockCol.size() || blockCol[ slotIndex ] != pBlock )
+		return -1;
+
+	return slotIndex;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::AddBlockToCol  Private
+///
+///	\param pBlock The block to add
+///	\param colIndex The index of the column to add the block to
+///	\param atBottom True to add the block below the column's blocks, false to add it on top
+///
+///	Add a block to a column and store its index in the column.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameFieldMultBase::AddBlockToCol( GameFieldBlockMultBase* pBlock, int32 colIndex, bool atBottom )
+{
+	MultBlockColumn& blockCol = m_Cols[ colIndex ];
+
+	// Blocks added to the bottom shift every block in the column up a slot
+	if( atBottom )
 	{
-		// If this is our block
-		if( *iterBlock == pBlock )
-			return iterBlock;
+		blockCol.insert( blockCol.begin(), pBlock );
+		UpdateColSlots( colIndex, 0 );
 	}
+	else
+	{
+		blockCol.push_back( pBlock );
+		pBlock->colSlots[ colIndex - pBlock->colIndex ] = (int32)blockCol.size() - 1;
+	}
+}
+
 
-	// There was no block so return the end iterator
-	return blockCol.end();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::RemoveBlockFromCol  Private
+///
+///	\param colIndex The index of the column to remove the block from
+///	\param slotIndex The index of the block within the column
+///
+///	Remove a block from a column and update the index of the blocks above it.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameFieldMultBase::RemoveBlockFromCol( int32 colIndex, int32 slotIndex )
+{
+	MultBlockColumn& blockCol = m_Cols[ colIndex ];
+	blockCol.erase( blockCol.begin() + slotIndex );
+	UpdateColSlots( colIndex, slotIndex );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::UpdateColSlots  Private
+///
+///	\param colIndex The index of the column to update
+///	\param startSlotIndex The index of the first block in the column to update
+///
+///	Store the index of each block within a column after blocks were added or removed below them.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameFieldMultBase::UpdateColSlots( int32 colIndex, int32 startSlotIndex )
+{
+	MultBlockColumn& blockCol = m_Cols[ colIndex ];
+	for( int32 slotIndex = startSlotIndex; slotIndex < (int32)blockCol.size(); ++slotIndex )
+	{
+		GameFieldBlockMultBase* pCurBlock = blockCol[ slotIndex ];
+		pCurBlock->colSlots[ colIndex - pCurBlock->colIndex ] = slotIndex;
+	}
 }
 
 
@@ -352,24 +430,20 @@ void GameFieldMultBase::Recurse_UpdateFalling( GameFieldBlockMultBase* pBlock )
 	bool existsSupportingBlock = false;
 	for( int32 colIndex = pBlock->colIndex; colIndex < pBlock->colIndex + pBlock->size.x; ++colIndex )
 	{
-		MultBlockList& curCol = m_Cols[ colIndex ];
-
 		// Find the block in this column
-		MultBlockList::iterator iterBlock = FindBlockInCol( pBlock, curCol );
-		if( iterBlock == curCol.end() )
+		int32 slotIndex = FindBlockInCol( pBlock, colIndex );
+		if( slotIndex < 0 )
 		{
 			MsgLogger::Get().Output( MsgLogger::MI_Error, L"Block not found in column list that it intersects." );
 			continue;
 		}
 
 		// If there is no block below this one
-		if( iterBlock == curCol.begin() )
+		if( slotIndex == 0 )
 			continue;
 
 		// Get the block below this one
-		MultBlockList::iterator belowBlock = iterBlock;
-		--belowBlock;
-		GameFieldBlockMultBase* pBelowBlock = *belowBlock;
+		GameFieldBlockMultBase* pBelowBlock = m_Cols[ colIndex ][ slotIndex - 1 ];
 
 		// If this block is falling then it can't support this block
 		if( pBelowBlock->isFalling )
@@ -403,24 +477,24 @@ void GameFieldMultBase::Recurse_UpdateFalling( GameFieldBlockMultBase* pBlock )
 	float32 thisBlockTopY = pBlock->yPos + (float32)(pBlock->size.y * GameDefines::BLOCK_HEIGHT);
 	for( int32 colIndex = pBlock->colIndex; colIndex < pBlock->colIndex + pBlock->size.x; ++colIndex )
 	{
-		MultBlockList& curCol = m_Cols[ colIndex ];
+		const MultBlockColumn& curCol = m_Cols[ colIndex ];
 
 		// Find the block in this column
-		MultBlockList::iterator iterBlock = FindBlockInCol( pBlock, curCol );
-		if( iterBlock == curCol.end() )
+		int32 slotIndex = FindBlockInCol( pBlock, colIndex );
+		if( slotIndex < 0 )
 			continue;
 
 		// Get the block above this block
-		++iterBlock;
-		if( iterBlock == curCol.end() )
+		if( slotIndex + 1 >= (int32)curCol.size() )
 			continue;
+		GameFieldBlockMultBase* pAboveBlock = curCol[ slotIndex + 1 ];
 
 		// If this block is not sitting on top of our block then don't update it
-		if( !TCBase::NearlyEquals<float32>( thisBlockTopY, (*iterBlock)->yPos, 1.0f ) )
+		if( !TCBase::NearlyEquals<float32>( thisBlockTopY, pAboveBlock->yPos, 1.0f ) )
 			continue;
 
 		// Update the block
-		Recurse_UpdateFalling( *iterBlock );
+		Recurse_UpdateFalling( pAboveBlock );
 	}
 }
 
@@ -434,7 +508,8 @@ void GameFieldMultBase::Recurse_UpdateFalling( GameFieldBlockMultBase* pBlock )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldMultBase::ClearField()
 {
-	// Clear all block related data
+	// Clear all block related data before the blocks are freed
+	m_SelBlocks.clear();
 	for( int32 colIndex = 0; colIndex < FIELD_WIDTH; ++colIndex )
 		m_Cols[colIndex].clear();
 
@@ -442,10 +517,178 @@ void GameFieldMultBase::ClearField()
 	for( MultBlockList::iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
 		delete *iterBlock;
 	m_ActiveBlocks.clear();
-	m_BlockIDMap.clear();
+	m_BlockIDs.Clear();
 
 	m_LowestY = 0.0f;
-	m_SelBlocks.clear();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::SerializeBlockState  Protected
+///
+///	\param serializer The serializer that reads and writes data
+///	\param pBlock The block to save, ignored when loading
+///	\returns The block that was saved or loaded, NULL if a loaded block is invalid
+///
+///	Save/load a block for a game state snapshot. When loading, the block is created with its type
+///	and value and put back in the ID table with its original ID.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GameFieldBlockMultBase* GameFieldMultBase::SerializeBlockState( Serializer& serializer, GameFieldBlockMultBase* pBlock )
+{
+	uint8 blockType = 0;
+	int32 blockValue = 0;
+	uint32 blockID = BlockIDTable::INVALID_ID;
+	if( !serializer.InReadMode() )
+	{
+		blockType = (uint8)pBlock->GetBlockType();
+		blockValue = pBlock->GetValue();
+		blockID = pBlock->GetID();
+	}
+
+	serializer.AddData( blockType );
+	serializer.AddData( blockValue );
+	serializer.AddData( blockID );
+
+	if( serializer.InReadMode() )
+	{
+		switch( blockType )
+		{
+		case GameFieldBlockMultBase::BT_MultBase:
+			pBlock = new GameFieldBlockMultBase( blockValue );
+			break;
+
+		case GameFieldBlockMultBase::BT_Product:
+			pBlock = new GameFieldBlockProduct( blockValue, true );
+			break;
+
+		case GameFieldBlockMultBase::BT_Factor:
+			pBlock = new GameFieldBlockProduct( blockValue, false );
+			break;
+
+		case GameFieldBlockMultBase::BT_Fraction:
+			pBlock = new GameFieldBlockFraction( blockValue );
+			break;
+
+		default:
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"A game state snapshot has an unknown block type (%u).", (uint32)blockType );
+			return 0;
+		}
+
+		if( !m_BlockIDs.Place( blockID, pBlock ) )
+		{
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"A game state snapshot has a block with an invalid ID." );
+			delete pBlock;
+			return 0;
+		}
+		pBlock->m_BlockID = blockID;
+	}
+
+	pBlock->SerializeState( serializer );
+	return pBlock;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::SubclassSerializeState  Protected
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the data is invalid
+///
+///	Save/load the blocks, the columns and the field movement for a game state snapshot. The
+///	columns are stored as block IDs from the bottom up so they are rebuilt in the same order.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameFieldMultBase::SubclassSerializeState( Serializer& serializer )
+{
+	serializer.AddData( m_PushUpSpeed );
+	serializer.AddData( m_IsFieldDone );
+	serializer.AddData( m_LastShakeTime );
+	for( int32 colIndex = 0; colIndex < FIELD_WIDTH; ++colIndex )
+		serializer.AddData( m_ColumnHeight[colIndex] );
+
+	// The blocks in the order they were added to the field
+	uint32 numBlocks = (uint32)m_ActiveBlocks.size();
+	serializer.AddData( numBlocks );
+	if( serializer.InReadMode() )
+	{
+		for( uint32 blockIndex = 0; blockIndex < numBlocks; ++blockIndex )
+		{
+			GameFieldBlockMultBase* pBlock = SerializeBlockState( serializer, 0 );
+			if( !pBlock )
+				return false;
+			m_ActiveBlocks.push_back( pBlock );
+		}
+	}
+	else
+	{
+		for( MultBlockList::iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
+			SerializeBlockState( serializer, *iterBlock );
+	}
+
+	// The columns
+	for( int32 colIndex = 0; colIndex < FIELD_WIDTH; ++colIndex )
+	{
+		uint32 numColBlocks = (uint32)m_Cols[colIndex].size();
+		serializer.AddData( numColBlocks );
+		for( uint32 slotIndex = 0; slotIndex < numColBlocks; ++slotIndex )
+		{
+			uint32 blockID = serializer.InReadMode() ? BlockIDTable::INVALID_ID : m_Cols[colIndex][slotIndex]->GetID();
+			serializer.AddData( blockID );
+			if( !serializer.InReadMode() )
+				continue;
+
+			// Every block in a column is an active block so it is a multiplication block
+			GameFieldBlockMultBase* pBlock = (GameFieldBlockMultBase*)m_BlockIDs.Find( blockID );
+			if( !pBlock || colIndex < pBlock->colIndex || colIndex >= pBlock->colIndex + pBlock->size.x )
+			{
+				MSG_LOGGER_OUT( MsgLogger::MI_Error, L"A game state snapshot has an invalid column." );
+				return false;
+			}
+			AddBlockToCol( pBlock, colIndex, false );
+		}
+	}
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::StorePrevPositions  Protected
+///
+///	Store the position of every block at the start of a simulation tick so drawing can blend
+///	between this tick and the next.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameFieldMultBase::StorePrevPositions()
+{
+	for( MultBlockList::iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
+		(*iterBlock)->prevYPos = (*iterBlock)->yPos;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldMultBase::GetDrawYPos  Protected
+///
+///	\param pBlock The block being drawn
+///	\returns The Y position in field coordinates at which to draw the block
+///
+///	Get the Y position at which to draw a block. The simulation runs in fixed ticks so the
+///	position is blended between the last two ticks based on how far the frame is into the next.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+float32 GameFieldMultBase::GetDrawYPos( const GameFieldBlock* pBlock ) const
+{
+	// While paused the blocks don't move so draw them where they are
+	if( GameMgr::Get().IsPaused() )
+		return pBlock->yPos;
+
+	float32 tickBlend = GameMgr::Get().GetTickBlend();
+	return pBlock->prevYPos + (pBlock->yPos - pBlock->prevYPos) * tickBlend;
 }
 
 
@@ -460,14 +703,14 @@ void GameFieldMultBase::ClearField()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldMultBase::SubclassUpdate( float frameTime )
 {
+	PROFILE_SCOPE( "GameFieldMultBase::SubclassUpdate" );
+
 	if( GameMgr::Get().IsPaused() )
 		return;
 
-	static Vector2i s_FieldShakeOffset;
-
 	// Clear the current shake offset
-	m_FieldBox.pos -= s_FieldShakeOffset;
-	s_FieldShakeOffset.Set(0, 0);
+	m_FieldBox.pos -= m_FieldShakeOffset;
+	m_FieldShakeOffset.Set(0, 0);
 
 	// Update the time since the last shake was applied
 	m_LastShakeTime += frameTime;
@@ -482,8 +725,8 @@ void GameFieldMultBase::SubclassUpdate( float frameTime )
 		float32 shakeInterval = (1.0f - shakeAmount) + MIN_SHAKE_INTERVAL;
 		if( m_LastShakeTime > shakeInterval )
 		{
-			s_FieldShakeOffset.Set( (rand() % 3) - 1, (rand() % 3) - 1 );
-			m_FieldBox.pos += s_FieldShakeOffset;
+			m_FieldShakeOffset.Set( m_ShakeRandom.NextInRange( -1, 1 ), m_ShakeRandom.NextInRange( -1, 1 ) );
+			m_FieldBox.pos += m_FieldShakeOffset;
 			m_LastShakeTime = 0.0f;
 		}
 	}
@@ -514,7 +757,7 @@ void GameFieldMultBase::SubclassUpdate( float frameTime )
 		}
 
 		// Get the height of this column
-		for( MultBlockList::reverse_iterator iterBlock = m_Cols[colIndex].rbegin(); iterBlock != m_Cols[colIndex].rend(); ++iterBlock )
+		for( MultBlockColumn::reverse_iterator iterBlock = m_Cols[colIndex].rbegin(); iterBlock != m_Cols[colIndex].rend(); ++iterBlock )
 		{
 			// If the block is falling then don't use it
 			if( (*iterBlock)->isFalling )
@@ -612,14 +855,17 @@ bool GameFieldMultBase::HandleInstruction( GameFieldInstruction* pInstruction )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldMultBase::Update_CheckForCollision_Column( GameFieldBlockMultBase* pFirstBlock, int32 colIndex )
 {
-	MultBlockList& curCol = m_Cols[ colIndex ];
+	const MultBlockColumn& curCol = m_Cols[ colIndex ];
 	GameFieldBlockMultBase* pPrevBlock = 0;
 	bool alreadyPlayedForColumn = false;
 
-	MultBlockList::iterator iterBlock = FindBlockInCol( pFirstBlock, curCol );
-	for( ; iterBlock != curCol.end(); ++iterBlock )
+	int32 firstSlotIndex = FindBlockInCol( pFirstBlock, colIndex );
+	if( firstSlotIndex < 0 )
+		return;
+
+	for( uint32 slotIndex = (uint32)firstSlotIndex; slotIndex < curCol.size(); ++slotIndex )
 	{
-		GameFieldBlockMultBase* pCurBlock = *iterBlock;
+		GameFieldBlockMultBase* pCurBlock = curCol[ slotIndex ];
 
 		float stoppedFallingSpeed = 0.0f;
 
@@ -690,7 +936,7 @@ void GameFieldMultBase::Update_CheckForCollision_Column( GameFieldBlockMultBase*
 		}
 
 		// Store the previous block pointer
-		pPrevBlock = *iterBlock;
+		pPrevBlock = pCurBlock;
 	}
 }
 
@@ -704,12 +950,14 @@ void GameFieldMultBase::Update_CheckForCollision_Column( GameFieldBlockMultBase*
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldMultBase::Update_CheckForCollision()
 {
+	PROFILE_SCOPE( "GameFieldMultBase::Update_CheckForCollision" );
+
 	// Now that all of the blocks have been moved let's check if any of the falling blocks landed
 	for( int32 colIndex = 0; colIndex < FIELD_WIDTH; ++colIndex )
 	{
 		if( m_Cols[ colIndex ].size() == 0 )
 			continue;
-		Update_CheckForCollision_Column( *(m_Cols[ colIndex ].begin()), colIndex );
+		Update_CheckForCollision_Column( m_Cols[ colIndex ].front(), colIndex );
 	}
 }
 
@@ -725,12 +973,14 @@ void GameFieldMultBase::Update_CheckForCollision()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameFieldMultBase::RemoveBlock( GameFieldBlock* pRemBaseBlock )
 {
+	PROFILE_SCOPE( "GameFieldMultBase::RemoveBlock" );
+
 	TCASSERT( pRemBaseBlock != NULL );
 	GameFieldBlockMultBase* pRemBlock = (GameFieldBlockMultBase*)pRemBaseBlock;
 
 	// Remove the block from active list
 	m_ActiveBlocks.remove( pRemBlock );
-	m_BlockIDMap.erase( pRemBlock->GetID() );
+	RemoveBlockID( pRemBlock );
 
 	// If the block is selected then remove it from the selected list
 	BlockList::iterator iterSelBlock;
@@ -747,20 +997,18 @@ void GameFieldMultBase::RemoveBlock( GameFieldBlock* pRemBaseBlock )
 	// Go through each column this block intersects
 	for( int32 colIndex = pRemBlock->colIndex; colIndex < pRemBlock->colIndex + pRemBlock->size.x; ++colIndex )
 	{
-		// Get the iterator for the block in the column
-		MultBlockList::iterator iterBlock = FindBlockInCol( pRemBlock, m_Cols[ colIndex ] );
-		if( iterBlock == m_Cols[ colIndex ].end() )
+		// Get the index of the block in the column
+		int32 slotIndex = FindBlockInCol( pRemBlock, colIndex );
+		if( slotIndex < 0 )
 			continue;
 
 		// Get the block above this one
-		MultBlockList::iterator iterAboveBlock = iterBlock;
-		++iterAboveBlock;
 		GameFieldBlockMultBase* pAboveBlock = NULL;
-		if( iterAboveBlock != m_Cols[ colIndex ].end() )
-			pAboveBlock = *iterAboveBlock;
+		if( slotIndex + 1 < (int32)m_Cols[ colIndex ].size() )
+			pAboveBlock = m_Cols[ colIndex ][ slotIndex + 1 ];
 
 		// Remove this block from the column
-		m_Cols[ colIndex ].erase( iterBlock );
+		RemoveBlockFromCol( colIndex, slotIndex );
 
 		// Update the falling
 		Recurse_UpdateFalling( pAboveBlock );
@@ -788,9 +1036,10 @@ void GameFieldMultBase::Draw() const
 	for( MultBlockList::const_iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
 	{
 		const GameFieldBlockMultBase* pBlock = *iterBlock;
+		const float32 drawYPos = GetDrawYPos( pBlock );
 
 		// Get the position from game field coordinates to screen coordinates
-		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, pBlock->yPos, pBlock->size.y );
+		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, drawYPos, pBlock->size.y );
 
 		// If the cursor is in the block
 		const RefSprite* pBlockSprite = pBlock->sprite.GetObj();
@@ -831,9 +1080,10 @@ void GameFieldMultBase::Draw() const
 	for( MultBlockList::const_iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
 	{
 		const GameFieldBlockMultBase* pBlock = *iterBlock;
+		const float32 drawYPos = GetDrawYPos( pBlock );
 
 		// Get the position from game field coordinates to screen coordinates
-		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, pBlock->yPos, pBlock->size.y );
+		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, drawYPos, pBlock->size.y );
         
 		// If the block has text then draw it
 		if( pBlock->GetText() )
@@ -849,101 +1099,86 @@ void GameFieldMultBase::Draw() const
 	}
 #else
 	
+	// Render a few of the queued block faces so the faces for a new product filter are ready
+	// without stalling a single frame
+	BlockFaceCache::Get().RenderQueuedFaces( FACES_RENDERED_PER_FRAME );
+	m_TextBlocks.clear();
+
 	// Go through the blocks and draw them
 	for( MultBlockList::const_iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
 	{
 		const GameFieldBlockMultBase* pBlock = *iterBlock;
+		const float32 drawYPos = GetDrawYPos( pBlock );
 
 		// If this block is off the bottom
-		if( pBlock->yPos < (float32)-GameDefines::BLOCK_HEIGHT )
+		if( drawYPos < (float32)-GameDefines::BLOCK_HEIGHT )
 			continue;
 
 		// Get the position from game field coordinates to screen coordinates
-		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, pBlock->yPos, pBlock->size.y );
-
-		// If the cursor is in the block
-		const RefSprite* pBlockSprite = pBlock->sprite.GetObj();
-		bool cursorIsOver = Box2i( blockPos, Vector2i(GameDefines::BLOCK_WIDTH, GameDefines::BLOCK_HEIGHT)).IsPointInside( cursorScreenPos );
-		
-		// If the cursor is below the field then don't highlight anything
-		if( cursorScreenPos.y > m_FieldBox.Bottom() )
-			cursorIsOver = false;
-		
-		if( cursorIsOver )
-		{
-			bool showPrimeBlock = false;
+		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, drawYPos, pBlock->size.y );
 
-			if( (GameMgr::Get().GetGameType() & GameDefines::GT_Mask_Type) == GameDefines::GT_PrimeTime
-				|| (GameMgr::Get().GetGameType() & GameDefines::GT_Mask_Type) == GameDefines::GT_Ceiling )
-			{
-				const GameFieldBlockProduct* pCurProductBlock = static_cast<const GameFieldBlockProduct*>( pBlock );
-
-				showPrimeBlock = !pCurProductBlock->IsProductBlock();
-			}
-
-			// If the block is a prime then show the specialized sprite for the prime
-			if( showPrimeBlock )
-			{
-				uint32 primeIndex = GameDefines::PrimeToIndex( pBlock->GetValue() );
-				if( primeIndex < GameDefines::NUM_PRIMES )
-					pBlockSprite = ResourceMgr::Get().GetRefSprite(GameDefines::PRIME_HILITED_SPRITE_ID[primeIndex]).GetObj();
-			}
-			// Otherise use the empty block
-			else
-			{
-				if( pBlock->size.x == 1 )
-					pBlockSprite = ResourceMgr::Get().GetRefSprite(RESID_SPRITE_PRODUCT_BLOCK_HILITED).GetObj();
-				else
-					pBlockSprite = ResourceMgr::Get().GetRefSprite(RESID_SPRITE_DBL_PRDCT_BLOCK_HILITED).GetObj();
-			}
-		}
+		const RefSprite* pBlockSprite = GetBlockDrawSprite( pBlock, blockPos, cursorScreenPos );
 		if( !pBlockSprite )
 			continue;
 
+		// If the block has text then use the face with the text already drawn on it, otherwise
+		// the text is drawn after all of the blocks
+		const BlockFaceCache::Face* pFace = 0;
+		if( pBlock->GetText() )
+		{
+			pFace = BlockFaceCache::Get().GetFace( pBlockSprite, pBlock->GetValue() );
+			if( !pFace )
+				m_TextBlocks.push_back( pBlock );
+		}
+
 		// If this block is off the bottom
-		if( pBlock->yPos < 0.0f )
+		if( drawYPos < 0.0f )
 		{
-			Box2i destRect( blockPos.x, blockPos.y, pBlock->size.x * GameDefines::BLOCK_WIDTH, (int32)pBlock->yPos + (pBlock->size.y * GameDefines::BLOCK_HEIGHT) );
-			g_pGraphicsMgr->DrawSpriteUnscaled( destRect, pBlockSprite );
+			Box2i destRect( blockPos.x, blockPos.y, pBlock->size.x * GameDefines::BLOCK_WIDTH, (int32)drawYPos + (pBlock->size.y * GameDefines::BLOCK_HEIGHT) );
+			if( pFace )
+			{
+				// Only draw the part of the face above the bottom of the field
+				Box2i srcRect = pFace->srcRect;
+				if( srcRect.size.y > destRect.size.y )
+					srcRect.size.y = destRect.size.y;
+				g_pGraphicsMgr->DrawImage( blockPos, pFace->pPage, srcRect );
+			}
+			else
+				g_pGraphicsMgr->DrawSpriteUnscaled( destRect, pBlockSprite );
 		}
 		// Else draw the block normally
 		else
 		{
-			g_pGraphicsMgr->DrawSprite( blockPos, pBlockSprite );
+			if( pFace )
+				g_pGraphicsMgr->DrawImage( blockPos, pFace->pPage, pFace->srcRect );
+			else
+				g_pGraphicsMgr->DrawSprite( blockPos, pBlockSprite );
 		}
 	}
 
-    // Go through the blocks and draw them
-	for( MultBlockList::const_iterator iterBlock = m_ActiveBlocks.begin(); iterBlock != m_ActiveBlocks.end(); ++iterBlock )
+	// Draw the text of the blocks that did not have a face
+	for( uint32 blockIndex = 0; blockIndex < m_TextBlocks.size(); ++blockIndex )
 	{
-		const GameFieldBlockMultBase* pBlock = *iterBlock;
-
-		// If this block is off the bottom
-		if( pBlock->yPos < (float32)-GameDefines::BLOCK_HEIGHT )
-			continue;
+		const GameFieldBlockMultBase* pBlock = m_TextBlocks[ blockIndex ];
+		const float32 drawYPos = GetDrawYPos( pBlock );
 
 		// Get the position from game field coordinates to screen coordinates
-		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, pBlock->yPos, pBlock->size.y );
+		Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, drawYPos, pBlock->size.y );
 
 		// If this block is off the bottom
-		if( pBlock->yPos < 0.0f )
+		if( drawYPos < 0.0f )
 		{
-			Box2i destRect( blockPos.x, blockPos.y, pBlock->size.x * GameDefines::BLOCK_WIDTH, (int32)pBlock->yPos + (pBlock->size.y * GameDefines::BLOCK_HEIGHT) );
+			Box2i destRect( blockPos.x, blockPos.y, pBlock->size.x * GameDefines::BLOCK_WIDTH, (int32)drawYPos + (pBlock->size.y * GameDefines::BLOCK_HEIGHT) );
 			
-			// If the block has text then draw it
+			// Clip the text to the bottom of the field
 			Box2i clipRect( blockPos + pBlock->GetTextOffset(), Vector2i(destRect.size.x,GameDefines::GetBlockTextFont()->GetCharHeight()) );
 			if( clipRect.Bottom() > m_FieldBox.Bottom() )
 				clipRect.size.y = m_FieldBox.Bottom() - clipRect.pos.y;
-			if( pBlock->GetText() )
-				g_pGraphicsMgr->DrawFontTextClipped( pBlockFont, pBlock->GetText(), clipRect );
+			g_pGraphicsMgr->DrawFontTextClipped( pBlockFont, pBlock->GetText(), clipRect );
 		}
 		// Else draw the block normally
 		else
-		{
-			// If the block has text then draw it
-			if( pBlock->GetText() )
-				g_pGraphicsMgr->DrawFontText( pBlockFont, pBlock->GetText(), blockPos + pBlock->GetTextOffset() );
-		}
+			g_pGraphicsMgr->DrawFontText( pBlockFont, pBlock->GetText(), blockPos + pBlock->GetTextOffset() );
 	}
 #endif
 
@@ -953,12 +1188,13 @@ void GameFieldMultBase::Draw() const
 		for( BlockList::const_iterator iterBlock = m_SelBlocks.begin(); iterBlock != m_SelBlocks.end(); ++iterBlock )
 		{
 			const GameFieldBlockMultBase* pBlock = (GameFieldBlockMultBase*)(*iterBlock);
+			const float32 drawYPos = GetDrawYPos( pBlock );
 
 			if( pBlock->colIndex < 0 )
 				continue;
 
 			// Get the position from game field coordinates to screen coordinates
-			Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, pBlock->yPos, pBlock->size.y );
+			Point2i blockPos = BlockFieldToScreenPos( pBlock->colIndex, drawYPos, pBlock->size.y );
 
 			AnimSprite animSpr;
 			if( pBlock->size.x == 1 )
@@ -967,9 +1203,9 @@ void GameFieldMultBase::Draw() const
 				animSpr = m_WideSelBracketSprite;
 
 			// If this block is off the bottom
-			if( pBlock->yPos < 0.0f )
+			if( drawYPos < 0.0f )
 			{
-				Box2i destRect( blockPos.x, blockPos.y, GameDefines::BLOCK_WIDTH, GameDefines::BLOCK_HEIGHT + (int32)pBlock->yPos );
+				Box2i destRect( blockPos.x, blockPos.y, GameDefines::BLOCK_WIDTH, GameDefines::BLOCK_HEIGHT + (int32)drawYPos );
 				Box2i srcRect( animSpr.GetSrcCoords() );
 				srcRect.size.y = destRect.size.y;
 				g_pGraphicsMgr->DrawImage( destRect.pos, animSpr.GetImage(), srcRect );
@@ -981,4 +1217,56 @@ void GameFieldMultBase::Draw() const
 	}
 
 	//g_pGraphicsMgr->DrawRect( m_FieldBox, 0x00FF0000 );
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  GameFieldMultBase::GetBlockDrawSprite  Protected
+///
+///	\param pBlock The block being drawn
+///	\param blockPos The top left of the block in screen coordinates
+///	\param cursorScreenPos The cursor position in screen coordinates
+///	\returns The sprite to draw for the block, NULL if the block has no sprite
+///
+///	Get the sprite for a block, which is the highlighted sprite if the cursor is over the block.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const RefSprite* GameFieldMultBase::GetBlockDrawSprite( const GameFieldBlockMultBase* pBlock, const Point2i& blockPos, const Point2i& cursorScreenPos ) const
+{
+	// If the cursor is in the block
+	const RefSprite* pBlockSprite = pBlock->sprite.GetObj();
+	bool cursorIsOver = Box2i( blockPos, Vector2i(GameDefines::BLOCK_WIDTH, GameDefines::BLOCK_HEIGHT)).IsPointInside( cursorScreenPos );
+	
+	// If the cursor is below the field then don't highlight anything
+	if( cursorScreenPos.y > m_FieldBox.Bottom() )
+		cursorIsOver = false;
+	
+	if( !cursorIsOver )
+		return pBlockSprite;
+
+	bool showPrimeBlock = false;
+
+	if( (GameMgr::Get().GetGameType() & GameDefines::GT_Mask_Type) == GameDefines::GT_PrimeTime
+		|| (GameMgr::Get().GetGameType() & GameDefines::GT_Mask_Type) == GameDefines::GT_Ceiling )
+	{
+		const GameFieldBlockProduct* pCurProductBlock = static_cast<const GameFieldBlockProduct*>( pBlock );
+
+		showPrimeBlock = !pCurProductBlock->IsProductBlock();
+	}
+
+	// If the block is a prime then show the specialized sprite for the prime
+	if( showPrimeBlock )
+	{
+		uint32 primeIndex = GameDefines::PrimeToIndex( pBlock->GetValue() );
+		if( primeIndex < GameDefines::NUM_PRIMES )
+			pBlockSprite = ResourceMgr::Get().GetRefSprite(GameDefines::PRIME_HILITED_SPRITE_ID[primeIndex]).GetObj();
+	}
+	// Otherise use the empty block
+	else
+	{
+		if( pBlock->size.x == 1 )
+			pBlockSprite = ResourceMgr::Get().GetRefSprite(RESID_SPRITE_PRODUCT_BLOCK_HILITED).GetObj();
+		else
+			pBlockSprite = ResourceMgr::Get().GetRefSprite(RESID_SPRITE_DBL_PRDCT_BLOCK_HILITED).GetObj();
+	}
+
+	return pBlockSprite;
+}
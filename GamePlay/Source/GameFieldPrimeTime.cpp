@@ -19,6 +19,7 @@
 #include "../GameMgr.h"
 #include "../GameLogic.h"
 #include "Base/NumFuncs.h"
+#include "Base/MsgLogger.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,8 +43,8 @@ void GameFieldPrimeTime::RemoveBlock( GameFieldBlockProduct* pRemBlock )
 		if( IsBlockSelected( pRemBlock, &iterSelBlock ) )
 			m_SelBlocks.erase( iterSelBlock );
 
-		// Remove it from the ID map
-		m_BlockIDMap.erase( pRemBlock->GetID() );
+		// Remove it from the ID table
+		RemoveBlockID( pRemBlock );
 
 		// Free the block
 		delete pRemBlock;
@@ -146,7 +147,15 @@ void GameFieldPrimeTime::SetComboBlock( int32 blockValue )
 	if( m_pComboBlock )
 		RemoveBlock( m_pComboBlock );
 
-	// Create the new block
+	CreateComboBlock( blockValue );
+
+	// Store the block in the ID table
+	AddBlockID( m_pComboBlock );
+}
+
+/// Create the combo block without adding it to the ID table
+void GameFieldPrimeTime::CreateComboBlock( int32 blockValue )
+{
 	m_pComboBlock = new GameFieldBlockProduct( blockValue, true );
 
 	if( blockValue < 100 )
@@ -160,9 +169,6 @@ void GameFieldPrimeTime::SetComboBlock( int32 blockValue )
 	m_ComboBlockBoundBox.size.y = m_pComboBlock->size.y * GameDefines::BLOCK_HEIGHT;
 	m_ComboBlockFieldBoundBox.size.x = m_ComboBlockBoundBox.size.x;
 	m_ComboBlockFieldBoundBox.size.y = m_ComboBlockBoundBox.size.y;
-
-	// Store the block in the ID map
-	m_BlockIDMap.insert( std::pair<uint32,GameFieldBlock*>(m_pComboBlock->GetID(),m_pComboBlock) );
 }
 
 /// Initialize the field
@@ -416,6 +422,80 @@ void GameFieldPrimeTime::ClearField()
 	m_pComboBlock = 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameFieldPrimeTime::SubclassSerializeState  Private
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the data is invalid
+///
+///	Save/load the field's blocks, the combo block and the blocks that can continue a combo for a
+///	game state snapshot.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameFieldPrimeTime::SubclassSerializeState( Serializer& serializer )
+{
+	if( !GameFieldMultBase::SubclassSerializeState( serializer ) )
+		return false;
+
+	// The combo block is not an active block so it is stored on its own
+	bool hasComboBlock = m_pComboBlock != 0;
+	serializer.AddData( hasComboBlock );
+	if( hasComboBlock )
+	{
+		int32 blockValue = serializer.InReadMode() ? 0 : m_pComboBlock->GetValue();
+		uint32 blockID = serializer.InReadMode() ? BlockIDTable::INVALID_ID : m_pComboBlock->GetID();
+		serializer.AddData( blockValue );
+		serializer.AddData( blockID );
+
+		if( serializer.InReadMode() )
+		{
+			CreateComboBlock( blockValue );
+			if( !m_BlockIDs.Place( blockID, m_pComboBlock ) )
+			{
+				MSG_LOGGER_OUT( MsgLogger::MI_Error, L"A game state snapshot has a combo block with an invalid ID." );
+				delete m_pComboBlock;
+				m_pComboBlock = 0;
+				return false;
+			}
+			m_pComboBlock->m_BlockID = blockID;
+		}
+
+		m_pComboBlock->SerializeState( serializer );
+	}
+
+	// The comboable blocks by ID
+	uint32 numComboable = (uint32)m_ComboableProducts.size();
+	serializer.AddData( numComboable );
+	if( serializer.InReadMode() )
+	{
+		m_ComboableProducts.clear();
+		for( uint32 comboIndex = 0; comboIndex < numComboable; ++comboIndex )
+		{
+			uint32 blockID = 0;
+			serializer.AddData( blockID );
+
+			GameFieldBlockMultBase* pBlock = (GameFieldBlockMultBase*)m_BlockIDs.Find( blockID );
+			if( !pBlock )
+			{
+				MSG_LOGGER_OUT( MsgLogger::MI_Error, L"A game state snapshot has a comboable block that is not on the field." );
+				return false;
+			}
+			m_ComboableProducts.push_back( pBlock );
+		}
+	}
+	else
+	{
+		for( MultBlockList::iterator iterBlock = m_ComboableProducts.begin(); iterBlock != m_ComboableProducts.end(); ++iterBlock )
+		{
+			uint32 blockID = (*iterBlock)->GetID();
+			serializer.AddData( blockID );
+		}
+	}
+
+	return true;
+}
+
 /// A message handler called when a successful equation is selected
 void GameFieldPrimeTime::AddToComboBlocksFromSelection()
 {
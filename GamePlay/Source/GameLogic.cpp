@@ -18,6 +18,8 @@
 #include "GUI/GUIMgr.h"
 #include "GUI/MsgBox.h"
 #include "Base/NumFuncs.h"
+#include "Base/ProfileTimer.h"
+#include "Base/Serializer.h"
 #include "PrimeTime/ApplicationBase.h"
 
 const float32 BASE_SPEED = (float32)GameDefines::BLOCK_HEIGHT + 0.1f;
@@ -44,6 +46,8 @@ void OnGameOverMBClose( MsgBox::EMsgBoxReturn retVal, void* )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameLogic::Update( float32 frameTime )
 {
+	PROFILE_SCOPE( "GameLogic::Update" );
+
 	bool gameIsOver = false;
 
 	// Update the time counter
@@ -86,8 +90,14 @@ void GameLogic::Update( float32 frameTime )
 			gameIsOver = true;
 	}
 
-	// If the game is over
-	if( gameIsOver )
+	// If the game is over without anyone watching then just end it
+	if( gameIsOver && GameMgr::Get().IsHeadless() )
+	{
+		GameMgr::Get().SetPauseState( true );
+		GameMgr::Get().EndGame();
+	}
+	// Else if the game is over
+	else if( gameIsOver )
 	{
 		// Display the end message box
 		GameMgr::Get().SetPauseState( true );
@@ -141,21 +151,59 @@ float32 GameLogic::GetPushUpSpeed( int32 level )
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogic::SerializeState  Public
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the logic doesn't support state
+///				snapshots or the data is invalid
+///
+///	Save/load the complete state of the logic and its field, including the random number
+///	generator, so the game continues exactly as it did from the point the state was saved.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameLogic::SerializeState( Serializer& serializer )
+{
+	if( !CanSerializeState() || !GetGameField() )
+		return false;
+
+	serializer.AddData( m_SecondCount );
+
+	TCBase::RandomGen::State randState = m_Random.GetState();
+	for( uint32 stateIndex = 0; stateIndex < 4; ++stateIndex )
+		serializer.AddData( randState.s[ stateIndex ] );
+	if( serializer.InReadMode() )
+		m_Random.SetState( randState );
+
+	if( !SubclassSerializeState( serializer ) )
+		return false;
+
+	return GetGameField()->SerializeState( serializer );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  GameLogic::Init  Public
 ///
 ///	\param gameType The game type being played
 ///	\param timeLimit The time limit for the games in seconds, 0 means no time limit
+///	\param seed The seed for the random number generator, the same seed will generate the same
+///		blocks
 ///
 ///	Initialize the game logic.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool GameLogic::Init( GameDefines::EGameType gameType, uint32 timeLimit )
+bool GameLogic::Init( GameDefines::EGameType gameType, uint32 timeLimit, uint64 seed )
 {
 	// Store the game type
 	m_GameType = gameType;
 
+	// Seed the random number generator before the subclass generates any blocks
+	m_Seed = seed;
+	m_Random.Seed( seed );
+
 	// Store the time limit
 	m_TimeLimit = timeLimit;
 
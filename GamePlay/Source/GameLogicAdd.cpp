@@ -24,6 +24,9 @@ const uint32 NUM_SUMMANDS = 12;
 const ResourceID RESID_SND_RIGHTPROD = 131;
 const ResourceID RESID_SND_WRONGPROD = 132;
 
+/// The most sums rolled while looking for one that can be made from the field
+const uint32 MAX_SUM_ATTEMPTS = 8;
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -127,9 +130,12 @@ void GameLogicAdd::Term()
 	if( pProfile )
 		pAdditionProfile = (ProfileSubsetAddition*)pProfile->GetSubset( ProfileSubsetAddition::SUBSET_ID );
 
-	// End the session with the profile
+	// End the session with the profile, saving only appends the session to the profile's journal
 	if( pAdditionProfile )
+	{
 		pAdditionProfile->StoreSession( m_CurSessionStats );
+		pProfile->SaveToFile();
+	}
 }
 
 
@@ -267,6 +273,15 @@ void GameLogicAdd::InitNumbers()
 		m_MaxSum = (uint32)( (float32)m_MinSum * 3.25f );
 	else
 		m_MaxSum = (uint32)( (float32)m_MinSum * 2.0f );
+
+	// Widen or narrow the range of sums when calibrating the difficulty
+	float32 sumRangeScale = GameMgr::Get().GetDiffTuning().sumRangeScale;
+	if( sumRangeScale != 1.0f )
+	{
+		m_MaxSum = m_MinSum + (int32)( (float32)(m_MaxSum - m_MinSum) * sumRangeScale );
+		if( m_MaxSum <= m_MinSum )
+			m_MaxSum = m_MinSum + 1;
+	}
 	
 	// Resize the summand array
 	m_Summands.resize( NUM_SUMMANDS );
@@ -305,7 +320,7 @@ void GameLogicAdd::InitNumbers()
 		{
 			// Calculate a percent of the minium sum
 			float32 percent = (float32)summandIndex / (float32)m_Summands.size();
-			percent += (float32)( (rand() % 13) - 6 ) / 100.0f;
+			percent += (float32)m_Random.NextInRange( -6, 6 ) / 100.0f;
 			const float32 ONE_TWELTH = 0.083333f;
 			const float32 ELEVEN_TWELTH = 0.9166667f;
 			if( percent < ONE_TWELTH )
@@ -327,7 +342,8 @@ void GameLogicAdd::InitNumbers()
 //
 //  GameLogicAdd::GenerateSum  Public
 ///
-///	Generate a sum.
+///	Generate a sum. Sums are rolled until one can be made from the blocks on the field, giving
+///	up after a few tries so a nearly empty field can't stall the game.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 int32 GameLogicAdd::GenerateSum()
@@ -335,11 +351,37 @@ int32 GameLogicAdd::GenerateSum()
 	if( _isInPractice10Mode )
 		return 10;
 
+	m_Solver.LoadSumField( m_pGameFieldAdd );
+
+	int32 sum = RollSum();
+	for( uint32 attemptIndex = 1; attemptIndex < MAX_SUM_ATTEMPTS; ++attemptIndex )
+	{
+		if( m_Solver.CountSolutions( EquationSolver::ET_Sum, sum ) > 0 )
+			break;
+
+		sum = RollSum();
+	}
+
+	return sum;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicAdd::RollSum  Protected
+///
+///	\returns A random sum within the sum range
+///
+///	Pick a sum by adding random summands.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int32 GameLogicAdd::RollSum()
+{
 	// Add summands until we get a sum within the range
 	int32 sum = 0;
 	while( sum < m_MinSum )
 	{
-		uint32 summandIndex = rand() % m_Summands.size();
+		uint32 summandIndex = m_Random.NextBelow( (uint32)m_Summands.size() );
 		sum += m_Summands[summandIndex].value;
 	}
 
@@ -347,10 +389,10 @@ int32 GameLogicAdd::GenerateSum()
 		return m_MaxSum - 1;
 
 	// 50% chance of adding more summands
-	while( rand() % 2 )
+	while( m_Random.Chance( 50 ) )
 	{
 		// If the next summand will not put the sum greater than the max then add it
-		uint32 summandIndex = rand() % m_Summands.size();
+		uint32 summandIndex = m_Random.NextBelow( (uint32)m_Summands.size() );
 		if( sum + m_Summands[summandIndex].value < m_MaxSum )
 			sum += m_Summands[summandIndex].value;
 		else
@@ -362,6 +404,24 @@ int32 GameLogicAdd::GenerateSum()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicAdd::CountSumSolutions  Public
+///
+///	\returns The number of combinations of blocks on the field that make the sum block, 0 if
+///	there is no sum block
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint64 GameLogicAdd::CountSumSolutions()
+{
+	if( !m_pGameFieldAdd || !m_pGameFieldAdd->GetSumBlock() )
+		return 0;
+
+	m_Solver.LoadSumField( m_pGameFieldAdd );
+	return m_Solver.CountSolutions( EquationSolver::ET_Sum, m_pGameFieldAdd->GetSumBlock()->GetValue() );
+}
+
+
 int32 GameLogicAdd::GetNextSummandIndex()
 {
 	// If we are in practice 10 mode then try to keep an even distribution of all summands
@@ -377,7 +437,7 @@ int32 GameLogicAdd::GetNextSummandIndex()
 		return minSummandIndex;
 	}
 
-	return rand() % m_Summands.size();
+	return (int32)m_Random.NextBelow( (uint32)m_Summands.size() );
 }
 
 
@@ -22,39 +22,6 @@
 const ResourceID RESID_SND_RIGHTPROD = 131;
 const ResourceID RESID_SND_WRONGPROD = 132;
 
-static std::vector<FractionModeSettings> g_FractionModeSettings(  (int32)GameDefines::GPDL_COUNT );
-
-static void PopulateFractionModes();
-
-
-bool IsEquivalentFraction( int32 numerator1, int32 denominator1, int32 numerator2, int32 denominator2 )
-{
-	if( denominator1 == 0 || denominator2 == 0 )
-		return false;
-
-	return (numerator1 * denominator2) == (numerator2 * denominator1);
-}
-
-bool IsEquivalentFraction( Fraction lhs, Fraction rhs )
-{
-	return IsEquivalentFraction(lhs.Numerator, lhs.Denominator, rhs.Numerator, rhs.Denominator);
-}
-
-template<class T>
-T GetRandomEntry( const std::list<T>& list )
-{
-	uint32 randIndex = rand() % list.size();
-
-	uint32 curIndex = 0;
-	typename std::list<T>::const_iterator iterItem = list.begin();
-	for( ; curIndex < randIndex; ++iterItem )
-	{
-		++curIndex;
-	}		
-
-	return *iterItem;
-}
-
 Fraction GameLogicFractions::GetNextFraction() const
 {
 	// Find the most common fraction
@@ -67,31 +34,19 @@ Fraction GameLogicFractions::GetNextFraction() const
 	}
 	*/
 
-	std::list<uint32> possibleNextFractions;
+	uint32 possibleNextFractions[ FractionModeSettings::MAX_FRACTIONS ];
+	uint32 numPossibleNextFractions = 0;
 	for( uint32 fractionIndex = 0; fractionIndex < _pCurModeSettings->AvailableFractions.size(); ++fractionIndex )
 	{
 		if( _solutionFractionPossibilities[fractionIndex] > 0 )
-			possibleNextFractions.push_back( fractionIndex );
+			possibleNextFractions[ numPossibleNextFractions++ ] = fractionIndex;
 	}
 
-	if( possibleNextFractions.size() == 0 )
+	if( numPossibleNextFractions == 0 )
 		return Fraction(1,2);
 
-	return _pCurModeSettings->GetRandomFraction( GetRandomEntry(possibleNextFractions) );
-}
-
-
-bool IsFractionWithinLength( float32 ratio, int32 length )
-{
-	// 2^-17
-	const float32 MIN_VALUE = 0.00000762939453125f;
-
-	float32 powOfTen = powf( 10.0f, (float)length );
-
-	float32 flooredVal = floorf( ratio * powOfTen ) / powOfTen;
-	float32 diff = fabs( flooredVal - ratio );
-
-	return diff < MIN_VALUE;
+	uint32 randIndex = m_Random.NextBelow( numPossibleNextFractions );
+	return _pCurModeSettings->GetRandomFraction( possibleNextFractions[randIndex], m_Random );
 }
 
 
@@ -157,7 +112,7 @@ GameLogic::EBlockSelAction GameLogicFractions::OnBlockSelect( GameFieldBlock* pB
 	{
 		Fraction selectedFraction(_pGameFieldFractions->GetSelectedNumerator(), _pGameFieldFractions->GetSelectedDenominator() );
 
-		bool isValidFraction = IsEquivalentFraction( _equivalentFraction.Numerator, _equivalentFraction.Denominator, selectedFraction.Numerator, selectedFraction.Denominator );
+		bool isValidFraction = _equivalentFraction.IsEquivalent( selectedFraction );
 
 		// Whether or not the fraction is correct we need to clear the selection
 		_pGameFieldFractions->SetSelectedNumerator( -1 );
@@ -166,29 +121,26 @@ GameLogic::EBlockSelAction GameLogicFractions::OnBlockSelect( GameFieldBlock* pB
 
 		if( isValidFraction )
 		{
-			// Update the possible solution count
-			for( uint32 fractionIndex = 0; fractionIndex < _pCurModeSettings->AvailableFractions.size(); ++fractionIndex )
-			{
-				// If we just cleared a fraction equivalent to this fraction then decrement the count
-				if( IsEquivalentFraction( _pCurModeSettings->AvailableFractions[fractionIndex].FractionValue, _equivalentFraction ) )
-				{
-					--_solutionFractionPossibilities[fractionIndex];
-					break;
-				}
-			}
+			// Update the possible solution count of the fraction that was just cleared
+			int32 clearedFractionIndex = _pCurModeSettings->FindFractionIndex( _equivalentFraction );
+			if( clearedFractionIndex >= 0 )
+				--_solutionFractionPossibilities[clearedFractionIndex];
 
 			// Update the stats
 			_curSessionStats.m_NumFractionsCleared++;
 			_curSessionStats.m_Score += selectedFraction.Numerator + selectedFraction.Denominator;
-			m_pGameGUILayout->SetScore( _curSessionStats.m_Score );
-
-			m_pGameGUILayout->SetCount( _curSessionStats.m_NumFractionsCleared );
+			if( m_pGameGUILayout )
+			{
+				m_pGameGUILayout->SetScore( _curSessionStats.m_Score );
+				m_pGameGUILayout->SetCount( _curSessionStats.m_NumFractionsCleared );
+			}
 
 			// If the player cleared the certain number of fractions then increase the speed
 			if( _curSessionStats.m_NumFractionsCleared % GameDefines::NUM_CLEAR_PER_LEVEL == 0 )
 			{
 				++m_CurrentLevel;
-				m_pGameGUILayout->SetLevel( m_CurrentLevel );
+				if( m_pGameGUILayout )
+					m_pGameGUILayout->SetLevel( m_CurrentLevel );
 				_pGameFieldFractions->SendInstruction( new PIISetPushSpeed( GameLogic::GetPushUpSpeed(m_CurrentLevel) ) );
 			}
 
@@ -196,20 +148,28 @@ GameLogic::EBlockSelAction GameLogicFractions::OnBlockSelect( GameFieldBlock* pB
 
 			_equivalentFraction = nextFraction;
 
-			float32 ratio = (float32)_equivalentFraction.Numerator / (float32)_equivalentFraction.Denominator;
-
-			bool showDecimal = ((rand() % 2) == 0) && IsFractionWithinLength( ratio, _pCurModeSettings->DecimalPlaces );
+			// The decimal text is stored with the fraction, but the tutorial's fractions may not be
+			// one of the mode's
+			int32 nextFractionIndex = _pCurModeSettings->FindFractionIndex( _equivalentFraction );
+			bool showDecimal = m_Random.Chance( 50 );
+			std::wstring sDecimalText;
+			if( showDecimal && nextFractionIndex >= 0 )
+			{
+				const FractionModeSettings::FractionInfo& nextFractionInfo = _pCurModeSettings->AvailableFractions[nextFractionIndex];
+				showDecimal = nextFractionInfo.HasShortDecimal;
+				sDecimalText = nextFractionInfo.DecimalText;
+			}
+			else if( showDecimal )
+			{
+				showDecimal = _equivalentFraction.IsDecimalWithin( _pCurModeSettings->DecimalPlaces );
+				if( showDecimal )
+					sDecimalText = _equivalentFraction.GetDecimalText( _pCurModeSettings->DecimalPlaces );
+			}
 
 			// Get the string showing the next fraction
 			std::wstring sNextString;
 			if( showDecimal )
-			{
-				wchar_t numBuffer[8] = {0};
-
-				swprintf( numBuffer, 8, L"%.*g", _pCurModeSettings->DecimalPlaces, ratio );
-
-				sNextString = numBuffer;
-			}
+				sNextString = sDecimalText;
 			else
 			{
 				sNextString = TCBase::EasyIToA( _equivalentFraction.Numerator );
@@ -218,10 +178,13 @@ GameLogic::EBlockSelAction GameLogicFractions::OnBlockSelect( GameFieldBlock* pB
 			}
 
 			// If the string is changing then flash it to make it more noticeable
-			if( m_pGameGUILayout->GetLabelText(GUILayoutInGame::L_CurrentProd) != sNextString )
-				m_pGameGUILayout->FlashLabel(GUILayoutInGame::L_CurrentProd);
+			if( m_pGameGUILayout )
+			{
+				if( m_pGameGUILayout->GetLabelText(GUILayoutInGame::L_CurrentProd) != sNextString )
+					m_pGameGUILayout->FlashLabel(GUILayoutInGame::L_CurrentProd);
 
-			m_pGameGUILayout->SetLabelText( GUILayoutInGame::L_CurrentProd, sNextString.c_str() );
+				m_pGameGUILayout->SetLabelText( GUILayoutInGame::L_CurrentProd, sNextString.c_str() );
+			}
 
 			// Update the value counts
 			const BlockList& selectedBlocks = _pGameFieldFractions->GetSelectedBlocks();
@@ -256,14 +219,7 @@ GameLogic::EBlockSelAction GameLogicFractions::OnBlockSelect( GameFieldBlock* pB
 
 void GameLogicFractions::SetDifficulty( int32 difficulty )
 {
-	PopulateFractionModes();
-	
-	if( difficulty < 0 )
-		difficulty = 0;
-	else if( difficulty >= (int32)g_FractionModeSettings.size() )
-		difficulty = g_FractionModeSettings.size() - 1;
-
-	_pCurModeSettings = &g_FractionModeSettings[ difficulty ];
+	_pCurModeSettings = &FractionModeSettings::GetForDifficulty( difficulty );
 
 	int32 numFractions = _pCurModeSettings->AvailableFractions.size();
 	int32 maxFractionValue = _pCurModeSettings->MaxValue;
@@ -290,33 +246,15 @@ void GameLogicFractions::CalculatePossibleSolutionCounts()
 
 		const FractionModeSettings::FractionInfo& curFractionInfo = _pCurModeSettings->AvailableFractions[curFractionIndex];
 
-		for( std::set<int32>::const_iterator iterNumerator = curFractionInfo.ValuesUpToMax.begin();
-				iterNumerator != curFractionInfo.ValuesUpToMax.end();
-				++iterNumerator )
+		// Go through the numerator and denominator values that are equivalent to the fraction
+		for( uint32 pairIndex = 0; pairIndex < curFractionInfo.SolutionPairs.size(); ++pairIndex )
 		{
-			// If there are no blocks of this value then skip it
-			if( _fractionValueCounts[*iterNumerator] == 0 )
-				continue;
-
-			std::set<int32>::const_iterator iterDenominator = iterNumerator;
-			for( ++iterDenominator;
-				iterDenominator != curFractionInfo.ValuesUpToMax.end();
-				++iterDenominator )
-			{
-				// If there are no blocks of this value then skip it
-				if( _fractionValueCounts[*iterDenominator] == 0 )
-					continue;
+			const Fraction& valuePair = curFractionInfo.SolutionPairs[pairIndex];
 
-				// If this combination of numerator and denominator values isn't equivalent to the
-				// fraction we are testing then skip it
-				if( !IsEquivalentFraction(*iterNumerator, *iterDenominator, curFractionInfo.FractionValue.Numerator, curFractionInfo.FractionValue.Denominator ) )
-					continue;
+			// Get the number of possible fractions that can be selected for the current fraction
+			uint8 minFractionValueCount = std::min(_fractionValueCounts[valuePair.Numerator], _fractionValueCounts[valuePair.Denominator]);
 
-				// Get the number of possible fractions that can be selected for the current fraction
-				uint8 minFractionValueCount = std::min(_fractionValueCounts[*iterNumerator], _fractionValueCounts[*iterDenominator]);
-
-				_solutionFractionPossibilities[curFractionIndex] += minFractionValueCount;
-			}
+			_solutionFractionPossibilities[curFractionIndex] += minFractionValueCount;
 		}
 	}
 }
@@ -404,7 +342,8 @@ bool GameLogicFractions::SubclassInit()
 	_pGameFieldFractions->DropNewBlocks( GenerateBlocksToFieldWidth() );
 
 	//TODO localize
-	m_pGameGUILayout->SetLabelText( GUILayoutInGame::L_CurrentProdName, L"Find An Equivalent Of:" );
+	if( m_pGameGUILayout )
+		m_pGameGUILayout->SetLabelText( GUILayoutInGame::L_CurrentProdName, L"Find An Equivalent Of:" );
 
 	_equivalentFraction = GetNextFraction();
 
@@ -412,7 +351,8 @@ bool GameLogicFractions::SubclassInit()
 	sNextString += L"/";
 	sNextString += TCBase::EasyIToA( _equivalentFraction.Denominator );
 
-	m_pGameGUILayout->SetLabelText( GUILayoutInGame::L_CurrentProd, sNextString.c_str() );
+	if( m_pGameGUILayout )
+		m_pGameGUILayout->SetLabelText( GUILayoutInGame::L_CurrentProd, sNextString.c_str() );
 
 	return true;
 }
@@ -451,21 +391,11 @@ GameFieldBlockFraction* GameLogicFractions::GenerateBlock( int32 maxBlockWidth )
 	return pNewBlock;
 }
 
-template<class T>
-int32 PickRandom(T values)
+/// Get the number of blocks on the field with a value scaled by the number of times the value is
+/// needed by the fraction's equivalents
+uint8 GameLogicFractions::GetScaledValueCount( const FractionModeSettings::FractionInfo& fraction, uint32 valueIndex ) const
 {
-	uint32 randIndex = (uint32)rand() % values.size();
-
-	uint32 valueIndex = 0;
-	for( typename T::iterator iterValue = values.begin(); iterValue != values.end(); ++iterValue )
-	{
-		if( valueIndex == randIndex )
-			return *iterValue;
-
-		++valueIndex;
-	}
-
-	return -1;
+	return _fractionValueCounts[ fraction.ValuesUpToMax[valueIndex] ] / fraction.ValueScalars[valueIndex];
 }
 
 int32 GameLogicFractions::GetNextFractionBlockValue( int32 maxBlockWidth ) const
@@ -483,42 +413,51 @@ int32 GameLogicFractions::GetNextFractionBlockValue( int32 maxBlockWidth ) const
 	}
 
 	const FractionModeSettings::FractionInfo& fraction = _pCurModeSettings->AvailableFractions[lowestChanceFractionIndex];
-	
-	uint8 lowestValueCount = 255;
-	std::list<int32> lowestValues;
+	const uint32 numValues = (uint32)fraction.ValuesUpToMax.size();
 
-	for( std::set<int32>::const_iterator iterValue = fraction.ValuesUpToMax.begin(); iterValue != fraction.ValuesUpToMax.end(); ++iterValue )
+	// Find the lowest scaled count and how many values have it
+	uint8 lowestValueCount = 255;
+	uint32 numLowestValues = 0;
+	for( uint32 valueIndex = 0; valueIndex < numValues; ++valueIndex )
 	{
-		if( maxBlockWidth < 2 && *iterValue > 99 )
+		if( maxBlockWidth < 2 && fraction.ValuesUpToMax[valueIndex] > 99 )
 			continue;
 
-		// Scale the value count by the number of times it's need by the fractions
-		uint8 numOfThisValueOnTheFieldScaled = _fractionValueCounts[*iterValue];
-		numOfThisValueOnTheFieldScaled /= fraction.ValueScalars.find(*iterValue)->second;
-		
+		uint8 numOfThisValueOnTheFieldScaled = GetScaledValueCount( fraction, valueIndex );
 		if( numOfThisValueOnTheFieldScaled < lowestValueCount )
 		{
-			lowestValues.clear();
-			lowestValues.push_back( *iterValue );
 			lowestValueCount = numOfThisValueOnTheFieldScaled;
+			numLowestValues = 1;
 		}
 		else if( numOfThisValueOnTheFieldScaled == lowestValueCount )
-			lowestValues.push_back( *iterValue );
+			numLowestValues++;
 	}
 
-	if( lowestValues.size() == 0 )
-		return PickRandom(fraction.ValuesUpToMax);
+	if( numLowestValues == 0 )
+		return fraction.ValuesUpToMax[ m_Random.NextBelow( numValues ) ];
 
-	// Pick one of the values at ranom
-	return PickRandom(lowestValues);
+	// Pick one of the values at random by its position among the lowest
+	uint32 lowestIndex = m_Random.NextBelow( numLowestValues );
+	for( uint32 valueIndex = 0; valueIndex < numValues; ++valueIndex )
+	{
+		if( maxBlockWidth < 2 && fraction.ValuesUpToMax[valueIndex] > 99 )
+			continue;
+
+		if( GetScaledValueCount( fraction, valueIndex ) != lowestValueCount )
+			continue;
+
+		if( lowestIndex == 0 )
+			return fraction.ValuesUpToMax[valueIndex];
+		--lowestIndex;
+	}
+
+	return -1;
 }
 
 
 /// Generate blocks up to a certain width
 GameFieldBlockMultBase** GameLogicFractions::GenerateBlocksToFieldWidth()
 {
-	static GameFieldBlockMultBase* s_FieldBlocks[ GameFieldMultBase::FIELD_WIDTH + 1 ] = {0};
-
 	CalculatePossibleSolutionCounts();
 
 	// Create as many blocks as needed to fill a row
@@ -533,7 +472,7 @@ GameFieldBlockMultBase** GameLogicFractions::GenerateBlocksToFieldWidth()
 		pNewBlock->colIndex = curWidth;
 
 		// Store the new block
-		s_FieldBlocks[curBlockIndex++] = pNewBlock;
+		m_GeneratedRow[curBlockIndex++] = pNewBlock;
 
 		// Add in the new block's width to the current width
 		curWidth += pNewBlock->size.x;
@@ -542,13 +481,13 @@ GameFieldBlockMultBase** GameLogicFractions::GenerateBlocksToFieldWidth()
 	// Clear the rest of the game field block pointers in the static arrays for safety
 	do
 	{
-		s_FieldBlocks[ curBlockIndex ] = NULL;
+		m_GeneratedRow[ curBlockIndex ] = NULL;
 	}while( ++curBlockIndex < GameFieldMultBase::FIELD_WIDTH );
 
 	CalculatePossibleSolutionCounts();
 
 	// Return the array
-	return s_FieldBlocks;
+	return m_GeneratedRow;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -565,105 +504,3 @@ GameLogicFractions::~GameLogicFractions()
 		_pGameFieldFractions = NULL;
 	}
 }
-
-void PopulateFractionModes()
-{
-	int32 minDiffOffset = (int32)GameDefines::GPDL_Pre3;
-
-	for( int32 diffValue = (int32)GameDefines::GPDL_Pre3; diffValue < (int32)GameDefines::GPDL_5; ++diffValue )
-	{
-		std::list<Fraction> fractions;
-		fractions.push_back( Fraction(1,3) );
-
-		int32 maxValue = 9;
-		if( diffValue < (int32)GameDefines::GPDL_3 )
-		{
-			fractions.push_back( Fraction(1,2) );
-		}
-		else
-		{
-			fractions.push_back( Fraction(2,4) );
-		
-			if( diffValue == (int32)GameDefines::GPDL_3 )
-				maxValue = 13;
-			else if( diffValue == (int32)GameDefines::GPDL_4 )
-			{
-				maxValue = 16;
-				fractions.push_back( Fraction(1,4) );
-			}
-		}
-
-		g_FractionModeSettings[diffValue - minDiffOffset] = FractionModeSettings(1, maxValue, fractions );
-	}
-
-	for( int32 diffValue = (int32)GameDefines::GPDL_5; diffValue < (int32)GameDefines::GPDL_8; ++diffValue )
-	{
-		std::list<Fraction> fractions;
-		fractions.push_back( Fraction(1,5) );
-		fractions.push_back( Fraction(1,6) );
-		fractions.push_back( Fraction(2,6) );
-		fractions.push_back( Fraction(3,6) );
-		fractions.push_back( Fraction(4,6) );
-		fractions.push_back( Fraction(2,8) );
-		fractions.push_back( Fraction(6,9) );
-
-		int32 maxValue = 30;
-
-		if( diffValue >= (int32)GameDefines::GPDL_6 )
-		{
-			maxValue = 36;
-			fractions.push_back( Fraction(6,8) );
-		}
-		
-		// Not an else if because we want to add on to the previous if statement
-		if( diffValue == (int32)GameDefines::GPDL_7 )
-		{
-			maxValue = 41;
-			fractions.push_back( Fraction(5,6) );
-		}
-
-		g_FractionModeSettings[diffValue - minDiffOffset] = FractionModeSettings(2, maxValue, fractions );
-	}
-
-	for( int32 diffValue = (int32)GameDefines::GPDL_8; diffValue <= (int32)GameDefines::GPDL_Secret2; ++diffValue )
-	{
-		std::list<Fraction> fractions;
-		fractions.push_back( Fraction(1,8) );
-		fractions.push_back( Fraction(3,8) );
-		fractions.push_back( Fraction(5,8) );
-		fractions.push_back( Fraction(7,8) );
-		fractions.push_back( Fraction(1,7) );
-		fractions.push_back( Fraction(2,7) );
-		fractions.push_back( Fraction(3,7) );
-		fractions.push_back( Fraction(4,7) );
-		fractions.push_back( Fraction(6,7) );
-		fractions.push_back( Fraction(1,9) );
-		fractions.push_back( Fraction(2,9) );
-		fractions.push_back( Fraction(4,9) );
-		fractions.push_back( Fraction(5,9) );
-		
-		
-
-		int32 maxValue = 54;
-
-		if( diffValue >= (int32)GameDefines::GPDL_Post8 )
-		{
-			maxValue = 61;
-			fractions.push_back( Fraction(5,7) );
-		}
-
-		if( diffValue >= (int32)GameDefines::GPDL_Secret1 )
-		{
-			maxValue = 110;
-			fractions.push_back( Fraction(7,9) );
-		}
-
-		if( diffValue >= (int32)GameDefines::GPDL_Secret2 )
-		{
-			maxValue = 150;
-			fractions.push_back( Fraction(8,9) );
-		}
-
-		g_FractionModeSettings[diffValue - minDiffOffset] = FractionModeSettings(3, maxValue, fractions );
-	}	
-}
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "../PIISetPushSpeed.h"
 #include "../GameMgr.h"
 #include "../GameFieldMultBase.h"
+#include "Base/Serializer.h"
 
 
 const float32 SPEED_KEY_SPEED = GameDefines::BLOCK_HEIGHT * 4.0f;
@@ -23,6 +24,21 @@ const float32 SPEED_KEY_SPEED = GameDefines::BLOCK_HEIGHT * 4.0f;
 const ResourceID RESID_SND_RAISE = 130;
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  GameLogicNormalBase::SubclassSerializeState  Protected
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the data is invalid
+///
+///	Save/load the level and if the push is accelerated for a game state snapshot.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameLogicNormalBase::SubclassSerializeState( Serializer& serializer )
+{
+	serializer.AddData( m_CurrentLevel );
+	serializer.AddData( m_IsPushAccelerated );
+	return true;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //  GameLogicNormalBase::SubclassUpdate  Private
 ///	\param frameTime The elapsed frame time
@@ -17,22 +17,18 @@
 #include "../GameMgr.h"
 #include "Base/MsgLogger.h"
 #include "Base/TCAssert.h"
+#include "Base/ProfileTimer.h"
 #include "../ProfileSubsetMultiplication.h"
 #include "../GUILayout_Game.h"
 #include "../PIISetPushSpeed.h"
+#include "../BlockFaceCache.h"
+#include "Base/Serializer.h"
 
 const ResourceID RESID_SND_RIGHTPROD = 131;
 const ResourceID RESID_SND_WRONGPROD = 132;
 
 const uint32 NUM_COMBO_FOR_0x = 5;
 
-bool RandomSuccess( int32 percentChance )
-{
-	if( (rand() % 100) < percentChance )
-		return true;
-
-	return false;
-}
 
 
 /// The destructor
@@ -47,6 +43,42 @@ GameLogicProduct::~GameLogicProduct()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicProduct::LoadSolver  Protected
+///
+///	Load the factors and products that are on the field into the solver. In Prime Time the
+///	combo block can be used as a factor.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameLogicProduct::LoadSolver()
+{
+	GameFieldBlock* pComboBlock = 0;
+	if( (m_GameType & GameDefines::GT_Mask_Type) == GameDefines::GT_PrimeTime )
+		pComboBlock = reinterpret_cast<GameFieldPrimeTime*>( m_pGameFieldMult )->GetComboBlock();
+
+	m_Solver.LoadProductField( m_pGameFieldMult, pComboBlock );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicProduct::CountSolvableProducts  Public
+///
+///	\returns The number of products on the field that can be cleared with the factors on the
+///	field
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 GameLogicProduct::CountSolvableProducts()
+{
+	if( !m_pGameFieldMult )
+		return 0;
+
+	LoadSolver();
+	return m_Solver.CountSolvableTargets( EquationSolver::ET_Product );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  GameLogicProduct::GetSelectedProduct  Private
@@ -551,20 +583,14 @@ void GameLogicProduct::SetDifficulty( int32 level )
 
 	// Get the new product filter
 	m_ProdFilter = GetFilterFromDiff( GameMgr::Get().GetGameplayDiff(), level );
-
-	// Add up the prime weights to be used when generating a prime
-	m_PrimeRandRange = 0;
-	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
-	{
-		if( (m_ProdFilter.useablePrimes & (1 << primeIndex)) != 0 )
-			m_PrimeRandRange += GameDefines::PRIME_WEIGHTS[primeIndex];
-	}
+	if( !GameMgr::Get().GetDiffTuning().IsDefault() )
+		GameMgr::Get().GetDiffTuning().ApplyToFilter( m_ProdFilter );
 
 	// Get the new array of products
-	m_GeneratableProducts = GameDefines::GetProductArraySubset( m_ProdFilter );
+	GameDefines::ProductArray generatableProducts = GameDefines::GetProductArraySubset( m_ProdFilter );
 
 	// Ensure a valid array
-	if( m_GeneratableProducts.size() == 0 )
+	if( generatableProducts.size() == 0 )
 	{
 		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to generate a valid subset." );
 
@@ -574,8 +600,15 @@ void GameLogicProduct::SetDifficulty( int32 level )
 		tempProd.primeFactors.push_back( 2 );
 		tempProd.primeFactors.push_back( 2 );
 		tempProd.primeFactors.push_back( 3 );
-		m_GeneratableProducts.push_back( tempProd );
+		generatableProducts.push_back( tempProd );
 	}
+
+	// Rebuild the tables used to draw the products and weighted primes
+	m_BlockSampler.SetProducts( generatableProducts, m_ProdFilter.useablePrimes );
+
+	// Start rendering the faces of the new products before they appear
+	if( !GameMgr::Get().IsHeadless() )
+		BlockFaceCache::Get().QueueProducts( generatableProducts );
 }
 
 
@@ -597,6 +630,8 @@ bool GameLogicProduct::SubclassInit()
 	m_ComboCount = 0;
 	m_CurrentLevel = 1;
 	m_ReadyFor0xBlock = false;
+	m_NumBlocksGenerated = 0;
+	m_NumProductFallbacks = 0;
 	
 	// If there is a field then clear it
 	if( m_pGameFieldMult )
@@ -662,6 +697,87 @@ bool GameLogicProduct::SubclassInit()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicProduct::SubclassSerializeState  Protected
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the data is invalid
+///
+///	Save/load the score, the session stats and the product generation state for a game state
+///	snapshot. The products blocks are drawn from are stored since they change with the level.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameLogicProduct::SubclassSerializeState( Serializer& serializer )
+{
+	if( !GameLogicNormalBase::SubclassSerializeState( serializer ) )
+		return false;
+
+	serializer.AddData( m_NumCompletedEquations );
+	serializer.AddData( m_IsGameDone );
+	serializer.AddData( m_Score );
+	serializer.AddData( m_ComboCount );
+
+	// The session's start time is the wall clock time the game was started, which differs each
+	// time a replay is played, so it is left out of the snapshot and a restored game keeps its own
+	struct tm sessionStartTime = m_CurSessionStats.m_SessionStartTime;
+	memset( &m_CurSessionStats.m_SessionStartTime, 0, sizeof(m_CurSessionStats.m_SessionStartTime) );
+	bool statsSerialized = m_CurSessionStats.Serialize_V1( serializer, GameDefines::NUM_PRIMES );
+	m_CurSessionStats.m_SessionStartTime = sessionStartTime;
+	if( !statsSerialized )
+		return false;
+
+	// The product generation
+	m_ProdFilter.Serialize( serializer );
+	serializer.AddData( m_IsPractice );
+	serializer.AddData( m_ShowProductPreview );
+	serializer.AddData( m_ReadyFor0xBlock );
+	serializer.AddData( m_NumProducts );
+	serializer.AddData( m_NumPrimes );
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+		serializer.AddData( m_PrimeOffsets[ primeIndex ] );
+	serializer.AddData( m_NumBlocksGenerated );
+	serializer.AddData( m_NumProductFallbacks );
+
+	GameDefines::ProductArray products = m_BlockSampler.GetProducts();
+	uint32 numProducts = (uint32)products.size();
+	serializer.AddData( numProducts );
+	if( serializer.InReadMode() )
+		products.resize( numProducts );
+	for( uint32 prodIndex = 0; prodIndex < numProducts; ++prodIndex )
+	{
+		GameDefines::ProductEntry& prodEntry = products[ prodIndex ];
+		serializer.AddData( prodEntry.product );
+		serializer.AddData( prodEntry.usedPrimeFlags );
+
+		uint32 numFactors = (uint32)prodEntry.primeFactors.size();
+		serializer.AddData( numFactors );
+		if( serializer.InReadMode() )
+			prodEntry.primeFactors.resize( numFactors );
+		for( uint32 factorIndex = 0; factorIndex < numFactors; ++factorIndex )
+			serializer.AddData( prodEntry.primeFactors[ factorIndex ] );
+	}
+
+	if( serializer.InReadMode() )
+	{
+		m_BlockSampler.SetProducts( products, m_ProdFilter.useablePrimes );
+		if( !GameMgr::Get().IsHeadless() )
+			BlockFaceCache::Get().QueueProducts( products );
+
+		// Show the restored values
+		if( m_pGameGUILayout )
+		{
+			m_pGameGUILayout->SetScore( m_CurSessionStats.m_Score );
+			m_pGameGUILayout->SetLevel( m_CurrentLevel );
+			m_pGameGUILayout->SetCount( m_NumCompletedEquations );
+			m_pGameGUILayout->SetComboCount( m_ComboCount );
+		}
+	}
+
+	return true;
+}
+
+
 /// Setup the ceiling field
 void GameLogicProduct::SetupCeilingField()
 {
@@ -683,7 +799,7 @@ void GameLogicProduct::SetupCeilingField()
 		int32 minColOffset = MAX_CEILING_OFFSET;
 		for( int32 colIndex = 0; colIndex < GameField::FIELD_WIDTH; ++colIndex )
 		{
-			ceilingOffsets[colIndex] = rand() % MAX_CEILING_OFFSET;
+			ceilingOffsets[colIndex] = (int32)m_Random.NextBelow( MAX_CEILING_OFFSET );
 			if( ceilingOffsets[colIndex] < minColOffset )
 				minColOffset = ceilingOffsets[colIndex];
 		}
@@ -784,9 +900,12 @@ void GameLogicProduct::Term()
 	if( pProfile )
 		pMultiplicationProfile = (ProfileSubsetMultiplication*)pProfile->GetSubset( ProfileSubsetMultiplication::SUBSET_ID );
 
-	// End the session with the profile
+	// End the session with the profile, saving only appends the session to the profile's journal
 	if( pMultiplicationProfile )
+	{
 		pMultiplicationProfile->StoreSession( m_CurSessionStats );
+		pProfile->SaveToFile();
+	}
 
 	// Stop the raise sound if there is one
 	if( _playingRaiseSound.IsValid() )
@@ -805,12 +924,10 @@ void GameLogicProduct::Term()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 GameFieldBlockMultBase** GameLogicProduct::GenerateBlocksToFieldWidth()
 {
-	static GameFieldBlockMultBase* s_FieldBlocks[ GameField::FIELD_WIDTH + 1 ] = {0};
-
 	// If it is time to generate a 0x block then determine what index to place the block
 	int32 block0xPos = GameField::FIELD_WIDTH;
 	if( m_ReadyFor0xBlock )
-		block0xPos = rand() % GameField::FIELD_WIDTH;
+		block0xPos = (int32)m_Random.NextBelow( GameField::FIELD_WIDTH );
 
 	// Create as many blocks as needed to fill a row
 	int32 curWidth = 0;
@@ -839,7 +956,7 @@ GameFieldBlockMultBase** GameLogicProduct::GenerateBlocksToFieldWidth()
 		pNewBlock->colIndex = curWidth;
 
 		// Store the new clock
-		s_FieldBlocks[curBlockIndex++] = pNewBlock;
+		m_GeneratedRow[curBlockIndex++] = pNewBlock;
 
 		// Add in the new block's width to the current width
 		curWidth += pNewBlock->size.x;
@@ -848,11 +965,11 @@ GameFieldBlockMultBase** GameLogicProduct::GenerateBlocksToFieldWidth()
 	// Clear the rest of the game field block pointers in the static arrays for safety
 	do
 	{
-		s_FieldBlocks[ curBlockIndex ] = NULL;
+		m_GeneratedRow[ curBlockIndex ] = NULL;
 	}while( ++curBlockIndex < GameField::FIELD_WIDTH );
 
 	// Return the array
-	return s_FieldBlocks;
+	return m_GeneratedRow;
 }
 
 
@@ -873,8 +990,8 @@ void GameLogicProduct::InitPractice( GameDefines::ProductSubsetFilter prodFilter
 	m_ProdFilter = prodFilter;
 
 	// Generate the products
-	m_GeneratableProducts = GameDefines::GetProductArraySubset( m_ProdFilter );
-	if( m_GeneratableProducts.size() == 0 )
+	GameDefines::ProductArray generatableProducts = GameDefines::GetProductArraySubset( m_ProdFilter );
+	if( generatableProducts.size() == 0 )
 	{
 		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to generate a valid subset for practice mode." );
 
@@ -883,8 +1000,11 @@ void GameLogicProduct::InitPractice( GameDefines::ProductSubsetFilter prodFilter
 		tempProd.product = 4;
 		tempProd.primeFactors.push_back( 2 );
 		tempProd.primeFactors.push_back( 2 );
-		m_GeneratableProducts.push_back( tempProd );
+		generatableProducts.push_back( tempProd );
 	}
+	m_BlockSampler.SetProducts( generatableProducts, m_ProdFilter.useablePrimes );
+	if( !GameMgr::Get().IsHeadless() )
+		BlockFaceCache::Get().QueueProducts( generatableProducts );
 
 	// Update the layout
 	//if( m_pGameGUILayout )
@@ -900,6 +1020,8 @@ void GameLogicProduct::InitPractice( GameDefines::ProductSubsetFilter prodFilter
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 GameFieldBlockProduct* GameLogicProduct::GenerateBlock( int32 maxWidth )
 {
+	PROFILE_SCOPE( "GameLogicProduct::GenerateBlock" );
+
 	// Get the value
 	int32 value = 2;
 	ResourceID spriteResID = RESID_SPRITE_2_BLOCK;
@@ -909,7 +1031,7 @@ GameFieldBlockProduct* GameLogicProduct::GenerateBlock( int32 maxWidth )
 	// 75% of the time we will generate a block that helps the player
 	bool forceGenerateProduct = false;
 	uint32 forceGeneratePrimeIndex = GameDefines::NUM_PRIMES;
-	if( m_IsPractice || RandomSuccess(CHANCE_OF_NEEDED) )
+	if( m_IsPractice || m_Random.Chance( CHANCE_OF_NEEDED ) )
 	{
 		// Go through the primes and see which are in demand
 		for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
@@ -925,7 +1047,7 @@ GameFieldBlockProduct* GameLogicProduct::GenerateBlock( int32 maxWidth )
 				if( m_PrimeOffsets[ primeIndex ] < m_PrimeOffsets[forceGeneratePrimeIndex] )
 					forceGeneratePrimeIndex = primeIndex;
 				// Else if the two are equal then give a 50% chance to use this prime
-				else if( m_PrimeOffsets[ primeIndex ] == m_PrimeOffsets[forceGeneratePrimeIndex] && RandomSuccess(50) )
+				else if( m_PrimeOffsets[ primeIndex ] == m_PrimeOffsets[forceGeneratePrimeIndex] && m_Random.Chance( 50 ) )
 					forceGeneratePrimeIndex = primeIndex;
 			}
 			// Else store this index
@@ -939,79 +1061,48 @@ GameFieldBlockProduct* GameLogicProduct::GenerateBlock( int32 maxWidth )
 	}
 
 	// A 25% chance to make a product
-	bool shouldMakeProduct = (RandomSuccess(25) || forceGenerateProduct) && forceGeneratePrimeIndex == GameDefines::NUM_PRIMES;
+	bool shouldMakeProduct = (m_Random.Chance( 25 ) || forceGenerateProduct) && forceGeneratePrimeIndex == GameDefines::NUM_PRIMES;
+
+	// If there is no product that fits in the space left in the row then make a prime instead
+	if( shouldMakeProduct && !m_BlockSampler.CanDrawProduct( maxWidth ) )
+	{
+		shouldMakeProduct = false;
+		m_NumProductFallbacks++;
+	}
+
 	if( shouldMakeProduct )
 	{
-		// Use the empty block sprite
-		spriteResID = RESID_SPRITE_PRODUCT_BLOCK;
-		uint32 productIndex = (uint32)(rand() % m_GeneratableProducts.size());
-		
-		// Store the value
-		value = m_GeneratableProducts[ productIndex ].product;
-		if( value > 99 )
-		{
-			// If the width needs to be capped then don't allow a large number
-			if( maxWidth < 2 )
-			{
-				productIndex = 0;
-				value = m_GeneratableProducts[ productIndex ].product;
+		// Draw a product that fits within the width left in the row
+		uint32 productIndex = m_BlockSampler.DrawProductIndex( maxWidth, m_Random );
+		const GameDefines::ProductEntry& productEntry = m_BlockSampler.GetProducts()[ productIndex ];
 
-				// If the backup product is still too large
-				if( value > 99 )
-				{
-					// Generate a prime
-					shouldMakeProduct = false;
-					goto MakePrime;
-				}
-			}
-			else
-				spriteResID = RESID_SPRITE_DOUBLE_PRODUCT_BLOCK;
-		}
+		// Store the value and use the empty block sprite
+		value = productEntry.product;
+		spriteResID = RESID_SPRITE_PRODUCT_BLOCK;
+		if( value > ProductBlockSampler::MAX_NARROW_PRODUCT )
+			spriteResID = RESID_SPRITE_DOUBLE_PRODUCT_BLOCK;
 
-		// If a product is still being generated
-		if( shouldMakeProduct )
+		// Update the prime value counts by decrement the offset.  We added a product so we
+		// decrement the count to mean we need one more.
+		for( uint32 factorIndex = 0; factorIndex < productEntry.primeFactors.size(); ++factorIndex )
 		{
-			// Update the prime value counts by decrement the offset.  We added a product so we
-			// decrement the count to mean we need one more.
-			for( uint32 factorIndex = 0; factorIndex < m_GeneratableProducts[ productIndex ].primeFactors.size(); ++factorIndex )
-			{
-				uint32 primeIndex = GameDefines::PrimeToIndex( m_GeneratableProducts[ productIndex ].primeFactors[factorIndex] );
-				m_PrimeOffsets[ primeIndex ]--;
-			}
-
-			// Keep track of the number of products
-			m_NumProducts++;
+			uint32 primeIndex = GameDefines::PrimeToIndex( productEntry.primeFactors[factorIndex] );
+			m_PrimeOffsets[ primeIndex ]--;
 		}
+
+		// Keep track of the number of products
+		m_NumProducts++;
 	}
 	// Else we are generating a prime number
 	else
 	{
-MakePrime:
 		uint32 createPrimeIndex = 0;
 		// If a specific prime is to be generated
 		if( forceGeneratePrimeIndex != GameDefines::NUM_PRIMES )
 			createPrimeIndex = forceGeneratePrimeIndex;
-		// Else randomly generate the prime
+		// Else draw a prime using the prime weights
 		else
-		{
-			uint32 randValue = (uint32)rand() % m_PrimeRandRange;
-			uint32 randSum = 0;
-			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
-			{
-				// If this product is not used then skip it
-				if( (m_ProdFilter.useablePrimes & (1 << primeIndex)) == 0 )
-					continue;
-
-				randSum += GameDefines::PRIME_WEIGHTS[primeIndex];
-
-				// If the value is in this range then use the prime
-				if( randSum > randValue )
-				{
-					createPrimeIndex = primeIndex;
-					break;
-				}
-			}
-		}
+			createPrimeIndex = m_BlockSampler.DrawPrimeIndex( m_Random );
 
 		// Store the value
 		value = GameDefines::PRIMES[ createPrimeIndex ];
@@ -1024,6 +1115,8 @@ MakePrime:
 		m_NumPrimes++;
 	}
 
+	m_NumBlocksGenerated++;
+
 	// Create the new block
 	GameFieldBlockProduct* pNewBlock = new GameFieldBlockProduct( value, shouldMakeProduct );
 
@@ -128,6 +128,77 @@ GameFieldBlockMultBase** GameLogicTutorPT::GenerateBlocksToFieldWidth()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicTutorPT::SubclassUpdate  Protected
+///
+///	\param frameTime The elapsed frame time
+///
+///	Update the tutorial and then the hint for the current step.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameLogicTutorPT::SubclassUpdate( float32 frameTime )
+{
+	BaseType::SubclassUpdate( frameTime );
+
+	UpdateHintNote();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameLogicTutorPT::UpdateHintNote  Protected
+///
+///	If the current step is to clear a product then add factors on the field that clear it to
+///	the tutorial note. The factors are only looked for again when the step or the number of
+///	factors that can be clicked changes.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameLogicTutorPT::UpdateHintNote()
+{
+	if( m_CurStepIndex >= m_Steps.size() || !m_pGameGUILayout || m_pMsgBox )
+		return;
+
+	const Step& curStep = m_Steps[m_CurStepIndex];
+	if( curStep.goal.goalType != GT_ClearProduct )
+		return;
+
+	LoadSolver();
+	uint32 numBlocks = m_Solver.GetNumBlocks();
+	if( m_CurStepIndex == m_HintStepIndex && numBlocks == m_HintNumBlocks )
+		return;
+	bool isNewStep = m_CurStepIndex != m_HintStepIndex;
+	m_HintStepIndex = m_CurStepIndex;
+	m_HintNumBlocks = numBlocks;
+
+	// Find the factors
+	EquationSolver::BlockMask solution = m_Solver.FindSolution( EquationSolver::ET_Product, curStep.goal.data.clearProduct );
+
+	std::wstring sNote = curStep.sNoteText;
+	if( solution != 0 )
+	{
+		const uint32 BUF_SIZE = 16;
+		wchar_t szValue[ BUF_SIZE ];
+		for( uint32 blockIndex = 0; blockIndex < m_Solver.GetNumBlocks(); ++blockIndex )
+		{
+			if( (solution & ((EquationSolver::BlockMask)1 << blockIndex)) == 0 )
+				continue;
+
+			swprintf( szValue, BUF_SIZE, L"%d", m_Solver.GetBlock( blockIndex )->GetValue() );
+			sNote += (sNote.length() > curStep.sNoteText.length()) ? L" x " : L" (";
+			sNote += szValue;
+		}
+		sNote += L")";
+	}
+
+	if( isNewStep || sNote != m_sHintNote )
+	{
+		m_sHintNote = sNote;
+		m_pGameGUILayout->SetNoteText( m_sHintNote.c_str() );
+	}
+}
+
+
 /// A message handler for when a block is selected that contains the mode-specific logic
 GameLogic::EBlockSelAction GameLogicTutorPT::OnBlockSelect( GameFieldBlock* pBlock )
 {
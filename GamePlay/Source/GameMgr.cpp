@@ -14,6 +14,7 @@
 #include "../GameFieldMultBase.h"
 #include "../GameFieldAdd.h"
 #include "../GameFieldBlock.h"
+#include "../GameFieldInstruction.h"
 #include "../GameLogicProduct.h"
 #include "../GameLogicFractions.h"
 #include "../GameLogicAdd.h"
@@ -22,6 +23,7 @@
 #include "GUI/GUIDefines.h"
 #include "GUI/GUIMessages.h"
 #include "Base/TCAssert.h"
+#include "Base/ProfileTimer.h"
 #include "GUI/GUIMgr.h"
 #include "../PlayerProfile.h"
 #include "../ProfileSubsetMultiplication.h"
@@ -35,18 +37,58 @@
 #include "Base/FileFuncs.h"
 #include "../../PrimeTime/ResourceIDs.h"
 #include "PrimeTime/ApplicationBase.h"
+#include "../InstructionStreamReplay.h"
+#include "../GameContext.h"
+#include "Base/Serializer.h"
 
 extern const ResourceID g_MenuMusicResID;
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameMgr::Get  Static Public
+///
+///	\returns The game manager of the game context bound to the calling thread, or the process
+///				wide game manager if no context is bound
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GameMgr& GameMgr::Get()
+{
+	GameContext* pContext = GameContext::GetCurrent();
+	if( pContext )
+		return pContext->GetGameMgr();
+
+	static GameMgr s_Mgr;
+	return s_Mgr;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  GameMgr::StartGame  Public
 ///
-///	Start a new game.
+///	Start a new game with a newly generated random seed.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameMgr::StartGame( GameDefines::EGameType gameType, GameDefines::ProductSubsetFilter filter )
+{
+	// Every game gets its own random sequence
+	StartGame( gameType, TCBase::RandomGen::GenerateSeed(), filter );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameMgr::StartGame  Public
+///
+///	\param gameType The type of game to start
+///	\param seed The random seed, the same seed and player input will play the same game
+///	\param filter The product filter used for practice games
+///
+///	Start a new game.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameMgr::StartGame( GameDefines::EGameType gameType, uint64 seed, GameDefines::ProductSubsetFilter filter )
 {
 	m_IsInGame = true;
 	m_IsPaused = false;
@@ -55,30 +97,42 @@ void GameMgr::StartGame( GameDefines::EGameType gameType, GameDefines::ProductSu
 	// Clear data if we currently have any
 	Clear();
 
-	// Load the music
-	_bgm = ResourceMgr::Get().GetMusicStream( RESID_MUSIC_DISCO_MUSIC );
-	_bgmOverlay = ResourceMgr::Get().GetMusicStream( RESID_MUSIC_DISCO_OVERLAY_MUSIC );
+	m_GameSeed = seed;
+	m_GameFilter = filter;
 
-	// Stop the menu music
-	AudioMgr::Get().SetBGMusic( NULL );
-	
-	// Play the game music
-	if( _bgm.GetObj() )
-	{
-		_bgm.GetObj()->Play();
-		_bgm.GetObj()->SetVolume( 0.5f );
-	}
-	if( _bgmOverlay.GetObj() )
+	// Only the game started by StartReplay plays the replay file
+	if( !m_IsStartingReplay )
+		m_sReplayFile.clear();
+	m_IsStartingReplay = false;
+
+	// Headless games have no music and don't report to the server
+	if( !m_IsHeadless )
 	{
-		_bgmOverlay.GetObj()->Play();
-		_bgmOverlay.GetObj()->SetVolume( 0.0f );
-	}
+		// Load the music
+		_bgm = ResourceMgr::Get().GetMusicStream( RESID_MUSIC_DISCO_MUSIC );
+		_bgmOverlay = ResourceMgr::Get().GetMusicStream( RESID_MUSIC_DISCO_OVERLAY_MUSIC );
 
-	std::wstring sGameMsg = L"sng,";
-	sGameMsg += TCBase::EasyUIToAHex( (int32)gameType );
-	sGameMsg += L",";
-	sGameMsg += TCBase::EasyIToA( (int32)m_GameDiff );;
-	ApplicationBase::Get()->SendAppConnectMessage( sGameMsg.c_str() );
+		// Stop the menu music
+		AudioMgr::Get().SetBGMusic( NULL );
+		
+		// Play the game music
+		if( _bgm.GetObj() )
+		{
+			_bgm.GetObj()->Play();
+			_bgm.GetObj()->SetVolume( 0.5f );
+		}
+		if( _bgmOverlay.GetObj() )
+		{
+			_bgmOverlay.GetObj()->Play();
+			_bgmOverlay.GetObj()->SetVolume( 0.0f );
+		}
+
+		std::wstring sGameMsg = L"sng,";
+		sGameMsg += TCBase::EasyUIToAHex( (int32)gameType );
+		sGameMsg += L",";
+		sGameMsg += TCBase::EasyIToA( (int32)m_GameDiff );;
+		ApplicationBase::Get()->SendAppConnectMessage( sGameMsg.c_str() );
+	}
 
 	switch( gameType & GameDefines::GT_Mask_Type )
 	{
@@ -106,7 +160,7 @@ void GameMgr::StartGame( GameDefines::EGameType gameType, GameDefines::ProductSu
 				pProdLogic->InitPractice( filter );
 			
 			// Set the logic to work with this field
-			m_pGameLogic->Init( gameType, m_TimeLimit );
+			m_pGameLogic->Init( gameType, m_TimeLimit, m_GameSeed );
 		}
 		break;
 
@@ -118,7 +172,7 @@ void GameMgr::StartGame( GameDefines::EGameType gameType, GameDefines::ProductSu
 			else
 				m_pGameLogic = new GameLogicFractions();			
 
-			m_pGameLogic->Init( gameType, m_TimeLimit );
+			m_pGameLogic->Init( gameType, m_TimeLimit, m_GameSeed );
 		}
 		break;
 
@@ -131,7 +185,7 @@ void GameMgr::StartGame( GameDefines::EGameType gameType, GameDefines::ProductSu
 				m_pGameLogic = new GameLogicAdd();
 
 			// Set the logic to work with this field
-			m_pGameLogic->Init( gameType, m_TimeLimit );
+			m_pGameLogic->Init( gameType, m_TimeLimit, m_GameSeed );
 		}
 		break;
 
@@ -160,6 +214,12 @@ void GameMgr::Clear()
 		m_pGameLogic = NULL;
 	}
 
+#ifdef _DEBUG
+	// Every block and instruction belongs to a game so none should be left once it is freed
+	GameFieldBlock::GetPool().ReportLeaks();
+	GameFieldInstruction::GetPool().ReportLeaks();
+#endif
+
 	// Clear the background music
 	if( _bgm.GetObj() )
 		_bgm.GetObj()->Stop();
@@ -187,16 +247,30 @@ void GameMgr::Clear()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void GameMgr::Update( float frameTime )
 {
+	PROFILE_SCOPE( "GameMgr::Update" );
+
 	// If the game is to be ended
 	if( m_GameEndFlagged )
 	{
 		// The game is stopped
 		m_IsInGame = false;
 
+		// Let the instruction stream record how the game ended
+		if( m_pGameLogic && m_pGameLogic->GetGameField() && m_pGameLogic->GetGameField()->m_pInstStream )
+			m_pGameLogic->GetGameField()->m_pInstStream->OnGameEnd();
+
 		// Tell the logic to clean up
 		if( m_pGameLogic )
 			m_pGameLogic->Term();
 
+		// Headless games have no results screen or music to change, the logic is kept so the
+		// results can be read until Clear is called or the next game starts
+		if( m_IsHeadless )
+		{
+			m_GameEndFlagged = false;
+			return;
+		}
+
 		// If this game was not a tutorial then display the results
 		bool isTutorial = (GetGameType() & GameDefines::GT_Mask_Mod) == GameDefines::GT_Mod_Tutorial;
 		isTutorial |= (GetGameType() & GameDefines::GT_Mask_Mod) == GameDefines::GT_Mod_Tutorial2;
@@ -275,8 +349,12 @@ void GameMgr::Update( float frameTime )
 		m_TimePlayed = 0.0f;
 	
 		SetPauseState( false );
+
+		// A replay restarts the same game
+		if( m_sReplayFile.empty() )
+			m_GameSeed = TCBase::RandomGen::GenerateSeed();
 		if( m_pGameLogic )
-			m_pGameLogic->Init( m_pGameLogic->GetGameType(), m_TimeLimit );
+			m_pGameLogic->Init( m_pGameLogic->GetGameType(), m_TimeLimit, m_GameSeed );
 	}
 
 	// If there is a message box
@@ -313,6 +391,142 @@ void GameMgr::Update( float frameTime )
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameMgr::StartReplay  Public
+///
+///	\param szReplayFile The path to the replay file
+///	\returns True if the replay was started, false if the file is not a replay
+///
+///	Start the game a replay file recorded with the settings it was recorded with. The game's
+///	field plays the recorded instructions instead of the player's input.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameMgr::StartReplay( const wchar_t* szReplayFile )
+{
+	ReplayHeader header;
+	if( !szReplayFile || !InstructionStreamReplay::ReadHeader( szReplayFile, header ) )
+		return false;
+
+	if( header.tickTime != GameDefines::SIM_TICK_TIME )
+		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"The replay %s was recorded with a different tick length and may not play correctly.", szReplayFile );
+
+	m_GameDiff = header.gameDiff;
+	m_TimeLimit = header.timeLimit;
+
+	m_sReplayFile = szReplayFile;
+	m_IsStartingReplay = true;
+	StartGame( header.gameType, header.seed, header.filter );
+
+	return m_IsInGame;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameMgr::SeekReplay  Public
+///
+///	\param gameTime The game time to move the replay to in seconds
+///	\returns True if the replay was moved, false if the current game is not a replay
+///
+///	Move a replay to a point in the game. The game state is restored from the closest snapshot
+///	before the point, or the game is restarted if moving backwards without a snapshot, and the
+///	remaining ticks are simulated. Games without snapshots are simulated from the current tick
+///	when moving forward.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameMgr::SeekReplay( float32 gameTime )
+{
+	PROFILE_SCOPE( "GameMgr::SeekReplay" );
+
+	InstructionStreamReplay* pReplayStream = GetReplayStream();
+	if( !pReplayStream )
+		return false;
+
+	if( gameTime < 0.0f )
+		gameTime = 0.0f;
+	uint32 targetTick = (uint32)( gameTime / GameDefines::SIM_TICK_TIME + 0.5f );
+
+	uint32 curTick = pReplayStream->GetCurTick();
+
+	// Close the game over message box since the game continues from the new point
+	bool wasPaused = m_IsPaused && !m_pMsgBox;
+	PopupMsgBox( NULL, NULL, NULL );
+	m_GameEndFlagged = false;
+	SetPauseState( false );
+
+	// Restore a snapshot if it is closer than the current tick
+	uint32 snapshotTick = 0;
+	bool useSnapshot = m_pGameLogic->CanSerializeState()
+						&& pReplayStream->FindSnapshotTick( targetTick, snapshotTick )
+						&& (targetTick < curTick || snapshotTick > curTick);
+	bool restored = useSnapshot && pReplayStream->RestoreSnapshot( targetTick );
+
+	// If the replay can't move backwards from a snapshot, or a snapshot failed to restore and
+	// left the game invalid, then start the game over
+	if( !restored && (targetTick < curTick || useSnapshot) )
+	{
+		m_TimePlayed = 0.0f;
+		m_pGameLogic->Init( m_pGameLogic->GetGameType(), m_TimeLimit, m_GameSeed );
+
+		// Initializing the logic creates a new field and stream
+		pReplayStream = GetReplayStream();
+	}
+
+	// Simulate the remaining ticks, stopping if the game ends on the way
+	while( pReplayStream->GetCurTick() < targetTick && !m_IsPaused && !m_GameEndFlagged && !m_pMsgBox )
+	{
+		m_TimePlayed += GameDefines::SIM_TICK_TIME;
+		m_pGameLogic->Update( GameDefines::SIM_TICK_TIME );
+	}
+
+	if( wasPaused && !m_pMsgBox )
+		SetPauseState( true );
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameMgr::GetReplayStream  Public
+///
+///	\returns The instruction stream playing the current replay, NULL if the current game is not
+///				a replay
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+InstructionStreamReplay* GameMgr::GetReplayStream()
+{
+	if( m_sReplayFile.empty() || !m_pGameLogic || !m_pGameLogic->GetGameField() )
+		return 0;
+
+	// A game started for a replay always plays it through a replay stream
+	return (InstructionStreamReplay*)m_pGameLogic->GetGameField()->m_pInstStream;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameMgr::SerializeGameState  Public
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the state was saved or loaded, false if the game can't save its state or
+///				the data is invalid
+///
+///	Save/load the complete state of the current game. This is used to record snapshots in
+///	replays and restore them to seek through a replay.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameMgr::SerializeGameState( Serializer& serializer )
+{
+	if( !m_pGameLogic || !m_pGameLogic->CanSerializeState() )
+		return false;
+
+	serializer.AddData( m_TimePlayed );
+	return m_pGameLogic->SerializeState( serializer );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  GameMgr::GetGameType  Public
@@ -18,7 +18,9 @@
 #include "GUI/GUIMessages.h"
 #include "Graphics2D/GraphicsMgr.h"
 #include "GUI/MsgBox.h"
+#ifdef WIN32
 #include <winuser.rh>
+#endif
 #include <SFML/Window/Keyboard.hpp>
 
 const wchar_t* GameMgrCtrl::CTRL_NAME = L"gamefield_ctrl";
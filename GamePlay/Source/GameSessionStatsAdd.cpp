@@ -36,7 +36,9 @@ bool GameSessionStatsAdd::Serialize_V1( Serializer& serializer )
 	serializer.AddData( tempDiff );
 	m_Difficulty = static_cast<GameDefines::EGameplayDiffLevel>( tempDiff );
 
+	// Copy the start time in first so it is written rather than uninitialized memory
 	uint8 startTimeBytes[ sizeof(m_SessionStartTime) ];
+	memcpy( startTimeBytes, &m_SessionStartTime, sizeof(m_SessionStartTime) );
 	serializer.AddRawData( startTimeBytes, sizeof(m_SessionStartTime) );
 	memcpy( &m_SessionStartTime, startTimeBytes, sizeof(m_SessionStartTime));
 
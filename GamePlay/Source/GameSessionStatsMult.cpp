@@ -80,7 +80,9 @@ bool GameSessionStatsMult::Serialize_V1( Serializer& serializer, uint32 numPrime
 	serializer.AddData( m_LevelReached );
 	serializer.AddData( m_ContextVal );
 
+	// Copy the start time in first so it is written rather than uninitialized memory
 	uint8 startTimeBytes[ sizeof(m_SessionStartTime) ];
+	memcpy( startTimeBytes, &m_SessionStartTime, sizeof(m_SessionStartTime) );
 	serializer.AddRawData( startTimeBytes, sizeof(m_SessionStartTime) );
 	memcpy( &m_SessionStartTime, startTimeBytes, sizeof(m_SessionStartTime));
 
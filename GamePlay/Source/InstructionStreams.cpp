@@ -1,62 +1,462 @@
 #include "../InstructionStreamPlay.h"
 #include "../InstructionStreamReplay.h"
 #include "../GameFieldInstruction.h"
-#include "Base/Serializer.h"
+#include "../ReplayWriter.h"
+#include "../GameMgr.h"
+#include "Base/DataBlock.h"
 #include "Base/DataBlockOut.h"
+#include "Base/MsgLogger.h"
+#include "Base/StringFuncs.h"
+#include "Base/FileFuncs.h"
 #include "../GameField.h"
+#include "../GameLogic.h"
+#include <fstream>
+#include <stdio.h>
+#include <time.h>
+
+
+/// Get the 64-bit FNV-1a hash of game state data
+static uint64 HashStateData( const uint8* pData, uint32 dataSize )
+{
+	uint64 hash = 0xCBF29CE484222325ull;
+	for( uint32 byteIndex = 0; byteIndex < dataSize; ++byteIndex )
+	{
+		hash ^= pData[ byteIndex ];
+		hash *= 0x100000001B3ull;
+	}
+
+	return hash;
+}
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //  InstructionStreamPlay::Init  Public
-///	\param recordGame True to record the game instructions, otherwise false
+///	\param sReplayDir The directory to record the game to, ending with a path separator, or an
+///						empty string to not record the game
 ///
 ///	Initialize the instruction stream.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void InstructionStreamPlay::Init( bool recordGame )
+void InstructionStreamPlay::Init( const std::wstring& sReplayDir )
+{
+	m_CurTick = 0;
+	m_NextSnapshotTick = 0;
+
+	if( sReplayDir.empty() )
+		return;
+
+	// Store what is needed to start the same game
+	const GameMgr& gameMgr = GameMgr::Get();
+	ReplayHeader header;
+	header.gameType = gameMgr.GetGameType();
+	header.gameDiff = gameMgr.GetGameplayDiff();
+	header.timeLimit = gameMgr.GetTimeLimit();
+	header.seed = gameMgr.GetGameSeed();
+	header.filter = gameMgr.GetGameFilter();
+	header.buildVersion = gameMgr.GetReplayBuild();
+
+	// Name the file by the seed and the time the game started. The same seed can be played more
+	// than once, so a counter is added if a game with the same seed started in the same second.
+	time_t curTime;
+	time( &curTime );
+	tm startTime;
+#ifdef WIN32
+	localtime_s( &startTime, &curTime );
+#else
+	localtime_r( &curTime, &startTime );
+#endif
+
+	wchar_t szFileName[ 96 ];
+	swprintf( szFileName, 96, L"Replay_%016llX_%04d%02d%02d_%02d%02d%02d", (unsigned long long)header.seed,
+				startTime.tm_year + 1900, startTime.tm_mon + 1, startTime.tm_mday,
+				startTime.tm_hour, startTime.tm_min, startTime.tm_sec );
+
+	std::wstring sFilePath = sReplayDir + szFileName + L".ptr";
+	for( uint32 fileIndex = 2; TCBase::DoesFileExist( sFilePath.c_str() ); ++fileIndex )
+	{
+		wchar_t szIndex[ 16 ];
+		swprintf( szIndex, 16, L"_%u", fileIndex );
+		sFilePath = sReplayDir + szFileName + szIndex + L".ptr";
+	}
+
+	if( !m_pReplayWriter )
+		m_pReplayWriter = new ReplayWriter();
+	if( !m_pReplayWriter->Begin( sFilePath.c_str(), header ) )
+	{
+		delete m_pReplayWriter;
+		m_pReplayWriter = 0;
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamPlay::PostUpdate  Public
+///
+///	Record a snapshot of the game state every SNAPSHOT_INTERVAL_TICKS, starting with the first
+///	tick, so a replay can seek without simulating the game from the start.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void InstructionStreamPlay::PostUpdate()
+{
+	if( !m_pReplayWriter || m_CurTick < m_NextSnapshotTick )
+		return;
+	m_NextSnapshotTick = m_CurTick + SNAPSHOT_INTERVAL_TICKS;
+
+	// Games whose logic can't save its state are only replayed from the start
+	GameLogic* pLogic = GameMgr::Get().GetLogic();
+	if( !pLogic || !pLogic->CanSerializeState() )
+		return;
+
+	if( m_SnapshotBuffer.empty() )
+		m_SnapshotBuffer.resize( SNAPSHOT_BUFFER_SIZE );
+
+	DataBlockOut dataOut( &m_SnapshotBuffer[0], SNAPSHOT_BUFFER_SIZE );
+	PackedSerializer serializer( &dataOut );
+	if( GameMgr::Get().SerializeGameState( serializer ) )
+		m_pReplayWriter->RecordSnapshot( &m_SnapshotBuffer[0], dataOut.GetCurPosition(), m_CurTick );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamPlay::OnGameEnd  Public
+///
+///	Record the final score and the number of blocks on the field so the replay can be verified.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void InstructionStreamPlay::OnGameEnd()
 {
-	if( recordGame )
+	if( !m_pReplayWriter )
+		return;
+
+	GameLogic* pLogic = GameMgr::Get().GetLogic();
+	if( !pLogic || !pLogic->GetGameField() )
+		return;
+
+	m_pReplayWriter->RecordSummary( pLogic->GetScore(), pLogic->GetGameField()->GetNumBlocks(), m_CurTick );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::ReadHeader  Static Public
+///	\param szReplayFile The path to the replay file
+///	\param header The header to fill in
+///	\returns True if the header was read, false if the file could not be opened or is not a
+///				replay
+///
+///	Read the header of a replay file, such as to find the game to start for the replay.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool InstructionStreamReplay::ReadHeader( const wchar_t* szReplayFile, ReplayHeader& header )
+{
+	std::ifstream inFile( TCBase::Narrow( szReplayFile ).c_str(), std::ios_base::in | std::ios_base::binary );
+	if( !inFile.good() )
 	{
-		m_OutFile.open( "c:\\TestGame.dat", std::ios_base::out | std::ios_base::binary );
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to open replay file %s.", szReplayFile );
+		return false;
+	}
+
+	PackedSerializer serializer( &inFile );
+	bool isValidHeader = false;
+	try
+	{
+		isValidHeader = header.Serialize( serializer ) && inFile.good();
+	}
+	catch( ... )
+	{
+		isValidHeader = false;
+	}
 
-		if( m_OutFile.good() )
-			m_pOutStream = new Serializer( &m_OutFile );
+	if( !isValidHeader )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The file %s is not a replay or is from an unsupported version.", szReplayFile );
+		return false;
 	}
+
+	return true;
 }
 
 
-void InstructionStreamReplay::Init( Serializer& serializer )
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::Init  Public
+///	\param szReplayFile The path to the replay file
+///	\returns True if the replay was loaded, false otherwise
+///
+///	Load the instructions from a replay file written by a ReplayWriter. The file is kept in
+///	memory and the location and hash of each game state snapshot is stored.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool InstructionStreamReplay::Init( const wchar_t* szReplayFile )
 {
-	uint32 fileLen = serializer.GetInputLength();
-	while( serializer.GetOffset() < fileLen )
+	std::ifstream inFile( TCBase::Narrow( szReplayFile ).c_str(), std::ios_base::in | std::ios_base::binary );
+	if( !inFile.good() )
 	{
-		// Read the instruction type ID
-		uint8 instuctionID = 0;
-		serializer.AddData( instuctionID );
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to open replay file %s.", szReplayFile );
+		return false;
+	}
+
+	// Read the whole file so the records are decoded from memory
+	inFile.seekg( 0, std::ios_base::end );
+	uint32 fileLen = (uint32)inFile.tellg();
+	inFile.seekg( 0, std::ios_base::beg );
+
+	m_FileData.resize( fileLen );
+	if( fileLen > 0 )
+		inFile.read( (char*)&m_FileData[0], fileLen );
+	inFile.close();
+
+	if( fileLen == 0 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The replay file %s is empty.", szReplayFile );
+		return false;
+	}
+
+	// The data block throws if a read goes past the end of the file
+	DataBlock dataIn( &m_FileData[0], fileLen );
+	PackedSerializer serializer( &dataIn );
+	bool isValidHeader = false;
+	try
+	{
+		isValidHeader = m_Header.Serialize( serializer );
+	}
+	catch( ... )
+	{
+		isValidHeader = false;
+	}
+
+	if( !isValidHeader )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The file %s is not a replay or is from an unsupported version.", szReplayFile );
+		return false;
+	}
 
-		GameFieldInstruction* pNewInst = GameFieldInstruction::CreateInstruction( (EGameFieldInstruction)instuctionID );
-		if( !pNewInst )
+	// Read the records, each starts with the number of ticks since the previous record. A file
+	// from a game that did not close properly can end partway through a record, so the replay
+	// ends at the last complete record.
+	uint32 curTick = 0;
+	while( dataIn.GetRemainingBytes() > 0 )
+	{
+		GameFieldInstruction* pNewInst = 0;
+		try
 		{
+			uint32 tickDelta = 0;
+			serializer.AddData( tickDelta );
+
+			uint8 instructionID = 0;
+			serializer.AddData( instructionID );
+
+			// Store where the snapshot's data is and skip it
+			if( instructionID == ReplayHeader::SNAPSHOT_RECORD_ID )
+			{
+				Snapshot newSnapshot;
+				newSnapshot.tick = curTick + tickDelta;
+				newSnapshot.nextRecordIndex = (uint32)m_Records.size();
+				newSnapshot.dataSize = 0;
+				serializer.AddData( newSnapshot.dataSize );
+				newSnapshot.dataOffset = dataIn.GetCurPosition();
+
+				if( newSnapshot.dataSize > dataIn.GetRemainingBytes() )
+				{
+					MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The replay file %s has an incomplete snapshot, the replay ends there.", szReplayFile );
+					break;
+				}
+				dataIn.ReadData( newSnapshot.dataSize );
+				newSnapshot.dataHash = HashStateData( &m_FileData[ newSnapshot.dataOffset ], newSnapshot.dataSize );
+
+				curTick = newSnapshot.tick;
+				if( m_Header.version >= ReplayHeader::RESTORABLE_SNAPSHOT_VERSION )
+					m_Snapshots.push_back( newSnapshot );
+				continue;
+			}
+
+			// The summary is the last record
+			if( instructionID == ReplayHeader::SUMMARY_RECORD_ID )
+			{
+				Summary newSummary;
+				newSummary.tick = curTick + tickDelta;
+				serializer.AddData( newSummary.score );
+				serializer.AddData( newSummary.numBlocks );
+				m_Summary = newSummary;
+				m_HasSummary = true;
+				break;
+			}
+
+			pNewInst = GameFieldInstruction::CreateInstruction( (EGameFieldInstruction)instructionID );
+			if( !pNewInst )
+			{
+				MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The replay file %s has an unknown instruction (%u), the replay ends there.", szReplayFile, (uint32)instructionID );
+				break;
+			}
+
+			pNewInst->SerializePayload( serializer );
+			curTick += tickDelta;
 		}
+		catch( ... )
+		{
+			delete pNewInst;
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The replay file %s has an incomplete record, the replay ends there.", szReplayFile );
+			break;
+		}
+
+		Record newRecord;
+		newRecord.tick = curTick;
+		newRecord.pInst = pNewInst;
+		m_Records.push_back( newRecord );
+	}
+
+	m_NextRecordIndex = 0;
+	m_CurTick = 0;
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::EnableVerification  Public
+///
+///	Compare the game to each snapshot after the current tick as the game is simulated. Only a
+///	game simulated from the start, without restoring snapshots, verifies the replay.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void InstructionStreamReplay::EnableVerification()
+{
+	m_IsVerifying = true;
+	m_VerifyResults = VerifyResults();
 
-		pNewInst->Serialize( serializer );
+	m_NextVerifyIndex = 0;
+	while( m_NextVerifyIndex < m_Snapshots.size() && m_Snapshots[ m_NextVerifyIndex ].tick <= m_CurTick )
+		++m_NextVerifyIndex;
+}
 
-		m_AllInstructions.push_back( pNewInst );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::PostUpdate  Public
+///
+///	When verifying, write the game's state the same way it was written for the snapshot recorded
+///	on this tick, if there is one, and compare the hashes.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void InstructionStreamReplay::PostUpdate()
+{
+	if( !m_IsVerifying )
+		return;
+
+	// Skip any snapshots the game has moved past
+	while( m_NextVerifyIndex < m_Snapshots.size() && m_Snapshots[ m_NextVerifyIndex ].tick < m_CurTick )
+		++m_NextVerifyIndex;
+	if( m_NextVerifyIndex >= m_Snapshots.size() || m_Snapshots[ m_NextVerifyIndex ].tick != m_CurTick )
+		return;
+	const Snapshot& snapshot = m_Snapshots[ m_NextVerifyIndex++ ];
+
+	if( m_VerifyBuffer.empty() )
+		m_VerifyBuffer.resize( InstructionStreamPlay::SNAPSHOT_BUFFER_SIZE );
+
+	DataBlockOut dataOut( &m_VerifyBuffer[0], (uint32)m_VerifyBuffer.size() );
+	PackedSerializer serializer( &dataOut );
+	bool isMatch = GameMgr::Get().SerializeGameState( serializer )
+					&& dataOut.GetCurPosition() == snapshot.dataSize
+					&& HashStateData( &m_VerifyBuffer[0], dataOut.GetCurPosition() ) == snapshot.dataHash;
+
+	m_VerifyResults.numChecked++;
+	if( !isMatch )
+	{
+		if( m_VerifyResults.numMismatched == 0 )
+			m_VerifyResults.firstMismatchTick = snapshot.tick;
+		m_VerifyResults.numMismatched++;
 	}
+}
+
 
-	m_PrevFrameIter = m_AllInstructions.begin();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::FindSnapshot  Private
+///	\param tick The tick to find the snapshot for
+///	\returns The last snapshot at or before the tick, NULL if there is none
+///
+///	Find the snapshot to restore to get to a tick with a binary search of the snapshots.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const InstructionStreamReplay::Snapshot* InstructionStreamReplay::FindSnapshot( uint32 tick ) const
+{
+	// Find the first snapshot after the tick
+	uint32 lowIndex = 0;
+	uint32 highIndex = (uint32)m_Snapshots.size();
+	while( lowIndex < highIndex )
+	{
+		uint32 midIndex = (lowIndex + highIndex) / 2;
+		if( m_Snapshots[ midIndex ].tick <= tick )
+			lowIndex = midIndex + 1;
+		else
+			highIndex = midIndex;
+	}
+
+	if( lowIndex == 0 )
+		return 0;
+	return &m_Snapshots[ lowIndex - 1 ];
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::FindSnapshotTick  Public
+///	\param tick The tick to find the snapshot for
+///	\param snapshotTick The tick of the snapshot that was found
+///	\returns True if there is a snapshot at or before the tick, false otherwise
+///
+///	Get the tick of the snapshot RestoreSnapshot would restore for a tick.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool InstructionStreamReplay::FindSnapshotTick( uint32 tick, uint32& snapshotTick ) const
+{
+	const Snapshot* pSnapshot = FindSnapshot( tick );
+	if( !pSnapshot )
+		return false;
+
+	snapshotTick = pSnapshot->tick;
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  InstructionStreamReplay::RestoreSnapshot  Public
+///	\param tick The tick to restore the game to or before
+///	\returns True if a snapshot was restored, false if there is no snapshot at or before the tick
+///				or it could not be restored
+///
+///	Restore the game state from the last snapshot at or before a tick and continue the replay
+///	from the snapshot. If restoring fails the game state is invalid and the replay should be
+///	restarted.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool InstructionStreamReplay::RestoreSnapshot( uint32 tick )
+{
+	const Snapshot* pSnapshot = FindSnapshot( tick );
+	if( !pSnapshot || pSnapshot->dataSize == 0 )
+		return false;
+
+	DataBlock dataIn( &m_FileData[ pSnapshot->dataOffset ], pSnapshot->dataSize );
+	PackedSerializer serializer( &dataIn );
+	if( !GameMgr::Get().SerializeGameState( serializer ) )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to restore the replay snapshot at tick %u.", pSnapshot->tick );
+		return false;
+	}
+
+	// Continue with the instructions recorded after the snapshot
+	m_PendingInstructions.clear();
+	m_CurTick = pSnapshot->tick;
+	m_NextRecordIndex = pSnapshot->nextRecordIndex;
+	return true;
+}
+
+
+/// The destructor
+InstructionStreamReplay::~InstructionStreamReplay()
+{
+	for( uint32 recordIndex = 0; recordIndex < m_Records.size(); ++recordIndex )
+		delete m_Records[ recordIndex ].pInst;
+	m_Records.clear();
 }
 
 /// Allow for calculation based on frame detlta
-void InstructionStreamReplay::Update( float32 fieldTime, float32 frameTime )
+void InstructionStreamReplay::Update( float32, float32 )
 {
 	m_PendingInstructions.clear();
+	++m_CurTick;
 
-	// Starting from the instruction after the last executed instruction, find instructions that
-	// should be executed this frame
-	while( m_PrevFrameIter != m_AllInstructions.end() && (*m_PrevFrameIter)->executionTime < (fieldTime + frameTime) )
+	// Starting from the instruction after the last released instruction, find instructions that
+	// were handled on this tick
+	while( m_NextRecordIndex < m_Records.size() && m_Records[ m_NextRecordIndex ].tick <= m_CurTick )
 	{
-		m_PendingInstructions.push_back( *m_PrevFrameIter );
-		++m_PrevFrameIter;
+		m_PendingInstructions.push_back( m_Records[ m_NextRecordIndex ].pInst );
+		++m_NextRecordIndex;
 	}
 }
 
@@ -69,11 +469,11 @@ void InstructionStreamReplay::AddPendingInstruction( GameFieldInstruction* pInst
 /// The destructor
 InstructionStreamPlay::~InstructionStreamPlay()
 {
-	if( m_pOutStream )
+	if( m_pReplayWriter )
 	{
-		delete m_pOutStream;
-		m_OutFile.close();
-		m_pOutStream = 0;
+		m_pReplayWriter->End();
+		delete m_pReplayWriter;
+		m_pReplayWriter = 0;
 	}
 }
 
@@ -81,10 +481,8 @@ InstructionStreamPlay::~InstructionStreamPlay()
 /// method if they are no longer needed.
 void InstructionStreamPlay::ProcessHandledInstruction( GameFieldInstruction* pInst )
 {
-	pInst->executionTime = m_pGameField->GetFieldElapsedTime();
+	if( m_pReplayWriter )
+		m_pReplayWriter->RecordInstruction( pInst, m_CurTick );
 
-	if( m_pOutStream )
-		pInst->Serialize( *m_pOutStream );
-	
 	delete pInst;
-}
\ No newline at end of file
+}
@@ -0,0 +1,419 @@
+/*=================================================================================================
+
+	\file PlayerBot.cpp
+	Game Play Library
+	Player Bot Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the automated player.
+
+=================================================================================================*/
+
+#include "../PlayerBot.h"
+#include "../GameMgr.h"
+#include "../GameLogic.h"
+#include "../GameFieldMultBase.h"
+#include "../GameFieldPrimeTime.h"
+#include "../GameFieldAdd.h"
+#include "../GameFieldBlockProduct.h"
+#include "../GameFieldBlockAdd.h"
+#include "../PIIToggleBlockSelect.h"
+#include "../PIIClearSelection.h"
+#include <algorithm>
+
+/// The most search steps used to find the factors of one product
+static const int32 MAX_FACTOR_SEARCH_STEPS = 500;
+
+/// The search steps used to find summands, scaled by the skill
+static const int32 SUMMAND_SEARCH_STEPS_PER_SKILL = 20;
+
+
+/// Sort blocks from the highest value to the lowest
+static bool IsBlockValueGreater( const GameFieldBlock* pLHS, const GameFieldBlock* pRHS )
+{
+	return pLHS->GetValue() > pRHS->GetValue();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::Init  Public
+///
+///	\param settings The settings that control how well the bot plays
+///	\param seed The seed for the bot's random choices
+///
+///	Initialize the bot for a new game.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerBot::Init( const Settings& settings, uint64 seed )
+{
+	m_Settings = settings;
+	m_Random.Seed( seed );
+
+	m_PlannedClicks.clear();
+	m_NextClickIndex = 0;
+	m_NumClicks = 0;
+	m_NumErrors = 0;
+	m_NumEquationsPlanned = 0;
+
+	// Give the player a moment to look at the field
+	m_TimeToNextAction = GetVariedTime( m_Settings.reactionTime );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::Update  Public
+///
+///	\param frameTime The elapsed time in seconds
+///
+///	Select the next block of the planned equation or plan a new one once the bot is ready to act.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerBot::Update( float32 frameTime )
+{
+	m_TimeToNextAction -= frameTime;
+	if( m_TimeToNextAction > 0.0f )
+		return;
+
+	if( !GameMgr::Get().IsPlaying() || GameMgr::Get().IsPaused() )
+		return;
+	GameLogic* pLogic = GameMgr::Get().GetLogic();
+	if( !pLogic )
+		return;
+	GameField* pField = pLogic->GetGameField();
+	if( !pField )
+		return;
+
+	// If an equation is in progress then continue it
+	if( m_NextClickIndex < m_PlannedClicks.size() )
+	{
+		ClickNextBlock( pField );
+		return;
+	}
+
+	// Clear anything left selected by a mistake before starting a new equation
+	if( pField->GetSelectedBlocks().size() > 0 )
+	{
+		pField->SendInstruction( new PIIClearSelection() );
+		m_TimeToNextAction = GetVariedTime( m_Settings.clickTime );
+		return;
+	}
+
+	m_PlannedClicks.clear();
+	m_NextClickIndex = 0;
+
+	bool hasPlan = false;
+	switch( pLogic->GetLogicType() )
+	{
+	case GameLogic::LT_Product:
+		hasPlan = PlanProductEquation( (GameFieldMultBase*)pField );
+		break;
+
+	case GameLogic::LT_Addition:
+		hasPlan = PlanSumEquation( (GameFieldAdd*)pField );
+		break;
+
+	// The bot doesn't know how to build fractions so it just selects blocks
+	default:
+		hasPlan = PlanRandomClick( pField );
+		break;
+	}
+
+	if( hasPlan )
+	{
+		m_NumEquationsPlanned++;
+		ClickNextBlock( pField );
+	}
+	// Otherwise wait for the field to change before looking again
+	else
+		m_TimeToNextAction = GetVariedTime( m_Settings.reactionTime );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::ClickNextBlock  Private
+///
+///	\param pField The game field being played
+///
+///	Send the instruction to select the next block of the planned equation. The block may be
+///	swapped for a random one to simulate a mistake.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerBot::ClickNextBlock( GameField* pField )
+{
+	uint32 blockID = m_PlannedClicks[ m_NextClickIndex++ ];
+
+	// If the block is gone, such as by being pushed off the field, then give up on the equation
+	if( !pField->GetBlockByID( blockID ) )
+	{
+		m_PlannedClicks.clear();
+		m_NextClickIndex = 0;
+		m_TimeToNextAction = GetVariedTime( m_Settings.reactionTime );
+		return;
+	}
+
+	// Sometimes click the wrong block
+	const BlockIDTable& blockIDs = pField->m_BlockIDs;
+	if( m_Settings.errorRate > 0 && blockIDs.GetNumBlocks() > 1 && m_Random.Chance( m_Settings.errorRate ) )
+	{
+		blockID = blockIDs.GetBlockByIndex( m_Random.NextBelow( blockIDs.GetNumBlocks() ) )->GetID();
+		m_NumErrors++;
+	}
+
+	pField->SendInstruction( new PIIToggleBlockSelect( blockID ) );
+	m_NumClicks++;
+
+	// If the equation is complete then take a moment before the next one
+	if( m_NextClickIndex >= m_PlannedClicks.size() )
+	{
+		m_PlannedClicks.clear();
+		m_NextClickIndex = 0;
+		m_TimeToNextAction = GetVariedTime( m_Settings.reactionTime );
+	}
+	else
+		m_TimeToNextAction = GetVariedTime( m_Settings.clickTime );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::IsBlockOnField  Static Private
+///
+///	\param pField The product field
+///	\param pBlock The block to test
+///	\returns True if the block is far enough onto the field to be clicked
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerBot::IsBlockOnField( const GameFieldMultBase* pField, const GameFieldBlock* pBlock )
+{
+	// New rows are pushed up from below the field and new blocks drop in from above it
+	const float32 HALF_BLOCK = (float32)GameDefines::BLOCK_HEIGHT * 0.5f;
+	if( pBlock->yPos < -HALF_BLOCK )
+		return false;
+	if( pBlock->yPos > (float32)pField->GetFieldRect().size.y - HALF_BLOCK )
+		return false;
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::PlanProductEquation  Private
+///
+///	\param pField The product field
+///	\returns True if an equation was planned, false if none was found
+///
+///	Look at some of the product blocks in a random order and plan the first one whose factors
+///	are on the field. The skill setting controls how many of the products are looked at.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerBot::PlanProductEquation( GameFieldMultBase* pField )
+{
+	m_CandidateBlocks.clear();
+	m_TargetBlocks.clear();
+
+	// Split the blocks into products and factors
+	const MultBlockList& activeBlocks = pField->GetActiveBlocks();
+	for( MultBlockList::const_iterator iterBlock = activeBlocks.begin(); iterBlock != activeBlocks.end(); ++iterBlock )
+	{
+		GameFieldBlockProduct* pBlock = (GameFieldBlockProduct*)*iterBlock;
+		if( pBlock->GetValue() <= 1 || !IsBlockOnField( pField, pBlock ) )
+			continue;
+
+		if( pBlock->IsProductBlock() )
+			m_TargetBlocks.push_back( pBlock );
+		else
+			m_CandidateBlocks.push_back( pBlock );
+	}
+
+	// The Prime Time combo block can be used as a factor
+	GameFieldBlockProduct* pComboBlock = 0;
+	if( (GameMgr::Get().GetGameType() & GameDefines::GT_Mask_Type) == GameDefines::GT_PrimeTime )
+	{
+		pComboBlock = ((GameFieldPrimeTime*)pField)->GetComboBlock();
+		if( pComboBlock && pComboBlock->GetValue() > 1 )
+			m_CandidateBlocks.push_back( pComboBlock );
+	}
+
+	if( m_TargetBlocks.empty() || m_CandidateBlocks.empty() )
+		return false;
+
+	// Trying the largest factors first finds an answer in the fewest steps
+	std::sort( m_CandidateBlocks.begin(), m_CandidateBlocks.end(), IsBlockValueGreater );
+
+	// Look at the products in a random order
+	for( uint32 targetIndex = (uint32)m_TargetBlocks.size() - 1; targetIndex > 0; --targetIndex )
+		std::swap( m_TargetBlocks[targetIndex], m_TargetBlocks[ m_Random.NextBelow( targetIndex + 1 ) ] );
+
+	uint32 numToCheck = ((uint32)m_TargetBlocks.size() * (uint32)m_Settings.skill + 99) / 100;
+	if( numToCheck < 1 )
+		numToCheck = 1;
+	if( numToCheck > m_TargetBlocks.size() )
+		numToCheck = (uint32)m_TargetBlocks.size();
+
+	for( uint32 targetIndex = 0; targetIndex < numToCheck; ++targetIndex )
+	{
+		GameFieldBlock* pProductBlock = m_TargetBlocks[targetIndex];
+
+		m_ChosenBlocks.clear();
+		m_SearchStepsLeft = MAX_FACTOR_SEARCH_STEPS;
+		if( !FindFactors( pProductBlock->GetValue(), 0 ) )
+			continue;
+
+		// The combo block alone is not an equation
+		if( m_ChosenBlocks.size() == 1 && m_ChosenBlocks[0] == pComboBlock )
+			continue;
+
+		// Select the factors and then the product
+		for( uint32 chosenIndex = 0; chosenIndex < m_ChosenBlocks.size(); ++chosenIndex )
+			m_PlannedClicks.push_back( m_ChosenBlocks[chosenIndex]->GetID() );
+		m_PlannedClicks.push_back( pProductBlock->GetID() );
+		return true;
+	}
+
+	return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::FindFactors  Private
+///
+///	\param remainingProduct The product left to be made from the factors
+///	\param startIndex The index of the first candidate block that can be used
+///	\returns True if the chosen blocks multiply to the product
+///
+///	Search the candidate blocks, sorted by descending value, for factors of a product.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerBot::FindFactors( int32 remainingProduct, uint32 startIndex )
+{
+	if( remainingProduct == 1 )
+		return !m_ChosenBlocks.empty();
+	if( --m_SearchStepsLeft < 0 )
+		return false;
+
+	int32 lastValueTried = 0;
+	for( uint32 blockIndex = startIndex; blockIndex < m_CandidateBlocks.size(); ++blockIndex )
+	{
+		GameFieldBlock* pBlock = m_CandidateBlocks[blockIndex];
+		int32 value = pBlock->GetValue();
+
+		// Blocks with the same value lead to the same result
+		if( value == lastValueTried || value > remainingProduct || (remainingProduct % value) != 0 )
+			continue;
+		lastValueTried = value;
+
+		m_ChosenBlocks.push_back( pBlock );
+		if( FindFactors( remainingProduct / value, blockIndex + 1 ) )
+			return true;
+		m_ChosenBlocks.pop_back();
+	}
+
+	return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::PlanSumEquation  Private
+///
+///	\param pField The addition field
+///	\returns True if an equation was planned, false if none was found
+///
+///	Find blocks that add up to the sum block. The skill setting controls how long the bot
+///	searches.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerBot::PlanSumEquation( GameFieldAdd* pField )
+{
+	GameFieldBlockAdd* pSumBlock = pField->GetSumBlock();
+	if( !pSumBlock || pSumBlock->GetValue() <= 0 )
+		return false;
+
+	m_CandidateBlocks.clear();
+	const BlockIDTable& blockIDs = pField->m_BlockIDs;
+	for( uint32 slotIndex = 0; slotIndex < blockIDs.GetNumSlots(); ++slotIndex )
+	{
+		GameFieldBlock* pBlock = blockIDs.GetBlockInSlot( slotIndex );
+		if( pBlock && pBlock != pSumBlock && pBlock->GetValue() > 0 )
+			m_CandidateBlocks.push_back( pBlock );
+	}
+	if( m_CandidateBlocks.empty() )
+		return false;
+
+	std::sort( m_CandidateBlocks.begin(), m_CandidateBlocks.end(), IsBlockValueGreater );
+
+	m_ChosenBlocks.clear();
+	m_SearchStepsLeft = (m_Settings.skill + 1) * SUMMAND_SEARCH_STEPS_PER_SKILL;
+	if( !FindSummands( pSumBlock->GetValue(), 0 ) )
+		return false;
+
+	// Select the summands and then the sum
+	for( uint32 chosenIndex = 0; chosenIndex < m_ChosenBlocks.size(); ++chosenIndex )
+		m_PlannedClicks.push_back( m_ChosenBlocks[chosenIndex]->GetID() );
+	m_PlannedClicks.push_back( pSumBlock->GetID() );
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::FindSummands  Private
+///
+///	\param remainingSum The sum left to be made from the summands
+///	\param startIndex The index of the first candidate block that can be used
+///	\returns True if the chosen blocks add up to the sum
+///
+///	Search the candidate blocks, sorted by descending value, for summands of a sum.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerBot::FindSummands( int32 remainingSum, uint32 startIndex )
+{
+	if( remainingSum == 0 )
+		return !m_ChosenBlocks.empty();
+	if( --m_SearchStepsLeft < 0 )
+		return false;
+
+	int32 lastValueTried = 0;
+	for( uint32 blockIndex = startIndex; blockIndex < m_CandidateBlocks.size(); ++blockIndex )
+	{
+		GameFieldBlock* pBlock = m_CandidateBlocks[blockIndex];
+		int32 value = pBlock->GetValue();
+		if( value == lastValueTried || value > remainingSum )
+			continue;
+		lastValueTried = value;
+
+		m_ChosenBlocks.push_back( pBlock );
+		if( FindSummands( remainingSum - value, blockIndex + 1 ) )
+			return true;
+		m_ChosenBlocks.pop_back();
+	}
+
+	return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerBot::PlanRandomClick  Private
+///
+///	\param pField The game field being played
+///	\returns True if a block was chosen, false if the field is empty
+///
+///	Plan to select one random block, used for game types the bot can't solve.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerBot::PlanRandomClick( GameField* pField )
+{
+	const BlockIDTable& blockIDs = pField->m_BlockIDs;
+	if( blockIDs.GetNumBlocks() == 0 )
+		return false;
+
+	m_PlannedClicks.push_back( blockIDs.GetBlockByIndex( m_Random.NextBelow( blockIDs.GetNumBlocks() ) )->GetID() );
+	return true;
+}
@@ -21,14 +21,33 @@
 #include "Base/TCAssert.h"
 #include "Base/FileFuncs.h"
 #include "Base/StringFuncs.h"
+#include "Base/DataBlock.h"
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
 
 const wchar_t* PlayerProfile::PROFILE_EXT = L".ptp";
+const wchar_t* PlayerProfile::JOURNAL_EXT = L".ptj";
+const wchar_t* PlayerProfile::SNAPSHOT_TEMP_EXT = L".tmp";
 #ifdef WIN32
 const wchar_t* PlayerProfile::PROFILE_PATH = L"Profiles\\";
 #else
 const wchar_t* PlayerProfile::PROFILE_PATH = L"Profiles/";
 #endif
 const FourCC PlayerProfile::FOURCC_PROFILE("PTPR");
+const FourCC PlayerProfile::FOURCC_GENERATION("PTJG");
+
+
+/// Convert a session start time, 0 if it is not valid
+static uint32 GetSessionTime( const tm& sessionStartTime )
+{
+	// mktime normalizes the structure it is passed so use a copy
+	tm startTime = sessionStartTime;
+	time_t retVal = mktime( &startTime );
+	if( retVal == (time_t)-1 || retVal < 0 )
+		return 0;
+	return (uint32)retVal;
+}
 
 
 static ProfileSubset* CreateSubset( FourCC subsetID )
@@ -44,6 +63,20 @@ static ProfileSubset* CreateSubset( FourCC subsetID )
 }
 
 
+/// Replace a file with another, the source file is gone afterwards
+static bool ReplaceFileWith( const std::wstring& sDestFile, const std::wstring& sSourceFile )
+{
+#ifdef WIN32
+	// Windows can't rename over an existing file, if the game stops between the two steps then
+	// OpenProfile finds the source file and finishes the rename
+	_wremove( sDestFile.c_str() );
+	return _wrename( sSourceFile.c_str(), sDestFile.c_str() ) == 0;
+#else
+	return rename( TCBase::Narrow( sSourceFile ).c_str(), TCBase::Narrow( sDestFile ).c_str() ) == 0;
+#endif
+}
+
+
 bool PlayerProfile::IsValidProfileName( const wchar_t* szName )
 {
 	// Since text boxes only allow alpha numeric characters, no leading spaces, and no names
@@ -133,6 +166,99 @@ std::list<std::wstring> PlayerProfile::GetAllProfileNames()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::GetAllProfileSummaries  Static Public
+///
+///	\returns A list of the summaries of all of the profiles found, the most recently played first
+///
+///	Get the summaries of all of the known profiles from the profile index. Only the profiles
+///	that changed since they were indexed are read.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::list<ProfileIndex::Summary> PlayerProfile::GetAllProfileSummaries()
+{
+	ProfileIndex index;
+	index.Load();
+	index.Refresh();
+	index.Save();
+
+	return index.GetSummaries();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::BuildSummary  Public
+///
+///	\returns The summary of the profile with the current stamps of its files
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ProfileIndex::Summary PlayerProfile::BuildSummary()
+{
+	ProfileIndex::Summary summary;
+	summary.sName = m_sName;
+
+	ProfileSubsetMultiplication* pMultSub = static_cast<ProfileSubsetMultiplication*>( GetSubset( ProfileSubsetMultiplication::SUBSET_ID ) );
+	if( pMultSub )
+	{
+		const ProfileSubsetMultiplication::Totals& multTotals = pMultSub->GetTotals();
+		summary.numMultSessions = multTotals.numSessions;
+		summary.totalTimePlayed += multTotals.duration;
+		summary.multHighScore = multTotals.highScore;
+
+		// The sessions are stored with the most recent first
+		const GameSessionStatsMult* pLastSession = pMultSub->GetFirstSession();
+		if( pLastSession )
+		{
+			summary.lastPlayedTime = GetSessionTime( pLastSession->m_SessionStartTime );
+			summary.lastGameType = (GameDefines::EGameType)(pLastSession->m_GameType & GameDefines::GT_Mask_Type);
+		}
+	}
+
+	ProfileSubsetAddition* pAddSub = static_cast<ProfileSubsetAddition*>( GetSubset( ProfileSubsetAddition::SUBSET_ID ) );
+	if( pAddSub )
+	{
+		const ProfileSubsetAddition::Totals& addTotals = pAddSub->GetTotals();
+		summary.numAddSessions = addTotals.numSessions;
+		summary.totalTimePlayed += addTotals.duration;
+		summary.addHighScore = addTotals.highScore;
+
+		const GameSessionStatsAdd* pLastSession = pAddSub->GetFirstSession();
+		if( pLastSession )
+		{
+			uint32 lastAddTime = GetSessionTime( pLastSession->m_SessionStartTime );
+			if( summary.lastGameType == GameDefines::GT_Error || lastAddTime > summary.lastPlayedTime )
+			{
+				summary.lastPlayedTime = lastAddTime;
+				summary.lastGameType = GameDefines::GT_AdditionAttack;
+			}
+		}
+	}
+
+	summary.StoreFileStamps();
+	return summary;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::UpdateIndex  Private
+///
+///	Store the profile's summary in the profile index, called after the profile's files are
+///	written so the summary has their new stamps.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerProfile::UpdateIndex()
+{
+	ProfileIndex index;
+	index.Load();
+	index.SetSummary( BuildSummary() );
+	if( !index.Save() )
+		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"Failed to write the profile index." );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  PlayerProfile::TransferData_Old  Public
@@ -281,6 +407,13 @@ bool PlayerProfile::TransferData( Serializer& serializer )
 			uint32 subsetDataLen = 0;
 			serializer.AddData( subsetDataLen );
 
+			// The snapshot generation is not a subset
+			if( subsetFourCC == FOURCC_GENERATION && subsetDataLen == sizeof(m_Generation) )
+			{
+				serializer.AddData( m_Generation );
+				continue;
+			}
+
 			// Allocate memory for the block
 			uint8* pSubsetMem = new uint8[ subsetDataLen ];
 
@@ -294,6 +427,13 @@ bool PlayerProfile::TransferData( Serializer& serializer )
 	// Else if the profile is being stored to file
 	else
 	{
+		// Write the snapshot generation so the journal for this snapshot can be recognized
+		int32 generationFourCCVal = FOURCC_GENERATION.ToInt32();
+		serializer.AddData( generationFourCCVal );
+		uint32 generationLen = sizeof(m_Generation);
+		serializer.AddData( generationLen );
+		serializer.AddData( m_Generation );
+
 		// Go through all of the profile subset data
 		for( SubsetMap::iterator iterSubset = m_Subsets.begin(); iterSubset != m_Subsets.end(); ++iterSubset )
 		{
@@ -360,6 +500,25 @@ std::wstring PlayerProfile::GetFilePathFromName( const wchar_t* szProfileName )
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::GetJournalPathFromName  Static Public
+///
+///	\param szProfileName The name of the player
+///	\returns A string containing the full file path of the profile's journal
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::wstring PlayerProfile::GetJournalPathFromName( const wchar_t* szProfileName )
+{
+	std::wstring sJournalPath = TCBase::GetUserFilesPath();
+	sJournalPath += PROFILE_PATH;
+	sJournalPath += szProfileName;
+	sJournalPath += JOURNAL_EXT;
+
+	return sJournalPath;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  PlayerProfile::OpenProfile  Static Public
@@ -379,6 +538,12 @@ PlayerProfile* PlayerProfile::OpenProfile( const wchar_t* szProfileName )
 	// Get the player's profile file path
 	std::wstring sProfilePath = GetFilePathFromName( szProfileName );
 
+	// Finish replacing the snapshot if the game stopped between removing the old one and
+	// renaming the new one
+	std::wstring sSnapshotTempPath = sProfilePath + SNAPSHOT_TEMP_EXT;
+	if( !TCBase::DoesFileExist( sProfilePath.c_str() ) && TCBase::DoesFileExist( sSnapshotTempPath.c_str() ) )
+		ReplaceFileWith( sProfilePath, sSnapshotTempPath );
+
 	// See if the file does not exist
 	if( !TCBase::DoesFileExist( sProfilePath.c_str() ) )
 	{
@@ -386,25 +551,21 @@ PlayerProfile* PlayerProfile::OpenProfile( const wchar_t* szProfileName )
 		PlayerProfile* pProfile = new PlayerProfile( szProfileName );
 
 		// Write a preliminary file
-		pProfile->SaveToFile();
+		pProfile->Compact();
 		return pProfile;
 	}
 
-	// Open the file
-	std::ifstream inFile( TCBase::Narrow(sProfilePath).c_str(), std::ios_base::in | std::ios_base::binary );
-
-	// If the file failed to open
-	if( !inFile )
-		return NULL;
-
 	// Create the profile
 	PlayerProfile* pProfile = new PlayerProfile( szProfileName );
 	if( !pProfile )
 		return NULL;
 
-	// Read in the data
-	Serializer serializer( &inFile );
-	pProfile->TransferData( serializer );
+	// Read in the snapshot and the changes saved since it
+	if( !pProfile->ReadFiles( sProfilePath ) )
+	{
+		delete pProfile;
+		return NULL;
+	}
 
 	// Return the profile
 	return pProfile;
@@ -413,29 +574,298 @@ PlayerProfile* PlayerProfile::OpenProfile( const wchar_t* szProfileName )
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
-//  PlayerProfile::SaveToFile  Static Public
+//  PlayerProfile::OpenProfileReadOnly  Static Public
+///
+///	\param szProfileName The name of the player without any file system information
+///	\returns A pointer to the opened profile, NULL if it does not exist or failed to open
+///
+///	Open an existing profile to read it without changing its files, so profiles can be read on
+///	several threads at once or while the game has them open. A damaged journal is not compacted
+///	and saving the profile does nothing.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+PlayerProfile* PlayerProfile::OpenProfileReadOnly( const wchar_t* szProfileName )
+{
+	if( !IsValidProfileName(szProfileName) )
+		return NULL;
+
+	// If the game stopped while replacing the snapshot then the new snapshot is the temporary file
+	std::wstring sProfilePath = GetFilePathFromName( szProfileName );
+	if( !TCBase::DoesFileExist( sProfilePath.c_str() ) )
+		sProfilePath += SNAPSHOT_TEMP_EXT;
+
+	PlayerProfile* pProfile = new PlayerProfile( szProfileName );
+	pProfile->m_IsReadOnly = true;
+	if( !pProfile->ReadFiles( sProfilePath ) )
+	{
+		delete pProfile;
+		return NULL;
+	}
+
+	return pProfile;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::ReadFiles  Private
+///
+///	\param sSnapshotPath The path of the snapshot file
+///	\returns True if the snapshot was read, false if it could not be opened
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerProfile::ReadFiles( const std::wstring& sSnapshotPath )
+{
+	{
+		std::ifstream inFile( TCBase::Narrow(sSnapshotPath).c_str(), std::ios_base::in | std::ios_base::binary );
+
+		// If the file failed to open
+		if( !inFile )
+			return false;
+
+		Serializer serializer( &inFile );
+		TransferData( serializer );
+	}
+
+	// Apply the changes saved since the snapshot
+	ReplayJournal();
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::ReplayJournal  Private
 ///
-/// Store a profile's data to file
+///	Apply the records of the journal that belongs to the snapshot that was read. If there is no
+///	journal for the snapshot, such as for a profile saved by an older version, or its end is
+///	damaged then what was recovered is compacted into a new snapshot and journal.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerProfile::ReplayJournal()
+{
+	std::vector<ProfileJournal::Record> records;
+	bool isJournalOpen = m_Journal.ReadRecords( m_Generation, records );
+
+	for( uint32 recordIndex = 0; recordIndex < records.size(); ++recordIndex )
+		ApplyJournalRecord( records[ recordIndex ] );
+
+	if( !isJournalOpen && !m_IsReadOnly )
+		Compact();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::ApplyJournalRecord  Private
+///
+///	\param record The record to apply
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerProfile::ApplyJournalRecord( const ProfileJournal::Record& record )
+{
+	if( record.recordType == ProfileJournal::RT_Changes )
+	{
+		ProfileSubset* pSubset = GetSubset( record.subsetID );
+		if( !pSubset )
+			return;
+
+		DataBlock recordData( record.sData.data(), (uint32)record.sData.size() );
+		Serializer reader( &recordData );
+		pSubset->SerializeChanges( reader );
+		return;
+	}
+
+	// The record replaces the whole subset, which is unpacked from the record when it is used
+	SubsetMap::iterator iterSubset = m_Subsets.find( record.subsetID );
+	if( iterSubset != m_Subsets.end() )
+	{
+		delete iterSubset->second;
+		m_Subsets.erase( iterSubset );
+	}
+
+	PackedSubsetMap::iterator iterPacked = m_PackedSubsets.find( record.subsetID );
+	if( iterPacked != m_PackedSubsets.end() )
+	{
+		delete [] (uint8*)iterPacked->second.GetPtr();
+		m_PackedSubsets.erase( iterPacked );
+	}
+
+	uint32 dataLen = (uint32)record.sData.size();
+	uint8* pSubsetMem = new uint8[ dataLen > 0 ? dataLen : 1 ];
+	if( dataLen > 0 )
+		memcpy( pSubsetMem, record.sData.data(), dataLen );
+	m_PackedSubsets.insert( PackedSubsetMap::value_type( record.subsetID, DataBlock( pSubsetMem, dataLen ) ) );
+
+	m_SavedChecksums[ record.subsetID ] = ProfileJournal::UpdateChecksum( 0, (const uint8*)record.sData.data(), dataLen );
+}
+
+
+/// Serialize a subset to memory
+void PlayerProfile::SerializeSubset( ProfileSubset* pSubset, std::string& sData )
+{
+	std::ostringstream outStream( std::ios_base::out | std::ios_base::binary );
+	Serializer serializer( &outStream );
+	pSubset->Serialize( serializer );
+	sData = outStream.str();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::StoreSavedChecksums  Private
+///
+///	Store the checksum of the data of every unpacked subset that is journaled whole so the next
+///	save only journals the subsets that changed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PlayerProfile::StoreSavedChecksums()
+{
+	for( SubsetMap::iterator iterSubset = m_Subsets.begin(); iterSubset != m_Subsets.end(); ++iterSubset )
+	{
+		if( iterSubset->second->IsJournaled() )
+			continue;
+
+		std::string sData;
+		SerializeSubset( iterSubset->second, sData );
+		m_SavedChecksums[ iterSubset->first ] = ProfileJournal::UpdateChecksum( 0, (const uint8*)sData.data(), (uint32)sData.size() );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::SaveToFile  Public
+///
+///	Store the profile's changes since the last save. Subsets that journal their changes, such as
+///	the session history, append only what changed and other subsets are appended whole if they
+///	differ from the last save, so the time taken does not depend on the size of the profile. The
+///	profile is compacted instead when the journal is full or can't be appended to.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void PlayerProfile::SaveToFile()
 {
-	// Get the player's profile file path
-	std::wstring sProfilePath = GetFilePathFromName( m_sName.c_str() );
+	if( m_IsReadOnly )
+		return;
+
+	// Without a journal for the current snapshot, such as after a failed write, write a snapshot
+	if( !m_Journal.IsOpen() )
+	{
+		Compact();
+		return;
+	}
+
+	std::vector<ProfileJournal::Record> records;
+	ChecksumMap newChecksums;
+	uint32 recordsSize = 0;
+	for( SubsetMap::iterator iterSubset = m_Subsets.begin(); iterSubset != m_Subsets.end(); ++iterSubset )
+	{
+		ProfileSubset* pSubset = iterSubset->second;
+
+		ProfileJournal::Record newRecord;
+		newRecord.subsetID = iterSubset->first;
+		if( pSubset->IsJournaled() )
+		{
+			if( !pSubset->HasUnsavedChanges() )
+				continue;
+
+			newRecord.recordType = ProfileJournal::RT_Changes;
+			std::ostringstream outStream( std::ios_base::out | std::ios_base::binary );
+			Serializer serializer( &outStream );
+			pSubset->SerializeChanges( serializer );
+			newRecord.sData = outStream.str();
+		}
+		else
+		{
+			newRecord.recordType = ProfileJournal::RT_Subset;
+			SerializeSubset( pSubset, newRecord.sData );
+
+			// Skip the subset if it is the same as it was last saved
+			uint32 checksum = ProfileJournal::UpdateChecksum( 0, (const uint8*)newRecord.sData.data(), (uint32)newRecord.sData.size() );
+			ChecksumMap::const_iterator iterChecksum = m_SavedChecksums.find( iterSubset->first );
+			if( iterChecksum != m_SavedChecksums.end() && iterChecksum->second == checksum )
+				continue;
+			newChecksums[ iterSubset->first ] = checksum;
+		}
 
-	// Open the file
-	std::ofstream outFile( TCBase::Narrow(sProfilePath).c_str(), std::ios_base::out | std::ios_base::binary );
+		recordsSize += ProfileJournal::GetRecordSize( newRecord );
+		records.push_back( newRecord );
+	}
+
+	if( records.empty() )
+		return;
 
-	// If the file failed to open
-	if( !outFile )
+	// Compact the profile when the journal is full or the records could not be written
+	if( m_Journal.GetFileSize() + recordsSize > ProfileJournal::MAX_FILE_SIZE || !m_Journal.Append( records ) )
 	{
-		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to open file for saving profile." );
+		Compact();
 		return;
 	}
 
-	// Store the data
-	Serializer serializer( &outFile );
-	TransferData( serializer );
+	for( SubsetMap::iterator iterSubset = m_Subsets.begin(); iterSubset != m_Subsets.end(); ++iterSubset )
+		iterSubset->second->MarkSaved();
+	for( ChecksumMap::iterator iterChecksum = newChecksums.begin(); iterChecksum != newChecksums.end(); ++iterChecksum )
+		m_SavedChecksums[ iterChecksum->first ] = iterChecksum->second;
+
+	UpdateIndex();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PlayerProfile::Compact  Public
+///
+///	\returns True if the snapshot was written, otherwise false
+///
+///	Write the whole profile to a new snapshot with the next generation and start an empty
+///	journal for it. The snapshot is written to a temporary file that replaces the profile file
+///	once it is complete, so a failed write leaves the last snapshot and journal in place.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PlayerProfile::Compact()
+{
+	if( m_IsReadOnly )
+		return false;
+
+	std::wstring sProfilePath = GetFilePathFromName( m_sName.c_str() );
+	std::wstring sSnapshotTempPath = sProfilePath + SNAPSHOT_TEMP_EXT;
+
+	uint32 prevGeneration = m_Generation;
+	m_Generation++;
+
+	// Write the snapshot
+	bool wasWritten = false;
+	{
+		std::ofstream outFile( TCBase::Narrow(sSnapshotTempPath).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+		if( outFile )
+		{
+			Serializer serializer( &outFile );
+			TransferData( serializer );
+			outFile.flush();
+			wasWritten = outFile.good();
+		}
+	}
+
+	if( !wasWritten || !ReplaceFileWith( sProfilePath, sSnapshotTempPath ) )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to write the profile snapshot." );
+		TCBase::TCDeleteFile( sSnapshotTempPath.c_str() );
+		m_Generation = prevGeneration;
+		return false;
+	}
+
+	// The old journal belongs to the old generation so it is ignored even if this fails, and the
+	// next save will try to compact again
+	if( !m_Journal.Reset( m_Generation ) )
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to start the profile journal." );
+
+	for( SubsetMap::iterator iterSubset = m_Subsets.begin(); iterSubset != m_Subsets.end(); ++iterSubset )
+		iterSubset->second->MarkSaved();
+	StoreSavedChecksums();
+
+	UpdateIndex();
+
+	return true;
 }
 
 
@@ -471,6 +901,11 @@ ProfileSubset* PlayerProfile::GetSubset( FourCC subsetID )
 		ProfileSubset* pNewSubset = ::CreateSubset( subsetID );
 		if( pNewSubset )
 		{
+			// Remember the saved data of a subset that is journaled whole so it is only journaled
+			// again once it changes
+			if( !pNewSubset->IsJournaled() )
+				m_SavedChecksums[ subsetID ] = ProfileJournal::UpdateChecksum( 0, pOrigData, subsetData.GetSize() );
+
 			// Read the data
 			Serializer reader( &subsetData );
 			pNewSubset->Serialize( reader );
@@ -0,0 +1,49 @@
+/*=================================================================================================
+
+	\file ProductBlockSampler.cpp
+	Game Play Library
+	Product Block Sampler Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the product block sampler class.
+
+=================================================================================================*/
+
+#include "../ProductBlockSampler.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProductBlockSampler::SetProducts  Public
+///
+///	\param products The products that can be generated
+///	\param useablePrimes The flags representing which primes can be generated
+///
+///	Store the generatable products and rebuild the alias tables used to draw from them.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProductBlockSampler::SetProducts( const GameDefines::ProductArray& products, uint32 useablePrimes )
+{
+	m_Products = products;
+
+	// Every product is equally likely, but keep a separate table of the products that can be
+	// used when only a single column is left in the row
+	m_NarrowProductIndices.clear();
+	for( uint32 productIndex = 0; productIndex < m_Products.size(); ++productIndex )
+	{
+		if( m_Products[productIndex].product <= MAX_NARROW_PRODUCT )
+			m_NarrowProductIndices.push_back( productIndex );
+	}
+	m_ProductTable.BuildUniform( (uint32)m_Products.size() );
+	m_NarrowProductTable.BuildUniform( (uint32)m_NarrowProductIndices.size() );
+
+	// Build the prime table from the weights of the primes that are allowed
+	uint32 primeWeights[ GameDefines::NUM_PRIMES ] = {0};
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		if( (useablePrimes & (1 << primeIndex)) != 0 )
+			primeWeights[primeIndex] = GameDefines::PRIME_WEIGHTS[primeIndex];
+	}
+	m_PrimeTable.Build( primeWeights, GameDefines::NUM_PRIMES );
+}
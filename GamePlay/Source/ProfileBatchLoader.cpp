@@ -0,0 +1,367 @@
+/*=================================================================================================
+
+	\file ProfileBatchLoader.cpp
+	Game Play Library
+	Profile Batch Loader Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the parallel profile loader.
+
+=================================================================================================*/
+
+#include "../ProfileBatchLoader.h"
+#include "../PlayerProfile.h"
+#include "../ProfileSubsetMultiplication.h"
+#include "../ProfileSubsetAddition.h"
+#include "Base/XPThreads.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+/// Sleep the calling thread
+static void SleepMS( uint32 numMS )
+{
+#ifdef WIN32
+	Sleep( numMS );
+#else
+	// usleep takes microseconds
+	usleep( numMS * 1000 );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoadThreadProc  Global
+///
+///	\param pParam The profile batch loader
+///
+///	The entry point of a worker thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef WIN32
+void ProfileBatchLoadThreadProc( void* pParam )
+#else
+void* ProfileBatchLoadThreadProc( void* pParam )
+#endif
+{
+	((ProfileBatchLoader*)pParam)->RunWorker();
+
+#ifndef WIN32
+	return 0;
+#endif
+}
+
+
+/// Reset the statistics
+void ProfileBatchLoader::Stats::Clear()
+{
+	numProfiles = 0;
+	numSessions = 0;
+	timeOnTask = 0.0;
+	numEqsCleared = 0;
+	numEqsFailed = 0;
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		validCounts[ primeIndex ] = 0;
+		errorCounts[ primeIndex ] = 0;
+	}
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+		difficultyCounts[ diffIndex ] = 0;
+}
+
+
+/// Add another set of statistics to these
+void ProfileBatchLoader::Stats::Merge( const Stats& stats )
+{
+	numProfiles += stats.numProfiles;
+	numSessions += stats.numSessions;
+	timeOnTask += stats.timeOnTask;
+	numEqsCleared += stats.numEqsCleared;
+	numEqsFailed += stats.numEqsFailed;
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		validCounts[ primeIndex ] += stats.validCounts[ primeIndex ];
+		errorCounts[ primeIndex ] += stats.errorCounts[ primeIndex ];
+	}
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+		difficultyCounts[ diffIndex ] += stats.difficultyCounts[ diffIndex ];
+}
+
+
+/// Get the fraction of a prime's uses that were valid, 0 if it was not used
+float64 ProfileBatchLoader::Stats::GetPrimeAccuracy( uint32 primeIndex ) const
+{
+	if( primeIndex >= GameDefines::NUM_PRIMES )
+		return 0.0;
+
+	uint64 numUses = validCounts[ primeIndex ] + errorCounts[ primeIndex ];
+	return numUses > 0 ? (float64)validCounts[ primeIndex ] / (float64)numUses : 0.0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::GetNumCores  Static Public
+///
+///	\returns The number of processor cores, at least 1
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 ProfileBatchLoader::GetNumCores()
+{
+#ifdef WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo( &sysInfo );
+	return sysInfo.dwNumberOfProcessors > 0 ? (uint32)sysInfo.dwNumberOfProcessors : 1;
+#else
+	long numCores = sysconf( _SC_NPROCESSORS_ONLN );
+	return numCores > 0 ? (uint32)numCores : 1;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::~ProfileBatchLoader  Public
+///
+///	The destructor, the workers use the loader so they are stopped before it is freed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ProfileBatchLoader::~ProfileBatchLoader()
+{
+	Cancel();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::Start  Public
+///
+///	\param profileNames The names of the profiles to read
+///	\param numThreads The number of worker threads, 0 to use one for each core
+///	\returns True if the workers were started, false if the last load is still running
+///
+///	Start reading profiles on worker threads and return without waiting for them.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileBatchLoader::Start( const std::list<std::wstring>& profileNames, uint32 numThreads )
+{
+	if( IsRunning() )
+		return false;
+
+	m_ProfileNames.assign( profileNames.begin(), profileNames.end() );
+
+	if( numThreads == 0 )
+		numThreads = GetNumCores();
+	if( numThreads > m_ProfileNames.size() )
+		numThreads = (uint32)m_ProfileNames.size();
+
+	m_Lock.Enter();
+	m_NextProfileIndex = 0;
+	m_NumRunningWorkers = numThreads;
+	m_NumLoaded = 0;
+	m_NumFailed = 0;
+	m_IsCanceled = false;
+	m_ClassStats.Clear();
+	m_NewSnapshots.clear();
+	m_Lock.Leave();
+
+	// The threads are detached, each one counts itself out when it finishes
+	for( uint32 threadIndex = 0; threadIndex < numThreads; ++threadIndex )
+	{
+		XPThreads worker( ProfileBatchLoadThreadProc );
+		worker.Run( this );
+	}
+
+	return true;
+}
+
+
+/// Get if the workers are still reading profiles
+bool ProfileBatchLoader::IsRunning()
+{
+	m_Lock.Enter();
+	bool isRunning = m_NumRunningWorkers > 0;
+	m_Lock.Leave();
+
+	return isRunning;
+}
+
+
+/// Wait for the workers to finish
+void ProfileBatchLoader::Wait()
+{
+	while( IsRunning() )
+		SleepMS( 1 );
+}
+
+
+/// Wait up to a number of milliseconds for the workers to finish, true if they finished
+bool ProfileBatchLoader::WaitFor( uint32 numMS )
+{
+	for( uint32 msIndex = 0; msIndex < numMS; ++msIndex )
+	{
+		if( !IsRunning() )
+			return true;
+		SleepMS( 1 );
+	}
+
+	return !IsRunning();
+}
+
+
+/// Stop the workers after the profiles they are reading and wait for them
+void ProfileBatchLoader::Cancel()
+{
+	m_Lock.Enter();
+	m_IsCanceled = true;
+	m_Lock.Leave();
+
+	Wait();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::GetProgress  Public
+///
+///	\param numLoaded The number of profiles read so far
+///	\param numFailed The number of profiles that could not be read so far
+///	\param numProfiles The number of profiles being read
+///	\param classStats The totals of the profiles read so far
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileBatchLoader::GetProgress( uint32& numLoaded, uint32& numFailed, uint32& numProfiles, Stats& classStats )
+{
+	m_Lock.Enter();
+	numLoaded = m_NumLoaded;
+	numFailed = m_NumFailed;
+	classStats = m_ClassStats;
+	m_Lock.Leave();
+
+	numProfiles = (uint32)m_ProfileNames.size();
+}
+
+
+/// Move the snapshots finished since the last call into a list
+void ProfileBatchLoader::TakeNewSnapshots( std::vector<ProfileSnapshot>& snapshots )
+{
+	snapshots.clear();
+
+	m_Lock.Enter();
+	snapshots.swap( m_NewSnapshots );
+	m_Lock.Leave();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::TakeNextProfile  Private
+///
+///	\param profileIndex The index of the profile that was taken
+///	\returns True if a profile was taken, false if the queue is empty or the load was canceled
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileBatchLoader::TakeNextProfile( uint32& profileIndex )
+{
+	m_Lock.Enter();
+	bool hasProfile = !m_IsCanceled && m_NextProfileIndex < m_ProfileNames.size();
+	if( hasProfile )
+		profileIndex = m_NextProfileIndex++;
+	m_Lock.Leave();
+
+	return hasProfile;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::RunWorker  Private
+///
+///	Read profiles from the queue until it is empty. The profiles are summarized outside of the
+///	lock so the workers only wait on each other to merge the summary.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileBatchLoader::RunWorker()
+{
+	uint32 profileIndex = 0;
+	while( TakeNextProfile( profileIndex ) )
+	{
+		ProfileSnapshot snapshot;
+		snapshot.sName = m_ProfileNames[ profileIndex ];
+
+		PlayerProfile* pProfile = PlayerProfile::OpenProfileReadOnly( snapshot.sName.c_str() );
+		if( pProfile )
+		{
+			BuildSnapshot( pProfile, snapshot );
+			delete pProfile;
+		}
+
+		m_Lock.Enter();
+		if( pProfile )
+		{
+			m_NumLoaded++;
+			m_ClassStats.Merge( snapshot.stats );
+			m_NewSnapshots.push_back( snapshot );
+		}
+		else
+			m_NumFailed++;
+		m_Lock.Leave();
+	}
+
+	m_Lock.Enter();
+	m_NumRunningWorkers--;
+	m_Lock.Leave();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileBatchLoader::BuildSnapshot  Static Public
+///
+///	\param pProfile The profile to summarize
+///	\param snapshot The snapshot to fill in, its name is left as it is
+///
+///	Summarize a profile from the subsets' running totals so none of the sessions are read.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileBatchLoader::BuildSnapshot( PlayerProfile* pProfile, ProfileSnapshot& snapshot )
+{
+	Stats& stats = snapshot.stats;
+	stats.Clear();
+	stats.numProfiles = 1;
+
+	ProfileSubsetMultiplication* pMultSub = static_cast<ProfileSubsetMultiplication*>( pProfile->GetSubset( ProfileSubsetMultiplication::SUBSET_ID ) );
+	if( pMultSub )
+	{
+		const ProfileSubsetMultiplication::Totals& multTotals = pMultSub->GetTotals();
+		stats.numSessions += multTotals.numSessions;
+		stats.timeOnTask += multTotals.duration;
+		stats.numEqsCleared += multTotals.numEqsCleared;
+		stats.numEqsFailed += multTotals.numEqsFailed;
+		for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+		{
+			stats.validCounts[ primeIndex ] += multTotals.validCounts[ primeIndex ];
+			stats.errorCounts[ primeIndex ] += multTotals.errorCounts[ primeIndex ];
+		}
+		for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+			stats.difficultyCounts[ diffIndex ] += multTotals.difficultyCounts[ diffIndex ];
+	}
+
+	ProfileSubsetAddition* pAddSub = static_cast<ProfileSubsetAddition*>( pProfile->GetSubset( ProfileSubsetAddition::SUBSET_ID ) );
+	if( pAddSub )
+	{
+		const ProfileSubsetAddition::Totals& addTotals = pAddSub->GetTotals();
+		stats.numSessions += addTotals.numSessions;
+		stats.timeOnTask += addTotals.duration;
+		stats.numEqsCleared += addTotals.numEqsCleared;
+		stats.numEqsFailed += addTotals.numEqsFailed;
+		for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+			stats.difficultyCounts[ diffIndex ] += addTotals.difficultyCounts[ diffIndex ];
+	}
+}
@@ -0,0 +1,284 @@
+/*=================================================================================================
+
+	\file ProfileIndex.cpp
+	Game Play Library
+	Profile Index Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the index of player profile summaries.
+
+=================================================================================================*/
+
+#include "../ProfileIndex.h"
+#include "../PlayerProfile.h"
+#include "../ProfileJournal.h"
+#include "Base/Serializer.h"
+#include "Base/DataBlock.h"
+#include "Base/FileFuncs.h"
+#include "Base/StringFuncs.h"
+#include "Base/MsgLogger.h"
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <string.h>
+
+const FourCC ProfileIndex::FOURCC_INDEX("PTPI");
+const wchar_t* ProfileIndex::INDEX_FILE_NAME = L"ProfileIndex.pti";
+
+
+/// Order summaries with the most recently played first and then by name
+static bool IsPlayedMoreRecently( const ProfileIndex::Summary& lhs, const ProfileIndex::Summary& rhs )
+{
+	if( lhs.lastPlayedTime != rhs.lastPlayedTime )
+		return lhs.lastPlayedTime > rhs.lastPlayedTime;
+	return lhs.sName < rhs.sName;
+}
+
+
+/// Store the modification times and sizes of the profile's files
+void ProfileIndex::Summary::StoreFileStamps()
+{
+	std::wstring sProfilePath = PlayerProfile::GetFilePathFromName( sName.c_str() );
+	std::wstring sJournalPath = PlayerProfile::GetJournalPathFromName( sName.c_str() );
+
+	profileModTime = (uint32)TCBase::GetFileModTime( sProfilePath.c_str() );
+	profileSize = (uint32)TCBase::GetFileSize( sProfilePath.c_str() );
+	journalModTime = (uint32)TCBase::GetFileModTime( sJournalPath.c_str() );
+	journalSize = (uint32)TCBase::GetFileSize( sJournalPath.c_str() );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileIndex::Summary::IsStale  Public
+///
+///	\returns True if the profile's snapshot or journal was written since the summary was made
+///
+///	The files' sizes are compared as well as their modification times since a save can land in
+///	the same second as the last one.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileIndex::Summary::IsStale() const
+{
+	Summary curStamps;
+	curStamps.sName = sName;
+	curStamps.StoreFileStamps();
+
+	return curStamps.profileModTime != profileModTime
+			|| curStamps.profileSize != profileSize
+			|| curStamps.journalModTime != journalModTime
+			|| curStamps.journalSize != journalSize;
+}
+
+
+/// Transfer the summary
+void ProfileIndex::Summary::Serialize( Serializer& serializer )
+{
+	serializer.AddData( sName );
+	serializer.AddData( profileModTime );
+	serializer.AddData( profileSize );
+	serializer.AddData( journalModTime );
+	serializer.AddData( journalSize );
+	serializer.AddData( numMultSessions );
+	serializer.AddData( numAddSessions );
+	serializer.AddData( totalTimePlayed );
+	serializer.AddData( lastPlayedTime );
+
+	int32 gameTypeVal = (int32)lastGameType;
+	serializer.AddData( gameTypeVal );
+	lastGameType = (GameDefines::EGameType)gameTypeVal;
+
+	serializer.AddData( multHighScore );
+	serializer.AddData( addHighScore );
+}
+
+
+/// Get the index file path
+std::wstring ProfileIndex::GetFilePath()
+{
+	std::wstring sIndexPath = TCBase::GetUserFilesPath();
+	sIndexPath += PlayerProfile::PROFILE_PATH;
+	sIndexPath += INDEX_FILE_NAME;
+
+	return sIndexPath;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileIndex::Load  Public
+///
+///	\returns True if the index was read, false if it is missing or damaged
+///
+///	Read the index file. The file is a header with the fourCC, version, checksum and length of
+///	the data followed by the summaries.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileIndex::Load()
+{
+	m_Summaries.clear();
+	m_HasChanges = false;
+
+	std::ifstream inFile( TCBase::Narrow( GetFilePath() ).c_str(), std::ios_base::in | std::ios_base::binary );
+	if( !inFile )
+		return false;
+
+	uint32 header[ 4 ] = { 0 };
+	inFile.read( (char*)header, sizeof(header) );
+	if( inFile.gcount() != (std::streamsize)sizeof(header)
+		|| FourCC( (int32)header[0] ) != FOURCC_INDEX
+		|| header[1] != FILE_VERSION
+		|| header[3] > ProfileJournal::MAX_RECORD_SIZE )
+		return false;
+
+	std::string sData( header[3], '\0' );
+	if( header[3] > 0 )
+	{
+		inFile.read( &sData[0], (std::streamsize)header[3] );
+		if( inFile.gcount() != (std::streamsize)header[3] )
+			return false;
+	}
+
+	if( ProfileJournal::UpdateChecksum( 0, (const uint8*)sData.data(), (uint32)sData.size() ) != header[2] )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"The profile index is damaged and will be rebuilt." );
+		return false;
+	}
+
+	DataBlock indexData( sData.data(), (uint32)sData.size() );
+	Serializer serializer( &indexData );
+
+	uint32 numSummaries = 0;
+	serializer.AddData( numSummaries );
+	for( uint32 summaryIndex = 0; summaryIndex < numSummaries; ++summaryIndex )
+	{
+		Summary summary;
+		summary.Serialize( serializer );
+		m_Summaries[ summary.sName ] = summary;
+	}
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileIndex::Save  Public
+///
+///	\returns True if the index was written or had no changes, otherwise false
+///
+///	Write the index file. A write that is cut short fails the checksum when it is next loaded so
+///	the index is rebuilt rather than trusted.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileIndex::Save()
+{
+	if( !m_HasChanges )
+		return true;
+
+	std::ostringstream outStream( std::ios_base::out | std::ios_base::binary );
+	{
+		Serializer serializer( &outStream );
+
+		uint32 numSummaries = (uint32)m_Summaries.size();
+		serializer.AddData( numSummaries );
+		for( SummaryMap::iterator iterSummary = m_Summaries.begin(); iterSummary != m_Summaries.end(); ++iterSummary )
+			iterSummary->second.Serialize( serializer );
+	}
+	std::string sData = outStream.str();
+
+	uint32 header[ 4 ];
+	header[0] = (uint32)FOURCC_INDEX.ToInt32();
+	header[1] = FILE_VERSION;
+	header[2] = ProfileJournal::UpdateChecksum( 0, (const uint8*)sData.data(), (uint32)sData.size() );
+	header[3] = (uint32)sData.size();
+
+	PlayerProfile::EnsureProfileDirExists();
+	std::ofstream outFile( TCBase::Narrow( GetFilePath() ).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+	if( !outFile )
+		return false;
+
+	outFile.write( (const char*)header, sizeof(header) );
+	outFile.write( sData.data(), (std::streamsize)sData.size() );
+	outFile.flush();
+	if( !outFile )
+		return false;
+
+	m_HasChanges = false;
+	return true;
+}
+
+
+/// Add or replace a profile's summary
+void ProfileIndex::SetSummary( const Summary& summary )
+{
+	m_Summaries[ summary.sName ] = summary;
+	m_HasChanges = true;
+}
+
+
+/// Remove a profile's summary
+void ProfileIndex::RemoveSummary( const wchar_t* szName )
+{
+	if( m_Summaries.erase( szName ) > 0 )
+		m_HasChanges = true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileIndex::Refresh  Public
+///
+///	Bring the summaries up to date with the profile directory. Only the profiles that have no
+///	summary or whose files changed since their summary was made are opened, and the summaries
+///	of profiles that no longer exist are removed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileIndex::Refresh()
+{
+	std::list<std::wstring> profileNames = PlayerProfile::GetAllProfileNames();
+	std::set<std::wstring> foundNames;
+
+	for( std::list<std::wstring>::const_iterator iterName = profileNames.begin(); iterName != profileNames.end(); ++iterName )
+	{
+		foundNames.insert( *iterName );
+
+		SummaryMap::const_iterator iterSummary = m_Summaries.find( *iterName );
+		if( iterSummary != m_Summaries.end() && !iterSummary->second.IsStale() )
+			continue;
+
+		// Open the profile read only so the files the summary is stamped with are not changed
+		PlayerProfile* pProfile = PlayerProfile::OpenProfileReadOnly( iterName->c_str() );
+		if( !pProfile )
+			continue;
+
+		SetSummary( pProfile->BuildSummary() );
+		delete pProfile;
+	}
+
+	// Remove the profiles that were deleted or renamed
+	for( SummaryMap::iterator iterSummary = m_Summaries.begin(); iterSummary != m_Summaries.end(); )
+	{
+		if( foundNames.find( iterSummary->first ) != foundNames.end() )
+		{
+			++iterSummary;
+			continue;
+		}
+
+		m_Summaries.erase( iterSummary++ );
+		m_HasChanges = true;
+	}
+}
+
+
+/// Get the summaries, the most recently played first
+std::list<ProfileIndex::Summary> ProfileIndex::GetSummaries() const
+{
+	std::list<Summary> retList;
+	for( SummaryMap::const_iterator iterSummary = m_Summaries.begin(); iterSummary != m_Summaries.end(); ++iterSummary )
+		retList.push_back( iterSummary->second );
+
+	retList.sort( IsPlayedMoreRecently );
+	return retList;
+}
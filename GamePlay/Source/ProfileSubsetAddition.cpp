@@ -13,6 +13,7 @@
 #include "../ProfileSubsetAddition.h"
 #include "../GameMgr.h"
 #include "Base/MsgLogger.h"
+#include <iterator>
 
 const FourCC ProfileSubsetAddition::SUBSET_ID("ADDI");
 
@@ -29,12 +30,13 @@ const FourCC ProfileSubsetAddition::SUBSET_ID("ADDI");
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool ProfileSubsetAddition::Serialize( Serializer& serializer )
 {
-	// The version
-	int version = 1;
+	// The version, version 2 adds the session totals and version 3 adds the difficulty counts to
+	// the totals
+	int version = 3;
 	serializer.AddData( version );
 
 	// If the version is unknown then bail
-	if( version != 1 )
+	if( version < 1 || version > 3 )
 	{
 		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"Unknown addition profile subset version" );
 		return false;
@@ -52,6 +54,7 @@ bool ProfileSubsetAddition::Serialize( Serializer& serializer )
 	if( serializer.InReadMode() )
 	{
 		m_Sessions.clear();
+		m_NumUnsavedSessions = 0;
 
 		// Store the recent sessions
 		for( uint32 sessionIndex = 0; sessionIndex < numRecentSessions; ++sessionIndex )
@@ -69,6 +72,12 @@ bool ProfileSubsetAddition::Serialize( Serializer& serializer )
 			iterSession->Serialize_V1( serializer );
 	}
 
+	// Transfer the totals, older profiles have them built once from the sessions
+	if( version >= 2 )
+		m_Totals.Serialize( serializer, version >= 3 );
+	if( serializer.InReadMode() && (version < 3 || m_Totals.numSessions != (uint32)m_Sessions.size()) )
+		RebuildTotals();
+
 	// Return success
 	return true;
 }
@@ -88,5 +97,138 @@ void ProfileSubsetAddition::StoreSession( const GameSessionStatsAdd& sessionStat
 {
 	// Store this session
 	if( sessionStats.m_Duration > 0 )
+	{
 		m_Sessions.push_front( sessionStats );
-}
\ No newline at end of file
+		m_NumUnsavedSessions++;
+		m_Totals.AddSession( sessionStats );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetAddition::RebuildTotals  Private
+///
+/// Rebuild the totals by going through every session.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileSubsetAddition::RebuildTotals()
+{
+	m_Totals.Clear();
+	for( SessionList::const_iterator iterSession = m_Sessions.begin(); iterSession != m_Sessions.end(); ++iterSession )
+		m_Totals.AddSession( *iterSession );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetAddition::SerializeChanges  Public
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the changes were transferred, otherwise false
+///
+///	Save the sessions stored since the last save, oldest first, or add sessions that were saved
+///	this way to the front of the list.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileSubsetAddition::SerializeChanges( Serializer& serializer )
+{
+	// The version
+	int version = 1;
+	serializer.AddData( version );
+	if( version != 1 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"Unknown addition profile journal version" );
+		return false;
+	}
+
+	int sessionVersion = 1;
+	serializer.AddData( sessionVersion );
+
+	uint32 numSessions = m_NumUnsavedSessions;
+	serializer.AddData( numSessions );
+
+	if( serializer.InReadMode() )
+	{
+		// The sessions are oldest first so each one goes in front of the last
+		for( uint32 sessionIndex = 0; sessionIndex < numSessions; ++sessionIndex )
+		{
+			GameSessionStatsAdd session;
+			if( sessionVersion == 1 )
+				session.Serialize_V1( serializer );
+			m_Sessions.push_front( session );
+			m_Totals.AddSession( session );
+		}
+	}
+	else
+	{
+		// Step back from the last unsaved session to the most recent
+		SessionList::iterator iterSession = m_Sessions.begin();
+		std::advance( iterSession, numSessions );
+		for( uint32 sessionIndex = 0; sessionIndex < numSessions; ++sessionIndex )
+		{
+			--iterSession;
+			iterSession->Serialize_V1( serializer );
+		}
+	}
+
+	return true;
+}
+
+
+/// Reset the totals to no sessions
+void ProfileSubsetAddition::Totals::Clear()
+{
+	numSessions = 0;
+	duration = 0;
+	numEqsCleared = 0;
+	numEqsFailed = 0;
+	summandsCleared = 0;
+	highScore = 0;
+	mostClearedIn5Mins = 0;
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+		difficultyCounts[ diffIndex ] = 0;
+}
+
+
+/// Add a session to the totals
+void ProfileSubsetAddition::Totals::AddSession( const GameSessionStatsAdd& session )
+{
+	numSessions++;
+	duration += session.m_Duration;
+	numEqsCleared += session.m_NumEqsCleared;
+	numEqsFailed += session.m_NumEqsFailed;
+	summandsCleared += session.m_SummandsCleared;
+	if( session.m_Score > highScore )
+		highScore = session.m_Score;
+	if( session.m_TimeLimit == 5 * 60 && session.m_NumEqsCleared > mostClearedIn5Mins )
+		mostClearedIn5Mins = session.m_NumEqsCleared;
+	if( (uint32)session.m_Difficulty < (uint32)GameDefines::GPDL_COUNT )
+		difficultyCounts[ session.m_Difficulty ]++;
+}
+
+
+/// Transfer the totals, along with the difficulty counts if hasDifficultyCounts is true
+void ProfileSubsetAddition::Totals::Serialize( Serializer& serializer, bool hasDifficultyCounts )
+{
+	serializer.AddData( numSessions );
+	serializer.AddData( duration );
+	serializer.AddData( numEqsCleared );
+	serializer.AddData( numEqsFailed );
+	serializer.AddData( summandsCleared );
+	serializer.AddData( highScore );
+	serializer.AddData( mostClearedIn5Mins );
+
+	if( !hasDifficultyCounts )
+		return;
+
+	// Transfer the difficulty counts, skipping any levels this version does not know of
+	uint32 numDifficulties = GameDefines::GPDL_COUNT;
+	serializer.AddData( numDifficulties );
+	for( uint32 diffIndex = 0; diffIndex < numDifficulties; ++diffIndex )
+	{
+		uint32 diffCount = diffIndex < GameDefines::GPDL_COUNT ? difficultyCounts[ diffIndex ] : 0;
+		serializer.AddData( diffCount );
+		if( diffIndex < GameDefines::GPDL_COUNT )
+			difficultyCounts[ diffIndex ] = diffCount;
+	}
+}
@@ -15,6 +15,8 @@
 #include "Base/NumFuncs.h"
 #include "../GameMgr.h"
 #include "Base/MsgLogger.h"
+#include <iterator>
+#include <sstream>
 
 const FourCC ProfileSubsetMultiplication::SUBSET_ID("MULT");
 
@@ -31,12 +33,13 @@ const FourCC ProfileSubsetMultiplication::SUBSET_ID("MULT");
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool ProfileSubsetMultiplication::Serialize( Serializer& serializer )
 {
-	// The version
-	int version = 1;
+	// The version, version 2 adds the session totals, version 3 stores the sessions in pages
+	// after the totals and version 4 adds the difficulty counts to the totals
+	int version = 4;
 	serializer.AddData( version );
 
 	// If the version is unknown then bail
-	if( version != 1 )
+	if( version < 1 || version > 4 )
 	{
 		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"Unknown multiplication profile subset version" );
 		return false;
@@ -51,14 +54,49 @@ bool ProfileSubsetMultiplication::Serialize( Serializer& serializer )
 	serializer.AddData( sessionVersion );
 
 	// The number of sessions
-	uint32 numRecentSessions = (uint32)m_Sessions.size();
+	uint32 numRecentSessions = GetNumSessions();
 	serializer.AddData( numRecentSessions );
 
-	// If we the profile is being loaded then read in the sessions
 	if( serializer.InReadMode() )
 	{
 		m_Sessions.clear();
+		m_SessionIter = m_Sessions.end();
+		m_NumUnsavedSessions = 0;
+		ClearPackedPages();
+
+		// The history is built from the sessions when it is first used
+		m_History.Clear();
+		m_HasHistory = false;
+	}
+
+	// Transfer the totals and pages, the pages are only decoded if they were saved with another
+	// number of primes
+	if( version >= 3 )
+	{
+		m_Totals.Serialize( serializer, numPrimes, version >= 4 );
+		if( !SerializePages( serializer, numRecentSessions, numPrimes ) )
+		{
+			MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"The multiplication profile subset session pages are damaged" );
+			ClearPackedPages();
+			m_Totals.Clear();
+			return false;
+		}
+
+		if( serializer.InReadMode() && numPrimes != GameDefines::NUM_PRIMES )
+			DecodeAllPages();
+		// Totals saved without the difficulty counts are built once from the sessions
+		if( serializer.InReadMode() && (version < 4 || m_Totals.numSessions != numRecentSessions) )
+		{
+			DecodeAllPages();
+			RebuildTotals();
+		}
 
+		return true;
+	}
+
+	// If we the profile is being loaded then read in the sessions
+	if( serializer.InReadMode() )
+	{
 		// Store the recent sessions
 		for( uint32 sessionIndex = 0; sessionIndex < numRecentSessions; ++sessionIndex )
 		{
@@ -76,6 +114,13 @@ bool ProfileSubsetMultiplication::Serialize( Serializer& serializer )
 			iterSession->Serialize_V1( serializer, numPrimes );
 	}
 
+	// Transfer the totals, these versions have no difficulty counts so the totals are built once
+	// from the sessions
+	if( version >= 2 )
+		m_Totals.Serialize( serializer, numPrimes, false );
+	if( serializer.InReadMode() )
+		RebuildTotals();
+
 	// Return success
 	return true;
 }
@@ -94,5 +139,412 @@ void ProfileSubsetMultiplication::StoreSession( const GameSessionStatsMult& sess
 {
 	// Store this session
 	if( sessionStats.m_Duration > 0 )
+	{
 		m_Sessions.push_front( sessionStats );
-}
\ No newline at end of file
+		m_NumUnsavedSessions++;
+		m_Totals.AddSession( sessionStats );
+		if( m_HasHistory )
+			m_History.AddSession( sessionStats );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::SerializePages  Private
+///
+///	\param serializer The serializer that reads and writes data
+///	\param numSessions The number of sessions in the subset
+///	\param numPrimes The number of primes the sessions were saved with
+///	\returns True if the pages were transferred, false if the directory does not match the data
+///
+///	Transfer the sessions as a directory of page session counts and lengths followed by the
+///	pages. Reading only copies the pages so they can be decoded when they are needed. Writing packs
+///	the decoded sessions into new pages and copies the pages that were never decoded as they are.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileSubsetMultiplication::SerializePages( Serializer& serializer, uint32 numSessions, uint32 numPrimes )
+{
+	if( serializer.InReadMode() )
+	{
+		uint32 numPages = 0;
+		serializer.AddData( numPages );
+
+		// A page holds at least one session, so there can't be more pages than sessions
+		if( numPages > numSessions )
+			return false;
+
+		// Read the directory
+		uint32 dataLen = 0;
+		uint32 numPageSessions = 0;
+		m_PackedPages.resize( numPages );
+		for( uint32 pageIndex = 0; pageIndex < numPages; ++pageIndex )
+		{
+			PackedPage& page = m_PackedPages[ pageIndex ];
+			serializer.AddData( page.numSessions );
+			serializer.AddData( page.dataLen );
+			page.dataOffset = dataLen;
+			if( page.numSessions == 0 || page.dataLen == 0 )
+				return false;
+
+			dataLen += page.dataLen;
+			numPageSessions += page.numSessions;
+		}
+
+		// The pages can't be longer than the subset, which keeps a damaged directory from
+		// allocating more than that
+		if( numPageSessions != numSessions || dataLen > serializer.GetInputLength() )
+			return false;
+
+		// Copy the pages
+		if( dataLen > 0 )
+		{
+			m_PackedPageData.resize( dataLen );
+			serializer.AddRawData( &m_PackedPageData[0], dataLen );
+		}
+		m_NextPackedPage = 0;
+		m_NumPackedSessions = numSessions;
+		m_PackedNumPrimes = numPrimes;
+
+		return true;
+	}
+
+	// Pack the decoded sessions into new pages
+	std::vector<std::string> newPages;
+	std::vector<uint32> newPageSessions;
+	SessionList::iterator iterSession = m_Sessions.begin();
+	while( iterSession != m_Sessions.end() )
+	{
+		std::ostringstream outStream( std::ios_base::out | std::ios_base::binary );
+		Serializer pageSerializer( &outStream );
+
+		uint32 numPageSessions = 0;
+		for( ; iterSession != m_Sessions.end() && numPageSessions < SESSIONS_PER_PAGE; ++iterSession, ++numPageSessions )
+			iterSession->Serialize_V1( pageSerializer, GameDefines::NUM_PRIMES );
+
+		newPages.push_back( outStream.str() );
+		newPageSessions.push_back( numPageSessions );
+	}
+
+	// Write the directory, the new pages come before the packed pages since they hold the more
+	// recent sessions
+	uint32 numPages = (uint32)newPages.size() + ((uint32)m_PackedPages.size() - m_NextPackedPage);
+	serializer.AddData( numPages );
+	for( uint32 pageIndex = 0; pageIndex < newPages.size(); ++pageIndex )
+	{
+		uint32 pageDataLen = (uint32)newPages[ pageIndex ].size();
+		serializer.AddData( newPageSessions[ pageIndex ] );
+		serializer.AddData( pageDataLen );
+	}
+	for( uint32 pageIndex = m_NextPackedPage; pageIndex < m_PackedPages.size(); ++pageIndex )
+	{
+		serializer.AddData( m_PackedPages[ pageIndex ].numSessions );
+		serializer.AddData( m_PackedPages[ pageIndex ].dataLen );
+	}
+
+	// Write the pages
+	for( uint32 pageIndex = 0; pageIndex < newPages.size(); ++pageIndex )
+		serializer.AddRawData( (uint8*)newPages[ pageIndex ].data(), (uint32)newPages[ pageIndex ].size() );
+	for( uint32 pageIndex = m_NextPackedPage; pageIndex < m_PackedPages.size(); ++pageIndex )
+		serializer.AddRawData( &m_PackedPageData[ m_PackedPages[ pageIndex ].dataOffset ], m_PackedPages[ pageIndex ].dataLen );
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::DecodeNextPage  Private
+///
+///	\returns True if a page was decoded, false if every page has been decoded
+///
+///	Decode the next packed page and add its sessions to the end of the session list, which keeps
+///	the list sorted with the most recent sessions first.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileSubsetMultiplication::DecodeNextPage()
+{
+	if( m_NextPackedPage >= m_PackedPages.size() )
+		return false;
+
+	const PackedPage& page = m_PackedPages[ m_NextPackedPage++ ];
+	DataBlock pageData( &m_PackedPageData[ page.dataOffset ], page.dataLen );
+	Serializer reader( &pageData );
+	for( uint32 sessionIndex = 0; sessionIndex < page.numSessions; ++sessionIndex )
+	{
+		GameSessionStatsMult session;
+		session.Serialize_V1( reader, m_PackedNumPrimes );
+		m_Sessions.push_back( session );
+	}
+	m_NumPackedSessions -= page.numSessions;
+
+	// Free the pages once they have all been decoded
+	if( m_NextPackedPage >= m_PackedPages.size() )
+		ClearPackedPages();
+
+	return true;
+}
+
+
+/// Decode every packed page
+void ProfileSubsetMultiplication::DecodeAllPages()
+{
+	while( DecodeNextPage() )
+	{
+	}
+}
+
+
+/// Free the packed pages
+void ProfileSubsetMultiplication::ClearPackedPages()
+{
+	m_PackedPages.clear();
+	std::vector<uint8>().swap( m_PackedPageData );
+	m_NextPackedPage = 0;
+	m_NumPackedSessions = 0;
+}
+
+
+/// Start iterating at the first session
+const GameSessionStatsMult* ProfileSubsetMultiplication::GetFirstSession()
+{
+	if( m_Sessions.empty() )
+		DecodeNextPage();
+
+	m_SessionIter = m_Sessions.begin();
+	if( m_SessionIter == m_Sessions.end() )
+		return 0;
+	return &(*m_SessionIter);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::GetNextSession  Public
+///
+///	\returns The next session, or NULL if the iteration reached the end
+///
+///	Step through the sessions. When the iteration reaches the last decoded session the next page
+///	is decoded onto the end of the list, so a caller that stops early only decodes the pages it
+///	reached.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const GameSessionStatsMult* ProfileSubsetMultiplication::GetNextSession()
+{
+	// If the iterator is already at the end
+	if( m_SessionIter == m_Sessions.end() )
+		return 0;
+
+	// Decode the next page if this is the last decoded session, the new sessions are added after
+	// the iterator
+	SessionList::iterator iterNext = m_SessionIter;
+	++iterNext;
+	if( iterNext == m_Sessions.end() && DecodeNextPage() )
+	{
+		iterNext = m_SessionIter;
+		++iterNext;
+	}
+
+	// Step forward
+	m_SessionIter = iterNext;
+
+	// If the iterator reached the end
+	if( m_SessionIter == m_Sessions.end() )
+		return 0;
+
+	return &(*m_SessionIter);
+}
+
+
+/// Get the sessions sorted by start time for charting, this decodes every session the first time
+const SessionHistoryMult& ProfileSubsetMultiplication::GetHistory()
+{
+	if( !m_HasHistory )
+	{
+		DecodeAllPages();
+		RebuildHistory();
+		m_HasHistory = true;
+	}
+
+	return m_History;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::RebuildTotals  Private
+///
+///	Rebuild the totals by going through every session.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileSubsetMultiplication::RebuildTotals()
+{
+	m_Totals.Clear();
+	for( SessionList::const_iterator iterSession = m_Sessions.begin(); iterSession != m_Sessions.end(); ++iterSession )
+		m_Totals.AddSession( *iterSession );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::RebuildHistory  Private
+///
+///	Rebuild the history from the sessions, adding the oldest first so each one is appended.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileSubsetMultiplication::RebuildHistory()
+{
+	m_History.Clear();
+	m_History.Reserve( (uint32)m_Sessions.size() );
+	for( SessionList::const_reverse_iterator iterSession = m_Sessions.rbegin(); iterSession != m_Sessions.rend(); ++iterSession )
+		m_History.AddSession( *iterSession );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::SerializeChanges  Public
+///
+///	\param serializer The serializer that reads and writes data
+///	\returns True if the changes were transferred, otherwise false
+///
+///	Save the sessions stored since the last save, oldest first, or add sessions that were saved
+///	this way to the front of the list.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ProfileSubsetMultiplication::SerializeChanges( Serializer& serializer )
+{
+	// The version
+	int version = 1;
+	serializer.AddData( version );
+	if( version != 1 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"Unknown multiplication profile journal version" );
+		return false;
+	}
+
+	uint32 numPrimes = GameDefines::NUM_PRIMES;
+	serializer.AddData( numPrimes );
+
+	int sessionVersion = 1;
+	serializer.AddData( sessionVersion );
+
+	uint32 numSessions = m_NumUnsavedSessions;
+	serializer.AddData( numSessions );
+
+	if( serializer.InReadMode() )
+	{
+		// The sessions are oldest first so each one goes in front of the last
+		for( uint32 sessionIndex = 0; sessionIndex < numSessions; ++sessionIndex )
+		{
+			GameSessionStatsMult session;
+			if( sessionVersion == 1 )
+				session.Serialize_V1( serializer, numPrimes );
+			m_Sessions.push_front( session );
+			m_Totals.AddSession( session );
+			if( m_HasHistory )
+				m_History.AddSession( session );
+		}
+	}
+	else
+	{
+		// Step back from the last unsaved session to the most recent
+		SessionList::iterator iterSession = m_Sessions.begin();
+		std::advance( iterSession, numSessions );
+		for( uint32 sessionIndex = 0; sessionIndex < numSessions; ++sessionIndex )
+		{
+			--iterSession;
+			iterSession->Serialize_V1( serializer, numPrimes );
+		}
+	}
+
+	return true;
+}
+
+
+/// Reset the totals to no sessions
+void ProfileSubsetMultiplication::Totals::Clear()
+{
+	numSessions = 0;
+	duration = 0;
+	numEqsCleared = 0;
+	numEqsFailed = 0;
+	numBlocksCleared = 0;
+	highScore = 0;
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		validCounts[ primeIndex ] = 0;
+		errorCounts[ primeIndex ] = 0;
+	}
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+		difficultyCounts[ diffIndex ] = 0;
+}
+
+
+/// Add a session to the totals
+void ProfileSubsetMultiplication::Totals::AddSession( const GameSessionStatsMult& session )
+{
+	numSessions++;
+	duration += session.m_Duration;
+	numEqsCleared += session.m_NumEqsCleared;
+	numEqsFailed += session.m_NumEqsFailed;
+	numBlocksCleared += session.m_NumBlocksCleared;
+	if( session.m_Score > highScore )
+		highScore = session.m_Score;
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		validCounts[ primeIndex ] += session.m_ValidCounts[ primeIndex ];
+		errorCounts[ primeIndex ] += session.m_ErrorCounts[ primeIndex ];
+	}
+	if( (uint32)session.m_Difficulty < (uint32)GameDefines::GPDL_COUNT )
+		difficultyCounts[ session.m_Difficulty ]++;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ProfileSubsetMultiplication::Totals::Serialize  Public
+///
+///	\param serializer The serializer that reads and writes data
+///	\param numPrimes The number of primes the counts were saved with
+///	\param hasDifficultyCounts True if the difficulty counts are transferred
+///
+///	Transfer the totals.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ProfileSubsetMultiplication::Totals::Serialize( Serializer& serializer, uint32 numPrimes, bool hasDifficultyCounts )
+{
+	serializer.AddData( numSessions );
+	serializer.AddData( duration );
+	serializer.AddData( numEqsCleared );
+	serializer.AddData( numEqsFailed );
+	serializer.AddData( numBlocksCleared );
+	serializer.AddData( highScore );
+
+	// Transfer the prime counts, skipping any primes this version does not know of
+	for( uint32 primeIndex = 0; primeIndex < numPrimes; ++primeIndex )
+	{
+		uint32 validCount = primeIndex < GameDefines::NUM_PRIMES ? validCounts[ primeIndex ] : 0;
+		uint32 errorCount = primeIndex < GameDefines::NUM_PRIMES ? errorCounts[ primeIndex ] : 0;
+		serializer.AddData( validCount );
+		serializer.AddData( errorCount );
+		if( primeIndex < GameDefines::NUM_PRIMES )
+		{
+			validCounts[ primeIndex ] = validCount;
+			errorCounts[ primeIndex ] = errorCount;
+		}
+	}
+
+	if( !hasDifficultyCounts )
+		return;
+
+	// Transfer the difficulty counts, skipping any levels this version does not know of
+	uint32 numDifficulties = GameDefines::GPDL_COUNT;
+	serializer.AddData( numDifficulties );
+	for( uint32 diffIndex = 0; diffIndex < numDifficulties; ++diffIndex )
+	{
+		uint32 diffCount = diffIndex < GameDefines::GPDL_COUNT ? difficultyCounts[ diffIndex ] : 0;
+		serializer.AddData( diffCount );
+		if( diffIndex < GameDefines::GPDL_COUNT )
+			difficultyCounts[ diffIndex ] = diffCount;
+	}
+}
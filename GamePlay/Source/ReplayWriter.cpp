@@ -0,0 +1,365 @@
+/*=================================================================================================
+
+	\file ReplayWriter.cpp
+	Game Play Library
+	Replay Writer Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the replay writer class.
+
+=================================================================================================*/
+
+#include "../ReplayWriter.h"
+#include "../GameFieldInstruction.h"
+#include "Base/DataBlockOut.h"
+#include "Base/MsgLogger.h"
+#include "Base/StringFuncs.h"
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+/// Sleep the calling thread
+static void SleepMS( uint32 numMS )
+{
+#ifdef WIN32
+	Sleep( numMS );
+#else
+	// usleep takes microseconds
+	usleep( numMS * 1000 );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriteThreadProc  Global
+///
+///	\param pParam The replay writer
+///
+///	The entry point of the writer thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef WIN32
+void ReplayWriteThreadProc( void* pParam )
+#else
+void* ReplayWriteThreadProc( void* pParam )
+#endif
+{
+	((ReplayWriter*)pParam)->RunWriteThread();
+
+#ifndef WIN32
+	return 0;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::ReplayWriter  Public
+///
+///	The default constructor.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ReplayWriter::ReplayWriter() : m_FillSize( 0 ),
+								m_WriteThread( ReplayWriteThreadProc ),
+								m_IsThreadRunning( false ),
+								m_StopRequested( false ),
+								m_IsRecording( false ),
+								m_PrevTick( 0 ),
+								m_FlushTick( 0 ),
+								m_NumBytesRecorded( 0 )
+{
+	// Reserve the space up front so the game thread doesn't allocate when flushing
+	m_PendingData.reserve( BUFFER_SIZE * 2 );
+	m_WriteData.reserve( BUFFER_SIZE * 2 );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::~ReplayWriter  Public
+///
+///	The destructor.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ReplayWriter::~ReplayWriter()
+{
+	End();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::Begin  Public
+///
+///	\param szFilePath The path of the replay file to create
+///	\param header The header describing the game being recorded
+///	\returns True if the replay is being recorded, false otherwise
+///
+///	Create the replay file, write the header and start the writer thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayWriter::Begin( const wchar_t* szFilePath, ReplayHeader& header )
+{
+	if( m_IsRecording )
+		End();
+
+	m_OutFile.open( TCBase::Narrow( szFilePath ).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+	if( !m_OutFile.good() )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to create replay file %s.", szFilePath );
+		return false;
+	}
+
+	// Pack the header into the fill buffer so it is written with the first records
+	DataBlockOut dataOut( m_FillBuffer, BUFFER_SIZE );
+	PackedSerializer serializer( &dataOut );
+	header.Serialize( serializer );
+
+	m_FillSize = dataOut.GetCurPosition();
+	m_NumBytesRecorded = m_FillSize;
+	m_PrevTick = 0;
+	m_FlushTick = 0;
+	m_StopRequested = false;
+
+	m_IsThreadRunning = true;
+	m_WriteThread.Run( this );
+
+	m_IsRecording = true;
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::RecordInstruction  Public
+///
+///	\param pInst The instruction that was handled
+///	\param tick The simulation tick the instruction was handled on
+///
+///	Pack an instruction into the fill buffer.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::RecordInstruction( GameFieldInstruction* pInst, uint32 tick )
+{
+	if( !m_IsRecording || !pInst )
+		return;
+
+	DataBlockOut dataOut( m_FillBuffer + m_FillSize, BUFFER_SIZE - m_FillSize );
+	PackedSerializer serializer( &dataOut );
+
+	// Store the number of ticks since the last record, which is almost always a single byte
+	uint32 tickDelta = tick - m_PrevTick;
+	serializer.AddData( tickDelta );
+	m_PrevTick = tick;
+
+	uint8 instructionID = (uint8)pInst->GetType();
+	serializer.AddData( instructionID );
+
+	pInst->SerializePayload( serializer );
+
+	m_FillSize += dataOut.GetCurPosition();
+	m_NumBytesRecorded += dataOut.GetCurPosition();
+
+	CheckFlush( tick );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::RecordSnapshot  Public
+///
+///	\param pStateData The game state data
+///	\param dataSize The size of the game state data in bytes
+///	\param tick The simulation tick the state is from
+///
+///	Record a snapshot of the game state. The record's header is packed into the fill buffer like
+///	an instruction. The state data is copied into the fill buffer if it fits, otherwise the fill
+///	buffer is flushed and the data is appended to the pending data directly.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::RecordSnapshot( const uint8* pStateData, uint32 dataSize, uint32 tick )
+{
+	if( !m_IsRecording || !pStateData )
+		return;
+
+	DataBlockOut dataOut( m_FillBuffer + m_FillSize, BUFFER_SIZE - m_FillSize );
+	PackedSerializer serializer( &dataOut );
+
+	uint32 tickDelta = tick - m_PrevTick;
+	serializer.AddData( tickDelta );
+	m_PrevTick = tick;
+
+	uint8 recordID = ReplayHeader::SNAPSHOT_RECORD_ID;
+	serializer.AddData( recordID );
+	serializer.AddData( dataSize );
+
+	m_FillSize += dataOut.GetCurPosition();
+	m_NumBytesRecorded += dataOut.GetCurPosition() + dataSize;
+
+	if( dataSize <= BUFFER_SIZE - m_FillSize )
+	{
+		memcpy( m_FillBuffer + m_FillSize, pStateData, dataSize );
+		m_FillSize += dataSize;
+	}
+	else
+	{
+		Flush();
+
+		m_DataLock.Enter();
+		m_PendingData.insert( m_PendingData.end(), pStateData, pStateData + dataSize );
+		m_DataLock.Leave();
+	}
+
+	CheckFlush( tick );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::RecordSummary  Public
+///
+///	\param score The final score
+///	\param numBlocks The number of blocks on the field when the game ended
+///	\param tick The simulation tick the game ended on
+///
+///	Record the results of the game so the replay can be verified. The summary is flushed right
+///	away since the game is over.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::RecordSummary( uint32 score, uint32 numBlocks, uint32 tick )
+{
+	if( !m_IsRecording )
+		return;
+
+	DataBlockOut dataOut( m_FillBuffer + m_FillSize, BUFFER_SIZE - m_FillSize );
+	PackedSerializer serializer( &dataOut );
+
+	uint32 tickDelta = tick - m_PrevTick;
+	serializer.AddData( tickDelta );
+	m_PrevTick = tick;
+
+	uint8 recordID = ReplayHeader::SUMMARY_RECORD_ID;
+	serializer.AddData( recordID );
+	serializer.AddData( score );
+	serializer.AddData( numBlocks );
+
+	m_FillSize += dataOut.GetCurPosition();
+	m_NumBytesRecorded += dataOut.GetCurPosition();
+
+	Flush();
+	m_FlushTick = tick;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::CheckFlush  Private
+///
+///	\param tick The simulation tick of the last record
+///
+///	Hand the fill buffer to the writer thread if another record might not fit or it has been a
+///	while since the last flush.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::CheckFlush( uint32 tick )
+{
+	if( BUFFER_SIZE - m_FillSize < MAX_RECORD_SIZE || tick - m_FlushTick >= FLUSH_INTERVAL_TICKS )
+	{
+		Flush();
+		m_FlushTick = tick;
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::Flush  Private
+///
+///	Append the fill buffer to the data waiting for the writer thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::Flush()
+{
+	if( m_FillSize == 0 )
+		return;
+
+	m_DataLock.Enter();
+	m_PendingData.insert( m_PendingData.end(), m_FillBuffer, m_FillBuffer + m_FillSize );
+	m_DataLock.Leave();
+
+	m_FillSize = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::RunWriteThread  Private
+///
+///	Write the pending data to the file until a stop is requested, then close the file. This runs
+///	on the writer thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::RunWriteThread()
+{
+	for(;;)
+	{
+		// Check for the stop before taking the data so the data flushed before the stop was
+		// requested is written
+		bool isStopping = m_StopRequested;
+
+		// Swap the buffers so the lock is only held for a moment
+		m_DataLock.Enter();
+		m_WriteData.swap( m_PendingData );
+		m_DataLock.Leave();
+
+		if( !m_WriteData.empty() )
+		{
+			m_OutFile.write( (const char*)&m_WriteData[0], (std::streamsize)m_WriteData.size() );
+			m_WriteData.clear();
+		}
+
+		if( isStopping )
+			break;
+
+		SleepMS( WRITE_INTERVAL_MS );
+	}
+
+	m_OutFile.close();
+	m_IsThreadRunning = false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayWriter::End  Public
+///
+///	Flush the remaining records, wait for the writer thread to write them and close the file.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::End()
+{
+	if( !m_IsRecording )
+		return;
+
+	Flush();
+	m_StopRequested = true;
+
+	// Wait for the writer thread to finish. The thread uses the file and the buffers, so the wait
+	// can not give up or the writer could be freed while the thread is still running.
+	uint32 waitTime = 0;
+	while( m_IsThreadRunning )
+	{
+		SleepMS( 1 );
+		if( ++waitTime == END_TIMEOUT_MS )
+			MSG_LOGGER_OUT( MsgLogger::MI_Warning, L"The replay writer thread is slow to finish, still waiting for it." );
+	}
+
+	m_IsRecording = false;
+}
@@ -0,0 +1,278 @@
+/*=================================================================================================
+
+	\file SessionHistoryMult.cpp
+	Game Play Library
+	Multiplication Session History Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the column store of multiplication sessions.
+
+=================================================================================================*/
+
+#include "../SessionHistoryMult.h"
+#include "../GameSessionStatsMult.h"
+#include <algorithm>
+
+
+/// Insert a value into a column, appending is the common case since sessions are played in order
+template< class T >
+static void InsertValue( std::vector<T>& column, uint32 index, const T& value )
+{
+	if( index == column.size() )
+		column.push_back( value );
+	else
+		column.insert( column.begin() + index, value );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  TotalColumn  Global
+///
+///	\param values The column to total
+///	\param startTimes The start time of each session
+///	\param firstIndex The first session in the range
+///	\param endIndex The index after the last session in the range
+///	\param startTime The time the first bucket starts at
+///	\param bucketLen The length of each bucket
+///	\param buckets The buckets to add to
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template< class T >
+static void TotalColumn( const std::vector<T>& values, const std::vector<time_t>& startTimes, uint32 firstIndex, uint32 endIndex,
+							time_t startTime, time_t bucketLen, std::vector<SessionHistoryMult::Bucket>& buckets )
+{
+	for( uint32 sessionIndex = firstIndex; sessionIndex < endIndex; ++sessionIndex )
+	{
+		SessionHistoryMult::Bucket& bucket = buckets[ (uint32)((startTimes[ sessionIndex ] - startTime) / bucketLen) ];
+		float64 value = (float64)values[ sessionIndex ];
+
+		bucket.numSessions++;
+		bucket.total += value;
+		if( bucket.numSessions == 1 || value > bucket.maxValue )
+			bucket.maxValue = value;
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SessionHistoryMult::GetStartTime  Static Public
+///
+///	\param session The session
+///	\returns The time the session started, 0 if it has no valid start time
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+time_t SessionHistoryMult::GetStartTime( const GameSessionStatsMult& session )
+{
+	// mktime normalizes the structure it is passed so use a copy
+	tm startTime = session.m_SessionStartTime;
+	time_t retVal = mktime( &startTime );
+	if( retVal == (time_t)-1 )
+		return 0;
+	return retVal;
+}
+
+
+/// Remove every session
+void SessionHistoryMult::Clear()
+{
+	m_StartTimes.clear();
+	m_Durations.clear();
+	m_Scores.clear();
+	m_NumEqsCleared.clear();
+	m_NumEqsFailed.clear();
+	m_NumBlocksCleared.clear();
+	m_Difficulties.clear();
+	m_MaxCombos.clear();
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		m_ValidCounts[ primeIndex ].clear();
+		m_ErrorCounts[ primeIndex ].clear();
+	}
+}
+
+
+/// Reserve space for a number of sessions
+void SessionHistoryMult::Reserve( uint32 numSessions )
+{
+	m_StartTimes.reserve( numSessions );
+	m_Durations.reserve( numSessions );
+	m_Scores.reserve( numSessions );
+	m_NumEqsCleared.reserve( numSessions );
+	m_NumEqsFailed.reserve( numSessions );
+	m_NumBlocksCleared.reserve( numSessions );
+	m_Difficulties.reserve( numSessions );
+	m_MaxCombos.reserve( numSessions );
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		m_ValidCounts[ primeIndex ].reserve( numSessions );
+		m_ErrorCounts[ primeIndex ].reserve( numSessions );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SessionHistoryMult::AddSession  Public
+///
+///	\param session The session to add
+///
+///	Add a session to the history. Sessions are normally added in the order they were played so
+///	they are appended, but a session that starts before the last one, such as after the clock
+///	was changed, is inserted where it belongs.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SessionHistoryMult::AddSession( const GameSessionStatsMult& session )
+{
+	time_t startTime = GetStartTime( session );
+
+	// Insert after any sessions that started at the same time to keep the order they were added
+	uint32 index = (uint32)m_StartTimes.size();
+	if( !m_StartTimes.empty() && startTime < m_StartTimes.back() )
+		index = (uint32)( std::upper_bound( m_StartTimes.begin(), m_StartTimes.end(), startTime ) - m_StartTimes.begin() );
+
+	InsertValue( m_StartTimes, index, startTime );
+	InsertValue( m_Durations, index, session.m_Duration );
+	InsertValue( m_Scores, index, session.m_Score );
+	InsertValue( m_NumEqsCleared, index, session.m_NumEqsCleared );
+	InsertValue( m_NumEqsFailed, index, session.m_NumEqsFailed );
+	InsertValue( m_NumBlocksCleared, index, session.m_NumBlocksCleared );
+	InsertValue( m_Difficulties, index, (uint8)session.m_Difficulty );
+	InsertValue( m_MaxCombos, index, session.m_MaxCombo );
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+	{
+		InsertValue( m_ValidCounts[ primeIndex ], index, session.m_ValidCounts[ primeIndex ] );
+		InsertValue( m_ErrorCounts[ primeIndex ], index, session.m_ErrorCounts[ primeIndex ] );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SessionHistoryMult::FindFirstSession  Public
+///
+///	\param startTime The time to search for
+///	\returns The index of the first session that starts at or after the time, the number of
+///	sessions if there are none
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 SessionHistoryMult::FindFirstSession( time_t startTime ) const
+{
+	return (uint32)( std::lower_bound( m_StartTimes.begin(), m_StartTimes.end(), startTime ) - m_StartTimes.begin() );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SessionHistoryMult::GetBucketRange  Private
+///
+///	\param startTime The start of the time range
+///	\param endTime The end of the time range, sessions starting at this time are not included
+///	\param numBuckets The number of buckets to split the range into
+///	\param firstIndex The first session in the range
+///	\param endIndex The index after the last session in the range
+///	\param bucketLen The length of each bucket, rounded up so the buckets cover the range
+///	\returns True if there are buckets to fill, false if the range or bucket count is empty
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SessionHistoryMult::GetBucketRange( time_t startTime, time_t endTime, uint32 numBuckets, uint32& firstIndex, uint32& endIndex, time_t& bucketLen ) const
+{
+	if( numBuckets == 0 || endTime <= startTime )
+		return false;
+
+	bucketLen = (endTime - startTime + (time_t)numBuckets - 1) / (time_t)numBuckets;
+	firstIndex = FindFirstSession( startTime );
+	endIndex = FindFirstSession( endTime );
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SessionHistoryMult::Downsample  Public
+///
+///	\param column The column to total
+///	\param startTime The start of the time range
+///	\param endTime The end of the time range, sessions starting at this time are not included
+///	\param numBuckets The number of buckets to split the range into
+///	\param buckets The list that receives the buckets, oldest first
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SessionHistoryMult::Downsample( EColumn column, time_t startTime, time_t endTime, uint32 numBuckets, std::vector<Bucket>& buckets ) const
+{
+	buckets.clear();
+
+	uint32 firstIndex = 0, endIndex = 0;
+	time_t bucketLen = 1;
+	if( !GetBucketRange( startTime, endTime, numBuckets, firstIndex, endIndex, bucketLen ) )
+		return;
+
+	buckets.resize( numBuckets );
+	for( uint32 bucketIndex = 0; bucketIndex < numBuckets; ++bucketIndex )
+		buckets[ bucketIndex ].startTime = startTime + (time_t)bucketIndex * bucketLen;
+
+	switch( column )
+	{
+	case C_Duration:
+		TotalColumn( m_Durations, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	case C_Score:
+		TotalColumn( m_Scores, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	case C_NumEqsCleared:
+		TotalColumn( m_NumEqsCleared, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	case C_NumEqsFailed:
+		TotalColumn( m_NumEqsFailed, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	case C_NumBlocksCleared:
+		TotalColumn( m_NumBlocksCleared, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	case C_Difficulty:
+		TotalColumn( m_Difficulties, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	case C_MaxCombo:
+		TotalColumn( m_MaxCombos, m_StartTimes, firstIndex, endIndex, startTime, bucketLen, buckets );
+		break;
+	default:
+		break;
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SessionHistoryMult::DownsamplePrime  Public
+///
+///	\param primeIndex The index of the prime factor
+///	\param startTime The start of the time range
+///	\param endTime The end of the time range, sessions starting at this time are not included
+///	\param numBuckets The number of buckets to split the range into
+///	\param buckets The list that receives the buckets, oldest first
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SessionHistoryMult::DownsamplePrime( uint32 primeIndex, time_t startTime, time_t endTime, uint32 numBuckets, std::vector<PrimeBucket>& buckets ) const
+{
+	buckets.clear();
+
+	uint32 firstIndex = 0, endIndex = 0;
+	time_t bucketLen = 1;
+	if( primeIndex >= GameDefines::NUM_PRIMES || !GetBucketRange( startTime, endTime, numBuckets, firstIndex, endIndex, bucketLen ) )
+		return;
+
+	buckets.resize( numBuckets );
+	for( uint32 bucketIndex = 0; bucketIndex < numBuckets; ++bucketIndex )
+		buckets[ bucketIndex ].startTime = startTime + (time_t)bucketIndex * bucketLen;
+
+	const std::vector<uint32>& validCounts = m_ValidCounts[ primeIndex ];
+	const std::vector<uint32>& errorCounts = m_ErrorCounts[ primeIndex ];
+	for( uint32 sessionIndex = firstIndex; sessionIndex < endIndex; ++sessionIndex )
+	{
+		PrimeBucket& bucket = buckets[ (uint32)((m_StartTimes[ sessionIndex ] - startTime) / bucketLen) ];
+		bucket.numSessions++;
+		bucket.validCount += validCounts[ sessionIndex ];
+		bucket.errorCount += errorCounts[ sessionIndex ];
+	}
+}
@@ -0,0 +1,229 @@
+//=================================================================================================
+/*!
+	\file DifficultyCalibrator.h
+	Game Simulator
+	Difficulty Calibrator Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the object that measures how the difficulty tables
+	play by simulating many bot games for each difficulty level and table adjustment.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __DifficultyCalibrator_h
+#define __DifficultyCalibrator_h
+
+#include "Base/Types.h"
+#include "Base/CriticalSection.h"
+#include "GamePlay/GameDefines.h"
+#include "GamePlay/PlayerBot.h"
+#include "GameSimRunner.h"
+#include <vector>
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class DifficultyCalibrator
+	\brief Plays bot games over a grid of difficulty levels and table adjustments in parallel.
+
+	Every combination of a difficulty level and the adjustments in the settings is a cell of the
+	grid, and each cell plays the same number of games. The Nth game of every cell starts from
+	the same seed so the differences between cells come from the adjustments rather than the
+	luck of the draw. Each worker thread binds its own GameContext and takes the next game from a
+	shared queue, so a sweep scales with the number of cores and gives the same numbers no
+	matter how many threads are used.
+*/
+//-------------------------------------------------------------------------------------------------
+class DifficultyCalibrator
+{
+public:
+
+	/// The settings for a calibration run
+	struct Settings
+	{
+		/// The type of game to play
+		GameDefines::EGameType gameType;
+
+		/// The difficulty levels to measure
+		std::vector<GameDefines::EGameplayDiffLevel> difficulties;
+
+		/// The scales of the largest product to measure
+		std::vector<float32> maxValueScales;
+
+		/// The offsets of the most prime factors to measure
+		std::vector<int32> maxNumFactorsOffsets;
+
+		/// The offsets of the largest usable prime to measure
+		std::vector<int32> maxPrimeIndexOffsets;
+
+		/// The scales of the range of sums to measure
+		std::vector<float32> sumRangeScales;
+
+		/// The number of games played for each cell of the grid
+		uint32 gamesPerCell;
+
+		/// The seed that all of the game seeds are generated from
+		uint64 seed;
+
+		/// The longest a single game is played before it is ended, in simulated seconds
+		float32 maxGameTime;
+
+		/// The settings for the bot that plays the games
+		PlayerBot::Settings botSettings;
+
+		Settings() : gameType( GameDefines::GT_PrimeTime ),
+					gamesPerCell( 100 ),
+					seed( 0 ),
+					maxGameTime( 600.0f )
+		{}
+	};
+
+	/// The measurements of one cell of the grid
+	struct Cell
+	{
+		/// The difficulty level
+		GameDefines::EGameplayDiffLevel difficulty;
+
+		/// The adjustments to the difficulty tables
+		GameDefines::DifficultyTuning diffTuning;
+
+		/// The number of games played
+		uint32 numGames;
+
+		/// The number of games that ended with the field filling before the time limit
+		uint32 numGamesFilled;
+
+		/// The number of equations cleared
+		uint64 numEqsCleared;
+
+		/// The number of equations failed
+		uint64 numEqsFailed;
+
+		/// The total simulated time of every game in seconds
+		float64 totalGameTime;
+
+		/// The total simulated time of the games that filled the field in seconds
+		float64 totalFillTime;
+
+		/// The number of times each prime was used in a cleared equation
+		uint64 primeCounts[ GameDefines::NUM_PRIMES ];
+
+		/// The final score of every game, sorted ascendingly
+		std::vector<uint32> scores;
+
+		Cell() : difficulty( GameDefines::GPDL_4 ),
+					numGames( 0 ),
+					numGamesFilled( 0 ),
+					numEqsCleared( 0 ),
+					numEqsFailed( 0 ),
+					totalGameTime( 0.0 ),
+					totalFillTime( 0.0 )
+		{
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+				primeCounts[ primeIndex ] = 0;
+		}
+
+		/// Get the fraction of the equations attempted that were cleared
+		float64 GetClearRate() const;
+
+		/// Get the equations cleared per simulated minute
+		float64 GetClearsPerMinute() const;
+
+		/// Get the average time for the field to fill, 0 if it never filled
+		float64 GetAvgFillTime() const;
+
+		/// Get the average final score
+		float64 GetAvgScore() const;
+
+		/// Get the score that a percentage of the games scored at or below
+		uint32 GetScorePercentile( uint32 percent ) const;
+
+		/// Get the fraction of the cleared prime factors that were a prime
+		float64 GetPrimeShare( uint32 primeIndex ) const;
+	};
+
+	/// The results of a calibration run
+	struct Results
+	{
+		/// The number of worker threads used
+		uint32 numThreads;
+
+		/// The number of games played
+		uint32 numGames;
+
+		/// The total number of ticks simulated
+		uint64 numTicks;
+
+		/// The real time taken in seconds
+		float64 wallTime;
+
+		Results() : numThreads( 0 ),
+					numGames( 0 ),
+					numTicks( 0 ),
+					wallTime( 0.0 )
+		{}
+	};
+
+private:
+
+	/// The settings for the run
+	Settings m_Settings;
+
+	/// The cells of the grid
+	std::vector<Cell> m_Cells;
+
+	/// The statistics of every game, the games of a cell are stored together in cell order
+	std::vector<GameSimRunner::GameResult> m_GameResults;
+
+	/// The index of the next game to hand to a worker, guarded by m_QueueLock
+	uint32 m_NextGameIndex;
+
+	/// The number of workers that have not finished, guarded by m_QueueLock
+	uint32 m_NumRunningWorkers;
+
+	/// The number of ticks simulated by the workers that have finished, guarded by m_QueueLock
+	uint64 m_NumTicks;
+
+	/// The lock for the game queue
+	TCBase::CriticalSection m_QueueLock;
+
+	/// The results of the last run
+	Results m_Results;
+
+
+	/// Create a cell for every combination of the settings' difficulties and adjustments
+	void BuildCells();
+
+	/// Take the next game from the queue, false if there are none left
+	bool TakeNextGame( uint32& gameIndex );
+
+	/// Play games until the queue is empty, this runs on a worker thread
+	void RunWorker();
+
+	/// Add the statistics of every game to its cell
+	void StoreCellResults();
+
+#ifdef WIN32
+	friend void DifficultyCalibrateThreadProc( void* pParam );
+#else
+	friend void* DifficultyCalibrateThreadProc( void* pParam );
+#endif
+
+public:
+
+	/// The default constructor
+	DifficultyCalibrator() : m_NextGameIndex( 0 ),
+								m_NumRunningWorkers( 0 ),
+								m_NumTicks( 0 )
+	{}
+
+	/// Play the games described by the settings using a number of worker threads
+	const Results& Run( const Settings& settings, uint32 numThreads );
+
+	/// Get the measurements of each cell from the last run
+	const std::vector<Cell>& GetCells() const { return m_Cells; }
+};
+
+#endif // __DifficultyCalibrator_h
@@ -0,0 +1,210 @@
+//=================================================================================================
+/*!
+	\file GameSimRunner.h
+	Game Simulator
+	Game Simulation Runner Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the object that plays games without graphics, audio
+	or a user interface so gameplay can be run as fast as possible and measured.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __GameSimRunner_h
+#define __GameSimRunner_h
+
+#include "Base/Types.h"
+#include "Base/RandomGen.h"
+#include "GamePlay/GameDefines.h"
+#include "GamePlay/PlayerBot.h"
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class GameSimRunner
+	\brief Plays headless games with the player bot and collects the results.
+
+	The runner drives the game manager with the same fixed simulation tick the application uses,
+	but as fast as the CPU allows. Every game is started from a seed derived from the run's seed
+	so a run can be repeated exactly.
+*/
+//-------------------------------------------------------------------------------------------------
+class GameSimRunner
+{
+public:
+
+	/// The settings for a simulation run
+	struct Settings
+	{
+		/// The type of game to play
+		GameDefines::EGameType gameType;
+
+		/// The difficulty level
+		GameDefines::EGameplayDiffLevel difficulty;
+
+		/// The seed that all of the game seeds are generated from
+		uint64 seed;
+
+		/// The number of games to play, 0 to play until the time is used
+		uint32 numGames;
+
+		/// The total simulated time to play in seconds, 0 to play until the games are done
+		float32 totalSimTime;
+
+		/// The longest a single game is played before it is ended, in simulated seconds
+		float32 maxGameTime;
+
+		/// The settings for the bot that plays the games
+		PlayerBot::Settings botSettings;
+
+		/// The adjustments to the difficulty tables
+		GameDefines::DifficultyTuning diffTuning;
+
+		Settings() : gameType( GameDefines::GT_PrimeTime ),
+					difficulty( GameDefines::GPDL_4 ),
+					seed( 0 ),
+					numGames( 10 ),
+					totalSimTime( 0.0f ),
+					maxGameTime( 600.0f )
+		{}
+	};
+
+	/// The statistics of a single game
+	struct GameResult
+	{
+		/// The final score
+		uint32 score;
+
+		/// The simulated length of the game in seconds
+		float32 gameTime;
+
+		/// If the game ended on its own, such as the field filling, instead of hitting the limit
+		bool endedOnItsOwn;
+
+		/// The number of equations cleared
+		uint32 numEqsCleared;
+
+		/// The number of equations failed
+		uint32 numEqsFailed;
+
+		/// The number of times each prime was used in a cleared equation, product games only
+		uint32 primeCounts[ GameDefines::NUM_PRIMES ];
+
+		GameResult()
+		{
+			Clear();
+		}
+
+		/// Clear the statistics
+		void Clear()
+		{
+			score = 0;
+			gameTime = 0.0f;
+			endedOnItsOwn = false;
+			numEqsCleared = 0;
+			numEqsFailed = 0;
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+				primeCounts[ primeIndex ] = 0;
+		}
+	};
+
+	/// The results of a simulation run
+	struct Results
+	{
+		/// The number of games played
+		uint32 numGamesPlayed;
+
+		/// The number of games that ended on their own instead of hitting the time limit
+		uint32 numGamesFinished;
+
+		/// The number of simulation ticks run
+		uint64 numTicks;
+
+		/// The number of clicks sent to the game field
+		uint64 numClicks;
+
+		/// The number of clicks the bot deliberately got wrong
+		uint64 numBotErrors;
+
+		/// The total simulated time in seconds
+		float64 simTime;
+
+		/// The total real time in seconds
+		float64 wallTime;
+
+		/// The sum of the final scores of every game
+		uint64 totalScore;
+
+		/// The number of equations the games reported as cleared
+		uint64 numEqsCleared;
+
+		/// The number of equations the games reported as failed
+		uint64 numEqsFailed;
+
+		/// The number of blocks generated, product games only
+		uint64 numBlocksGenerated;
+
+		/// The number of products that were made primes because none fit the row, product games only
+		uint64 numProductFallbacks;
+
+		Results()
+		{
+			Clear();
+		}
+
+		/// Clear the results
+		void Clear()
+		{
+			numGamesPlayed = 0;
+			numGamesFinished = 0;
+			numTicks = 0;
+			numClicks = 0;
+			numBotErrors = 0;
+			simTime = 0.0;
+			wallTime = 0.0;
+			totalScore = 0;
+			numEqsCleared = 0;
+			numEqsFailed = 0;
+			numBlocksGenerated = 0;
+			numProductFallbacks = 0;
+		}
+	};
+
+private:
+
+	/// The settings for the run
+	Settings m_Settings;
+
+	/// The results of the run
+	Results m_Results;
+
+	/// The random number generator used to create the game and bot seeds
+	TCBase::RandomGen m_SeedRandom;
+
+	/// The bot that plays the games
+	PlayerBot m_Bot;
+
+	/// The statistics of the last game played
+	GameResult m_LastGame;
+
+	/// Add the statistics of the game that just ended to the results
+	void StoreGameResults();
+
+public:
+
+	/// Play the games described by the settings
+	const Results& Run( const Settings& settings );
+
+	/// Play a single game, returning false if the game could not be started
+	bool RunGame( uint64 gameSeed );
+
+	/// Get the results of the last run
+	const Results& GetResults() const { return m_Results; }
+
+	/// Get the statistics of the last game played
+	const GameResult& GetLastGame() const { return m_LastGame; }
+};
+
+#endif // __GameSimRunner_h
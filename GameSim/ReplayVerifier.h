@@ -0,0 +1,277 @@
+//=================================================================================================
+/*!
+	\file ReplayVerifier.h
+	Game Simulator
+	Replay Verifier Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the object that re-simulates a directory of replays
+	on worker threads and checks that each one still plays the game that was recorded.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __ReplayVerifier_h
+#define __ReplayVerifier_h
+
+#include "Base/Types.h"
+#include "Base/CriticalSection.h"
+#include "GamePlay/InstructionStreamReplay.h"
+#include <string>
+#include <vector>
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class ReplayVerifier
+	\brief Re-simulates replays in parallel and compares them to the recorded results.
+
+	Each worker thread binds its own GameContext, so every replay is played by a separate game
+	manager, logic and field, and takes the next replay from a shared queue until there are none
+	left. A replay passes if every snapshot matches the simulated game's state and, for replays
+	with a summary, the final score and block count match.
+
+	When columns are checked, the columns of a product or fraction field are compared after
+	every tick to the blocks that span them, and the ticks are timed separately depending on if
+	blocks were falling, so the cost of cascades can be measured against recorded games.
+
+	When seeks are checked, each replay that verifies is then sought back to the tick before
+	every snapshot in turn and simulated to the snapshot, which must match the state recorded
+	there. Each seek restores the previous snapshot and simulates up to a full snapshot interval,
+	the slowest a seek can be, and is timed so the seek latency can be measured against its
+	target.
+*/
+//-------------------------------------------------------------------------------------------------
+class ReplayVerifier
+{
+public:
+
+	/// The result of verifying one replay
+	struct ReplayResult
+	{
+		/// The replay file
+		std::wstring sFile;
+
+		/// If the replay was loaded and its game started
+		bool wasLoaded;
+
+		/// If the replay has a summary of the recorded game
+		bool hasSummary;
+
+		/// If the game stopped for a message box before reaching the end of the replay
+		bool wasStalled;
+
+		/// The final score recorded in the replay
+		uint32 expectedScore;
+
+		/// The final score of the simulated game
+		uint32 score;
+
+		/// The number of blocks on the field recorded in the replay
+		uint32 expectedNumBlocks;
+
+		/// The number of blocks on the field of the simulated game
+		uint32 numBlocks;
+
+		/// The number of snapshots in the replay
+		uint32 numSnapshots;
+
+		/// The results of comparing the snapshots to the simulated game
+		InstructionStreamReplay::VerifyResults snapshotResults;
+
+		/// The number of ticks simulated
+		uint32 numTicks;
+
+		/// The number of ticks after which the field's columns did not match its blocks
+		uint32 numColumnMismatches;
+
+		/// The first tick after which the field's columns did not match its blocks
+		uint32 firstColumnMismatchTick;
+
+		/// The number of ticks on which blocks were falling, and the time they took
+		uint32 numCascadeTicks;
+		uint64 cascadeNanosecs;
+		uint64 maxCascadeNanosecs;
+
+		/// The number of ticks on which no blocks were falling, and the time they took
+		uint32 numSettledTicks;
+		uint64 settledNanosecs;
+
+		/// The number of seeks, and the time they took
+		uint32 numSeeks;
+		uint64 seekNanosecs;
+		uint64 maxSeekNanosecs;
+
+		/// The number of seeks that took longer than the target
+		uint32 numSlowSeeks;
+
+		/// The number of seeks after which the following snapshot did not match the game
+		uint32 numSeekMismatches;
+
+		/// The tick the first seek that was followed by a mismatch moved to
+		uint32 firstSeekMismatchTick;
+
+		ReplayResult() : wasLoaded( false ),
+							hasSummary( false ),
+							wasStalled( false ),
+							expectedScore( 0 ),
+							score( 0 ),
+							expectedNumBlocks( 0 ),
+							numBlocks( 0 ),
+							numSnapshots( 0 ),
+							numTicks( 0 ),
+							numColumnMismatches( 0 ),
+							firstColumnMismatchTick( 0 ),
+							numCascadeTicks( 0 ),
+							cascadeNanosecs( 0 ),
+							maxCascadeNanosecs( 0 ),
+							numSettledTicks( 0 ),
+							settledNanosecs( 0 ),
+							numSeeks( 0 ),
+							seekNanosecs( 0 ),
+							maxSeekNanosecs( 0 ),
+							numSlowSeeks( 0 ),
+							numSeekMismatches( 0 ),
+							firstSeekMismatchTick( 0 )
+		{}
+
+		/// Get if the replay played the recorded game
+		bool Passed() const
+		{
+			if( !wasLoaded || wasStalled || snapshotResults.numMismatched > 0 || numColumnMismatches > 0 || numSeekMismatches > 0 )
+				return false;
+
+			return !hasSummary || (score == expectedScore && numBlocks == expectedNumBlocks);
+		}
+	};
+
+	/// The results of verifying every replay
+	struct Results
+	{
+		/// The number of worker threads used
+		uint32 numThreads;
+
+		/// The number of replays that passed
+		uint32 numPassed;
+
+		/// The number of replays that failed
+		uint32 numFailed;
+
+		/// The total number of ticks simulated
+		uint64 numTicks;
+
+		/// The real time taken in seconds
+		float64 wallTime;
+
+		/// The number of ticks on which blocks were falling, and the time they took
+		uint64 numCascadeTicks;
+		uint64 cascadeNanosecs;
+		uint64 maxCascadeNanosecs;
+
+		/// The number of ticks on which no blocks were falling, and the time they took
+		uint64 numSettledTicks;
+		uint64 settledNanosecs;
+
+		/// The number of seeks, and the time they took
+		uint64 numSeeks;
+		uint64 seekNanosecs;
+		uint64 maxSeekNanosecs;
+
+		/// The number of seeks that took longer than the target
+		uint64 numSlowSeeks;
+
+		Results() : numThreads( 0 ),
+					numPassed( 0 ),
+					numFailed( 0 ),
+					numTicks( 0 ),
+					wallTime( 0.0 ),
+					numCascadeTicks( 0 ),
+					cascadeNanosecs( 0 ),
+					maxCascadeNanosecs( 0 ),
+					numSettledTicks( 0 ),
+					settledNanosecs( 0 ),
+					numSeeks( 0 ),
+					seekNanosecs( 0 ),
+					maxSeekNanosecs( 0 ),
+					numSlowSeeks( 0 )
+		{}
+	};
+
+	/// The longest a seek should take, in nanoseconds
+	static const uint64 TARGET_SEEK_NANOSECS = 50000000;
+
+private:
+
+	/// The replay files to verify
+	std::vector<std::wstring> m_ReplayFiles;
+
+	/// The result for each replay file, in the same order as the files
+	std::vector<ReplayResult> m_ReplayResults;
+
+	/// The index of the next replay to hand to a worker, guarded by m_QueueLock
+	uint32 m_NextReplayIndex;
+
+	/// The number of workers that have not finished, guarded by m_QueueLock
+	uint32 m_NumRunningWorkers;
+
+	/// The lock for the replay queue
+	TCBase::CriticalSection m_QueueLock;
+
+	/// If the field's columns are checked and the ticks timed while verifying
+	bool m_CheckColumns;
+
+	/// If seeking before each snapshot is checked and timed after verifying
+	bool m_CheckSeeks;
+
+	/// The results of the last run
+	Results m_Results;
+
+
+	/// Take the next replay from the queue, false if there are none left
+	bool TakeNextReplay( uint32& replayIndex );
+
+	/// Verify replays until the queue is empty, this runs on a worker thread
+	void RunWorker();
+
+	/// Play a replay with the calling thread's game context and compare the results
+	static void VerifyReplay( ReplayResult& result, bool checkColumns, bool checkSeeks );
+
+	/// Seek to before each snapshot of the replay being played and check the game reaches it
+	static void CheckSeeks( ReplayResult& result );
+
+#ifdef WIN32
+	friend void ReplayVerifyThreadProc( void* pParam );
+#else
+	friend void* ReplayVerifyThreadProc( void* pParam );
+#endif
+
+public:
+
+	/// The default constructor
+	ReplayVerifier() : m_NextReplayIndex( 0 ),
+						m_NumRunningWorkers( 0 ),
+						m_CheckColumns( false ),
+						m_CheckSeeks( false )
+	{}
+
+	/// Get the number of processor cores, the default number of worker threads
+	static uint32 GetNumCores();
+
+	/// Add every replay file in a directory, returns the number of replays found
+	uint32 AddReplayDir( const wchar_t* szReplayDir );
+
+	/// Set if the field's columns are checked and the ticks timed while verifying
+	void SetCheckColumns( bool checkColumns ) { m_CheckColumns = checkColumns; }
+
+	/// Set if seeking before each snapshot is checked and timed after verifying
+	void SetCheckSeeks( bool checkSeeks ) { m_CheckSeeks = checkSeeks; }
+
+	/// Verify the replays using a number of worker threads
+	const Results& Run( uint32 numThreads );
+
+	/// Get the result for each replay from the last run
+	const std::vector<ReplayResult>& GetReplayResults() const { return m_ReplayResults; }
+};
+
+#endif // __ReplayVerifier_h
@@ -0,0 +1,372 @@
+/*=================================================================================================
+
+	\file DifficultyCalibrator.cpp
+	Game Simulator
+	Difficulty Calibrator Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the parallel difficulty calibrator.
+
+=================================================================================================*/
+
+#include "../DifficultyCalibrator.h"
+#include "../ReplayVerifier.h"
+#include "GamePlay/GameContext.h"
+#include "GamePlay/FractionModeSettings.h"
+#include "GamePlay/BlockFaceCache.h"
+#include "Base/XPThreads.h"
+#include "Base/ProfileTimer.h"
+#include <algorithm>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+/// Sleep the calling thread
+static void SleepMS( uint32 numMS )
+{
+#ifdef WIN32
+	Sleep( numMS );
+#else
+	// usleep takes microseconds
+	usleep( numMS * 1000 );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrateThreadProc  Global
+///
+///	\param pParam The difficulty calibrator
+///
+///	The entry point of a worker thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef WIN32
+void DifficultyCalibrateThreadProc( void* pParam )
+#else
+void* DifficultyCalibrateThreadProc( void* pParam )
+#endif
+{
+	((DifficultyCalibrator*)pParam)->RunWorker();
+
+#ifndef WIN32
+	return 0;
+#endif
+}
+
+
+/// Get the fraction of the equations attempted that were cleared
+float64 DifficultyCalibrator::Cell::GetClearRate() const
+{
+	uint64 numAttempted = numEqsCleared + numEqsFailed;
+	return numAttempted > 0 ? (float64)numEqsCleared / (float64)numAttempted : 0.0;
+}
+
+
+/// Get the equations cleared per simulated minute
+float64 DifficultyCalibrator::Cell::GetClearsPerMinute() const
+{
+	return totalGameTime > 0.0 ? (float64)numEqsCleared * 60.0 / totalGameTime : 0.0;
+}
+
+
+/// Get the average time for the field to fill, 0 if it never filled
+float64 DifficultyCalibrator::Cell::GetAvgFillTime() const
+{
+	return numGamesFilled > 0 ? totalFillTime / (float64)numGamesFilled : 0.0;
+}
+
+
+/// Get the average final score
+float64 DifficultyCalibrator::Cell::GetAvgScore() const
+{
+	if( scores.empty() )
+		return 0.0;
+
+	uint64 totalScore = 0;
+	for( uint32 gameIndex = 0; gameIndex < scores.size(); ++gameIndex )
+		totalScore += scores[ gameIndex ];
+	return (float64)totalScore / (float64)scores.size();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrator::Cell::GetScorePercentile  Public
+///
+///	\param percent The percentage of games, from 0 to 100
+///	\returns The score that the percentage of games scored at or below, 0 if no games were played
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 DifficultyCalibrator::Cell::GetScorePercentile( uint32 percent ) const
+{
+	if( scores.empty() )
+		return 0;
+	if( percent > 100 )
+		percent = 100;
+
+	// The scores are sorted so the percentile is the nearest rank
+	uint32 scoreIndex = (uint32)( ((uint64)(scores.size() - 1) * percent + 50) / 100 );
+	return scores[ scoreIndex ];
+}
+
+
+/// Get the fraction of the cleared prime factors that were a prime
+float64 DifficultyCalibrator::Cell::GetPrimeShare( uint32 primeIndex ) const
+{
+	if( primeIndex >= GameDefines::NUM_PRIMES )
+		return 0.0;
+
+	uint64 numPrimes = 0;
+	for( uint32 curPrimeIndex = 0; curPrimeIndex < GameDefines::NUM_PRIMES; ++curPrimeIndex )
+		numPrimes += primeCounts[ curPrimeIndex ];
+
+	return numPrimes > 0 ? (float64)primeCounts[ primeIndex ] / (float64)numPrimes : 0.0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrator::Run  Public
+///
+///	\param settings The grid and games to play
+///	\param numThreads The number of worker threads, 0 to use one for each core
+///	\returns The results of the run
+///
+///	Play every game of every cell of the grid, waiting for the worker threads to finish.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const DifficultyCalibrator::Results& DifficultyCalibrator::Run( const Settings& settings, uint32 numThreads )
+{
+	m_Settings = settings;
+	m_Results = Results();
+	if( m_Settings.gamesPerCell == 0 )
+		m_Settings.gamesPerCell = 1;
+
+	BuildCells();
+
+	m_GameResults.clear();
+	m_GameResults.resize( m_Cells.size() * m_Settings.gamesPerCell );
+
+	if( numThreads == 0 )
+		numThreads = ReplayVerifier::GetNumCores();
+	if( numThreads > m_GameResults.size() )
+		numThreads = (uint32)m_GameResults.size();
+	m_Results.numThreads = numThreads;
+
+	// The product and fraction tables and the block text are built the first time they are used,
+	// so build them before the workers share them
+	GameDefines::GetProductArray();
+	FractionModeSettings::GetForDifficulty( 0 );
+	BlockFaceCache::Get().BuildValueTexts();
+
+	m_NextGameIndex = 0;
+	m_NumRunningWorkers = numThreads;
+	m_NumTicks = 0;
+
+	uint64 startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+
+	// The threads are detached, each one counts itself out when it finishes
+	std::vector<XPThreads*> workers;
+	for( uint32 threadIndex = 0; threadIndex < numThreads; ++threadIndex )
+	{
+		XPThreads* pWorker = new XPThreads( DifficultyCalibrateThreadProc );
+		pWorker->Run( this );
+		workers.push_back( pWorker );
+	}
+
+	// Wait for the workers to empty the queue
+	for( ;; )
+	{
+		m_QueueLock.Enter();
+		uint32 numRunningWorkers = m_NumRunningWorkers;
+		m_QueueLock.Leave();
+
+		if( numRunningWorkers == 0 )
+			break;
+		SleepMS( 10 );
+	}
+
+	m_Results.wallTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - startTime) / 1000000000.0;
+	m_Results.numGames = (uint32)m_GameResults.size();
+	m_Results.numTicks = m_NumTicks;
+
+	for( uint32 workerIndex = 0; workerIndex < workers.size(); ++workerIndex )
+		delete workers[ workerIndex ];
+
+	StoreCellResults();
+
+	return m_Results;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrator::BuildCells  Private
+///
+///	Create a cell for every combination of the settings' difficulty levels and adjustments. An
+///	empty list of difficulty levels measures the levels a player can choose and an empty list of
+///	adjustments leaves that part of the tables unchanged.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void DifficultyCalibrator::BuildCells()
+{
+	GameDefines::DifficultyTuning defaultTuning;
+
+	std::vector<GameDefines::EGameplayDiffLevel> difficulties = m_Settings.difficulties;
+	if( difficulties.empty() )
+	{
+		for( int32 diffIndex = (int32)GameDefines::GPDL_Pre3; diffIndex <= (int32)GameDefines::GPDL_Post8; ++diffIndex )
+			difficulties.push_back( (GameDefines::EGameplayDiffLevel)diffIndex );
+	}
+
+	std::vector<float32> maxValueScales = m_Settings.maxValueScales;
+	if( maxValueScales.empty() )
+		maxValueScales.push_back( defaultTuning.maxValueScale );
+
+	std::vector<int32> maxNumFactorsOffsets = m_Settings.maxNumFactorsOffsets;
+	if( maxNumFactorsOffsets.empty() )
+		maxNumFactorsOffsets.push_back( defaultTuning.maxNumFactorsOffset );
+
+	std::vector<int32> maxPrimeIndexOffsets = m_Settings.maxPrimeIndexOffsets;
+	if( maxPrimeIndexOffsets.empty() )
+		maxPrimeIndexOffsets.push_back( defaultTuning.maxPrimeIndexOffset );
+
+	std::vector<float32> sumRangeScales = m_Settings.sumRangeScales;
+	if( sumRangeScales.empty() )
+		sumRangeScales.push_back( defaultTuning.sumRangeScale );
+
+	m_Cells.clear();
+	for( uint32 diffIndex = 0; diffIndex < difficulties.size(); ++diffIndex )
+	{
+		for( uint32 valueIndex = 0; valueIndex < maxValueScales.size(); ++valueIndex )
+		{
+			for( uint32 factorsIndex = 0; factorsIndex < maxNumFactorsOffsets.size(); ++factorsIndex )
+			{
+				for( uint32 primeIndex = 0; primeIndex < maxPrimeIndexOffsets.size(); ++primeIndex )
+				{
+					for( uint32 sumIndex = 0; sumIndex < sumRangeScales.size(); ++sumIndex )
+					{
+						Cell newCell;
+						newCell.difficulty = difficulties[ diffIndex ];
+						newCell.diffTuning.maxValueScale = maxValueScales[ valueIndex ];
+						newCell.diffTuning.maxNumFactorsOffset = maxNumFactorsOffsets[ factorsIndex ];
+						newCell.diffTuning.maxPrimeIndexOffset = maxPrimeIndexOffsets[ primeIndex ];
+						newCell.diffTuning.sumRangeScale = sumRangeScales[ sumIndex ];
+						m_Cells.push_back( newCell );
+					}
+				}
+			}
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrator::TakeNextGame  Private
+///
+///	\param gameIndex The index of the game that was taken
+///	\returns True if a game was taken, false if the queue is empty
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool DifficultyCalibrator::TakeNextGame( uint32& gameIndex )
+{
+	m_QueueLock.Enter();
+	bool hasGame = m_NextGameIndex < m_GameResults.size();
+	if( hasGame )
+		gameIndex = m_NextGameIndex++;
+	m_QueueLock.Leave();
+
+	return hasGame;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrator::RunWorker  Private
+///
+///	Play games from the queue until it is empty. The worker's game context is bound for the life
+///	of the worker so every game it plays uses the worker's own game manager and pools.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void DifficultyCalibrator::RunWorker()
+{
+	uint64 numTicks = 0;
+
+	{
+		GameContext context;
+		GameContext::Scope contextScope( context );
+
+		GameSimRunner runner;
+		GameSimRunner::Settings runSettings;
+		runSettings.gameType = m_Settings.gameType;
+		runSettings.numGames = 1;
+		runSettings.totalSimTime = 0.0f;
+		runSettings.maxGameTime = m_Settings.maxGameTime;
+		runSettings.botSettings = m_Settings.botSettings;
+
+		uint32 gameIndex = 0;
+		while( TakeNextGame( gameIndex ) )
+		{
+			const Cell& cell = m_Cells[ gameIndex / m_Settings.gamesPerCell ];
+			runSettings.difficulty = cell.difficulty;
+			runSettings.diffTuning = cell.diffTuning;
+
+			// The Nth game of every cell uses the same seed
+			uint64 gameNumber = gameIndex % m_Settings.gamesPerCell;
+			runSettings.seed = m_Settings.seed + gameNumber * 0x9E3779B97F4A7C15ull;
+
+			numTicks += runner.Run( runSettings ).numTicks;
+			m_GameResults[ gameIndex ] = runner.GetLastGame();
+		}
+	}
+
+	m_QueueLock.Enter();
+	m_NumTicks += numTicks;
+	m_NumRunningWorkers--;
+	m_QueueLock.Leave();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  DifficultyCalibrator::StoreCellResults  Private
+///
+///	Add the statistics of every game to the cell it was played for.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void DifficultyCalibrator::StoreCellResults()
+{
+	for( uint32 cellIndex = 0; cellIndex < m_Cells.size(); ++cellIndex )
+	{
+		Cell& cell = m_Cells[ cellIndex ];
+		cell.scores.reserve( m_Settings.gamesPerCell );
+
+		for( uint32 gameNumber = 0; gameNumber < m_Settings.gamesPerCell; ++gameNumber )
+		{
+			const GameSimRunner::GameResult& game = m_GameResults[ cellIndex * m_Settings.gamesPerCell + gameNumber ];
+
+			cell.numGames++;
+			cell.numEqsCleared += game.numEqsCleared;
+			cell.numEqsFailed += game.numEqsFailed;
+			cell.totalGameTime += (float64)game.gameTime;
+			if( game.endedOnItsOwn )
+			{
+				cell.numGamesFilled++;
+				cell.totalFillTime += (float64)game.gameTime;
+			}
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+				cell.primeCounts[ primeIndex ] += game.primeCounts[ primeIndex ];
+			cell.scores.push_back( game.score );
+		}
+
+		std::sort( cell.scores.begin(), cell.scores.end() );
+	}
+}
@@ -0,0 +1,62 @@
+/*=================================================================================================
+
+	\file GameSimApp.cpp
+	Game Simulator
+	Headless Application Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the application members the gameplay libraries refer to. The
+	simulator has no window, resources or network so it uses this in place of the game's
+	ApplicationBase.cpp, which would pull in all of those.
+
+=================================================================================================*/
+
+#include "PrimeTime/ApplicationBase.h"
+
+
+ApplicationBase* ApplicationBase::_pAppInstance = 0;
+uint64 ApplicationBase::GameKey = 0;
+std::wstring ApplicationBase::s_resourcePath;
+
+
+/// The simulator has no profile to remember
+void ApplicationBase::SetAutoLoginProfile( const wchar_t* szProfileName )
+{
+	Settings.AutoLoginProfile = szProfileName;
+}
+
+
+/// Get the path to the resources, the simulator runs from the game's directory
+std::wstring ApplicationBase::GetResourcePath()
+{
+	if( s_resourcePath.size() == 0 )
+		s_resourcePath = TCBase::GetAppPath();
+
+	return s_resourcePath;
+}
+
+
+/// The simulator does not report anything to the server
+void ApplicationBase::SendAppConnectMessage( const wchar_t* )
+{
+}
+
+
+/// Clean up the application
+void ApplicationBase::TermApp()
+{
+	if( _pAppInstance )
+	{
+		_pAppInstance->Term();
+		delete _pAppInstance;
+	}
+
+	_pAppInstance = NULL;
+}
+
+
+/// There is nothing to clean up, the simulator clears the game manager itself
+void ApplicationBase::Term()
+{
+}
@@ -0,0 +1,187 @@
+/*=================================================================================================
+
+	\file GameSimRunner.cpp
+	Game Simulator
+	Game Simulation Runner Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the headless game runner.
+
+=================================================================================================*/
+
+#include "../GameSimRunner.h"
+#include "GamePlay/GameMgr.h"
+#include "GamePlay/GameLogic.h"
+#include "GamePlay/GameLogicProduct.h"
+#include "GamePlay/GameLogicAdd.h"
+#include "GamePlay/GameLogicFractions.h"
+#include "Base/ProfileTimer.h"
+#include "Base/MsgLogger.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameSimRunner::Run  Public
+///
+///	\param settings The description of the games to play
+///	\returns The results of the run
+///
+///	Play games until the number of games or the simulated time in the settings is reached.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const GameSimRunner::Results& GameSimRunner::Run( const Settings& settings )
+{
+	m_Settings = settings;
+	m_Results.Clear();
+	m_SeedRandom.Seed( settings.seed );
+
+	// Without a limit only play one game
+	if( m_Settings.numGames == 0 && m_Settings.totalSimTime <= 0.0f )
+		m_Settings.numGames = 1;
+
+	GameMgr::Get().SetHeadless( true );
+	GameMgr::Get().SetGameplayDiff( m_Settings.difficulty );
+	GameMgr::Get().SetDiffTuning( m_Settings.diffTuning );
+
+	uint64 startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+
+	for( ;; )
+	{
+		if( m_Settings.numGames > 0 && m_Results.numGamesPlayed >= m_Settings.numGames )
+			break;
+		if( m_Settings.totalSimTime > 0.0f && m_Results.simTime >= (float64)m_Settings.totalSimTime )
+			break;
+
+		// Each game gets its own seed from the run's generator so any game can be replayed alone
+		uint64 gameSeed = ((uint64)m_SeedRandom.NextUInt32() << 32) | (uint64)m_SeedRandom.NextUInt32();
+		if( !RunGame( gameSeed ) )
+			break;
+	}
+
+	m_Results.wallTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - startTime) / 1000000000.0;
+
+	GameMgr::Get().Clear();
+	GameMgr::Get().SetHeadless( false );
+	GameMgr::Get().SetDiffTuning( GameDefines::DifficultyTuning() );
+
+	return m_Results;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameSimRunner::RunGame  Public
+///
+///	\param gameSeed The seed for the game's random number generator
+///	\returns True if the game was played, false if it could not be started
+///
+///	Play one game from start to finish.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GameSimRunner::RunGame( uint64 gameSeed )
+{
+	GameMgr::Get().StartGame( m_Settings.gameType, gameSeed );
+	if( !GameMgr::Get().IsPlaying() || !GameMgr::Get().GetLogic() )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"The simulator failed to start a game." );
+		GameMgr::Get().Clear();
+		return false;
+	}
+
+	// The bot's seed comes from the game's so the whole game can be repeated from one value
+	m_Bot.Init( m_Settings.botSettings, gameSeed ^ 0xB07B07B07B07B07Bull );
+
+	float32 gameTime = 0.0f;
+	bool hitTimeLimit = false;
+	while( GameMgr::Get().IsPlaying() )
+	{
+		// End games that go on too long, such as when the bot never falls behind
+		if( gameTime >= m_Settings.maxGameTime && !hitTimeLimit )
+		{
+			hitTimeLimit = true;
+			GameMgr::Get().EndGame();
+		}
+
+		m_Bot.Update( GameDefines::SIM_TICK_TIME );
+		GameMgr::Get().Update( GameDefines::SIM_TICK_TIME );
+
+		gameTime += GameDefines::SIM_TICK_TIME;
+		m_Results.numTicks++;
+	}
+
+	m_LastGame.Clear();
+	m_LastGame.gameTime = gameTime;
+	m_LastGame.endedOnItsOwn = !hitTimeLimit;
+
+	m_Results.simTime += (float64)gameTime;
+	m_Results.numClicks += m_Bot.GetNumClicks();
+	m_Results.numBotErrors += m_Bot.GetNumErrors();
+	m_Results.numGamesPlayed++;
+	if( !hitTimeLimit )
+		m_Results.numGamesFinished++;
+
+	StoreGameResults();
+
+	// Free the finished game
+	GameMgr::Get().Clear();
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GameSimRunner::StoreGameResults  Private
+///
+///	Add the session statistics of the game that just ended to the run's results.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GameSimRunner::StoreGameResults()
+{
+	GameLogic* pLogic = GameMgr::Get().GetLogic();
+	if( !pLogic )
+		return;
+
+	switch( pLogic->GetLogicType() )
+	{
+	case GameLogic::LT_Product:
+		{
+			const GameLogicProduct* pProductLogic = (GameLogicProduct*)pLogic;
+			const GameSessionStatsMult& stats = pProductLogic->GetSessionStats();
+			m_LastGame.score = stats.m_Score;
+			m_LastGame.numEqsCleared = stats.m_NumEqsCleared;
+			m_LastGame.numEqsFailed = stats.m_NumEqsFailed;
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+				m_LastGame.primeCounts[ primeIndex ] = stats.m_ValidCounts[ primeIndex ];
+
+			m_Results.numBlocksGenerated += pProductLogic->GetNumBlocksGenerated();
+			m_Results.numProductFallbacks += pProductLogic->GetNumProductFallbacks();
+		}
+		break;
+
+	case GameLogic::LT_Addition:
+		{
+			const GameSessionStatsAdd& stats = ((GameLogicAdd*)pLogic)->GetSessionStats();
+			m_LastGame.score = stats.m_Score;
+			m_LastGame.numEqsCleared = stats.m_NumEqsCleared;
+			m_LastGame.numEqsFailed = stats.m_NumEqsFailed;
+		}
+		break;
+
+	case GameLogic::LT_Fraction:
+		{
+			const GameSessionStatsFractions& stats = ((GameLogicFractions*)pLogic)->GetSessionStats();
+			m_LastGame.score = stats.m_Score;
+			m_LastGame.numEqsCleared = stats.m_NumFractionsCleared;
+			m_LastGame.numEqsFailed = stats.m_NumFractionsFailed;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	m_Results.totalScore += m_LastGame.score;
+	m_Results.numEqsCleared += m_LastGame.numEqsCleared;
+	m_Results.numEqsFailed += m_LastGame.numEqsFailed;
+}
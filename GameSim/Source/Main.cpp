@@ -0,0 +1,946 @@
+/*=================================================================================================
+
+	\file Main.cpp
+	Game Simulator
+	Main Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the entry point for the headless game simulator. The simulator
+	plays games as fast as possible to measure the cost of a gameplay tick and to soak test the
+	gameplay code.
+
+	Options:
+		/type <pt|ceiling|add|fractions>	The type of game to play, defaults to pt
+		/diff <0-9>							The difficulty level, defaults to 2 (level 4)
+		/games <count>						The number of games to play, defaults to 10
+		/minutes <count>					The simulated minutes to play instead of a game count
+		/seed <value>						The seed for the run, defaults to a new seed
+		/skill <0-100>						The percent of equations the bot looks at
+		/reaction <seconds>					The average time the bot waits before an equation
+		/clicktime <seconds>				The average time between the bot's clicks
+		/errors <0-100>						The percent chance each bot click is a mistake
+		/suite								Run every game type with a fixed seed and compare
+		/replays <dir>						Record a replay of every game to a directory
+		/verify <dir>						Re-simulate every replay in a directory and check it
+		/colcheck <dir>						Verify replays on one thread, checking the field columns each tick and timing cascades
+		/seekcheck <dir>					Verify replays on one thread, then seek to before each snapshot, check it and time the seeks
+		/threads <count>					The worker threads used to verify, calibrate or read profiles, defaults to one per core
+		/calibrate							Measure how the difficulty tables play over a grid of adjustments
+		/valuescale <scale ...>				The scales of the largest product to calibrate
+		/factors <offset ...>				The offsets of the most prime factors to calibrate
+		/primes <offset ...>				The offsets of the largest usable prime to calibrate
+		/sumscale <scale ...>				The scales of the range of sums to calibrate
+		/history [count]					Time charting queries over a profile of synthetic sessions, defaults to 100000
+		/classreport						Read every profile in parallel and report the class totals
+		/classbench [count]					Time reading a class of synthetic profiles, defaults to 1000
+
+	When calibrating, /diff takes a list of levels and defaults to every level a player can
+	choose, and /games is the number of games for each cell of the grid.
+
+=================================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <atomic>
+#include <sstream>
+#include "Base/Types.h"
+#include "Base/FileFuncs.h"
+#include "Base/ProfileTimer.h"
+#include "Base/RandomGen.h"
+#include "GamePlay/GameFieldBlock.h"
+#include "GamePlay/GameFieldInstruction.h"
+#include "GamePlay/GameMgr.h"
+#include "GamePlay/ProfileSubsetMultiplication.h"
+#include "GamePlay/ProfileSubsetAddition.h"
+#include "GamePlay/ProfileIndex.h"
+#include "GamePlay/ProfileBatchLoader.h"
+#include "GamePlay/PlayerProfile.h"
+#include "../GameSimRunner.h"
+#include "../ReplayVerifier.h"
+#include "../DifficultyCalibrator.h"
+
+
+/// The allocation counters, updated by the replaced global operator new and delete. The replay
+/// verifier and difficulty calibrator allocate from worker threads so the counters are atomic.
+static std::atomic<uint64> s_NumAllocs( 0 );
+static std::atomic<uint64> s_NumFrees( 0 );
+static std::atomic<uint64> s_NumBytesAllocated( 0 );
+
+/// The seed used by the benchmark suite so runs can be compared with each other
+const uint64 SUITE_SEED = 0x5052494D4554494Dull;
+
+/// The default number of sessions in the session history benchmark profile
+const uint32 DEFAULT_HISTORY_SESSIONS = 100000;
+
+/// The default number of profiles in the class report benchmark
+const uint32 DEFAULT_CLASS_PROFILES = 1000;
+
+
+void* operator new( size_t numBytes )
+{
+	s_NumAllocs.fetch_add( 1, std::memory_order_relaxed );
+	s_NumBytesAllocated.fetch_add( numBytes, std::memory_order_relaxed );
+	void* pMem = malloc( numBytes ? numBytes : 1 );
+	if( !pMem )
+		throw std::bad_alloc();
+	return pMem;
+}
+
+void* operator new[]( size_t numBytes )
+{
+	return operator new( numBytes );
+}
+
+void operator delete( void* pMem ) throw()
+{
+	if( !pMem )
+		return;
+	s_NumFrees.fetch_add( 1, std::memory_order_relaxed );
+	free( pMem );
+}
+
+void operator delete[]( void* pMem ) throw()
+{
+	operator delete( pMem );
+}
+
+
+/// The allocation counts at a point in time
+struct AllocSnapshot
+{
+	uint64 numAllocs;
+	uint64 numFrees;
+	uint64 numBytes;
+
+	/// The allocations served by the block and instruction pools, which do not use the heap
+	uint64 numBlockAllocs;
+	uint64 numInstructionAllocs;
+
+	AllocSnapshot() : numAllocs( s_NumAllocs.load() ),
+						numFrees( s_NumFrees.load() ),
+						numBytes( s_NumBytesAllocated.load() ),
+						numBlockAllocs( GameFieldBlock::GetPool().GetNumAllocs() ),
+						numInstructionAllocs( GameFieldInstruction::GetPool().GetNumAllocs() )
+	{}
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	ParseGameType  Global
+///
+///	\param sName The name of the game type from the command line
+///	\returns The game type or GT_Error if the name is not recognized
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static GameDefines::EGameType ParseGameType( const std::wstring& sName )
+{
+	if( sName == L"pt" || sName == L"primetime" )
+		return GameDefines::GT_PrimeTime;
+	if( sName == L"ceiling" )
+		return GameDefines::GT_Ceiling;
+	if( sName == L"add" || sName == L"addition" )
+		return GameDefines::GT_AdditionAttack;
+	if( sName == L"fractions" )
+		return GameDefines::GT_Fractions;
+
+	return GameDefines::GT_Error;
+}
+
+
+/// Get the display name of a game type
+static const char* GetGameTypeName( GameDefines::EGameType gameType )
+{
+	switch( gameType & GameDefines::GT_Mask_Type )
+	{
+	case GameDefines::GT_PrimeTime:
+		return "PrimeTime";
+	case GameDefines::GT_Ceiling:
+		return "Ceiling";
+	case GameDefines::GT_AdditionAttack:
+		return "AdditionAttack";
+	case GameDefines::GT_Fractions:
+		return "Fractions";
+	default:
+		break;
+	}
+
+	return "Unknown";
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	PrintResults  Global
+///
+///	\param gameType The type of game that was played
+///	\param results The results of the run
+///	\param allocsBefore The allocation counts before the run
+///	\param allocsAfter The allocation counts after the run
+///
+///	Output the speed, allocations and game statistics of a run.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static void PrintResults( GameDefines::EGameType gameType, const GameSimRunner::Results& results, const AllocSnapshot& allocsBefore, const AllocSnapshot& allocsAfter )
+{
+	float64 numTicks = results.numTicks > 0 ? (float64)results.numTicks : 1.0;
+	float64 wallTime = results.wallTime > 0.0 ? results.wallTime : 0.000001;
+	uint64 numAllocs = allocsAfter.numAllocs - allocsBefore.numAllocs;
+	uint64 numFrees = allocsAfter.numFrees - allocsBefore.numFrees;
+
+	printf( "%s\n", GetGameTypeName( gameType ) );
+	printf( "  Games played:     %u (%u ended on their own)\n", results.numGamesPlayed, results.numGamesFinished );
+	printf( "  Simulated time:   %.1f sec\n", results.simTime );
+	printf( "  Real time:        %.3f sec (%.1fx real time)\n", results.wallTime, results.simTime / wallTime );
+	printf( "  Ticks:            %llu (%.0f ticks/sec, %.2f us/tick)\n", (unsigned long long)results.numTicks, numTicks / wallTime, (wallTime * 1000000.0) / numTicks );
+	printf( "  Allocations:      %llu (%.2f per tick, %.1f bytes per tick)\n", (unsigned long long)numAllocs, (float64)numAllocs / numTicks, (float64)(allocsAfter.numBytes - allocsBefore.numBytes) / numTicks );
+	printf( "  Unfreed blocks:   %lld\n", (long long)numAllocs - (long long)numFrees );
+	printf( "  Pooled blocks:    %llu (%.2f per tick, %u pages)\n", (unsigned long long)(allocsAfter.numBlockAllocs - allocsBefore.numBlockAllocs), (float64)(allocsAfter.numBlockAllocs - allocsBefore.numBlockAllocs) / numTicks, GameFieldBlock::GetPool().GetNumPages() );
+	printf( "  Pooled insts:     %llu (%.2f per tick, %u pages)\n", (unsigned long long)(allocsAfter.numInstructionAllocs - allocsBefore.numInstructionAllocs), (float64)(allocsAfter.numInstructionAllocs - allocsBefore.numInstructionAllocs) / numTicks, GameFieldInstruction::GetPool().GetNumPages() );
+	printf( "  Bot clicks:       %llu (%llu mistakes)\n", (unsigned long long)results.numClicks, (unsigned long long)results.numBotErrors );
+	printf( "  Equations:        %llu cleared, %llu failed\n", (unsigned long long)results.numEqsCleared, (unsigned long long)results.numEqsFailed );
+	printf( "  Average score:    %.1f\n", results.numGamesPlayed > 0 ? (float64)results.totalScore / (float64)results.numGamesPlayed : 0.0 );
+	if( results.numBlocksGenerated > 0 )
+		printf( "  Blocks generated: %llu (%llu products made primes, %.4f per block)\n", (unsigned long long)results.numBlocksGenerated, (unsigned long long)results.numProductFallbacks, (float64)results.numProductFallbacks / (float64)results.numBlocksGenerated );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	PrintProfileSections  Global
+///
+///	Output the timings of the profiled sections of code. The sections are only timed when the
+///	gameplay libraries are built with PT_PROFILE defined.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static void PrintProfileSections()
+{
+	std::vector<TCBase::ProfileTimer::Section> sections;
+	TCBase::ProfileTimer::GetSections( sections );
+	if( sections.empty() )
+		return;
+
+	printf( "  %-44s %12s %12s %12s\n", "Section", "Calls", "Avg (us)", "Max (us)" );
+	for( uint32 sectionIndex = 0; sectionIndex < sections.size(); ++sectionIndex )
+	{
+		const TCBase::ProfileTimer::Section& section = sections[sectionIndex];
+		if( section.numCalls == 0 )
+			continue;
+
+		printf( "  %-44s %12llu %12.3f %12.3f\n", section.szName,
+					(unsigned long long)section.numCalls,
+					(float64)section.totalNanosecs / (float64)section.numCalls / 1000.0,
+					(float64)section.maxNanosecs / 1000.0 );
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	RunAndReport  Global
+///
+///	\param settings The settings for the run
+///
+///	Run a set of games and output the results.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static void RunAndReport( const GameSimRunner::Settings& settings )
+{
+	GameSimRunner runner;
+
+	TCBase::ProfileTimer::Reset();
+	AllocSnapshot allocsBefore;
+
+	const GameSimRunner::Results& results = runner.Run( settings );
+
+	AllocSnapshot allocsAfter;
+	PrintResults( settings.gameType, results, allocsBefore, allocsAfter );
+	PrintProfileSections();
+	printf( "\n" );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	VerifyAndReport  Global
+///
+///	\param szReplayDir The directory containing the replays
+///	\param numThreads The number of worker threads, 0 for one per core
+///	\param checkColumns True to check the field columns after every tick and time cascades
+///	\param checkSeeks True to check and time seeking to before every snapshot
+///	\returns True if every replay passed, false otherwise
+///
+///	Verify a directory of replays and output the failures and the speed. The columns and seeks
+///	are checked on a single thread so other workers do not slow the ticks or seeks that are timed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static bool VerifyAndReport( const wchar_t* szReplayDir, uint32 numThreads, bool checkColumns, bool checkSeeks )
+{
+	ReplayVerifier verifier;
+	if( verifier.AddReplayDir( szReplayDir ) == 0 )
+	{
+		printf( "No replays were found in %ls.\n", szReplayDir );
+		return false;
+	}
+
+	if( checkColumns || checkSeeks )
+	{
+		verifier.SetCheckColumns( checkColumns );
+		verifier.SetCheckSeeks( checkSeeks );
+		numThreads = 1;
+		TCBase::ProfileTimer::Reset();
+	}
+
+	const ReplayVerifier::Results& results = verifier.Run( numThreads );
+
+	const std::vector<ReplayVerifier::ReplayResult>& replayResults = verifier.GetReplayResults();
+	for( uint32 replayIndex = 0; replayIndex < replayResults.size(); ++replayIndex )
+	{
+		const ReplayVerifier::ReplayResult& result = replayResults[replayIndex];
+		if( result.Passed() )
+			continue;
+
+		printf( "FAILED %ls\n", result.sFile.c_str() );
+		if( !result.wasLoaded )
+		{
+			printf( "  The replay could not be loaded.\n" );
+			continue;
+		}
+		if( result.wasStalled )
+			printf( "  The game stopped for a message box after %u ticks.\n", result.numTicks );
+		if( result.snapshotResults.numMismatched > 0 )
+			printf( "  %u of %u snapshots differ, the first on tick %u\n", result.snapshotResults.numMismatched, result.snapshotResults.numChecked, result.snapshotResults.firstMismatchTick );
+		if( result.hasSummary && result.score != result.expectedScore )
+			printf( "  Score %u, recorded %u\n", result.score, result.expectedScore );
+		if( result.hasSummary && result.numBlocks != result.expectedNumBlocks )
+			printf( "  Blocks %u, recorded %u\n", result.numBlocks, result.expectedNumBlocks );
+		if( result.numColumnMismatches > 0 )
+			printf( "  The columns differ from the blocks after %u ticks, the first on tick %u\n", result.numColumnMismatches, result.firstColumnMismatchTick );
+		if( result.numSeekMismatches > 0 )
+			printf( "  %u of %u seeks did not reach the following snapshot, the first to tick %u\n", result.numSeekMismatches, result.numSeeks, result.firstSeekMismatchTick );
+	}
+
+	float64 wallTime = results.wallTime > 0.0 ? results.wallTime : 0.000001;
+	uint32 numReplays = results.numPassed + results.numFailed;
+
+	printf( "Replay verification\n" );
+	printf( "  Replays:          %u (%u passed, %u failed)\n", numReplays, results.numPassed, results.numFailed );
+	printf( "  Threads:          %u\n", results.numThreads );
+	printf( "  Real time:        %.3f sec\n", results.wallTime );
+	printf( "  Speed:            %.1f games/sec (%.0f ticks/sec)\n", (float64)numReplays / wallTime, (float64)results.numTicks / wallTime );
+	if( checkColumns )
+	{
+		printf( "  Cascade ticks:    %llu, %.3f us avg, %.3f us max\n", (unsigned long long)results.numCascadeTicks,
+					results.numCascadeTicks > 0 ? (float64)results.cascadeNanosecs / (float64)results.numCascadeTicks / 1000.0 : 0.0,
+					(float64)results.maxCascadeNanosecs / 1000.0 );
+		printf( "  Settled ticks:    %llu, %.3f us avg\n", (unsigned long long)results.numSettledTicks,
+					results.numSettledTicks > 0 ? (float64)results.settledNanosecs / (float64)results.numSettledTicks / 1000.0 : 0.0 );
+	}
+	if( checkSeeks )
+	{
+		printf( "  Seeks:            %llu, %.3f ms avg, %.3f ms max\n", (unsigned long long)results.numSeeks,
+					results.numSeeks > 0 ? (float64)results.seekNanosecs / (float64)results.numSeeks / 1000000.0 : 0.0,
+					(float64)results.maxSeekNanosecs / 1000000.0 );
+		printf( "  Over %.0f ms:       %llu\n", (float64)ReplayVerifier::TARGET_SEEK_NANOSECS / 1000000.0, (unsigned long long)results.numSlowSeeks );
+	}
+	if( checkColumns || checkSeeks )
+		PrintProfileSections();
+	printf( "\n" );
+
+	return results.numFailed == 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	CalibrateAndReport  Global
+///
+///	\param settings The grid and games to play
+///	\param numThreads The number of worker threads, 0 for one per core
+///
+///	Play the calibration games and output a row of measurements for each cell of the grid.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static void CalibrateAndReport( const DifficultyCalibrator::Settings& settings, uint32 numThreads )
+{
+	DifficultyCalibrator calibrator;
+	const DifficultyCalibrator::Results& results = calibrator.Run( settings, numThreads );
+
+	bool isProductGame = (settings.gameType & GameDefines::GT_Mask_Type) == GameDefines::GT_PrimeTime
+						|| (settings.gameType & GameDefines::GT_Mask_Type) == GameDefines::GT_Ceiling;
+
+	printf( "%s calibration, seed 0x%llX\n", GetGameTypeName( settings.gameType ), (unsigned long long)settings.seed );
+	printf( "%4s %6s %5s %5s %6s %6s %7s %8s %7s %8s %7s %7s %7s %9s\n",
+				"Diff", "Value", "Fact", "Prime", "Sum", "Games", "Clear%", "Clr/min", "Filled%", "Fill sec",
+				"P10", "P50", "P90", "Avg score" );
+
+	const std::vector<DifficultyCalibrator::Cell>& cells = calibrator.GetCells();
+	for( uint32 cellIndex = 0; cellIndex < cells.size(); ++cellIndex )
+	{
+		const DifficultyCalibrator::Cell& cell = cells[cellIndex];
+		float64 numGames = cell.numGames > 0 ? (float64)cell.numGames : 1.0;
+
+		printf( "%4d %6.2f %+5d %+5d %6.2f %6u %7.1f %8.1f %7.1f %8.1f %7u %7u %7u %9.1f\n",
+					(int)cell.difficulty,
+					cell.diffTuning.maxValueScale,
+					cell.diffTuning.maxNumFactorsOffset,
+					cell.diffTuning.maxPrimeIndexOffset,
+					cell.diffTuning.sumRangeScale,
+					cell.numGames,
+					cell.GetClearRate() * 100.0,
+					cell.GetClearsPerMinute(),
+					(float64)cell.numGamesFilled * 100.0 / numGames,
+					cell.GetAvgFillTime(),
+					cell.GetScorePercentile( 10 ),
+					cell.GetScorePercentile( 50 ),
+					cell.GetScorePercentile( 90 ),
+					cell.GetAvgScore() );
+
+		// The share of each prime in the cleared products
+		if( isProductGame )
+		{
+			printf( "     Primes:" );
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+				printf( " %d=%.1f%%", GameDefines::PRIMES[primeIndex], cell.GetPrimeShare( primeIndex ) * 100.0 );
+			printf( "\n" );
+		}
+	}
+
+	float64 wallTime = results.wallTime > 0.0 ? results.wallTime : 0.000001;
+	printf( "\n" );
+	printf( "  Games:            %u in %u cells\n", results.numGames, (uint32)cells.size() );
+	printf( "  Threads:          %u\n", results.numThreads );
+	printf( "  Real time:        %.3f sec\n", results.wallTime );
+	printf( "  Speed:            %.1f games/sec (%.0f ticks/sec)\n", (float64)results.numGames / wallTime, (float64)results.numTicks / wallTime );
+	printf( "\n" );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	BenchmarkSessionHistory  Global
+///
+///	\param numSessions The number of sessions in the profile
+///	\param seed The seed for the synthetic sessions
+///	\returns True if the session list and the history gave the same chart, false otherwise
+///
+///	Fill a profile with synthetic sessions spread over the last two years and time the chart of
+///	the accuracy on prime 7 by week over the last year, once by walking the session list and once
+///	with the session history. The saved profile is also opened the way starting a game does,
+///	which only reads the newest session, and timed against decoding every session.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static bool BenchmarkSessionHistory( uint32 numSessions, uint64 seed )
+{
+	const time_t SECS_PER_WEEK = 60 * 60 * 24 * 7;
+	const uint32 NUM_WEEKS = 52;
+	const uint32 PRIME_INDEX = 3;
+	const uint32 NUM_QUERIES = 20;
+
+	TCBase::RandomGen randGen( seed );
+	time_t endTime = time( NULL );
+	time_t firstTime = endTime - SECS_PER_WEEK * NUM_WEEKS * 2;
+	time_t startTime = endTime - SECS_PER_WEEK * NUM_WEEKS;
+
+	// Build the profile with the sessions in the order they would have been played
+	ProfileSubsetMultiplication multSubset;
+	uint64 buildStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	for( uint32 sessionIndex = 0; sessionIndex < numSessions; ++sessionIndex )
+	{
+		GameSessionStatsMult session;
+		time_t sessionTime = firstTime + (time_t)(((uint64)(endTime - firstTime) * sessionIndex) / numSessions);
+		tm* pLocalTime = localtime( &sessionTime );
+		if( pLocalTime )
+			session.m_SessionStartTime = *pLocalTime;
+
+		session.m_Duration = randGen.NextFloatInRange( 60.0f, 600.0f );
+		session.m_NumEqsCleared = (uint32)randGen.NextInRange( 10, 200 );
+		session.m_NumEqsFailed = (uint32)randGen.NextInRange( 0, 20 );
+		session.m_Score = session.m_NumEqsCleared * (uint32)randGen.NextInRange( 50, 150 );
+		session.m_Difficulty = (GameDefines::EGameplayDiffLevel)randGen.NextInRange( GameDefines::GPDL_Pre3, GameDefines::GPDL_8 );
+		for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+		{
+			session.m_ValidCounts[ primeIndex ] = (uint32)randGen.NextInRange( 0, 60 );
+			session.m_ErrorCounts[ primeIndex ] = (uint32)randGen.NextInRange( 0, 6 );
+		}
+
+		multSubset.StoreSession( session );
+	}
+	float64 buildTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - buildStartTime) / 1000000000.0;
+
+	// Save the subset
+	std::ostringstream outStream( std::ios_base::out | std::ios_base::binary );
+	Serializer writer( &outStream );
+	multSubset.Serialize( writer );
+	std::string sSavedData = outStream.str();
+
+	// Open the saved subset and read the newest session
+	uint64 openStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	for( uint32 queryIndex = 0; queryIndex < NUM_QUERIES; ++queryIndex )
+	{
+		DataBlock savedData( sSavedData.data(), (uint32)sSavedData.size() );
+		Serializer reader( &savedData );
+		ProfileSubsetMultiplication openedSubset;
+		openedSubset.Serialize( reader );
+		openedSubset.GetFirstSession();
+	}
+	float64 openTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - openStartTime) / 1000000000.0;
+
+	// Open the saved subset and decode every session
+	uint32 numDecoded = 0;
+	uint64 decodeStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	for( uint32 queryIndex = 0; queryIndex < NUM_QUERIES; ++queryIndex )
+	{
+		DataBlock savedData( sSavedData.data(), (uint32)sSavedData.size() );
+		Serializer reader( &savedData );
+		ProfileSubsetMultiplication openedSubset;
+		openedSubset.Serialize( reader );
+
+		numDecoded = 0;
+		for( const GameSessionStatsMult* pSession = openedSubset.GetFirstSession(); pSession; pSession = openedSubset.GetNextSession() )
+			numDecoded++;
+	}
+	float64 decodeTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - decodeStartTime) / 1000000000.0;
+
+	// Chart by walking every session, which is what the charts had to do with only the list
+	std::vector<SessionHistoryMult::PrimeBucket> listBuckets;
+	uint64 listStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	for( uint32 queryIndex = 0; queryIndex < NUM_QUERIES; ++queryIndex )
+	{
+		listBuckets.assign( NUM_WEEKS, SessionHistoryMult::PrimeBucket() );
+		for( const GameSessionStatsMult* pSession = multSubset.GetFirstSession(); pSession; pSession = multSubset.GetNextSession() )
+		{
+			time_t sessionTime = SessionHistoryMult::GetStartTime( *pSession );
+			if( sessionTime < startTime || sessionTime >= endTime )
+				continue;
+
+			SessionHistoryMult::PrimeBucket& bucket = listBuckets[ (uint32)((sessionTime - startTime) / SECS_PER_WEEK) ];
+			bucket.numSessions++;
+			bucket.validCount += pSession->m_ValidCounts[ PRIME_INDEX ];
+			bucket.errorCount += pSession->m_ErrorCounts[ PRIME_INDEX ];
+		}
+	}
+	float64 listTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - listStartTime) / 1000000000.0;
+
+	// Chart with the history
+	std::vector<SessionHistoryMult::PrimeBucket> historyBuckets;
+	uint64 historyStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	for( uint32 queryIndex = 0; queryIndex < NUM_QUERIES; ++queryIndex )
+		multSubset.GetHistory().DownsamplePrime( PRIME_INDEX, startTime, endTime, NUM_WEEKS, historyBuckets );
+	float64 historyTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - historyStartTime) / 1000000000.0;
+
+	bool isMatch = listBuckets.size() == historyBuckets.size() && numDecoded == multSubset.GetNumSessions();
+	for( uint32 bucketIndex = 0; isMatch && bucketIndex < listBuckets.size(); ++bucketIndex )
+	{
+		isMatch = listBuckets[bucketIndex].numSessions == historyBuckets[bucketIndex].numSessions
+					&& listBuckets[bucketIndex].validCount == historyBuckets[bucketIndex].validCount
+					&& listBuckets[bucketIndex].errorCount == historyBuckets[bucketIndex].errorCount;
+	}
+
+	float64 historyQueryTime = historyTime > 0.0 ? historyTime : 0.000000001;
+	printf( "Session history, %u sessions, seed 0x%llX\n", numSessions, (unsigned long long)seed );
+	printf( "  Build time:       %.3f sec\n", buildTime );
+	printf( "  Saved size:       %u KB\n", (uint32)(sSavedData.size() / 1024) );
+	printf( "  Open for a game:  %.3f ms\n", openTime * 1000.0 / NUM_QUERIES );
+	printf( "  Decode all:       %.3f ms\n", decodeTime * 1000.0 / NUM_QUERIES );
+	printf( "  Session list:     %.3f ms/chart\n", listTime * 1000.0 / NUM_QUERIES );
+	printf( "  Session history:  %.3f ms/chart (%.1fx)\n", historyTime * 1000.0 / NUM_QUERIES, listTime / historyQueryTime );
+	printf( "  Charts match:     %s\n", isMatch ? "yes" : "NO" );
+
+	if( !historyBuckets.empty() )
+	{
+		printf( "  Prime %d accuracy by week:", GameDefines::PRIMES[ PRIME_INDEX ] );
+		for( uint32 bucketIndex = 0; bucketIndex < historyBuckets.size(); bucketIndex += 13 )
+			printf( " %.1f%%", historyBuckets[bucketIndex].GetAccuracy() * 100.0 );
+		printf( " ...\n" );
+	}
+	printf( "\n" );
+
+	return isMatch;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	ReportClass  Global
+///
+///	\param numThreads The number of worker threads, 0 for one per core
+///
+///	Read every profile with the batch loader, outputting each profile as it is read, and then
+///	output the class totals.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static void ReportClass( uint32 numThreads )
+{
+	std::list<std::wstring> profileNames = PlayerProfile::GetAllProfileNames();
+	if( profileNames.empty() )
+	{
+		printf( "No profiles were found.\n" );
+		return;
+	}
+
+	uint64 startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+
+	ProfileBatchLoader loader;
+	loader.Start( profileNames, numThreads );
+
+	// Output the profiles as the workers finish them
+	std::vector<ProfileBatchLoader::ProfileSnapshot> snapshots;
+	printf( "%-24s %8s %10s %8s\n", "Profile", "Games", "Minutes", "Clear%" );
+	for( ;; )
+	{
+		bool isRunning = loader.IsRunning();
+
+		loader.TakeNewSnapshots( snapshots );
+		for( uint32 snapshotIndex = 0; snapshotIndex < snapshots.size(); ++snapshotIndex )
+		{
+			const ProfileBatchLoader::Stats& stats = snapshots[snapshotIndex].stats;
+			uint64 numEqs = stats.numEqsCleared + stats.numEqsFailed;
+			printf( "%-24ls %8u %10.1f %8.1f\n", snapshots[snapshotIndex].sName.c_str(), stats.numSessions, stats.timeOnTask / 60.0,
+						numEqs > 0 ? (float64)stats.numEqsCleared * 100.0 / (float64)numEqs : 0.0 );
+		}
+
+		if( !isRunning )
+			break;
+		loader.WaitFor( 50 );
+	}
+
+	float64 wallTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - startTime) / 1000000000.0;
+
+	uint32 numLoaded = 0, numFailed = 0, numProfiles = 0;
+	ProfileBatchLoader::Stats classStats;
+	loader.GetProgress( numLoaded, numFailed, numProfiles, classStats );
+
+	printf( "\nClass report\n" );
+	printf( "  Profiles:         %u (%u could not be read)\n", numLoaded, numFailed );
+	printf( "  Games:            %u\n", classStats.numSessions );
+	printf( "  Time on task:     %.1f min, %.1f min per profile\n", classStats.timeOnTask / 60.0, classStats.GetAvgTimeOnTask() / 60.0 );
+	printf( "  Prime accuracy:  " );
+	for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+		printf( " %d=%.1f%%", GameDefines::PRIMES[primeIndex], classStats.GetPrimeAccuracy( primeIndex ) * 100.0 );
+	printf( "\n  Difficulty games:" );
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+		printf( " %u=%u", diffIndex, classStats.difficultyCounts[diffIndex] );
+	printf( "\n  Real time:        %.3f sec (%.1f profiles/sec)\n\n", wallTime, (float64)numProfiles / (wallTime > 0.0 ? wallTime : 0.000001) );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	BenchmarkClassReport  Global
+///
+///	\param numProfiles The number of profiles in the class
+///	\param numThreads The number of worker threads, 0 for one per core
+///	\param seed The seed for the synthetic sessions
+///	\returns True if the class totals match the sessions that were written, false otherwise
+///
+///	Write a class of profiles filled with synthetic sessions, time reading them with the batch
+///	loader and then delete them. The benchmark will not run if any of its profile names are
+///	already taken so it never changes a player's profile.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static bool BenchmarkClassReport( uint32 numProfiles, uint32 numThreads, uint64 seed )
+{
+	const uint32 NUM_MULT_SESSIONS = 200;
+	const uint32 NUM_ADD_SESSIONS = 20;
+
+	std::list<std::wstring> profileNames;
+	for( uint32 profileIndex = 0; profileIndex < numProfiles; ++profileIndex )
+	{
+		std::wostringstream nameStream;
+		nameStream << L"ClassBench" << profileIndex;
+		if( PlayerProfile::DoesProfileExist( nameStream.str().c_str() ) )
+		{
+			printf( "The profile %ls already exists.\n", nameStream.str().c_str() );
+			return false;
+		}
+		profileNames.push_back( nameStream.str() );
+	}
+
+	// Write the profiles, counting the games at each difficulty to check the report with
+	TCBase::RandomGen randGen( seed );
+	uint32 expectedDiffCounts[ GameDefines::GPDL_COUNT ] = { 0 };
+	PlayerProfile::EnsureProfileDirExists();
+	uint64 writeStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	for( std::list<std::wstring>::const_iterator iterName = profileNames.begin(); iterName != profileNames.end(); ++iterName )
+	{
+		PlayerProfile* pProfile = PlayerProfile::OpenProfile( iterName->c_str() );
+		if( !pProfile )
+			continue;
+
+		ProfileSubsetMultiplication* pMultSub = static_cast<ProfileSubsetMultiplication*>( pProfile->GetSubset( ProfileSubsetMultiplication::SUBSET_ID ) );
+		for( uint32 sessionIndex = 0; pMultSub && sessionIndex < NUM_MULT_SESSIONS; ++sessionIndex )
+		{
+			GameSessionStatsMult session;
+			session.m_Duration = randGen.NextFloatInRange( 60.0f, 600.0f );
+			session.m_NumEqsCleared = (uint32)randGen.NextInRange( 10, 200 );
+			session.m_NumEqsFailed = (uint32)randGen.NextInRange( 0, 20 );
+			session.m_Difficulty = (GameDefines::EGameplayDiffLevel)randGen.NextInRange( GameDefines::GPDL_Pre3, GameDefines::GPDL_8 );
+			for( uint32 primeIndex = 0; primeIndex < GameDefines::NUM_PRIMES; ++primeIndex )
+			{
+				session.m_ValidCounts[ primeIndex ] = (uint32)randGen.NextInRange( 0, 60 );
+				session.m_ErrorCounts[ primeIndex ] = (uint32)randGen.NextInRange( 0, 6 );
+			}
+			pMultSub->StoreSession( session );
+			expectedDiffCounts[ session.m_Difficulty ]++;
+		}
+
+		ProfileSubsetAddition* pAddSub = static_cast<ProfileSubsetAddition*>( pProfile->GetSubset( ProfileSubsetAddition::SUBSET_ID ) );
+		for( uint32 sessionIndex = 0; pAddSub && sessionIndex < NUM_ADD_SESSIONS; ++sessionIndex )
+		{
+			GameSessionStatsAdd session;
+			session.m_Duration = randGen.NextFloatInRange( 60.0f, 600.0f );
+			session.m_NumEqsCleared = (uint32)randGen.NextInRange( 10, 100 );
+			session.m_Difficulty = (GameDefines::EGameplayDiffLevel)randGen.NextInRange( GameDefines::GPDL_Pre3, GameDefines::GPDL_8 );
+			pAddSub->StoreSession( session );
+			expectedDiffCounts[ session.m_Difficulty ]++;
+		}
+
+		pProfile->Compact();
+		delete pProfile;
+	}
+	float64 writeTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - writeStartTime) / 1000000000.0;
+
+	// Read the class
+	uint64 readStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+	ProfileBatchLoader loader;
+	loader.Start( profileNames, numThreads );
+	loader.Wait();
+	float64 readTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - readStartTime) / 1000000000.0;
+
+	uint32 numLoaded = 0, numFailed = 0, numTotal = 0;
+	ProfileBatchLoader::Stats classStats;
+	loader.GetProgress( numLoaded, numFailed, numTotal, classStats );
+
+	bool isMatch = numLoaded == numProfiles && classStats.numSessions == numProfiles * (NUM_MULT_SESSIONS + NUM_ADD_SESSIONS);
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT && isMatch; ++diffIndex )
+		isMatch = classStats.difficultyCounts[ diffIndex ] == expectedDiffCounts[ diffIndex ];
+
+	// Remove the profiles and their summaries
+	ProfileIndex index;
+	index.Load();
+	for( std::list<std::wstring>::const_iterator iterName = profileNames.begin(); iterName != profileNames.end(); ++iterName )
+	{
+		TCBase::TCDeleteFile( PlayerProfile::GetFilePathFromName( iterName->c_str() ).c_str() );
+		std::wstring sJournalPath = PlayerProfile::GetJournalPathFromName( iterName->c_str() );
+		if( TCBase::DoesFileExist( sJournalPath.c_str() ) )
+			TCBase::TCDeleteFile( sJournalPath.c_str() );
+		index.RemoveSummary( iterName->c_str() );
+	}
+	index.Save();
+
+	printf( "Class report, %u profiles of %u games, seed 0x%llX\n", numProfiles, NUM_MULT_SESSIONS + NUM_ADD_SESSIONS, (unsigned long long)seed );
+	printf( "  Write profiles:   %.3f sec\n", writeTime );
+	printf( "  Read profiles:    %.3f sec (%.1f profiles/sec, %u could not be read)\n", readTime, (float64)numLoaded / (readTime > 0.0 ? readTime : 0.000001), numFailed );
+	printf( "  Difficulty games:" );
+	for( uint32 diffIndex = 0; diffIndex < GameDefines::GPDL_COUNT; ++diffIndex )
+		printf( " %u=%u", diffIndex, classStats.difficultyCounts[diffIndex] );
+	printf( "\n  Totals:           %s\n\n", isMatch ? "match" : "DO NOT MATCH" );
+
+	return isMatch;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Main  Global
+///
+///	The entry point for the application.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+	TCBase::ParamList cmdLineParams;
+	cmdLineParams.ParseCmdLineOptions( argc, argv );
+
+	GameSimRunner::Settings settings;
+	settings.seed = TCBase::RandomGen::GenerateSeed();
+	bool runSuite = false;
+	bool runCalibration = false;
+	uint32 numHistorySessions = 0;
+	bool runClassReport = false;
+	uint32 numClassProfiles = 0;
+	DifficultyCalibrator::Settings calibrateSettings;
+	std::wstring sVerifyDir;
+	bool checkColumns = false;
+	bool checkSeeks = false;
+	uint32 numVerifyThreads = 0;
+
+	// Go through the options
+	for( const TCBase::ParamList::CmdLineParam* pParam = cmdLineParams.GetFirstOption(); pParam; pParam = cmdLineParams.GetNextOption() )
+	{
+		if( pParam->sOption == L"suite" )
+		{
+			runSuite = true;
+			continue;
+		}
+		if( pParam->sOption == L"calibrate" )
+		{
+			runCalibration = true;
+			continue;
+		}
+		if( pParam->sOption == L"classreport" )
+		{
+			runClassReport = true;
+			continue;
+		}
+		if( pParam->sOption == L"classbench" )
+		{
+			numClassProfiles = DEFAULT_CLASS_PROFILES;
+			if( !pParam->sParameters.empty() )
+				numClassProfiles = (uint32)wcstoul( pParam->sParameters.front().c_str(), NULL, 10 );
+			continue;
+		}
+		if( pParam->sOption == L"history" )
+		{
+			numHistorySessions = DEFAULT_HISTORY_SESSIONS;
+			if( !pParam->sParameters.empty() )
+				numHistorySessions = (uint32)wcstoul( pParam->sParameters.front().c_str(), NULL, 10 );
+			continue;
+		}
+
+		if( pParam->sParameters.empty() )
+		{
+			printf( "The option /%ls requires a value.\n", pParam->sOption.c_str() );
+			return 1;
+		}
+		const std::wstring& sValue = pParam->sParameters.front();
+
+		if( pParam->sOption == L"type" )
+		{
+			settings.gameType = ParseGameType( sValue );
+			if( settings.gameType == GameDefines::GT_Error )
+			{
+				printf( "Unknown game type %ls.\n", sValue.c_str() );
+				return 1;
+			}
+		}
+		else if( pParam->sOption == L"diff" )
+		{
+			settings.difficulty = (GameDefines::EGameplayDiffLevel)wcstol( sValue.c_str(), NULL, 10 );
+			for( std::list<std::wstring>::const_iterator iterValue = pParam->sParameters.begin(); iterValue != pParam->sParameters.end(); ++iterValue )
+				calibrateSettings.difficulties.push_back( (GameDefines::EGameplayDiffLevel)wcstol( iterValue->c_str(), NULL, 10 ) );
+		}
+		else if( pParam->sOption == L"games" )
+		{
+			settings.numGames = (uint32)wcstoul( sValue.c_str(), NULL, 10 );
+			settings.totalSimTime = 0.0f;
+		}
+		else if( pParam->sOption == L"minutes" )
+		{
+			settings.totalSimTime = (float32)wcstod( sValue.c_str(), NULL ) * 60.0f;
+			settings.numGames = 0;
+		}
+		else if( pParam->sOption == L"seed" )
+			settings.seed = (uint64)wcstoull( sValue.c_str(), NULL, 0 );
+		else if( pParam->sOption == L"skill" )
+			settings.botSettings.skill = (int32)wcstol( sValue.c_str(), NULL, 10 );
+		else if( pParam->sOption == L"reaction" )
+			settings.botSettings.reactionTime = (float32)wcstod( sValue.c_str(), NULL );
+		else if( pParam->sOption == L"clicktime" )
+			settings.botSettings.clickTime = (float32)wcstod( sValue.c_str(), NULL );
+		else if( pParam->sOption == L"errors" )
+			settings.botSettings.errorRate = (int32)wcstol( sValue.c_str(), NULL, 10 );
+		else if( pParam->sOption == L"replays" )
+		{
+			// The replay directory must end with a separator
+			std::wstring sReplayDir = sValue;
+			if( sReplayDir[ sReplayDir.length() - 1 ] != L'/' && sReplayDir[ sReplayDir.length() - 1 ] != L'\\' )
+				sReplayDir += L'/';
+			TCBase::CreateDir( sReplayDir.c_str() );
+			GameMgr::Get().SetReplayDir( sReplayDir.c_str(), 0 );
+		}
+		else if( pParam->sOption == L"verify" )
+			sVerifyDir = sValue;
+		else if( pParam->sOption == L"colcheck" )
+		{
+			sVerifyDir = sValue;
+			checkColumns = true;
+		}
+		else if( pParam->sOption == L"seekcheck" )
+		{
+			sVerifyDir = sValue;
+			checkSeeks = true;
+		}
+		else if( pParam->sOption == L"threads" )
+			numVerifyThreads = (uint32)wcstoul( sValue.c_str(), NULL, 10 );
+		else if( pParam->sOption == L"valuescale" )
+		{
+			for( std::list<std::wstring>::const_iterator iterValue = pParam->sParameters.begin(); iterValue != pParam->sParameters.end(); ++iterValue )
+				calibrateSettings.maxValueScales.push_back( (float32)wcstod( iterValue->c_str(), NULL ) );
+		}
+		else if( pParam->sOption == L"factors" )
+		{
+			for( std::list<std::wstring>::const_iterator iterValue = pParam->sParameters.begin(); iterValue != pParam->sParameters.end(); ++iterValue )
+				calibrateSettings.maxNumFactorsOffsets.push_back( (int32)wcstol( iterValue->c_str(), NULL, 10 ) );
+		}
+		else if( pParam->sOption == L"primes" )
+		{
+			for( std::list<std::wstring>::const_iterator iterValue = pParam->sParameters.begin(); iterValue != pParam->sParameters.end(); ++iterValue )
+				calibrateSettings.maxPrimeIndexOffsets.push_back( (int32)wcstol( iterValue->c_str(), NULL, 10 ) );
+		}
+		else if( pParam->sOption == L"sumscale" )
+		{
+			for( std::list<std::wstring>::const_iterator iterValue = pParam->sParameters.begin(); iterValue != pParam->sParameters.end(); ++iterValue )
+				calibrateSettings.sumRangeScales.push_back( (float32)wcstod( iterValue->c_str(), NULL ) );
+		}
+		else
+		{
+			printf( "Unknown option /%ls.\n", pParam->sOption.c_str() );
+			return 1;
+		}
+	}
+
+	if( !sVerifyDir.empty() )
+		return VerifyAndReport( sVerifyDir.c_str(), numVerifyThreads, checkColumns, checkSeeks ) ? 0 : 1;
+
+	if( runClassReport )
+	{
+		ReportClass( numVerifyThreads );
+		return 0;
+	}
+
+	if( numClassProfiles > 0 )
+		return BenchmarkClassReport( numClassProfiles, numVerifyThreads, settings.seed ) ? 0 : 1;
+
+	if( numHistorySessions > 0 )
+		return BenchmarkSessionHistory( numHistorySessions, settings.seed ) ? 0 : 1;
+
+	if( runCalibration )
+	{
+		calibrateSettings.gameType = settings.gameType;
+		calibrateSettings.seed = settings.seed;
+		calibrateSettings.botSettings = settings.botSettings;
+		if( settings.numGames > 0 )
+			calibrateSettings.gamesPerCell = settings.numGames;
+		CalibrateAndReport( calibrateSettings, numVerifyThreads );
+		return 0;
+	}
+
+	if( runSuite )
+	{
+		// Play the same seeded games for every type so the numbers can be compared between builds
+		const GameDefines::EGameType SUITE_GAME_TYPES[] = { GameDefines::GT_PrimeTime,
+															GameDefines::GT_Ceiling,
+															GameDefines::GT_AdditionAttack,
+															GameDefines::GT_Fractions };
+		const uint32 NUM_SUITE_GAME_TYPES = sizeof(SUITE_GAME_TYPES) / sizeof(SUITE_GAME_TYPES[0]);
+
+		printf( "Benchmark suite, seed 0x%llX\n\n", (unsigned long long)SUITE_SEED );
+		for( uint32 typeIndex = 0; typeIndex < NUM_SUITE_GAME_TYPES; ++typeIndex )
+		{
+			settings.gameType = SUITE_GAME_TYPES[typeIndex];
+			settings.seed = SUITE_SEED;
+			RunAndReport( settings );
+		}
+	}
+	else
+	{
+		printf( "Seed 0x%llX\n\n", (unsigned long long)settings.seed );
+		RunAndReport( settings );
+	}
+
+	return 0;
+}
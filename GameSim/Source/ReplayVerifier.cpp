@@ -0,0 +1,482 @@
+/*=================================================================================================
+
+	\file ReplayVerifier.cpp
+	Game Simulator
+	Replay Verifier Source
+	\author agent
+	\Date October 19, 2026
+
+	This source file contains the implementation of the parallel replay verifier.
+
+=================================================================================================*/
+
+#include "../ReplayVerifier.h"
+#include "GamePlay/GameContext.h"
+#include "GamePlay/GameMgr.h"
+#include "GamePlay/GameLogic.h"
+#include "GamePlay/GameField.h"
+#include "GamePlay/GameFieldMultBase.h"
+#include "GamePlay/GameFieldBlockMultBase.h"
+#include "GamePlay/GameDefines.h"
+#include "GamePlay/FractionModeSettings.h"
+#include "GamePlay/BlockFaceCache.h"
+#include "Base/XPThreads.h"
+#include "Base/FileFuncs.h"
+#include "Base/ProfileTimer.h"
+#include <list>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+/// Sleep the calling thread
+static void SleepMS( uint32 numMS )
+{
+#ifdef WIN32
+	Sleep( numMS );
+#else
+	// usleep takes microseconds
+	usleep( numMS * 1000 );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  GetNumFallingBlocks  Global
+///
+///	\param pField The field to check
+///	\returns The number of blocks on the field that are falling
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32 GetNumFallingBlocks( const GameFieldMultBase* pField )
+{
+	uint32 numFalling = 0;
+	const MultBlockList& activeBlocks = pField->GetActiveBlocks();
+	for( MultBlockList::const_iterator iterBlock = activeBlocks.begin(); iterBlock != activeBlocks.end(); ++iterBlock )
+	{
+		if( (*iterBlock)->isFalling )
+			numFalling++;
+	}
+
+	return numFalling;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  CheckFieldColumns  Global
+///
+///	\param pField The field to check
+///	\param listCol The storage for the rebuilt column, passed in so it is not allocated each time
+///	\returns True if every column holds the blocks it should, false otherwise
+///
+///	Compare the field's column arrays to the column lists the field used to keep. Each list is
+///	rebuilt by searching every block on the field for the ones that span the column and ordering
+///	them from bottom to top, the order the lists were kept in. The index each block stores for
+///	its place in each of its columns is checked as well.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static bool CheckFieldColumns( const GameFieldMultBase* pField, std::vector<const GameFieldBlockMultBase*>& listCol )
+{
+	const MultBlockList& activeBlocks = pField->GetActiveBlocks();
+	for( int32 colIndex = 0; colIndex < GameField::FIELD_WIDTH; ++colIndex )
+	{
+		// Rebuild the column list with a linear search of the blocks
+		listCol.clear();
+		for( MultBlockList::const_iterator iterBlock = activeBlocks.begin(); iterBlock != activeBlocks.end(); ++iterBlock )
+		{
+			const GameFieldBlockMultBase* pCurBlock = *iterBlock;
+			if( colIndex < pCurBlock->colIndex || colIndex >= pCurBlock->colIndex + pCurBlock->size.x )
+				continue;
+
+			// Insert the block above every block that is not higher than it
+			std::vector<const GameFieldBlockMultBase*>::iterator iterInsert = listCol.end();
+			while( iterInsert != listCol.begin() && (*(iterInsert - 1))->yPos > pCurBlock->yPos )
+				--iterInsert;
+			listCol.insert( iterInsert, pCurBlock );
+		}
+
+		const MultBlockColumn& blockCol = pField->GetColumn( colIndex );
+		if( blockCol.size() != listCol.size() )
+			return false;
+
+		for( uint32 slotIndex = 0; slotIndex < blockCol.size(); ++slotIndex )
+		{
+			if( blockCol[slotIndex] != listCol[slotIndex] )
+				return false;
+			if( pField->FindBlockInCol( blockCol[slotIndex], colIndex ) != (int32)slotIndex )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifyThreadProc  Global
+///
+///	\param pParam The replay verifier
+///
+///	The entry point of a worker thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef WIN32
+void ReplayVerifyThreadProc( void* pParam )
+#else
+void* ReplayVerifyThreadProc( void* pParam )
+#endif
+{
+	((ReplayVerifier*)pParam)->RunWorker();
+
+#ifndef WIN32
+	return 0;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::GetNumCores  Static Public
+///
+///	\returns The number of processor cores, at least 1
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 ReplayVerifier::GetNumCores()
+{
+#ifdef WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo( &sysInfo );
+	return sysInfo.dwNumberOfProcessors > 0 ? (uint32)sysInfo.dwNumberOfProcessors : 1;
+#else
+	long numCores = sysconf( _SC_NPROCESSORS_ONLN );
+	return numCores > 0 ? (uint32)numCores : 1;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::AddReplayDir  Public
+///
+///	\param szReplayDir The directory containing the replays
+///	\returns The number of replays found in the directory
+///
+///	Add every replay file in a directory to the replays to verify.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 ReplayVerifier::AddReplayDir( const wchar_t* szReplayDir )
+{
+	std::wstring sReplayDir = szReplayDir ? szReplayDir : L"";
+	if( sReplayDir.empty() )
+		return 0;
+	if( sReplayDir[ sReplayDir.length() - 1 ] != L'/' && sReplayDir[ sReplayDir.length() - 1 ] != L'\\' )
+		sReplayDir += L'/';
+
+	std::list<std::wstring> fileNames = TCBase::FindFiles( sReplayDir.c_str(), L"*.ptr" );
+	for( std::list<std::wstring>::const_iterator iterFile = fileNames.begin(); iterFile != fileNames.end(); ++iterFile )
+		m_ReplayFiles.push_back( sReplayDir + *iterFile );
+
+	return (uint32)fileNames.size();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::Run  Public
+///
+///	\param numThreads The number of worker threads, 0 to use one for each core
+///	\returns The results of the run
+///
+///	Verify every replay that was added, waiting for the worker threads to finish.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const ReplayVerifier::Results& ReplayVerifier::Run( uint32 numThreads )
+{
+	m_Results = Results();
+	m_ReplayResults.clear();
+	m_ReplayResults.resize( m_ReplayFiles.size() );
+	for( uint32 replayIndex = 0; replayIndex < m_ReplayFiles.size(); ++replayIndex )
+		m_ReplayResults[ replayIndex ].sFile = m_ReplayFiles[ replayIndex ];
+
+	if( numThreads == 0 )
+		numThreads = GetNumCores();
+	if( numThreads > m_ReplayFiles.size() )
+		numThreads = (uint32)m_ReplayFiles.size();
+	m_Results.numThreads = numThreads;
+
+	// The product and fraction tables and the block text are built the first time they are used,
+	// so build them before the workers share them
+	GameDefines::GetProductArray();
+	FractionModeSettings::GetForDifficulty( 0 );
+	BlockFaceCache::Get().BuildValueTexts();
+
+	m_NextReplayIndex = 0;
+	m_NumRunningWorkers = numThreads;
+
+	uint64 startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+
+	// The threads are detached, each one counts itself out when it finishes
+	std::vector<XPThreads*> workers;
+	for( uint32 threadIndex = 0; threadIndex < numThreads; ++threadIndex )
+	{
+		XPThreads* pWorker = new XPThreads( ReplayVerifyThreadProc );
+		pWorker->Run( this );
+		workers.push_back( pWorker );
+	}
+
+	// Wait for the workers to empty the queue
+	for( ;; )
+	{
+		m_QueueLock.Enter();
+		uint32 numRunningWorkers = m_NumRunningWorkers;
+		m_QueueLock.Leave();
+
+		if( numRunningWorkers == 0 )
+			break;
+		SleepMS( 1 );
+	}
+
+	m_Results.wallTime = (float64)(TCBase::ProfileTimer::GetTimeNanosecs() - startTime) / 1000000000.0;
+
+	for( uint32 workerIndex = 0; workerIndex < workers.size(); ++workerIndex )
+		delete workers[ workerIndex ];
+
+	for( uint32 replayIndex = 0; replayIndex < m_ReplayResults.size(); ++replayIndex )
+	{
+		const ReplayResult& result = m_ReplayResults[ replayIndex ];
+		m_Results.numTicks += result.numTicks;
+		m_Results.numCascadeTicks += result.numCascadeTicks;
+		m_Results.cascadeNanosecs += result.cascadeNanosecs;
+		if( result.maxCascadeNanosecs > m_Results.maxCascadeNanosecs )
+			m_Results.maxCascadeNanosecs = result.maxCascadeNanosecs;
+		m_Results.numSettledTicks += result.numSettledTicks;
+		m_Results.settledNanosecs += result.settledNanosecs;
+		m_Results.numSeeks += result.numSeeks;
+		m_Results.seekNanosecs += result.seekNanosecs;
+		if( result.maxSeekNanosecs > m_Results.maxSeekNanosecs )
+			m_Results.maxSeekNanosecs = result.maxSeekNanosecs;
+		m_Results.numSlowSeeks += result.numSlowSeeks;
+		if( result.Passed() )
+			m_Results.numPassed++;
+		else
+			m_Results.numFailed++;
+	}
+
+	return m_Results;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::TakeNextReplay  Private
+///
+///	\param replayIndex The index of the replay that was taken
+///	\returns True if a replay was taken, false if the queue is empty
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayVerifier::TakeNextReplay( uint32& replayIndex )
+{
+	m_QueueLock.Enter();
+	bool hasReplay = m_NextReplayIndex < m_ReplayResults.size();
+	if( hasReplay )
+		replayIndex = m_NextReplayIndex++;
+	m_QueueLock.Leave();
+
+	return hasReplay;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::RunWorker  Private
+///
+///	Verify replays from the queue until it is empty. The worker's game context is bound for the
+///	life of the worker so every replay it plays uses the worker's own game manager and pools.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayVerifier::RunWorker()
+{
+	{
+		GameContext context;
+		GameContext::Scope contextScope( context );
+
+		uint32 replayIndex = 0;
+		while( TakeNextReplay( replayIndex ) )
+			VerifyReplay( m_ReplayResults[ replayIndex ], m_CheckColumns, m_CheckSeeks );
+	}
+
+	m_QueueLock.Enter();
+	m_NumRunningWorkers--;
+	m_QueueLock.Leave();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::VerifyReplay  Static Private
+///
+///	\param result The result to fill in, its file is the replay to play
+///	\param checkColumns True to check the field's columns and time the ticks
+///	\param checkSeeks True to check and time seeking to each snapshot once the replay verifies
+///
+///	Play a replay from the start with the game manager of the calling thread's game context,
+///	comparing the game to the snapshots as it goes and to the summary at the end. A replay with
+///	a summary is played to the tick the game ended on, otherwise it is played until its last
+///	instruction.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayVerifier::VerifyReplay( ReplayResult& result, bool checkColumns, bool checkSeeks )
+{
+	GameMgr& gameMgr = GameMgr::Get();
+	if( !gameMgr.StartReplay( result.sFile.c_str() ) || !gameMgr.GetReplayStream() )
+	{
+		gameMgr.Clear();
+		return;
+	}
+	result.wasLoaded = true;
+
+	InstructionStreamReplay* pReplayStream = gameMgr.GetReplayStream();
+	pReplayStream->EnableVerification();
+	result.hasSummary = pReplayStream->HasSummary();
+	result.numSnapshots = pReplayStream->GetNumSnapshots();
+
+	InstructionStreamReplay::Summary summary = pReplayStream->GetSummary();
+	result.expectedScore = summary.score;
+	result.expectedNumBlocks = summary.numBlocks;
+
+	// Only the product and fraction fields store their blocks in columns
+	const GameFieldMultBase* pMultField = NULL;
+	GameLogic* pLogic = gameMgr.GetLogic();
+	if( checkColumns && pLogic && pLogic->GetGameField()
+		&& (pLogic->GetGameType() & GameDefines::GT_Mask_Type) != GameDefines::GT_AdditionAttack )
+		pMultField = static_cast<const GameFieldMultBase*>( pLogic->GetGameField() );
+
+	std::vector<const GameFieldBlockMultBase*> listCol;
+	uint32 numFallingBlocks = pMultField ? GetNumFallingBlocks( pMultField ) : 0;
+
+	while( gameMgr.IsPlaying() )
+	{
+		if( result.hasSummary ? pReplayStream->GetCurTick() >= summary.tick : pReplayStream->IsFinished() )
+			break;
+
+		// A message box, such as completing a ceiling level, waits for input a replay can't give
+		if( gameMgr.IsPaused() )
+		{
+			result.wasStalled = true;
+			break;
+		}
+
+		if( !pMultField )
+		{
+			gameMgr.Update( GameDefines::SIM_TICK_TIME );
+			result.numTicks++;
+			continue;
+		}
+
+		uint64 tickStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+		gameMgr.Update( GameDefines::SIM_TICK_TIME );
+		uint64 tickNanosecs = TCBase::ProfileTimer::GetTimeNanosecs() - tickStartTime;
+		result.numTicks++;
+
+		// A tick is part of a cascade if blocks were falling before or after it
+		uint32 prevNumFallingBlocks = numFallingBlocks;
+		numFallingBlocks = GetNumFallingBlocks( pMultField );
+		if( prevNumFallingBlocks > 0 || numFallingBlocks > 0 )
+		{
+			result.numCascadeTicks++;
+			result.cascadeNanosecs += tickNanosecs;
+			if( tickNanosecs > result.maxCascadeNanosecs )
+				result.maxCascadeNanosecs = tickNanosecs;
+		}
+		else
+		{
+			result.numSettledTicks++;
+			result.settledNanosecs += tickNanosecs;
+		}
+
+		if( !CheckFieldColumns( pMultField, listCol ) )
+		{
+			if( result.numColumnMismatches == 0 )
+				result.firstColumnMismatchTick = pReplayStream->GetCurTick();
+			result.numColumnMismatches++;
+		}
+	}
+
+	result.snapshotResults = pReplayStream->GetVerifyResults();
+
+	pLogic = gameMgr.GetLogic();
+	if( pLogic )
+	{
+		result.score = pLogic->GetScore();
+		if( pLogic->GetGameField() )
+			result.numBlocks = pLogic->GetGameField()->GetNumBlocks();
+	}
+
+	// Seeking is only checked against snapshots the forward run matched
+	if( checkSeeks && result.Passed() )
+		CheckSeeks( result );
+
+	gameMgr.Clear();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ReplayVerifier::CheckSeeks  Static Private
+///
+///	\param result The result to add the seeks to
+///
+///	Seek the replay being played back to the tick before each snapshot, starting from the last,
+///	and simulate the one tick to the snapshot, where the game must match the recorded state. Each
+///	seek restores the snapshot before it and simulates the ticks in between, the longest a seek
+///	can take. Going backwards means every seek restores a snapshot rather than simulating on from
+///	the current tick. The seek is timed from the call to SeekReplay until it returns.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ReplayVerifier::CheckSeeks( ReplayResult& result )
+{
+	GameMgr& gameMgr = GameMgr::Get();
+	GameLogic* pLogic = gameMgr.GetLogic();
+	InstructionStreamReplay* pReplayStream = gameMgr.GetReplayStream();
+	if( !pLogic || !pLogic->CanSerializeState() || !pReplayStream )
+		return;
+
+	for( uint32 snapshotIndex = pReplayStream->GetNumSnapshots(); snapshotIndex-- > 1; )
+	{
+		uint32 nextTick = pReplayStream->GetSnapshotTick( snapshotIndex );
+		uint32 seekTick = nextTick - 1;
+
+		uint64 seekStartTime = TCBase::ProfileTimer::GetTimeNanosecs();
+		gameMgr.SeekReplay( (float32)seekTick * GameDefines::SIM_TICK_TIME );
+		uint64 seekNanosecs = TCBase::ProfileTimer::GetTimeNanosecs() - seekStartTime;
+
+		result.numSeeks++;
+		result.seekNanosecs += seekNanosecs;
+		if( seekNanosecs > result.maxSeekNanosecs )
+			result.maxSeekNanosecs = seekNanosecs;
+		if( seekNanosecs > TARGET_SEEK_NANOSECS )
+			result.numSlowSeeks++;
+
+		// A failed restore starts the game over, so get the stream again
+		pReplayStream = gameMgr.GetReplayStream();
+
+		// Compare the game to the snapshot only, once it is reached
+		pReplayStream->EnableVerification();
+		while( pReplayStream->GetCurTick() < nextTick && gameMgr.IsPlaying() && !gameMgr.IsPaused() )
+			gameMgr.Update( GameDefines::SIM_TICK_TIME );
+
+		const InstructionStreamReplay::VerifyResults& verifyResults = pReplayStream->GetVerifyResults();
+		if( pReplayStream->GetCurTick() != nextTick || verifyResults.numChecked != 1 || verifyResults.numMismatched > 0 )
+		{
+			if( result.numSeekMismatches == 0 )
+				result.firstSeekMismatchTick = seekTick;
+			result.numSeekMismatches++;
+		}
+	}
+}
@@ -153,6 +153,10 @@ public:
 	/// Load an image from memory
 	virtual TCImage* LoadImageFromMemory( uint32 resID, DataBlock* pImageDataBlock ) = 0;
 
+	/// Create a transparent image that can be drawn to with a temporary render target, NULL if
+	/// the graphics manager does not support it
+	virtual TCImage* CreateBlankImage( const Vector2i& ) { return 0; }
+
 	/// Load an image from memory
 	TCFont* LoadFontFromMemory( uint32 resID, DataBlock* pImageDataBlock );
 
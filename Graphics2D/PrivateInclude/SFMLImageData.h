@@ -0,0 +1,61 @@
+//=================================================================================================
+/*!
+	\file SFMLImageData.h
+	2D Graphics Engine
+	SFML Image Data Header
+	\author agent
+	\date October 19, 2026
+
+	This header contains the definition for the data stored with each image when using SFML.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __SFMLImageData_h
+#define __SFMLImageData_h
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\struct SFMLImageData
+	\brief The pixels of an image and the texture they are drawn from.
+
+	SFML draws from textures in video memory, but images are created and modified in system
+	memory. Each image keeps its own texture so switching between images while drawing does not
+	upload the pixels again. The texture is only uploaded when it is first drawn and after the
+	pixels change.
+*/
+//-------------------------------------------------------------------------------------------------
+struct SFMLImageData
+{
+	/// The pixels
+	sf::Image image;
+
+	/// The texture created from the pixels
+	sf::Texture texture;
+
+	/// If the pixels have changed since the texture was uploaded
+	bool isTextureStale;
+
+	/// The default constructor
+	SFMLImageData() : isTextureStale( true )
+	{}
+
+	/// Get the texture, uploading the pixels first if they have changed
+	const sf::Texture& GetTexture()
+	{
+		if( isTextureStale )
+		{
+			texture.loadFromImage( image );
+			texture.setSmooth( false );
+			isTextureStale = false;
+		}
+
+		return texture;
+	}
+};
+
+#endif // __SFMLImageData_h
@@ -24,6 +24,7 @@
 #include "../CachedFontDraw.h"
 #include "../PrivateInclude/TCFontImpl.h"
 #include "../PrivateInclude/RefSpriteImpl.h"
+#include "../PrivateInclude/SFMLImageData.h"
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Sprite.hpp>
@@ -55,18 +56,11 @@ private:
 	sf::RenderWindow* _pRenderWindow;
 
 	/// The temporary render target, if any
-	sf::Image* _pTempTargetImage;
-
-    /// The current texture image
-    sf::Image* _pCurrentImage;
-
-    /// The current texture, cached to avoid re-loading it to video memory
-    sf::Texture _currentTexture;
+	SFMLImageData* _pTempTargetImage;
 
 	/// The default constructor, private to enforce a singleton
 	GraphicsMgrSFML() : _pRenderWindow( 0 ),
-						_pTempTargetImage( 0 ),
-                        _pCurrentImage( NULL )
+						_pTempTargetImage( 0 )
 	{
 	}
 
@@ -142,17 +136,9 @@ public:
 			return;
 		}
 
-		sf::Image* pSFMLImage = static_cast<sf::Image*>( pFontImage->GetImageData() );
-
-        // If the active texture isn't using the correct image
-        if( pSFMLImage != _pCurrentImage )
-        {
-            _pCurrentImage = pSFMLImage;
-            _currentTexture.loadFromImage( *pSFMLImage );
-            _currentTexture.setSmooth(false);            
-        }
+		SFMLImageData* pSFMLImage = static_cast<SFMLImageData*>( pFontImage->GetImageData() );
 
-		sf::Sprite sprite( _currentTexture );
+		sf::Sprite sprite( pSFMLImage->GetTexture() );
 		sprite.setColor( IntToColor(colorTint) );
 
 		// Draw the characters
@@ -176,7 +162,7 @@ public:
 		if( !pImage )
 			return;
 
-		sf::Image* pSFMLImage = static_cast<sf::Image*>( pImage->GetImageData() );
+		SFMLImageData* pSFMLImage = static_cast<SFMLImageData*>( pImage->GetImageData() );
 
 		// If we are using a temporary render target then render to that target
 		if( _pTempTargetImage )
@@ -184,19 +170,12 @@ public:
 			if( srcRect.size.x == 0 || srcRect.size.y == 0 )
 				return;
 
-			_pTempTargetImage->copy( *pSFMLImage, destPos.x, destPos.y, sf::IntRect(srcRect.pos.x, srcRect.pos.y, srcRect.size.x, srcRect.size.y), true);
+			_pTempTargetImage->image.copy( pSFMLImage->image, destPos.x, destPos.y, sf::IntRect(srcRect.pos.x, srcRect.pos.y, srcRect.size.x, srcRect.size.y), true);
+			_pTempTargetImage->isTextureStale = true;
 			return;
 		}
 
-        // If the active texture isn't using the correct image
-        if( pSFMLImage != _pCurrentImage )
-        {
-            _pCurrentImage = pSFMLImage;
-            _currentTexture.loadFromImage( *_pCurrentImage );
-            _currentTexture.setSmooth(false);            
-        }
-        
-		sf::Sprite sprite( _currentTexture );
+		sf::Sprite sprite( pSFMLImage->GetTexture() );
 		sprite.setPosition((float)destPos.x, (float)destPos.y);
 		sprite.setTextureRect( sf::IntRect(srcRect.pos.x, srcRect.pos.y, srcRect.size.x, srcRect.size.y ) );
         sprite.setColor( IntToColor(colorTint) );
@@ -225,17 +204,9 @@ public:
 		if( _pTempTargetImage )
 			return;
 
-		sf::Image* pSFMLImage = static_cast<sf::Image*>( pImage->GetImageData() );
-        
-        // If the active texture isn't using the correct image
-        if( pSFMLImage != _pCurrentImage )
-        {
-            _pCurrentImage = pSFMLImage;
-            _currentTexture.loadFromImage( *_pCurrentImage );
-            _currentTexture.setSmooth(false);            
-        }
+		SFMLImageData* pSFMLImage = static_cast<SFMLImageData*>( pImage->GetImageData() );
 
-		sf::Sprite sprite( _currentTexture );
+		sf::Sprite sprite( pSFMLImage->GetTexture() );
 
 		sprite.setPosition((float)destRect.pos.x, (float)destRect.pos.y); 
 		sprite.setTextureRect( sf::IntRect(srcRect.pos.x, srcRect.pos.y, srcRect.size.x, srcRect.size.y ) );
@@ -352,7 +323,9 @@ public:
 	/// Apply an effect to an image
 	virtual bool ApplyEffect( TCImage* pImage, const Box2i& rect, GraphicsDefines::ModPixelCB pixelCB )
 	{
-		sf::Image* pSFMLImage = static_cast<sf::Image*>( pImage->GetImageData() );
+		SFMLImageData* pImageData = static_cast<SFMLImageData*>( pImage->GetImageData() );
+		sf::Image* pSFMLImage = &pImageData->image;
+		pImageData->isTextureStale = true;
 
 		const sf::Color trans(255,0,255);
 
@@ -376,7 +349,7 @@ public:
 	/// Set a temporary render target
 	virtual bool SetTempRenderTarget( TCImage* pImage )
 	{
-		_pTempTargetImage = static_cast<sf::Image*>( pImage->GetImageData() );
+		_pTempTargetImage = static_cast<SFMLImageData*>( pImage->GetImageData() );
 
 		return true;
 	}
@@ -405,9 +378,21 @@ public:
 		
 		// Load the image data to surface and return the pointer
 		TCImage* pImg = TCImage::Create( resID );
-		sf::Image* pNewImage = new sf::Image();
-		pNewImage->create( imgDims.x, imgDims.y );
-		FillInImageData( pNewImage, imgDims, imageType, &pixelData );
+		SFMLImageData* pNewImage = new SFMLImageData();
+		pNewImage->image.create( imgDims.x, imgDims.y );
+		FillInImageData( &pNewImage->image, imgDims, imageType, &pixelData );
+
+		pImg->SetImageData( pNewImage );
+
+		return pImg;
+	}
+
+	/// Create a transparent image that can be drawn to with a temporary render target
+	virtual TCImage* CreateBlankImage( const Vector2i& imgDims )
+	{
+		TCImage* pImg = TCImage::Create( 0 );
+		SFMLImageData* pNewImage = new SFMLImageData();
+		pNewImage->image.create( imgDims.x, imgDims.y, sf::Color( 0, 0, 0, 0 ) );
 
 		pImg->SetImageData( pNewImage );
 
@@ -418,7 +403,8 @@ public:
 	/// Reload the image data for a resource
 	virtual bool ReloadImageData( TCImage* pImage, DataBlock* pImageDataBlock )
 	{
-		sf::Image* pDestImage = static_cast<sf::Image*>( pImage->GetImageData() );
+		SFMLImageData* pDestImage = static_cast<SFMLImageData*>( pImage->GetImageData() );
+		pDestImage->isTextureStale = true;
 
 		// Read in the dimensions
 		Vector2i imgDims;
@@ -433,7 +419,7 @@ public:
 		DataBlock pixelData( pImageDataBlock->ReadData(dataLen), dataLen );
 		
 		// Load the image data to surface and return the pointer
-		FillInImageData( pDestImage, imgDims, imageType, &pixelData );
+		FillInImageData( &pDestImage->image, imgDims, imageType, &pixelData );
 
 		// No need to do this with SFML, as far as I know
 		return true;
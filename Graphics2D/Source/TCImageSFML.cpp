@@ -14,7 +14,7 @@
 #include "Base/Types.h"
 #include "Math/Vector2i.h"
 #include "Base/TCAssert.h"
-#include <SFML/Graphics/Image.hpp>
+#include "../PrivateInclude/SFMLImageData.h"
 
 
 //-------------------------------------------------------------------------------------------------
@@ -29,8 +29,8 @@ class TCImageSFML : public TCImage
 {
 public:
 
-	/// The DirectDraw surface object
-	sf::Image* _pSFMLImage;
+	/// The pixels and the texture used to draw them
+	SFMLImageData* _pSFMLImage;
 
 	/// The default constructor is private so we can't instantiate this class
 	TCImageSFML( ResourceID resID ) : TCImage( resID ),
@@ -49,7 +49,7 @@ public:
 	/// Set the image data
 	virtual void SetImageData( void* pImageData )
 	{
-		_pSFMLImage = (sf::Image*)pImageData;
+		_pSFMLImage = (SFMLImageData*)pImageData;
 	}
 };
 
@@ -89,5 +89,5 @@ Vector2i TCImageSFML::GetDims() const
 	}
 
 	// Return the dimensions of the DirectDraw surface
-	return Vector2i( _pSFMLImage->getSize().x, _pSFMLImage->getSize().y );
+	return Vector2i( _pSFMLImage->image.getSize().x, _pSFMLImage->image.getSize().y );
 }
@@ -15,7 +15,7 @@
 #define __MATRIX3X3_H
 
 #include "Base/Types.h"
-#include "Vector3.h"
+#include "vector3.h"
 #include "Point2.h"
 #include "Vector2.h"
 
@@ -10,7 +10,7 @@
 //=============================================================================
 
 #include "../Matrix3x3.h"
-#include "../Vector3.h"
+#include "../vector3.h"
 #include <math.h>
 
 
@@ -46,7 +46,9 @@ typedef list<NetMsgTemplate> NetMsgList;
 
 NetMsgList ParseFile( const wchar_t* szFile );
 
-void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile );
+void ExportTemplates( const NetMsgList& msgTemplates, const wchar_t* szOutFile );
+
+void ExportChecks( const NetMsgList& msgTemplates, const wchar_t* szOutFile );
 
 int wmain( int argv, wchar_t* argc[] )
 {
@@ -57,10 +59,15 @@ int wmain( int argv, wchar_t* argc[] )
 	const wchar_t* szOutFile = L"GameNetMsgs.h";
 	if( argv > 2 )
 		szOutFile = argc[2];
+
+	const wchar_t* szCheckFile = L"GameNetMsgsCheck.h";
+	if( argv > 3 )
+		szCheckFile = argc[3];
 		
 	NetMsgList msgTemplates = ParseFile( szInFile );
 
 	ExportTemplates( msgTemplates, szOutFile );
+	ExportChecks( msgTemplates, szCheckFile );
 	return 0;
 }
 
@@ -90,17 +97,17 @@ bool ParseLine( const wchar_t* szLine, NetMsgMember& member )
 	member.size = _wtol( wstring( szCurPos, szCommaChar - szCurPos ).c_str() );
 	szCurPos = szCommaChar + 1;
 
-	// Read up to the comma for the name
+	// Read up to the comma for the name, prepended with m_
 	szCommaChar = wcschr( szCurPos, L',' );
 	if( !szCommaChar )
 	{
 		if( szCurPos - szLine == strLen )
 			return false;
-		member.sName = wstring( szCurPos, strLen - (szCurPos - szLine) );
+		member.sName = L"m_" + wstring( szCurPos, strLen - (szCurPos - szLine) );
 		return true;
 	}
 	else
-		member.sName = wstring( szCurPos, szCommaChar - szCurPos );
+		member.sName = L"m_" + wstring( szCurPos, szCommaChar - szCurPos );
 	szCurPos = szCommaChar + 1;
 
 	// Get the length of the remaining string which is the comment
@@ -190,27 +197,52 @@ NetMsgList ParseFile( const wchar_t* szFile )
 }
 
 
+
+/// Get if a member is a string
+static bool IsStringMember( const NetMsgMember& member )
+{
+	return member.type == L"std::wstring";
+}
+
+/// Get the number of bytes a member takes on the wire, only counting a string's length
+static int GetMinMemberSize( const NetMsgMember& member )
+{
+	if( IsStringMember( member ) )
+		return 2;
+	return member.size / 8;
+}
+
+/// Get the mask for the bits of a member that are sent
+static const wchar_t* GetMemberMask( const NetMsgMember& member )
+{
+	if( member.size == 8 )
+		return L"0xFF";
+	if( member.size == 16 )
+		return L"0xFFFF";
+	return L"0xFFFFFFFF";
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
-//	ExportTemplates  Global
+//	ExportHeaderStart  Global
 ///
-///	\param msgTemplates The list of network message templates
-///	\param szOutFile The output file path
+///	\param pOutFile The file to write to
+///	\param szFileName The name of the file to list in the comment
+///	\param szDesc The description of the file to list in the comment
+///	\param szGuardName The name used in the include guard
+///	\param szContents What the file contains, to list in the comment
 ///
-///	Export the read-in network message templates
+///	Write the comment block and include guard that start a generated header.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile )
+void ExportHeaderStart( FILE* pOutFile, const wchar_t* szFileName, const wchar_t* szDesc, const wchar_t* szGuardName, const wchar_t* szContents )
 {
-	FILE* pOutFile = 0;
-	if( _wfopen_s( &pOutFile, szOutFile, L"w" ) != 0 )
-		return;
-
 	fwprintf_s( pOutFile, L"//=================================================================================================\n" );
 	fwprintf_s( pOutFile, L"/*!\n" );
-	fwprintf_s( pOutFile, L"\t\\file GameNetMsgs.h\n" );
+	fwprintf_s( pOutFile, L"\t\\file %s\n", szFileName );
 	fwprintf_s( pOutFile, L"\tGame Play Library\n" );
-	fwprintf_s( pOutFile, L"\tAuto-Generated Game Network Message Header\n" );
+	fwprintf_s( pOutFile, L"\t%s\n", szDesc );
 	fwprintf_s( pOutFile, L"\t\\author The NetMsgGen application, but that is by Taylor Clark\n" );
 
 	struct tm   newTime;
@@ -224,51 +256,82 @@ void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile )
 
 	fwprintf_s( pOutFile, L"\t\\date %s\n", _wasctime( &newTime ) );
 	fwprintf_s( pOutFile, L"\n" );
-	fwprintf_s( pOutFile, L"\tThis file is auto-generated contains the definitions for the game network message objects.  It\n" );
+	fwprintf_s( pOutFile, L"\tThis file is auto-generated contains %s.  It\n", szContents );
 	fwprintf_s( pOutFile, L"\tshould not be editted directly, but rather the source file should be altered and this file\n" );
 	fwprintf_s( pOutFile, L"\tregenerated.\n" );
 	fwprintf_s( pOutFile, L"*/\n" );
 	fwprintf_s( pOutFile, L"//=================================================================================================\n" );
 	fwprintf_s( pOutFile, L"\n" );
 	fwprintf_s( pOutFile, L"#pragma once\n" );
-	fwprintf_s( pOutFile, L"#ifndef __GameNetMsgs_h\n" );
-	fwprintf_s( pOutFile, L"#define __GameNetMsgs_h\n" );
+	fwprintf_s( pOutFile, L"#ifndef __%s_h\n", szGuardName );
+	fwprintf_s( pOutFile, L"#define __%s_h\n", szGuardName );
 	fwprintf_s( pOutFile, L"\n" );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	ExportTemplates  Global
+///
+///	\param msgTemplates The list of network message templates
+///	\param szOutFile The output file path
+///
+///	Export the read-in network message templates. Each message gets its wire size and
+///	straight-line functions that encode it into and decode it from a span of memory, checking the
+///	size once for the whole message, and switches over the message IDs encode and decode every
+///	message without virtual calls.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ExportTemplates( const NetMsgList& msgTemplates, const wchar_t* szOutFile )
+{
+	FILE* pOutFile = 0;
+	if( _wfopen_s( &pOutFile, szOutFile, L"w" ) != 0 )
+		return;
+
+	ExportHeaderStart( pOutFile, L"GameNetMsgs.h", L"Auto-Generated Game Network Message Header", L"GameNetMsgs",
+						L"the definitions for the game network message objects" );
 	fwprintf_s( pOutFile, L"#include \"Network/NetMsg.h\"\n" );
+	fwprintf_s( pOutFile, L"#include \"Network/NetMsgPool.h\"\n" );
+	fwprintf_s( pOutFile, L"#include \"Network/NetWire.h\"\n" );
+	fwprintf_s( pOutFile, L"#include \"Network/NetworkMgr.h\"\n" );
 	fwprintf_s( pOutFile, L"#include \"GameDefines.h\"\n" );
 	fwprintf_s( pOutFile, L"\n" );
 
-	// Generate the registration code
-	for( NetMsgList::iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
-		fwprintf_s( pOutFile, L"NetworkMgr::Get().RegisterNetMsg( GNMI_%s, NetMsg%s::CreateMsg );\n", iterMsg->sName.c_str(), iterMsg->sName.c_str() );
-	fwprintf_s( pOutFile, L"\n" );
-
 	// Write the enum
 	fwprintf_s( pOutFile, L"/// The game network message IDs\n" );
 	fwprintf_s( pOutFile, L"enum EGameNetMsgIDs\n" );
 	fwprintf_s( pOutFile, L"{\n" );
 	fwprintf_s( pOutFile, L"\tGNMI_Error = -1,\n" );
-	for( NetMsgList::iterator iterTemplate = msgTemplates.begin(); iterTemplate != msgTemplates.end(); ++iterTemplate )
+	for( NetMsgList::const_iterator iterTemplate = msgTemplates.begin(); iterTemplate != msgTemplates.end(); ++iterTemplate )
 		fwprintf_s( pOutFile, L"\tGNMI_%s,\n", iterTemplate->sName.c_str() );
 	fwprintf_s( pOutFile, L"\tGNMI_COUNT\n" );
 	fwprintf_s( pOutFile, L"};\n" );
 	fwprintf_s( pOutFile, L"\n" );
 
+	// Write the family ID that separates the game messages from other messages with the same IDs
+	fwprintf_s( pOutFile, L"/// The message family ID of the game network messages, 'PTGM'\n" );
+	fwprintf_s( pOutFile, L"const uint32 GAME_NET_MSG_FAMILY_ID = 0x5054474D;\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
 	// Go through the templates
-	for( NetMsgList::iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
 	{
 		// Get the class name
 		wstring sClassName( L"NetMsg" );
 		sClassName += iterMsg->sName;
 
-		// Prepend the member names with m_
-		for( MsgMemberList::iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
+		// Calculate the wire sizes
+		int numFixedBytes = 0;
+		int numStrings = 0;
+		for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
 		{
-			wstring sName( L"m_" );
-			sName += iterMember->sName;
-
-			iterMember->sName = sName;
+			if( IsStringMember( *iterMember ) )
+				++numStrings;
+			else
+				numFixedBytes += GetMinMemberSize( *iterMember );
 		}
+		const int minWireSize = numFixedBytes + numStrings * 2;
+		const int maxWireSize = minWireSize + numStrings * 2 * 0xFFFF;
 
 		fwprintf_s( pOutFile, L"\n" );
 		fwprintf_s( pOutFile, L"//-------------------------------------------------------------------------------------------------\n" );
@@ -295,60 +358,149 @@ void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile )
 			fwprintf_s( pOutFile, L"\n" );
 		}
 
-		// Write the constructor
+		// Write the wire sizes
+		fwprintf_s( pOutFile, L"\t/// The fewest bytes the message data takes, with its strings empty\n" );
+		fwprintf_s( pOutFile, L"\tstatic const uint32 MIN_WIRE_SIZE = %d;\n", minWireSize );
+		fwprintf_s( pOutFile, L"\n" );
+		fwprintf_s( pOutFile, L"\t/// The most bytes the message data takes, with its strings as long as they can be\n" );
+		fwprintf_s( pOutFile, L"\tstatic const uint32 MAX_WIRE_SIZE = %d;\n", maxWireSize );
+		fwprintf_s( pOutFile, L"\n" );
+		fwprintf_s( pOutFile, L"\t/// If the message data always takes MIN_WIRE_SIZE bytes\n" );
+		fwprintf_s( pOutFile, L"\tstatic const bool IS_FIXED_SIZE = %s;\n", numStrings == 0 ? L"true" : L"false" );
+		fwprintf_s( pOutFile, L"\n" );
+
+		// Write the constructor, which clears the values
 		fwprintf_s( pOutFile, L"\t/// The default constructor\n" );
-		fwprintf_s( pOutFile, L"\t%s()\n", sClassName.c_str() );
+		fwprintf_s( pOutFile, L"\t%s()", sClassName.c_str() );
+		bool isFirstInit = true;
+		for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
+		{
+			if( IsStringMember( *iterMember ) )
+				continue;
+
+			fwprintf_s( pOutFile, isFirstInit ? L" : " : L",\n\t\t\t\t" );
+			if( iterMember->type == L"bool" )
+				fwprintf_s( pOutFile, L"%s( false )", iterMember->sName.c_str() );
+			else
+				fwprintf_s( pOutFile, L"%s( (%s)0 )", iterMember->sName.c_str(), iterMember->type.c_str() );
+			isFirstInit = false;
+		}
+		fwprintf_s( pOutFile, L"\n" );
 		fwprintf_s( pOutFile, L"\t{\n" );
 		fwprintf_s( pOutFile, L"\t}\n" );
 		fwprintf_s( pOutFile, L"\n" );
 
 
-		// The create message function
-		fwprintf_s( pOutFile, L"\t/// Create this message upon receiving data\n" );
-		fwprintf_s( pOutFile, L"\tstatic NetMsg* CreateMsg( NetDataBlock dataBlock )\n" );
-		fwprintf_s( pOutFile, L"\t{\n" );
-
-		// If this class has no members
-		if( iterMsg->members.size() == 0 )
+		// The wire size function
+		fwprintf_s( pOutFile, L"\t/// Get the number of bytes the message data takes\n" );
+		if( numStrings == 0 )
+			fwprintf_s( pOutFile, L"\tuint32 GetWireSize() const { return MIN_WIRE_SIZE; }\n" );
+		else
 		{
-			fwprintf_s( pOutFile, L"\t\tif( dataBlock.GetRemainingBytes() > 0 )\n" );
-			fwprintf_s( pOutFile, L"\t\t\treturn 0;\n", sClassName.c_str() );
-			fwprintf_s( pOutFile, L"\t\treturn new %s();\n", sClassName.c_str() );
+			fwprintf_s( pOutFile, L"\tuint32 GetWireSize() const\n" );
+			fwprintf_s( pOutFile, L"\t{\n" );
+			fwprintf_s( pOutFile, L"\t\treturn %d", numFixedBytes );
+			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
+			{
+				if( IsStringMember( *iterMember ) )
+					fwprintf_s( pOutFile, L" + NetWire::GetStringSize( %s )", iterMember->sName.c_str() );
+			}
+			fwprintf_s( pOutFile, L";\n" );
+			fwprintf_s( pOutFile, L"\t}\n" );
 		}
+		fwprintf_s( pOutFile, L"\n" );
+
+
+		// The encoding function
+		fwprintf_s( pOutFile, L"\t/// Write a message's data into a buffer, returning the end of the data or NULL if it does not\n\t/// fit\n" );
+		if( iterMsg->members.size() == 0 )
+			fwprintf_s( pOutFile, L"\tstatic uint8* Encode( const %s&, uint8* pOut, uint8* ) { return pOut; }\n", sClassName.c_str() );
 		else
 		{
-			// Go through the members
-			fwprintf_s( pOutFile, L"\t\t// Ensure the data block contains the right amount of data (Calculated during message\n\t\t// generation)\n" );
-			fwprintf_s( pOutFile, L"\t\tif( dataBlock.GetRemainingBytes() < " );
-			int numBytes = 0;
+			fwprintf_s( pOutFile, L"\tstatic uint8* Encode( const %s& msg, uint8* pOut, uint8* pOutEnd )\n", sClassName.c_str() );
+			fwprintf_s( pOutFile, L"\t{\n" );
+			fwprintf_s( pOutFile, L"\t\tif( (uint32)(pOutEnd - pOut) < msg.GetWireSize()" );
 			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
 			{
-				if( iterMember->type == L"std::wstring" )
-					numBytes += 2;
-				else
-					numBytes += iterMember->size / 8;
+				if( IsStringMember( *iterMember ) )
+					fwprintf_s( pOutFile, L"\n\t\t\t|| msg.%s.length() > NetWire::MAX_STRING_CHARS", iterMember->sName.c_str() );
 			}
-			fwprintf_s( pOutFile, L"%d )\n", numBytes );
+			fwprintf_s( pOutFile, L" )\n" );
 			fwprintf_s( pOutFile, L"\t\t\treturn 0;\n" );
 			fwprintf_s( pOutFile, L"\n" );
 
-			fwprintf_s( pOutFile, L"\t\t// Create the new message and fill in the data\n" );
-			fwprintf_s( pOutFile, L"\t\t%s* pNewMsg = new %s();\n", sClassName.c_str(), sClassName.c_str() );
-
 			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
 			{
-				if( iterMember->type == L"std::wstring" )
-					fwprintf_s( pOutFile, L"\t\tpNewMsg->%s = dataBlock.ReadString();", iterMember->sName.c_str() );
+				if( IsStringMember( *iterMember ) )
+					fwprintf_s( pOutFile, L"\t\tNetWire::WriteString( pOut, msg.%s );\n", iterMember->sName.c_str() );
 				else if( iterMember->type == L"bool" )
-					fwprintf_s( pOutFile, L"\t\tpNewMsg->%s = dataBlock.ReadUint8() != 0;", iterMember->sName.c_str() );
+					fwprintf_s( pOutFile, L"\t\tNetWire::WriteUint8( pOut, msg.%s ? 1 : 0 );\n", iterMember->sName.c_str() );
 				else
-					fwprintf_s( pOutFile, L"\t\tpNewMsg->%s = (%s)dataBlock.ReadUint%d();", iterMember->sName.c_str(), iterMember->type.c_str(), iterMember->size );
-				fwprintf_s( pOutFile, L"\n" );
+					fwprintf_s( pOutFile, L"\t\tNetWire::WriteUint%d( pOut, (uint%d)msg.%s );\n", iterMember->size, iterMember->size, iterMember->sName.c_str() );
 			}
+			fwprintf_s( pOutFile, L"\t\treturn pOut;\n" );
+			fwprintf_s( pOutFile, L"\t}\n" );
+		}
+		fwprintf_s( pOutFile, L"\n" );
+
+
+		// The decoding function, which checks the size up to the first string at once and that each
+		// string leaves room for the members after it
+		fwprintf_s( pOutFile, L"\t/// Read a message's data into a message, returning false if the data is bad or is not exactly\n\t/// the message's size\n" );
+		if( iterMsg->members.size() == 0 )
+			fwprintf_s( pOutFile, L"\tstatic bool Decode( %s&, const uint8* pIn, const uint8* pInEnd ) { return pIn == pInEnd; }\n", sClassName.c_str() );
+		else
+		{
+			fwprintf_s( pOutFile, L"\tstatic bool Decode( %s& msg, const uint8* pIn, const uint8* pInEnd )\n", sClassName.c_str() );
+			fwprintf_s( pOutFile, L"\t{\n" );
+			fwprintf_s( pOutFile, L"\t\tif( (uint32)(pInEnd - pIn) < MIN_WIRE_SIZE )\n" );
+			fwprintf_s( pOutFile, L"\t\t\treturn false;\n" );
 			fwprintf_s( pOutFile, L"\n" );
-			fwprintf_s( pOutFile, L"\t\t// Return the message\n" );
-			fwprintf_s( pOutFile, L"\t\treturn pNewMsg;\n" );
+
+			int numBytesLeft = minWireSize;
+			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
+			{
+				numBytesLeft -= GetMinMemberSize( *iterMember );
+				if( IsStringMember( *iterMember ) )
+				{
+					if( numBytesLeft > 0 )
+						fwprintf_s( pOutFile, L"\t\tif( !NetWire::ReadString( pIn, pInEnd - %d, msg.%s ) )\n", numBytesLeft, iterMember->sName.c_str() );
+					else
+						fwprintf_s( pOutFile, L"\t\tif( !NetWire::ReadString( pIn, pInEnd, msg.%s ) )\n", iterMember->sName.c_str() );
+					fwprintf_s( pOutFile, L"\t\t\treturn false;\n" );
+				}
+				else if( iterMember->type == L"bool" )
+					fwprintf_s( pOutFile, L"\t\tmsg.%s = NetWire::ReadUint8( pIn ) != 0;\n", iterMember->sName.c_str() );
+				else
+					fwprintf_s( pOutFile, L"\t\tmsg.%s = (%s)NetWire::ReadUint%d( pIn );\n", iterMember->sName.c_str(), iterMember->type.c_str(), iterMember->size );
+			}
+			fwprintf_s( pOutFile, L"\t\treturn pIn == pInEnd;\n" );
+			fwprintf_s( pOutFile, L"\t}\n" );
 		}
+		fwprintf_s( pOutFile, L"\n" );
+
+
+		// The function to create a message from its pool
+		fwprintf_s( pOutFile, L"\t/// Create this message from its data, returning NULL if the data is bad\n" );
+		fwprintf_s( pOutFile, L"\tstatic NetMsg* DecodeMsg( const uint8* pData, const uint8* pDataEnd )\n" );
+		fwprintf_s( pOutFile, L"\t{\n" );
+		fwprintf_s( pOutFile, L"\t\t// Take a message from the pool and fill in the data, returning it to the pool if the data\n\t\t// is bad\n" );
+		fwprintf_s( pOutFile, L"\t\t%s* pNewMsg = NetMsgPool<%s>::Get().Alloc();\n", sClassName.c_str(), sClassName.c_str() );
+		fwprintf_s( pOutFile, L"\t\tif( !Decode( *pNewMsg, pData, pDataEnd ) )\n" );
+		fwprintf_s( pOutFile, L"\t\t{\n" );
+		fwprintf_s( pOutFile, L"\t\t\tNetMsg::Release( pNewMsg );\n" );
+		fwprintf_s( pOutFile, L"\t\t\treturn 0;\n" );
+		fwprintf_s( pOutFile, L"\t\t}\n" );
+		fwprintf_s( pOutFile, L"\t\treturn pNewMsg;\n" );
+		fwprintf_s( pOutFile, L"\t}\n" );
+		fwprintf_s( pOutFile, L"\n" );
+
+
+		// The create message function
+		fwprintf_s( pOutFile, L"\t/// Create this message upon receiving data\n" );
+		fwprintf_s( pOutFile, L"\tstatic NetMsg* CreateMsg( NetDataBlock dataBlock )\n" );
+		fwprintf_s( pOutFile, L"\t{\n" );
+		fwprintf_s( pOutFile, L"\t\treturn DecodeMsg( dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );\n" );
 		fwprintf_s( pOutFile, L"\t}\n" );
 		fwprintf_s( pOutFile, L"\n" );
 
@@ -361,22 +513,13 @@ void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile )
 		{
 			fwprintf_s( pOutFile, L"\tvirtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const\n" );
 			fwprintf_s( pOutFile, L"\t{\n" );
-			fwprintf_s( pOutFile, L"\t\tuint32 startPos = dataOut.GetCurPosition();\n" );
+			fwprintf_s( pOutFile, L"\t\tuint8* pOut = dataOut.GetCurData();\n" );
+			fwprintf_s( pOutFile, L"\t\tuint8* pOutEnd = Encode( *this, pOut, pOut + dataOut.GetRemainingBytes() );\n" );
+			fwprintf_s( pOutFile, L"\t\tif( !pOutEnd )\n" );
+			fwprintf_s( pOutFile, L"\t\t\tthrow( \"Buffer overflow\" );\n" );
 			fwprintf_s( pOutFile, L"\n" );
-
-			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
-			{
-				if( iterMember->size == 8 )
-					fwprintf_s( pOutFile, L"\t\tdataOut.WriteVal8( (uint8)%s );\n", iterMember->sName.c_str() );
-				else if( iterMember->size == 16 )
-					fwprintf_s( pOutFile, L"\t\tdataOut.WriteVal16( (uint16)%s );\n", iterMember->sName.c_str() );
-				else if( iterMember->size == 32 )
-					fwprintf_s( pOutFile, L"\t\tdataOut.WriteVal32( (uint32)%s );\n", iterMember->sName.c_str() );
-				else if( iterMember->type == L"std::wstring" )
-					fwprintf_s( pOutFile, L"\t\tdataOut.WriteString( %s );\n", iterMember->sName.c_str() );
-			}
-			fwprintf_s( pOutFile, L"\n" );
-			fwprintf_s( pOutFile, L"\t\treturn dataOut.GetCurPosition() - startPos;\n" );
+			fwprintf_s( pOutFile, L"\t\tdataOut.Skip( (uint32)(pOutEnd - pOut) );\n" );
+			fwprintf_s( pOutFile, L"\t\treturn (uint32)(pOutEnd - pOut);\n" );
 			fwprintf_s( pOutFile, L"\t}\n" );
 		}
 		fwprintf_s( pOutFile, L"\n" );
@@ -385,6 +528,9 @@ void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile )
 		// The message ID accessor
 		fwprintf_s( pOutFile, L"\t/// Get the message type ID\n" );
 		fwprintf_s( pOutFile, L"\tvirtual uint16 GetMsgTypeID() const { return GNMI_%s; }\n", iterMsg->sName.c_str() );
+		fwprintf_s( pOutFile, L"\n" );
+		fwprintf_s( pOutFile, L"\t/// Get the message family ID\n" );
+		fwprintf_s( pOutFile, L"\tvirtual uint32 GetMsgFamilyID() const { return GAME_NET_MSG_FAMILY_ID; }\n" );
 
 
 		// Close the class
@@ -392,6 +538,166 @@ void ExportTemplates( NetMsgList& msgTemplates, const wchar_t* szOutFile )
 		fwprintf_s( pOutFile, L"\n" );
 	}
 
+	// Generate the encoding switch
+	fwprintf_s( pOutFile, L"\n" );
+	fwprintf_s( pOutFile, L"/// Write the data of a game message into a buffer, returning the end of the data or NULL if the\n" );
+	fwprintf_s( pOutFile, L"/// message is not the game message the ID is for or the data does not fit\n" );
+	fwprintf_s( pOutFile, L"inline uint8* EncodeGameNetMsg( uint16 msgID, const NetMsg& msg, uint8* pOut, uint8* pOutEnd )\n" );
+	fwprintf_s( pOutFile, L"{\n" );
+	fwprintf_s( pOutFile, L"\t// Check the message's type before it is cast to it\n" );
+	fwprintf_s( pOutFile, L"\tif( msg.GetMsgFamilyID() != GAME_NET_MSG_FAMILY_ID || msg.GetMsgTypeID() != msgID )\n" );
+	fwprintf_s( pOutFile, L"\t\treturn 0;\n" );
+	fwprintf_s( pOutFile, L"\n" );
+	fwprintf_s( pOutFile, L"\tswitch( msgID )\n" );
+	fwprintf_s( pOutFile, L"\t{\n" );
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+	{
+		fwprintf_s( pOutFile, L"\tcase GNMI_%s:\n", iterMsg->sName.c_str() );
+		fwprintf_s( pOutFile, L"\t\treturn NetMsg%s::Encode( static_cast<const NetMsg%s&>( msg ), pOut, pOutEnd );\n", iterMsg->sName.c_str(), iterMsg->sName.c_str() );
+	}
+	fwprintf_s( pOutFile, L"\tdefault:\n" );
+	fwprintf_s( pOutFile, L"\t\tbreak;\n" );
+	fwprintf_s( pOutFile, L"\t}\n" );
+	fwprintf_s( pOutFile, L"\treturn 0;\n" );
+	fwprintf_s( pOutFile, L"}\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
+	// Generate the decoding switch
+	fwprintf_s( pOutFile, L"/// Create a game message from its data, returning NULL if the ID is not a game message's or the\n" );
+	fwprintf_s( pOutFile, L"/// data is bad\n" );
+	fwprintf_s( pOutFile, L"inline NetMsg* DecodeGameNetMsg( uint16 msgID, const uint8* pData, const uint8* pDataEnd )\n" );
+	fwprintf_s( pOutFile, L"{\n" );
+	fwprintf_s( pOutFile, L"\tswitch( msgID )\n" );
+	fwprintf_s( pOutFile, L"\t{\n" );
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+	{
+		fwprintf_s( pOutFile, L"\tcase GNMI_%s:\n", iterMsg->sName.c_str() );
+		fwprintf_s( pOutFile, L"\t\treturn NetMsg%s::DecodeMsg( pData, pDataEnd );\n", iterMsg->sName.c_str() );
+	}
+	fwprintf_s( pOutFile, L"\tdefault:\n" );
+	fwprintf_s( pOutFile, L"\t\tbreak;\n" );
+	fwprintf_s( pOutFile, L"\t}\n" );
+	fwprintf_s( pOutFile, L"\treturn 0;\n" );
+	fwprintf_s( pOutFile, L"}\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
+	// Generate the registration code
+	fwprintf_s( pOutFile, L"/// Register the game messages so the network manager encodes and decodes them with the switches\n" );
+	fwprintf_s( pOutFile, L"inline void RegisterGameNetMsgs()\n" );
+	fwprintf_s( pOutFile, L"{\n" );
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+		fwprintf_s( pOutFile, L"\tNetworkMgr::Get().RegisterNetMsg( GNMI_%s, NetMsg%s::CreateMsg, EncodeGameNetMsg, DecodeGameNetMsg );\n", iterMsg->sName.c_str(), iterMsg->sName.c_str() );
+	fwprintf_s( pOutFile, L"}\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
 	// Close the file
 	fwprintf_s( pOutFile, L"#endif // __GameNetMsgs_h" );
-}
\ No newline at end of file
+	fclose( pOutFile );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	ExportChecks  Global
+///
+///	\param msgTemplates The list of network message templates
+///	\param szOutFile The output file path
+///
+///	Export the functions that fill in each message with random data and compare messages, and
+///	the functions that run the round trip checks, fuzzing and benchmark from NetMsgCheck.h over
+///	every message.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ExportChecks( const NetMsgList& msgTemplates, const wchar_t* szOutFile )
+{
+	FILE* pOutFile = 0;
+	if( _wfopen_s( &pOutFile, szOutFile, L"w" ) != 0 )
+		return;
+
+	ExportHeaderStart( pOutFile, L"GameNetMsgsCheck.h", L"Auto-Generated Game Network Message Check Header", L"GameNetMsgsCheck",
+						L"the checks and benchmark of the game network message encoding" );
+	fwprintf_s( pOutFile, L"#include \"GameNetMsgs.h\"\n" );
+	fwprintf_s( pOutFile, L"#include \"Network/NetMsgCheck.h\"\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+	{
+		wstring sClassName( L"NetMsg" );
+		sClassName += iterMsg->sName;
+
+		// The function to fill in a message with random data
+		fwprintf_s( pOutFile, L"\n" );
+		fwprintf_s( pOutFile, L"/// Fill in a %s with random data\n", sClassName.c_str() );
+		if( iterMsg->members.size() == 0 )
+			fwprintf_s( pOutFile, L"inline void RandomizeNetMsg( %s&, TCBase::RandomGen& ) {}\n", sClassName.c_str() );
+		else
+		{
+			fwprintf_s( pOutFile, L"inline void RandomizeNetMsg( %s& msg, TCBase::RandomGen& randGen )\n", sClassName.c_str() );
+			fwprintf_s( pOutFile, L"{\n" );
+			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
+			{
+				if( IsStringMember( *iterMember ) )
+					fwprintf_s( pOutFile, L"\tRandomizeNetMsgString( msg.%s, randGen );\n", iterMember->sName.c_str() );
+				else if( iterMember->type == L"bool" )
+					fwprintf_s( pOutFile, L"\tmsg.%s = randGen.Chance( 50 );\n", iterMember->sName.c_str() );
+				else
+					fwprintf_s( pOutFile, L"\tmsg.%s = (%s)(randGen.NextUInt32() & %s);\n", iterMember->sName.c_str(), iterMember->type.c_str(), GetMemberMask( *iterMember ) );
+			}
+			fwprintf_s( pOutFile, L"}\n" );
+		}
+		fwprintf_s( pOutFile, L"\n" );
+
+		// The function to compare messages
+		fwprintf_s( pOutFile, L"/// Compare the data of two %s messages\n", sClassName.c_str() );
+		if( iterMsg->members.size() == 0 )
+			fwprintf_s( pOutFile, L"inline bool AreNetMsgsEqual( const %s&, const %s& ) { return true; }\n", sClassName.c_str(), sClassName.c_str() );
+		else
+		{
+			fwprintf_s( pOutFile, L"inline bool AreNetMsgsEqual( const %s& msg1, const %s& msg2 )\n", sClassName.c_str(), sClassName.c_str() );
+			fwprintf_s( pOutFile, L"{\n" );
+			for( MsgMemberList::const_iterator iterMember = iterMsg->members.begin(); iterMember != iterMsg->members.end(); ++iterMember )
+			{
+				fwprintf_s( pOutFile, iterMember == iterMsg->members.begin() ? L"\treturn " : L"\n\t\t&& " );
+				fwprintf_s( pOutFile, L"msg1.%s == msg2.%s", iterMember->sName.c_str(), iterMember->sName.c_str() );
+			}
+			fwprintf_s( pOutFile, L";\n" );
+			fwprintf_s( pOutFile, L"}\n" );
+		}
+	}
+	fwprintf_s( pOutFile, L"\n" );
+
+	// The function to run the checks
+	fwprintf_s( pOutFile, L"\n" );
+	fwprintf_s( pOutFile, L"/// Check that every game message decodes to the message it was encoded from and that bad data is\n" );
+	fwprintf_s( pOutFile, L"/// rejected, returning the number of failed checks\n" );
+	fwprintf_s( pOutFile, L"inline uint32 CheckGameNetMsgs( uint64 seed, uint32 numIterations )\n" );
+	fwprintf_s( pOutFile, L"{\n" );
+	fwprintf_s( pOutFile, L"\tTCBase::RandomGen randGen( seed );\n" );
+	fwprintf_s( pOutFile, L"\tuint32 numFailures = 0;\n" );
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+	{
+		const wchar_t* szName = iterMsg->sName.c_str();
+		fwprintf_s( pOutFile, L"\tnumFailures += NetMsgChecker<NetMsg%s>::CheckRoundTrips( L\"%s\", GNMI_%s, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );\n", szName, szName, szName );
+		fwprintf_s( pOutFile, L"\tnumFailures += NetMsgChecker<NetMsg%s>::Fuzz( L\"%s\", GNMI_%s, DecodeGameNetMsg, randGen, numIterations );\n", szName, szName, szName );
+	}
+	fwprintf_s( pOutFile, L"\treturn numFailures;\n" );
+	fwprintf_s( pOutFile, L"}\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
+	// The function to run the benchmark
+	fwprintf_s( pOutFile, L"/// Measure encoding and decoding every game message and log the times\n" );
+	fwprintf_s( pOutFile, L"inline void BenchmarkGameNetMsgs( uint64 seed, uint32 numIterations )\n" );
+	fwprintf_s( pOutFile, L"{\n" );
+	fwprintf_s( pOutFile, L"\tTCBase::RandomGen randGen( seed );\n" );
+	for( NetMsgList::const_iterator iterMsg = msgTemplates.begin(); iterMsg != msgTemplates.end(); ++iterMsg )
+	{
+		const wchar_t* szName = iterMsg->sName.c_str();
+		fwprintf_s( pOutFile, L"\tNetMsgChecker<NetMsg%s>::Benchmark( L\"%s\", GNMI_%s, EncodeGameNetMsg, DecodeGameNetMsg, randGen, numIterations );\n", szName, szName, szName );
+	}
+	fwprintf_s( pOutFile, L"}\n" );
+	fwprintf_s( pOutFile, L"\n" );
+
+	// Close the file
+	fwprintf_s( pOutFile, L"#endif // __GameNetMsgsCheck_h" );
+	fclose( pOutFile );
+}
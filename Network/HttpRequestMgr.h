@@ -16,6 +16,7 @@
 
 #include "Base/Types.h"
 #include <string>
+#include <string.h>
 #include "Base/StringFuncs.h"
 
 struct ReadBuffer
@@ -45,6 +45,9 @@ public:
 	/// Receive data waiting on the queue into a message
 	virtual void ReceiveData();
 
+	/// Receive a message when the receiving socket is ready
+	virtual void HandleSocketEvent( const NetEvent& netEvent );
+
 	/// Prevent or allow incoming messages
 	void SetAllowReceive( bool allowReceive );
 
@@ -74,6 +74,9 @@ public:
 	/// Receive any data that might be waiting on the socket
 	virtual void ReceiveData();
 
+	/// Accept the connection, receive messages or send waiting batches when the socket is ready
+	virtual void HandleSocketEvent( const NetEvent& netEvent );
+
 	/// Determine if the connection is valid
 	virtual bool IsValid() const;
 };
@@ -81,6 +81,9 @@ public:
 	/// Retrieve a character
 	std::wstring ReadString();
 
+	/// Retrieve a string into an existing string, reusing its memory
+	void ReadString( std::wstring& str );
+
 	/// Get the size of the data block
 	uint32 GetSize() const { return m_DataLen; }
 
@@ -89,6 +92,9 @@ public:
 
 	/// Get the remaining bytes left
 	uint32 GetRemainingBytes() const { return m_DataLen - m_CurByteOffset; }
+
+	/// Get the data at the current position, to decode the remaining bytes directly
+	const uint8* GetCurData() const { return m_pDataStart + m_CurByteOffset; }
 };
 
 #endif // __NetDataBlock_h
\ No newline at end of file
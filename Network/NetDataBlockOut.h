@@ -90,6 +90,18 @@ public:
 
 	/// Get the remaining bytes left
 	uint32 GetRemainingBytes() const { return m_DataLen - m_CurByteOffset; }
+
+	/// Get the memory at the current position, to encode a message directly into the block
+	uint8* GetCurData() const { return (uint8*)(m_pDataStart + m_CurByteOffset); }
+
+	/// Step ahead past data that was written directly into the block
+	void Skip( uint32 numBytes )
+	{
+		if( (m_CurByteOffset + numBytes) > m_DataLen )
+			throw( "Buffer overflow" );
+
+		m_CurByteOffset += numBytes;
+	}
 };
 
 #endif // __NetDataBlockOut_h
\ No newline at end of file
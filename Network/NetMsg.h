@@ -20,6 +20,8 @@
 #include "NetDataBlockOut.h"
 #include "IPAddress.h"
 
+class NetMsgPoolBase;
+
 
 //-------------------------------------------------------------------------------------------------
 /*!
@@ -31,6 +33,11 @@ class NetMsg
 {
 public:
 
+	/// The default constructor
+	NetMsg() : m_SenderPort( 0 ),
+				m_pPool( 0 )
+	{}
+
 	/// The default destructor
 	virtual ~NetMsg(){}
 
@@ -40,11 +47,40 @@ public:
 	/// The port of the sender of this message
 	uint16 m_SenderPort;
 
+	/// The pool this message was taken from, NULL if it was not taken from a pool
+	NetMsgPoolBase* m_pPool;
+
+	/// Return a received message to its pool, or free it if it was not taken from one
+	static void Release( NetMsg* pMsg );
+
 	/// Fill in a buffer with the message data
 	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const = 0;
 
 	/// Get the message type ID
 	virtual uint16 GetMsgTypeID() const = 0;
+
+	/// Get the ID of the set of message types this type belongs to, 0 if it is not in a set. A
+	/// set's encode function checks this before treating a message as one of its types, since the
+	/// type IDs of different sets can overlap.
+	virtual uint32 GetMsgFamilyID() const { return 0; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgHandler
+	\brief The interface for the objects received messages are handed to
+*/
+//-------------------------------------------------------------------------------------------------
+class NetMsgHandler
+{
+public:
+
+	/// The default destructor
+	virtual ~NetMsgHandler(){}
+
+	/// Handle a received message, which is released after this returns
+	virtual void HandleNetMsg( const NetMsg& msg ) = 0;
 };
 
 #endif // __NetMsg_h
\ No newline at end of file
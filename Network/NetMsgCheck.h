@@ -0,0 +1,291 @@
+//=================================================================================================
+/*!
+	\file NetMsgCheck.h
+	Network Library
+	Network Message Check Header
+	\author agent
+	\date October 19, 2026
+
+	This file contains the definition for the checks and benchmark of the generated message
+	encoding.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __NetMsgCheck_h
+#define __NetMsgCheck_h
+
+#include "Base/Types.h"
+#include "Base/RandomGen.h"
+#include "Base/ProfileTimer.h"
+#include "Base/MsgLogger.h"
+#include "NetMsg.h"
+#include "NetworkMgr.h"
+#include <string.h>
+#include <vector>
+
+
+/// Fill in a string with random characters, used to fill in messages with random data
+inline void RandomizeNetMsgString( std::wstring& str, TCBase::RandomGen& randGen )
+{
+	str.resize( randGen.NextBelow( 33 ) );
+	for( uint32 charIndex = 0; charIndex < str.length(); ++charIndex )
+		str[ charIndex ] = (wchar_t)(randGen.NextUInt32() & 0xFFFF);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgChecker
+	\brief Checks and measures the encoding NetMsgGen generates for a message type.
+
+	The message type must have the members NetMsgGen generates, and a RandomizeNetMsg function to
+	fill in a message with random data and an AreNetMsgsEqual function to compare two messages
+	must be declared for it, which NetMsgGen also generates. The checks log each failure and
+	return the number of them.
+*/
+//-------------------------------------------------------------------------------------------------
+template< class T >
+class NetMsgChecker
+{
+private:
+
+	/// Log a failed check
+	static void ReportFailure( const wchar_t* szName, const wchar_t* szReason, uint32& numFailures )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"%s message check failed: %s", szName, szReason );
+		++numFailures;
+	}
+
+	/// Get the start of a buffer, NULL if it is empty
+	static uint8* GetData( std::vector<uint8>& buffer ) { return buffer.empty() ? 0 : &buffer[0]; }
+
+public:
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//  NetMsgChecker::CheckRoundTrips  Public
+	///
+	///	\param szName The name of the message type to log
+	///	\param msgID The message type's ID
+	///	\param pEncodeFunc The generated switch that encodes every message type
+	///	\param pDecodeFunc The generated switch that decodes every message type
+	///	\param randGen The generator for the message data
+	///	\param numIterations The number of random messages to check
+	///	\returns The number of failed checks
+	///
+	///	Check that random messages encode to their wire size the same way through every path and
+	///	decode back to the same message, and that encoding into a buffer that is too small and
+	///	decoding data that is cut short or too long fail.
+	///
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	static uint32 CheckRoundTrips( const wchar_t* szName, uint16 msgID, MsgEncodeFunc pEncodeFunc, MsgDecodeFunc pDecodeFunc, TCBase::RandomGen& randGen, uint32 numIterations )
+	{
+		uint32 numFailures = 0;
+		T msg, decodedMsg;
+		std::vector<uint8> buffer;
+		for( uint32 iterIndex = 0; iterIndex < numIterations; ++iterIndex )
+		{
+			RandomizeNetMsg( msg, randGen );
+
+			const uint32 wireSize = msg.GetWireSize();
+			if( wireSize < T::MIN_WIRE_SIZE || wireSize > T::MAX_WIRE_SIZE || (T::IS_FIXED_SIZE && wireSize != T::MIN_WIRE_SIZE) )
+			{
+				ReportFailure( szName, L"The wire size is outside of the generated limits", numFailures );
+				continue;
+			}
+
+			// Encode into the first half of the buffer and compare the other encodings against it
+			buffer.assign( wireSize * 2 + 1, 0 );
+			uint8* pBuffer = GetData( buffer );
+			if( wireSize > 0 && T::Encode( msg, pBuffer, pBuffer + wireSize - 1 ) )
+				ReportFailure( szName, L"Encoded into a buffer that is too small", numFailures );
+			if( T::Encode( msg, pBuffer, pBuffer + wireSize ) != pBuffer + wireSize )
+			{
+				ReportFailure( szName, L"The encoded size does not match the wire size", numFailures );
+				continue;
+			}
+
+			if( pEncodeFunc( msgID, msg, pBuffer + wireSize, pBuffer + wireSize * 2 ) != pBuffer + wireSize * 2
+				|| memcmp( pBuffer, pBuffer + wireSize, wireSize ) != 0 )
+				ReportFailure( szName, L"The encoding switch wrote different data", numFailures );
+
+			memset( pBuffer + wireSize, 0, wireSize );
+			NetDataBlockOut dataOut( pBuffer + wireSize, wireSize );
+			try
+			{
+				const NetMsg& baseMsg = msg;
+				if( baseMsg.StoreInBuffer( dataOut ) != wireSize || memcmp( pBuffer, pBuffer + wireSize, wireSize ) != 0 )
+					ReportFailure( szName, L"StoreInBuffer wrote different data", numFailures );
+			}
+			catch( ... )
+			{
+				ReportFailure( szName, L"StoreInBuffer overflowed", numFailures );
+			}
+
+			// Decode the message back, and check that the decoding only accepts the exact data
+			if( !T::Decode( decodedMsg, pBuffer, pBuffer + wireSize ) || !AreNetMsgsEqual( msg, decodedMsg ) )
+				ReportFailure( szName, L"The decoded message does not match", numFailures );
+			for( uint32 dataLen = 0; dataLen < wireSize; ++dataLen )
+			{
+				if( T::Decode( decodedMsg, pBuffer, pBuffer + dataLen ) )
+				{
+					ReportFailure( szName, L"Decoded a message from data that was cut short", numFailures );
+					break;
+				}
+			}
+			if( T::Decode( decodedMsg, pBuffer, pBuffer + wireSize + 1 ) )
+				ReportFailure( szName, L"Decoded a message from data that was too long", numFailures );
+
+			NetMsg* pNewMsg = pDecodeFunc( msgID, pBuffer, pBuffer + wireSize );
+			if( !pNewMsg || pNewMsg->GetMsgTypeID() != msgID || !AreNetMsgsEqual( msg, static_cast<const T&>( *pNewMsg ) ) )
+				ReportFailure( szName, L"The decoding switch created a different message", numFailures );
+			NetMsg::Release( pNewMsg );
+		}
+
+		return numFailures;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//  NetMsgChecker::Fuzz  Public
+	///
+	///	\param szName The name of the message type to log
+	///	\param msgID The message type's ID
+	///	\param pDecodeFunc The generated switch that decodes every message type
+	///	\param randGen The generator for the data
+	///	\param numIterations The number of blocks of data to decode
+	///	\returns The number of failed checks
+	///
+	///	Decode random data and encoded messages with bytes changed, cut short or extended. The data
+	///	is held in a buffer of exactly its size so a memory checker catches reads past the end.
+	///	Data that decodes must encode back to the same number of bytes and decode to the same
+	///	message, and the decoding switch must accept the same data as the message's decoding.
+	///
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	static uint32 Fuzz( const wchar_t* szName, uint16 msgID, MsgDecodeFunc pDecodeFunc, TCBase::RandomGen& randGen, uint32 numIterations )
+	{
+		uint32 numFailures = 0;
+		T msg, decodedMsg, redecodedMsg;
+		std::vector<uint8> data, reencodedData;
+		for( uint32 iterIndex = 0; iterIndex < numIterations; ++iterIndex )
+		{
+			if( randGen.Chance( 50 ) )
+			{
+				data.resize( randGen.NextBelow( T::MIN_WIRE_SIZE + 64 ) );
+				for( uint32 byteIndex = 0; byteIndex < data.size(); ++byteIndex )
+					data[ byteIndex ] = (uint8)randGen.NextUInt32();
+			}
+			else
+			{
+				RandomizeNetMsg( msg, randGen );
+				data.resize( msg.GetWireSize() );
+				T::Encode( msg, GetData( data ), GetData( data ) + data.size() );
+
+				const uint32 numChanges = data.empty() ? 0 : randGen.NextBelow( 4 );
+				for( uint32 changeIndex = 0; changeIndex < numChanges; ++changeIndex )
+					data[ randGen.NextBelow( (uint32)data.size() ) ] = (uint8)randGen.NextUInt32();
+				if( randGen.Chance( 25 ) )
+					data.resize( randGen.NextBelow( (uint32)data.size() + 4 ) );
+			}
+
+			const uint8* pData = GetData( data );
+			const uint8* pDataEnd = pData + data.size();
+			const bool decoded = T::Decode( decodedMsg, pData, pDataEnd );
+
+			NetMsg* pNewMsg = pDecodeFunc( msgID, pData, pDataEnd );
+			if( (pNewMsg != 0) != decoded )
+				ReportFailure( szName, L"The decoding switch disagrees with the message's decoding", numFailures );
+			NetMsg::Release( pNewMsg );
+
+			// Any message ID must be handled, known or not
+			NetMsg::Release( pDecodeFunc( (uint16)randGen.NextUInt32(), pData, pDataEnd ) );
+
+			if( !decoded )
+				continue;
+
+			reencodedData.resize( decodedMsg.GetWireSize() + 1 );
+			uint8* pOut = GetData( reencodedData );
+			uint8* pOutEnd = T::Encode( decodedMsg, pOut, pOut + reencodedData.size() - 1 );
+			if( !pOutEnd || (uint32)(pOutEnd - pOut) != data.size()
+				|| !T::Decode( redecodedMsg, pOut, pOutEnd ) || !AreNetMsgsEqual( decodedMsg, redecodedMsg ) )
+				ReportFailure( szName, L"Decoded data did not encode back to the same message", numFailures );
+		}
+
+		return numFailures;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//  NetMsgChecker::Benchmark  Public
+	///
+	///	\param szName The name of the message type to log
+	///	\param msgID The message type's ID
+	///	\param pEncodeFunc The generated switch that encodes every message type
+	///	\param pDecodeFunc The generated switch that decodes every message type
+	///	\param randGen The generator for the message data
+	///	\param numIterations The number of times to encode and decode the message each way
+	///
+	///	Measure encoding and decoding a random message directly and through the generated
+	///	switches, which is how the network manager handles it, and log the times.
+	///
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	static void Benchmark( const wchar_t* szName, uint16 msgID, MsgEncodeFunc pEncodeFunc, MsgDecodeFunc pDecodeFunc, TCBase::RandomGen& randGen, uint32 numIterations )
+	{
+		T msg, decodedMsg;
+		RandomizeNetMsg( msg, randGen );
+		const uint32 wireSize = msg.GetWireSize();
+		std::vector<uint8> buffer( wireSize + 1 );
+
+		// The buffer is reached through a volatile pointer so the repeated work is not optimized
+		// away
+		uint8* volatile pVolatileBuffer = GetData( buffer );
+		uint32 checkSum = 0;
+		if( numIterations == 0 )
+			numIterations = 1;
+
+		uint64 startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+		for( uint32 iterIndex = 0; iterIndex < numIterations; ++iterIndex )
+		{
+			uint8* pBuffer = pVolatileBuffer;
+			checkSum += (uint32)(T::Encode( msg, pBuffer, pBuffer + wireSize ) - pBuffer);
+		}
+		const uint64 encodeTime = TCBase::ProfileTimer::GetTimeNanosecs() - startTime;
+
+		startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+		for( uint32 iterIndex = 0; iterIndex < numIterations; ++iterIndex )
+		{
+			uint8* pBuffer = pVolatileBuffer;
+			checkSum += (uint32)(pEncodeFunc( msgID, msg, pBuffer, pBuffer + wireSize ) - pBuffer);
+		}
+		const uint64 switchEncodeTime = TCBase::ProfileTimer::GetTimeNanosecs() - startTime;
+
+		startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+		for( uint32 iterIndex = 0; iterIndex < numIterations; ++iterIndex )
+		{
+			const uint8* pBuffer = pVolatileBuffer;
+			if( T::Decode( decodedMsg, pBuffer, pBuffer + wireSize ) )
+				checkSum += decodedMsg.GetWireSize();
+		}
+		const uint64 decodeTime = TCBase::ProfileTimer::GetTimeNanosecs() - startTime;
+
+		startTime = TCBase::ProfileTimer::GetTimeNanosecs();
+		for( uint32 iterIndex = 0; iterIndex < numIterations; ++iterIndex )
+		{
+			const uint8* pBuffer = pVolatileBuffer;
+			NetMsg* pNewMsg = pDecodeFunc( msgID, pBuffer, pBuffer + wireSize );
+			if( pNewMsg )
+				checkSum += pNewMsg->GetMsgTypeID();
+			NetMsg::Release( pNewMsg );
+		}
+		const uint64 switchDecodeTime = TCBase::ProfileTimer::GetTimeNanosecs() - startTime;
+
+		const float64 numMsgs = (float64)numIterations;
+		const float64 encodeMBPerSec = encodeTime > 0 ? ((float64)wireSize * numMsgs * 1000.0) / (float64)encodeTime : 0.0;
+		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"%s (%u bytes): encode %.1f ns, switch encode %.1f ns, decode %.1f ns, switch decode %.1f ns per message, %.0f MB/s encoded (check %u)",
+						szName, wireSize, (float64)encodeTime / numMsgs, (float64)switchEncodeTime / numMsgs,
+						(float64)decodeTime / numMsgs, (float64)switchDecodeTime / numMsgs, encodeMBPerSec, checkSum );
+	}
+};
+
+#endif // __NetMsgCheck_h
@@ -0,0 +1,125 @@
+//=================================================================================================
+/*!
+	\file NetMsgPool.h
+	Network Library
+	Network Message Pool Header
+	\author agent
+	\date October 19, 2026
+
+	This file contains the definition for the pools that received network messages are taken from
+	and returned to.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __NetMsgPool_h
+#define __NetMsgPool_h
+
+#include "Base/Types.h"
+#include "Base/CriticalSection.h"
+#include "NetMsg.h"
+#include <vector>
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgPoolBase
+	\brief The base class for the message pools so a message can be returned to its pool without
+			knowing its type.
+*/
+//-------------------------------------------------------------------------------------------------
+class NetMsgPoolBase
+{
+protected:
+
+	/// The number of messages the pools have allocated
+	static uint32 s_NumMsgsAllocated;
+
+public:
+
+	/// The destructor
+	virtual ~NetMsgPoolBase() {}
+
+	/// Return a message to the pool
+	virtual void Recycle( NetMsg* pMsg ) = 0;
+
+	/// Get the number of messages the pools have allocated, to measure how often decoding allocates
+	static uint32 GetNumMsgsAllocated() { return s_NumMsgsAllocated; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgPool
+	\brief The pool of one type of message.
+
+	A message type's CreateMsg takes its message from the pool, and NetMsg::Release returns it
+	once it has been handled. The messages are kept whole, so the members holding memory, such as
+	strings, keep it for the next message decoded into them and a steady stream of messages does
+	not allocate. Messages are taken on the network update thread and returned on the thread that
+	handles them, so the pool is locked. This class follows the singleton pattern for each type.
+*/
+//-------------------------------------------------------------------------------------------------
+template< class T >
+class NetMsgPool : public NetMsgPoolBase
+{
+private:
+
+	/// The messages waiting to be used
+	std::vector<T*> m_FreeMsgs;
+
+	/// The lock for the free messages
+	TCBase::CriticalSection m_Lock;
+
+	/// The default constructor, private since this class follows the singleton pattern
+	NetMsgPool() {}
+
+public:
+
+	/// Get the pool for this message type
+	static NetMsgPool& Get()
+	{
+		static NetMsgPool s_Pool;
+		return s_Pool;
+	}
+
+	/// The destructor, frees the waiting messages
+	virtual ~NetMsgPool()
+	{
+		for( uint32 msgIndex = 0; msgIndex < m_FreeMsgs.size(); ++msgIndex )
+			delete m_FreeMsgs[ msgIndex ];
+		m_FreeMsgs.clear();
+	}
+
+	/// Take a message from the pool, allocating one if none are waiting
+	T* Alloc()
+	{
+		m_Lock.Enter();
+		T* pMsg = 0;
+		if( !m_FreeMsgs.empty() )
+		{
+			pMsg = m_FreeMsgs.back();
+			m_FreeMsgs.pop_back();
+		}
+		else
+			++s_NumMsgsAllocated;
+		m_Lock.Leave();
+
+		if( !pMsg )
+		{
+			pMsg = new T();
+			pMsg->m_pPool = this;
+		}
+		return pMsg;
+	}
+
+	/// Return a message to the pool
+	virtual void Recycle( NetMsg* pMsg )
+	{
+		m_Lock.Enter();
+		m_FreeMsgs.push_back( static_cast<T*>( pMsg ) );
+		m_Lock.Leave();
+	}
+};
+
+#endif // __NetMsgPool_h
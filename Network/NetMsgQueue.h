@@ -0,0 +1,77 @@
+//=================================================================================================
+/*!
+	\file NetMsgQueue.h
+	Network Library
+	Network Message Queue Header
+	\author agent
+	\date October 19, 2026
+
+	This file contains the definition for the queue of received network messages.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __NetMsgQueue_h
+#define __NetMsgQueue_h
+
+#include "Base/Types.h"
+#include <list>
+
+class NetMsg;
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetMsgQueue
+	\brief A first-in, first-out queue of messages held in a fixed-capacity ring.
+
+	Queueing a message into the ring does not allocate. If the messages are not handled as fast as
+	they arrive and the ring fills, the newer messages wait in an overflow list until there is
+	room, so no message is lost.
+*/
+//-------------------------------------------------------------------------------------------------
+class NetMsgQueue
+{
+public:
+
+	/// The number of messages the ring holds
+	static const uint32 RING_CAPACITY = 256;
+
+private:
+
+	/// The ring of messages
+	NetMsg* m_Ring[ RING_CAPACITY ];
+
+	/// The index of the oldest message in the ring
+	uint32 m_Head;
+
+	/// The number of messages in the ring
+	uint32 m_Count;
+
+	/// The messages that arrived while the ring was full, the oldest first
+	std::list<NetMsg*> m_Overflow;
+
+public:
+
+	/// The default constructor
+	NetMsgQueue() : m_Head( 0 ),
+					m_Count( 0 )
+	{}
+
+	/// The destructor, releases the queued messages
+	~NetMsgQueue() { Clear(); }
+
+	/// Add a message to the end of the queue
+	void Push( NetMsg* pMsg );
+
+	/// Remove the message at the front of the queue, NULL if the queue is empty
+	NetMsg* Pop();
+
+	/// Release every queued message
+	void Clear();
+
+	/// Get if the queue is empty
+	bool IsEmpty() const { return m_Count == 0; }
+};
+
+#endif // __NetMsgQueue_h
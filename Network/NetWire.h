@@ -0,0 +1,117 @@
+//=================================================================================================
+/*!
+	\file NetWire.h
+	Network Library
+	Network Wire Format Header
+	\author agent
+	\date October 19, 2026
+
+	This file contains the functions that write values to and read values from message data in
+	the network byte order.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __NetWire_h
+#define __NetWire_h
+
+#include "Base/Types.h"
+#include <string>
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\namespace NetWire
+	\brief The functions used by the generated message encoding.
+
+	The values are stored in the same format as NetDataBlockOut writes them, with the most
+	significant byte first and strings stored as a 16-bit character count followed by 16-bit
+	characters. The functions do not check the buffer size, the generated code checks the size
+	of a whole message once before writing or reading its members. The pointer passed in is
+	stepped ahead past the value.
+*/
+//-------------------------------------------------------------------------------------------------
+namespace NetWire
+{
+	/// The most characters a string can have
+	static const uint32 MAX_STRING_CHARS = 0xFFFF;
+
+	/// Write out an 8-bit value
+	inline void WriteUint8( uint8*& pOut, uint8 val )
+	{
+		*pOut++ = val;
+	}
+
+	/// Write out a 16-bit value
+	inline void WriteUint16( uint8*& pOut, uint16 val )
+	{
+		pOut[0] = (uint8)(val >> 8);
+		pOut[1] = (uint8)val;
+		pOut += 2;
+	}
+
+	/// Write out a 32-bit value
+	inline void WriteUint32( uint8*& pOut, uint32 val )
+	{
+		pOut[0] = (uint8)(val >> 24);
+		pOut[1] = (uint8)(val >> 16);
+		pOut[2] = (uint8)(val >> 8);
+		pOut[3] = (uint8)val;
+		pOut += 4;
+	}
+
+	/// Read an 8-bit value
+	inline uint8 ReadUint8( const uint8*& pIn )
+	{
+		return *pIn++;
+	}
+
+	/// Read a 16-bit value
+	inline uint16 ReadUint16( const uint8*& pIn )
+	{
+		const uint16 retVal = (uint16)( ((uint16)pIn[0] << 8) | (uint16)pIn[1] );
+		pIn += 2;
+		return retVal;
+	}
+
+	/// Read a 32-bit value
+	inline uint32 ReadUint32( const uint8*& pIn )
+	{
+		const uint32 retVal = ((uint32)pIn[0] << 24) | ((uint32)pIn[1] << 16) | ((uint32)pIn[2] << 8) | (uint32)pIn[3];
+		pIn += 4;
+		return retVal;
+	}
+
+	/// Get the number of bytes a string takes, including its character count
+	inline uint32 GetStringSize( const std::wstring& str )
+	{
+		return sizeof(uint16) + (uint32)str.length() * sizeof(uint16);
+	}
+
+	/// Write out a string, which must have no more than MAX_STRING_CHARS characters
+	inline void WriteString( uint8*& pOut, const std::wstring& str )
+	{
+		const uint16 numChars = (uint16)str.length();
+		WriteUint16( pOut, numChars );
+		for( uint16 charIndex = 0; charIndex < numChars; ++charIndex )
+			WriteUint16( pOut, (uint16)str[ charIndex ] );
+	}
+
+	/// Read a string into an existing string, reusing its memory. This returns false if the
+	/// string does not end before pInEnd.
+	inline bool ReadString( const uint8*& pIn, const uint8* pInEnd, std::wstring& str )
+	{
+		if( pInEnd - pIn < (int32)sizeof(uint16) )
+			return false;
+		const uint16 numChars = ReadUint16( pIn );
+		if( (uint32)(pInEnd - pIn) < (uint32)numChars * sizeof(uint16) )
+			return false;
+
+		str.resize( numChars );
+		for( uint16 charIndex = 0; charIndex < numChars; ++charIndex )
+			str[ charIndex ] = (wchar_t)ReadUint16( pIn );
+		return true;
+	}
+}
+
+#endif // __NetWire_h
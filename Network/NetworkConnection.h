@@ -15,21 +15,26 @@
 #define __NetConn_h
 
 #include "Base/Types.h"
-#include <list>
+#include "NetMsgQueue.h"
 class NetMsg;
+class NetMsgHandler;
 class NetworkMgr;
+struct NetEvent;
 
 class NetworkConnection
 {
 protected:
 	friend NetworkMgr;
 
-	typedef std::list< NetMsg* > NetMsgList;
-	NetMsgList m_PendingReadMessages;
+	/// The received messages waiting to be handled
+	NetMsgQueue m_PendingReadMessages;
 
 	/// Close the connection
 	virtual void Close() = 0;
 
+	/// Handle a socket of this connection being ready, called on the network update thread
+	virtual void HandleSocketEvent( const NetEvent& netEvent ) = 0;
+
 public:
 
 	/// The port this connection is connected to or, in the case of a broadcasting LAN connection,
@@ -47,20 +52,14 @@ public:
 	virtual ~NetworkConnection();
 
 	/// Check if there are any messages pending
-	bool HasPendingMessages(){ return m_PendingReadMessages.size() != 0; }
-
-	/// Get the next message.  Note that the user is responsible for freeing the memory after
-	///	popping the message
-	NetMsg* PopNextMessage()
-	{ 
-		NetMsg* pRetVal = 0;
-		if( m_PendingReadMessages.size() > 0 )
-		{
-			pRetVal = m_PendingReadMessages.front();
-			m_PendingReadMessages.pop_front();
-		}
-		return pRetVal;
-	}
+	bool HasPendingMessages();
+
+	/// Get the next message.  Note that the user is responsible for releasing the message with
+	///	NetMsg::Release after popping the message
+	NetMsg* PopNextMessage();
+
+	/// Hand each waiting message to a handler and release it afterwards
+	uint32 DispatchMessages( NetMsgHandler& handler );
 
 	/// Send a message over this connection
 	virtual void SendNetMsg( const NetMsg* pMsg ) = 0;
@@ -17,7 +17,9 @@
 #include <list>
 #include "IPAddress.h"
 #include "NetDataBlock.h"
+#include "NetDataBlockOut.h"
 #include <map>
+#include <vector>
 class NetMsg;
 class NetworkConnection;
 class NetConnTCP;
@@ -28,6 +30,15 @@ class NetConnLAN;
 /// The callback function type for creating messages
 typedef NetMsg* (*MsgCreateFunc)( NetDataBlock );
 
+/// The callback function type for writing the data of a message of any type in a set with a known
+/// ID, returning the end of the written data or NULL if the message is not in the set or the data
+/// does not fit
+typedef uint8* (*MsgEncodeFunc)( uint16 msgID, const NetMsg& msg, uint8* pOut, uint8* pOutEnd );
+
+/// The callback function type for creating a message of any type in a set with a known ID,
+/// returning NULL if the ID is unknown or the data is bad
+typedef NetMsg* (*MsgDecodeFunc)( uint16 msgID, const uint8* pData, const uint8* pDataEnd );
+
 
 //-------------------------------------------------------------------------------------------------
 /*!
@@ -52,6 +63,12 @@ public:
 	typedef std::map< uint32, MsgCreateFunc> MsgCreateMap;
 	MsgCreateMap m_MsgCreateMap;
 
+	/// The functions that encode and decode a set of message types with a switch, indexed by the
+	/// message ID they were registered for and NULL for other IDs. They are tried before the
+	/// message's StoreInBuffer and the registered creation function.
+	std::vector<MsgEncodeFunc> m_MsgEncodeFuncs;
+	std::vector<MsgDecodeFunc> m_MsgDecodeFuncs;
+
 	/// The active connections
 	typedef std::list< NetworkConnection* > ConnList;
 	ConnList m_ActiveConns;
@@ -109,14 +126,24 @@ public:
 	/// Close a connection
 	void CloseConnection( NetworkConnection* pNetConn );
 
-	/// Register a network message
-	void RegisterNetMsg( uint32 msgID, MsgCreateFunc pFunc );
+	/// Register a network message, optionally with the functions that encode and decode the set of
+	/// message types it is in
+	void RegisterNetMsg( uint32 msgID, MsgCreateFunc pFunc, MsgEncodeFunc pEncodeFunc = 0, MsgDecodeFunc pDecodeFunc = 0 );
+
+	/// Write a message's data into a buffer, returning false if it does not fit
+	bool StoreMsg( uint16 msgID, const NetMsg& msg, NetDataBlockOut& dataOut );
 
 	/// Create a message from data received over the network
 	NetMsg* CreateMsgFromData( NetDataBlock dataBlock, IPAddress senderIP, uint16 senderPort );
 
+	/// Create a message of a registered type from its data
+	NetMsg* CreateMsg( uint16 msgID, NetDataBlock dataBlock, IPAddress senderIP, uint16 senderPort );
+
 	/// Get the local IP address of the network adapter being used
 	IPAddress GetLocalIP() const { return m_LocalIP; }
+
+	/// Get the number of times the update thread woke up, to measure how often it runs
+	uint32 GetNumUpdateWakeUps() const;
 };
 
 #endif // __NetworkMgr_h
\ No newline at end of file
@@ -0,0 +1,152 @@
+//=================================================================================================
+/*!
+	\file NetEventLoop.h
+	Network Library
+	Network Event Loop Header
+	\author agent
+	\date October 19, 2026
+
+	This file contains the definition for the event loop that waits on every socket at once.
+*/
+//=================================================================================================
+
+#pragma once
+#ifndef __NetEventLoop_h
+#define __NetEventLoop_h
+
+#include "Base/Types.h"
+#include "Base/CriticalSection.h"
+#include <map>
+#include <vector>
+
+#ifdef WIN32
+#include <winsock2.h>
+#else
+/// The socket handle type, a file descriptor outside of Windows
+typedef int SOCKET;
+#endif
+
+class NetworkConnection;
+
+
+/// A socket that is ready to be read from or written to
+struct NetEvent
+{
+	/// The socket
+	SOCKET socket;
+
+	/// The connection the socket belongs to
+	NetworkConnection* pConn;
+
+	/// The NetEventLoop::EF_ flags of what the socket is ready for
+	uint32 eventFlags;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+/*!
+	\class NetEventLoop
+	\brief Waits on every connection's socket and a wake-up channel at once.
+
+	The network update thread blocks in Wait until a socket can be read, a listening socket has a
+	connection to accept or a socket that had a full send buffer can be written to, so messages
+	are handled as soon as they arrive and the thread does not run while the network is idle.
+	Wake returns the thread from Wait, such as when the network manager shuts down.
+
+	On Linux the sockets are watched with epoll and woken with an eventfd. Elsewhere the loop
+	falls back to select, woken by a loopback UDP socket on Windows or a pipe otherwise, and the
+	socket sets are rebuilt from the watched sockets each time it waits. This class follows the
+	singleton pattern.
+*/
+//-------------------------------------------------------------------------------------------------
+class NetEventLoop
+{
+public:
+
+	/// The events a socket can be watched for
+	enum EEventFlags
+	{
+		EF_Read = 1,
+		EF_Write = 2
+	};
+
+private:
+
+	/// The watched socket entry
+	struct Watch
+	{
+		/// The connection the socket belongs to
+		NetworkConnection* pConn;
+
+		/// The EF_ flags of the events to watch for
+		uint32 eventFlags;
+	};
+
+	/// The watched sockets
+	typedef std::map<SOCKET,Watch> WatchMap;
+	WatchMap m_Watches;
+
+	/// The lock for the watched sockets
+	TCBase::CriticalSection m_Lock;
+
+#ifdef __linux__
+	/// The epoll instance
+	int m_EpollFD;
+
+	/// The eventfd that wakes the wait
+	int m_WakeFD;
+#else
+	/// The socket or pipe end that is read to wake the wait
+	SOCKET m_WakeRecvSocket;
+
+	/// The socket or pipe end that is written to wake the wait
+	SOCKET m_WakeSendSocket;
+#endif
+
+	/// If the loop was initialized
+	bool m_IsInitialized;
+
+	/// The number of times Wait returned
+	uint32 m_NumWakeUps;
+
+	/// The default constructor, private since this class follows the singleton pattern
+	NetEventLoop();
+
+	/// Empty the wake-up channel
+	void DrainWake();
+
+public:
+
+	/// Get the one and only event loop instance
+	static NetEventLoop& Get()
+	{
+		static NetEventLoop s_EventLoop;
+		return s_EventLoop;
+	}
+
+	/// The destructor
+	~NetEventLoop() { Term(); }
+
+	/// Create the wait and wake-up channel
+	bool Init();
+
+	/// Free the wait and wake-up channel and stop watching every socket
+	void Term();
+
+	/// Start watching a socket or change the events it is watched for
+	bool WatchSocket( SOCKET socket, uint32 eventFlags, NetworkConnection* pConn );
+
+	/// Stop watching a socket, this must be done before the socket is closed
+	void UnwatchSocket( SOCKET socket );
+
+	/// Wait until sockets are ready or the loop is woken
+	void Wait( int32 timeoutMS, std::vector<NetEvent>& events );
+
+	/// Return the thread in Wait
+	void Wake();
+
+	/// Get the number of times Wait returned, to measure how often the network thread runs
+	uint32 GetNumWakeUps() const { return m_NumWakeUps; }
+};
+
+#endif // __NetEventLoop_h
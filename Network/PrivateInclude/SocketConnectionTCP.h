@@ -15,6 +15,9 @@
 #define __SocketConnectionTCP_h
 
 #include "SocketConnectionBase.h"
+#include "../IPAddress.h"
+#include "../NetMsgQueue.h"
+#include <vector>
 
 class NetMsg;
 
@@ -29,18 +32,68 @@ class NetMsg;
 	\brief The class to handle a socket connection.
 
 	This class encapsulates the functionality for sending and receiving data.
+
+	TCP is a stream, so a receive may return part of a message or several messages at once. The
+	messages are sent in batches, each a 16-bit length of the rest of the batch followed by the
+	message count and then the messages, each a 16-bit length of the rest of the message followed
+	by the message type ID and data. Messages sent before the socket is next written to are
+	coalesced into one batch and the received data is kept until a whole batch has arrived.
 */
 //-------------------------------------------------------------------------------------------------
 class SocketConnectionTCP : public SocketConnectionBase
 {
+public:
+
+	/// The most bytes a batch can hold after its length
+	static const uint32 MAX_BATCH_LEN = 0xFFFF;
+
 protected:
 
+	/// The size of a batch's length and message count
+	static const uint32 BATCH_HEADER_SIZE = sizeof(uint16) * 2;
+
+	/// The size of a message's length and type ID
+	static const uint32 MSG_HEADER_SIZE = sizeof(uint16) * 2;
+
+	/// The number of bytes the receive buffer grows by to read from the socket
+	static const uint32 RECV_CHUNK_SIZE = 4096;
+
+	/// The offset value when no batch is open for messages to be added to
+	static const uint32 NO_OPEN_BATCH = 0xFFFFFFFF;
+
 	/// The flag for if this connection is listening
 	bool m_IsListening;
 
 	/// The port this connection is connected to
 	uint16 m_BoundPort;
 
+	/// The address of the computer on the other end of the connection
+	IPAddress m_PeerIP;
+
+	/// The port of the computer on the other end of the connection
+	uint16 m_PeerPort;
+
+	/// The batches waiting for the socket to be written to
+	std::vector<uint8> m_PendingSend;
+
+	/// The offset of the batch in m_PendingSend that messages are added to, or NO_OPEN_BATCH
+	uint32 m_OpenBatchOffset;
+
+	/// The number of messages in the open batch
+	uint16 m_OpenBatchMsgCount;
+
+	/// The received data that has not formed a whole batch yet, grown as needed
+	std::vector<uint8> m_RecvStream;
+
+	/// The number of bytes used in m_RecvStream
+	uint32 m_RecvLen;
+
+	/// The received messages that have not been returned by ReceiveDataWait
+	NetMsgQueue m_ReceivedMsgs;
+
+	/// Create the messages in a batch
+	bool ReadBatch( uint8* pBatchData, uint32 batchLen, NetMsgQueue& msgs );
+
 public:
 
 	/// The constructor to initialize from a socket
@@ -64,9 +117,27 @@ public:
 	/// Listen for a TCP connection but does not blocl
 	bool AcceptConnAsync();
 
-	/// Send a message over this connection
+	/// Add a message to the batch waiting to be sent
 	virtual bool SendData( const NetMsg* pMsg );
 
+	/// Send as much of the waiting batches as the socket takes
+	bool SendPendingData();
+
+	/// Get if there is data waiting for the socket to be written to
+	bool HasPendingData() const { return !m_PendingSend.empty(); }
+
+	/// Read the data waiting on the socket and add the messages of the whole batches to a queue
+	bool ReceiveMessages( NetMsgQueue& msgs );
+
+	/// Receive a message from a socket that is ready to be read
+	virtual NetMsg* ReceiveDataWait();
+
+	/// Make socket calls return instead of waiting
+	void SetNonBlocking();
+
+	/// Store the address of the computer on the other end of the connection
+	void SetPeer( IPAddress peerIP, uint16 peerPort ) { m_PeerIP = peerIP; m_PeerPort = peerPort; }
+
 	/// Get the bound port
 	uint16 GetBoundPort() const { return m_BoundPort; }
 
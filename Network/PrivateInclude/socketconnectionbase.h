@@ -65,6 +65,9 @@ public:
 
 	/// Check if this object is currently connection
 	bool IsValid() const { return m_Socket != 0; }
+
+	/// Get the socket
+	SOCKET GetSocket() const { return m_Socket; }
 };
 
 //#pragma warning( pop )
@@ -14,6 +14,7 @@
 #include "../NetConnTCP.h"
 #include "../NetworkMgr.h"
 #include "../NetMsg.h"
+#include "NetEventLoop.h"
 
 
 /// The default constructor
@@ -26,9 +27,7 @@ NetworkConnection::NetworkConnection() : m_ConnPort( 0 )
 NetworkConnection::~NetworkConnection()
 {
 	// Free any remaining read messages
-	for( NetMsgList::iterator iterMsg = m_PendingReadMessages.begin(); iterMsg != m_PendingReadMessages.end(); ++iterMsg )
-		delete *iterMsg;
-	m_PendingReadMessages.clear();
+	m_PendingReadMessages.Clear();
 
 	// Free the mutex
 	if( m_hMutex )
@@ -38,13 +37,60 @@ NetworkConnection::~NetworkConnection()
 	}
 }
 
+/// Check if there are any messages pending
+bool NetworkConnection::HasPendingMessages()
+{
+	WaitForSingleObject( m_hMutex, INFINITE );
+	bool hasMessages = !m_PendingReadMessages.IsEmpty();
+	ReleaseMutex( m_hMutex );
+
+	return hasMessages;
+}
+
+/// Get the next message.  Note that the user is responsible for releasing the message with
+///	NetMsg::Release after popping the message
+NetMsg* NetworkConnection::PopNextMessage()
+{
+	// The messages are added on the network update thread
+	WaitForSingleObject( m_hMutex, INFINITE );
+	NetMsg* pRetVal = m_PendingReadMessages.Pop();
+	ReleaseMutex( m_hMutex );
+
+	return pRetVal;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetworkConnection::DispatchMessages  Public
+///
+///	\param handler The object to hand the messages to
+///	\returns The number of messages handled
+///
+///	Hand each waiting message to a handler and then return it to its pool. The connection is not
+///	locked while the handler runs, so the handler may send messages over this connection.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32 NetworkConnection::DispatchMessages( NetMsgHandler& handler )
+{
+	uint32 numHandled = 0;
+	while( NetMsg* pMsg = PopNextMessage() )
+	{
+		handler.HandleNetMsg( *pMsg );
+		NetMsg::Release( pMsg );
+		++numHandled;
+	}
+
+	return numHandled;
+}
+
 /// Close the connection
 void NetConnTCP::Close()
 {
+	WaitForSingleObject( m_hMutex, INFINITE );
 	m_Conn.Close();
-	while( m_ConnState == CS_Listening )
-		Sleep( 50 );
 	m_ConnState = CS_Invalid;
+	ReleaseMutex( m_hMutex );
 }
 
 
@@ -53,7 +99,69 @@ void NetConnTCP::SendNetMsg( const NetMsg* pMsg )
 {
 	if( !pMsg )
 		return;
+
+	// Add the message to the waiting batch, and if nothing was waiting then have the network
+	// update thread send the batch once the socket can be written to so the messages sent until
+	// then go out together
+	WaitForSingleObject( m_hMutex, INFINITE );
+	bool wasWaiting = m_Conn.HasPendingData();
 	m_Conn.SendData( pMsg );
+	if( !wasWaiting && m_Conn.HasPendingData() )
+		NetEventLoop::Get().WatchSocket( m_Conn.GetSocket(), NetEventLoop::EF_Read | NetEventLoop::EF_Write, this );
+	ReleaseMutex( m_hMutex );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetConnTCP::HandleSocketEvent  Public
+///
+///	\param netEvent The socket event
+///
+///	Accept the connection when the listening socket is ready, or send the batches waiting for the
+///	socket and receive the messages that arrived. This is called on the network update thread.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void NetConnTCP::HandleSocketEvent( const NetEvent& netEvent )
+{
+	WaitForSingleObject( m_hMutex, INFINITE );
+
+	// Ignore the events of a socket this connection no longer uses
+	if( netEvent.socket != m_Conn.GetSocket() )
+	{
+		ReleaseMutex( m_hMutex );
+		return;
+	}
+
+	// If the listening socket has a connection to accept
+	if( m_ConnState == CS_Listening )
+	{
+		m_Conn.AcceptConnSync();
+		if( m_Conn.IsValid() && !m_Conn.IsListening() )
+		{
+			m_ConnState = CS_Connected;
+			NetEventLoop::Get().WatchSocket( m_Conn.GetSocket(), NetEventLoop::EF_Read, this );
+		}
+		ReleaseMutex( m_hMutex );
+		return;
+	}
+
+	// Send the waiting data and stop watching for the socket to be writable once it is sent
+	if( netEvent.eventFlags & NetEventLoop::EF_Write )
+	{
+		if( !m_Conn.SendPendingData() )
+			m_Conn.Close();
+		else if( !m_Conn.HasPendingData() )
+			NetEventLoop::Get().WatchSocket( m_Conn.GetSocket(), NetEventLoop::EF_Read, this );
+	}
+
+	if( (netEvent.eventFlags & NetEventLoop::EF_Read) && m_Conn.IsValid() )
+		m_Conn.ReceiveMessages( m_PendingReadMessages );
+
+	if( !m_Conn.IsValid() )
+		m_ConnState = CS_Invalid;
+
+	ReleaseMutex( m_hMutex );
 }
 
 /// Send a message over this connection
@@ -66,24 +174,38 @@ void NetConnLAN::SendNetMsg( const NetMsg* pMsg )
 
 void NetConnLAN::ReceiveData()
 {
+	WaitForSingleObject( m_hMutex, INFINITE );
 	NetMsg* pNewMsg = m_RecvConn.ReceiveData();
 	if( pNewMsg )
-		m_PendingReadMessages.push_back( pNewMsg );
+		m_PendingReadMessages.Push( pNewMsg );
+	ReleaseMutex( m_hMutex );
 }
 
-void NetConnTCP::ReceiveData()
+/// Receive a message when the receiving socket is ready, called on the network update thread
+void NetConnLAN::HandleSocketEvent( const NetEvent& netEvent )
 {
-	NetMsg* pNewMsg = m_Conn.ReceiveData();
+	if( netEvent.socket != m_RecvConn.GetSocket() || !(netEvent.eventFlags & NetEventLoop::EF_Read) )
+		return;
 
-	// If a message was received
+	WaitForSingleObject( m_hMutex, INFINITE );
+	NetMsg* pNewMsg = m_RecvConn.ReceiveDataWait();
 	if( pNewMsg )
-		m_PendingReadMessages.push_back( pNewMsg );
-	// Otherwise check if there was an error
-	else
-	{
-		if( !m_Conn.IsValid() )
-			m_ConnState = CS_Invalid;
-	}
+		m_PendingReadMessages.Push( pNewMsg );
+	ReleaseMutex( m_hMutex );
+}
+
+void NetConnTCP::ReceiveData()
+{
+	WaitForSingleObject( m_hMutex, INFINITE );
+
+	// The socket does not block, so read whatever whole batches have arrived
+	if( m_ConnState == CS_Connected )
+		m_Conn.ReceiveMessages( m_PendingReadMessages );
+
+	// Check if there was an error
+	if( !m_Conn.IsValid() )
+		m_ConnState = CS_Invalid;
+	ReleaseMutex( m_hMutex );
 }
 
 /// Determine if the connection is valid
@@ -23,26 +23,27 @@ uint8 NetDataBlock::ReadUint8() throw(...)
 
 /// Retrieve a character
 std::wstring NetDataBlock::ReadString() throw(...)
+{
+	std::wstring retStr;
+	ReadString( retStr );
+	return retStr;
+}
+
+/// Retrieve a string into an existing string, reusing its memory so decoding a message into a
+/// pooled message does not allocate
+void NetDataBlock::ReadString( std::wstring& str ) throw(...)
 {
 	// Read the string length
 	uint16 strLen = (uint16)ntohs( ReadVal<u_short>() );
-	if( strLen == 0 )
-		return std::wstring();
 
 	// Check if there is enough data left in the block for this string
 	if( (m_CurByteOffset + sizeof(wchar_t) * strLen) > m_DataLen )
 		throw( "Buffer overflow" );
 
 	// Read in the characters, one at a time
-	std::wstring retStr;
+	str.resize( strLen );
 	for( uint16 charIndex = 0; charIndex < strLen; ++charIndex )
-	{
-		wchar_t curChar = (wchar_t)ntohs( ReadVal<u_short>() );
-		retStr += curChar;
-	}
-
-	// Return the string
-	return retStr;
+		str[ charIndex ] = (wchar_t)ntohs( ReadVal<u_short>() );
 }
 
 
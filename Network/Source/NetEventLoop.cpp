@@ -0,0 +1,414 @@
+//=================================================================================================
+/*!
+	\file NetEventLoop.cpp
+	Network Library
+	Network Event Loop Source
+	\author agent
+	\date October 19, 2026
+
+	This source file contains the implementation for the network event loop class.
+*/
+//=================================================================================================
+
+#include "NetEventLoop.h"
+#include "Base/MsgLogger.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#elif !defined(WIN32)
+#include <sys/select.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+
+#ifdef __linux__
+/// The most events read from epoll in one wait
+static const int MAX_EPOLL_EVENTS = 64;
+#endif
+
+
+/// The default constructor
+NetEventLoop::NetEventLoop() :
+#ifdef __linux__
+								m_EpollFD( -1 ),
+								m_WakeFD( -1 ),
+#else
+								m_WakeRecvSocket( 0 ),
+								m_WakeSendSocket( 0 ),
+#endif
+								m_IsInitialized( false ),
+								m_NumWakeUps( 0 )
+{
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetEventLoop::Init  Public
+///
+///	\returns True if the loop can wait on sockets, otherwise false
+///
+///	Create the wait and the wake-up channel. On Windows this must be done after the socket
+///	manager starts Winsock.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool NetEventLoop::Init()
+{
+	if( m_IsInitialized )
+		return true;
+
+	m_NumWakeUps = 0;
+
+#ifdef __linux__
+	m_EpollFD = epoll_create( MAX_EPOLL_EVENTS );
+	m_WakeFD = eventfd( 0, EFD_NONBLOCK );
+	if( m_EpollFD == -1 || m_WakeFD == -1 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to create the network event loop (error %d)", errno );
+		Term();
+		return false;
+	}
+
+	epoll_event wakeEvent;
+	memset( &wakeEvent, 0, sizeof(wakeEvent) );
+	wakeEvent.events = EPOLLIN;
+	wakeEvent.data.fd = m_WakeFD;
+	if( epoll_ctl( m_EpollFD, EPOLL_CTL_ADD, m_WakeFD, &wakeEvent ) == -1 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to watch the network event loop wake-up (error %d)", errno );
+		Term();
+		return false;
+	}
+#elif defined(WIN32)
+	// Wake with a datagram sent to a loopback socket since select only waits on sockets
+	m_WakeRecvSocket = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+	m_WakeSendSocket = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+	if( m_WakeRecvSocket == INVALID_SOCKET || m_WakeSendSocket == INVALID_SOCKET )
+	{
+		m_WakeRecvSocket = m_WakeRecvSocket == INVALID_SOCKET ? 0 : m_WakeRecvSocket;
+		m_WakeSendSocket = m_WakeSendSocket == INVALID_SOCKET ? 0 : m_WakeSendSocket;
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to create the network event loop wake-up sockets" );
+		Term();
+		return false;
+	}
+
+	sockaddr_in wakeAddr;
+	memset( &wakeAddr, 0, sizeof(wakeAddr) );
+	wakeAddr.sin_family = AF_INET;
+	wakeAddr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	wakeAddr.sin_port = 0;
+	int wakeAddrSize = sizeof(wakeAddr);
+	u_long isNonBlocking = 1;
+	if( bind( m_WakeRecvSocket, (sockaddr*)&wakeAddr, sizeof(wakeAddr) ) == SOCKET_ERROR
+		|| getsockname( m_WakeRecvSocket, (sockaddr*)&wakeAddr, &wakeAddrSize ) == SOCKET_ERROR
+		|| connect( m_WakeSendSocket, (sockaddr*)&wakeAddr, sizeof(wakeAddr) ) == SOCKET_ERROR
+		|| ioctlsocket( m_WakeRecvSocket, FIONBIO, &isNonBlocking ) == SOCKET_ERROR )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to connect the network event loop wake-up sockets" );
+		Term();
+		return false;
+	}
+#else
+	int pipeFDs[ 2 ] = { -1, -1 };
+	if( pipe( pipeFDs ) == -1 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to create the network event loop wake-up pipe (error %d)", errno );
+		return false;
+	}
+	m_WakeRecvSocket = pipeFDs[ 0 ];
+	m_WakeSendSocket = pipeFDs[ 1 ];
+	fcntl( m_WakeRecvSocket, F_SETFL, fcntl( m_WakeRecvSocket, F_GETFL ) | O_NONBLOCK );
+	fcntl( m_WakeSendSocket, F_SETFL, fcntl( m_WakeSendSocket, F_GETFL ) | O_NONBLOCK );
+#endif
+
+	m_IsInitialized = true;
+	return true;
+}
+
+
+/// Free the wait and wake-up channel and stop watching every socket
+void NetEventLoop::Term()
+{
+	m_Lock.Enter();
+	m_Watches.clear();
+	m_Lock.Leave();
+
+#ifdef __linux__
+	if( m_WakeFD != -1 )
+		close( m_WakeFD );
+	if( m_EpollFD != -1 )
+		close( m_EpollFD );
+	m_WakeFD = -1;
+	m_EpollFD = -1;
+#elif defined(WIN32)
+	if( m_WakeRecvSocket != 0 )
+		closesocket( m_WakeRecvSocket );
+	if( m_WakeSendSocket != 0 )
+		closesocket( m_WakeSendSocket );
+	m_WakeRecvSocket = 0;
+	m_WakeSendSocket = 0;
+#else
+	if( m_WakeRecvSocket != 0 )
+		close( m_WakeRecvSocket );
+	if( m_WakeSendSocket != 0 )
+		close( m_WakeSendSocket );
+	m_WakeRecvSocket = 0;
+	m_WakeSendSocket = 0;
+#endif
+
+	m_IsInitialized = false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetEventLoop::WatchSocket  Public
+///
+///	\param socket The socket
+///	\param eventFlags The EF_ flags of the events to watch for
+///	\param pConn The connection the socket belongs to, which is returned with its events
+///	\returns True if the socket is being watched, otherwise false
+///
+///	Start watching a socket or change the events it is watched for. This can be called from any
+///	thread, including while another thread is in Wait.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool NetEventLoop::WatchSocket( SOCKET socket, uint32 eventFlags, NetworkConnection* pConn )
+{
+	if( !m_IsInitialized || socket == 0 )
+		return false;
+
+	m_Lock.Enter();
+
+	bool isWatched = m_Watches.find( socket ) != m_Watches.end();
+	Watch& watch = m_Watches[ socket ];
+	watch.pConn = pConn;
+	watch.eventFlags = eventFlags;
+
+#ifdef __linux__
+	epoll_event socketEvent;
+	memset( &socketEvent, 0, sizeof(socketEvent) );
+	if( eventFlags & EF_Read )
+		socketEvent.events |= (uint32)EPOLLIN;
+	if( eventFlags & EF_Write )
+		socketEvent.events |= (uint32)EPOLLOUT;
+	socketEvent.data.fd = socket;
+	if( epoll_ctl( m_EpollFD, isWatched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, socket, &socketEvent ) == -1 )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to watch a socket (error %d)", errno );
+		m_Watches.erase( socket );
+		m_Lock.Leave();
+		return false;
+	}
+	m_Lock.Leave();
+#else
+	m_Lock.Leave();
+
+	// The waiting thread must rebuild its socket sets
+	Wake();
+#endif
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetEventLoop::UnwatchSocket  Public
+///
+///	\param socket The socket
+///
+///	Stop watching a socket. Events for the socket that Wait has not returned yet are dropped, so
+///	this must be called before the socket is closed and its handle reused.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void NetEventLoop::UnwatchSocket( SOCKET socket )
+{
+	if( !m_IsInitialized || socket == 0 )
+		return;
+
+	m_Lock.Enter();
+
+	WatchMap::iterator iterWatch = m_Watches.find( socket );
+	if( iterWatch == m_Watches.end() )
+	{
+		m_Lock.Leave();
+		return;
+	}
+	m_Watches.erase( iterWatch );
+
+#ifdef __linux__
+	epoll_event socketEvent;
+	memset( &socketEvent, 0, sizeof(socketEvent) );
+	epoll_ctl( m_EpollFD, EPOLL_CTL_DEL, socket, &socketEvent );
+	m_Lock.Leave();
+#else
+	m_Lock.Leave();
+	Wake();
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetEventLoop::Wait  Public
+///
+///	\param timeoutMS The longest time to wait in milliseconds, -1 to wait until there are events
+///	\param events The list to fill with the sockets that are ready, it is emptied first
+///
+///	Wait until watched sockets are ready or the loop is woken. Only one thread may wait at a
+///	time. The events of a socket that is unwatched while waiting are not returned.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void NetEventLoop::Wait( int32 timeoutMS, std::vector<NetEvent>& events )
+{
+	events.clear();
+	if( !m_IsInitialized )
+		return;
+
+#ifdef __linux__
+	epoll_event readyEvents[ MAX_EPOLL_EVENTS ];
+	int numReady = epoll_wait( m_EpollFD, readyEvents, MAX_EPOLL_EVENTS, timeoutMS );
+	m_NumWakeUps++;
+	if( numReady == -1 )
+	{
+		if( errno != EINTR )
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to wait for network events (error %d)", errno );
+		return;
+	}
+
+	m_Lock.Enter();
+	for( int eventIndex = 0; eventIndex < numReady; ++eventIndex )
+	{
+		const epoll_event& readyEvent = readyEvents[ eventIndex ];
+		if( readyEvent.data.fd == m_WakeFD )
+		{
+			DrainWake();
+			continue;
+		}
+
+		WatchMap::const_iterator iterWatch = m_Watches.find( readyEvent.data.fd );
+		if( iterWatch == m_Watches.end() )
+			continue;
+
+		// A closed or failed socket is reported as readable so the read finds the error
+		NetEvent newEvent;
+		newEvent.socket = readyEvent.data.fd;
+		newEvent.pConn = iterWatch->second.pConn;
+		newEvent.eventFlags = 0;
+		if( readyEvent.events & (EPOLLIN | EPOLLHUP | EPOLLERR) )
+			newEvent.eventFlags |= EF_Read;
+		if( readyEvent.events & EPOLLOUT )
+			newEvent.eventFlags |= EF_Write;
+		newEvent.eventFlags &= iterWatch->second.eventFlags | EF_Read;
+		events.push_back( newEvent );
+	}
+	m_Lock.Leave();
+#else
+	// Build the socket sets from the watched sockets
+	fd_set readSet;
+	fd_set writeSet;
+	FD_ZERO( &readSet );
+	FD_ZERO( &writeSet );
+
+// Suppress warning c4127 conditional express is constant
+#ifdef WIN32
+#pragma warning( push )
+#pragma warning( disable : 4127 )
+#endif
+	FD_SET( m_WakeRecvSocket, &readSet );
+	SOCKET maxSocket = m_WakeRecvSocket;
+
+	m_Lock.Enter();
+	for( WatchMap::const_iterator iterWatch = m_Watches.begin(); iterWatch != m_Watches.end(); ++iterWatch )
+	{
+		if( iterWatch->second.eventFlags & EF_Read )
+			FD_SET( iterWatch->first, &readSet );
+		if( iterWatch->second.eventFlags & EF_Write )
+			FD_SET( iterWatch->first, &writeSet );
+		if( iterWatch->first > maxSocket )
+			maxSocket = iterWatch->first;
+	}
+	m_Lock.Leave();
+#ifdef WIN32
+#pragma warning( pop )
+#endif
+
+	timeval timeout;
+	timeout.tv_sec = timeoutMS / 1000;
+	timeout.tv_usec = (timeoutMS % 1000) * 1000;
+	int numReady = select( (int)maxSocket + 1, &readSet, &writeSet, NULL, timeoutMS < 0 ? NULL : &timeout );
+	m_NumWakeUps++;
+	if( numReady <= 0 )
+		return;
+
+	if( FD_ISSET( m_WakeRecvSocket, &readSet ) )
+		DrainWake();
+
+	// A socket unwatched during the wait is skipped since it is no longer in the map
+	m_Lock.Enter();
+	for( WatchMap::const_iterator iterWatch = m_Watches.begin(); iterWatch != m_Watches.end(); ++iterWatch )
+	{
+		NetEvent newEvent;
+		newEvent.socket = iterWatch->first;
+		newEvent.pConn = iterWatch->second.pConn;
+		newEvent.eventFlags = 0;
+		if( (iterWatch->second.eventFlags & EF_Read) && FD_ISSET( iterWatch->first, &readSet ) )
+			newEvent.eventFlags |= EF_Read;
+		if( (iterWatch->second.eventFlags & EF_Write) && FD_ISSET( iterWatch->first, &writeSet ) )
+			newEvent.eventFlags |= EF_Write;
+		if( newEvent.eventFlags != 0 )
+			events.push_back( newEvent );
+	}
+	m_Lock.Leave();
+#endif
+}
+
+
+/// Return the thread in Wait
+void NetEventLoop::Wake()
+{
+	if( !m_IsInitialized )
+		return;
+
+#ifdef __linux__
+	uint64 wakeCount = 1;
+	if( write( m_WakeFD, &wakeCount, sizeof(wakeCount) ) == -1 && errno != EAGAIN )
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to wake the network event loop (error %d)", errno );
+#elif defined(WIN32)
+	char wakeByte = 0;
+	send( m_WakeSendSocket, &wakeByte, 1, 0 );
+#else
+	char wakeByte = 0;
+	if( write( m_WakeSendSocket, &wakeByte, 1 ) == -1 && errno != EAGAIN )
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to wake the network event loop (error %d)", errno );
+#endif
+}
+
+
+/// Empty the wake-up channel
+void NetEventLoop::DrainWake()
+{
+#ifdef __linux__
+	uint64 wakeCount = 0;
+	while( read( m_WakeFD, &wakeCount, sizeof(wakeCount) ) > 0 )
+	{
+	}
+#elif defined(WIN32)
+	char wakeBytes[ 64 ];
+	while( recv( m_WakeRecvSocket, wakeBytes, sizeof(wakeBytes), 0 ) > 0 )
+	{
+	}
+#else
+	char wakeBytes[ 64 ];
+	while( read( m_WakeRecvSocket, wakeBytes, sizeof(wakeBytes) ) > 0 )
+	{
+	}
+#endif
+}
@@ -0,0 +1,83 @@
+//=================================================================================================
+/*!
+	\file NetMsgPool.cpp
+	Network Library
+	Network Message Pool Source
+	\author agent
+	\date October 19, 2026
+
+	This source file contains the implementation for the network message pools and queue.
+*/
+//=================================================================================================
+
+#include "../NetMsgPool.h"
+#include "../NetMsgQueue.h"
+
+
+/// The number of messages the pools have allocated
+uint32 NetMsgPoolBase::s_NumMsgsAllocated = 0;
+
+
+/// Return a message to its pool, or free it if it was not taken from one
+void NetMsg::Release( NetMsg* pMsg )
+{
+	if( !pMsg )
+		return;
+
+	if( pMsg->m_pPool )
+		pMsg->m_pPool->Recycle( pMsg );
+	else
+		delete pMsg;
+}
+
+
+/// Add a message to the end of the queue
+void NetMsgQueue::Push( NetMsg* pMsg )
+{
+	// Keep the messages in order by adding to the overflow list while it has messages
+	if( m_Count < RING_CAPACITY && m_Overflow.empty() )
+	{
+		m_Ring[ (m_Head + m_Count) % RING_CAPACITY ] = pMsg;
+		++m_Count;
+	}
+	else
+		m_Overflow.push_back( pMsg );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetMsgQueue::Pop  Public
+///
+///	\returns The message at the front of the queue, or NULL if the queue is empty
+///
+///	Remove the message at the front of the queue. If messages are waiting in the overflow list
+///	then the oldest one takes the freed spot in the ring.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+NetMsg* NetMsgQueue::Pop()
+{
+	if( m_Count == 0 )
+		return 0;
+
+	NetMsg* pRetMsg = m_Ring[ m_Head ];
+	m_Head = (m_Head + 1) % RING_CAPACITY;
+	--m_Count;
+
+	if( !m_Overflow.empty() )
+	{
+		m_Ring[ (m_Head + m_Count) % RING_CAPACITY ] = m_Overflow.front();
+		m_Overflow.pop_front();
+		++m_Count;
+	}
+
+	return pRetMsg;
+}
+
+
+/// Release every queued message
+void NetMsgQueue::Clear()
+{
+	while( NetMsg* pMsg = Pop() )
+		NetMsg::Release( pMsg );
+}
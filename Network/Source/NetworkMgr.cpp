@@ -18,51 +18,12 @@
 #include "../NetConnLAN.h"
 #include "../NetMsg.h"
 #include "../HttpRequestMgr.h"
+#include "NetEventLoop.h"
 #include <process.h>
+#include <algorithm>
+#include <vector>
 
 static CRITICAL_SECTION m_ActiveConnCritSec;
-bool g_CloseAllThreads = false;
-
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-//
-//  WaitForTCPConn  Global
-///
-///	\param UNNAMED A pointer to conext sensitive data
-///
-///	Listen for TCP connections
-///
-///////////////////////////////////////////////////////////////////////////////////////////////////
-DWORD WINAPI WaitForTCPConn( void* pVoidNetConnTCP )
-{
-	if( !pVoidNetConnTCP )
-		return 0;
-
-	// Place the connection
-	NetConnTCP* pNetConnTCP = reinterpret_cast<NetConnTCP*>( pVoidNetConnTCP );
-	if( !pNetConnTCP->m_Conn.Listen() )
-		return 0;
-
-	// Loop while the socket is listening
-	pNetConnTCP->m_ConnState = NetConnTCP::CS_Listening;
-	while( !g_CloseAllThreads && pNetConnTCP->m_Conn.IsValid() && pNetConnTCP->m_Conn.IsListening() )
-	{
-		// If the connection accepts
-		if( pNetConnTCP->m_Conn.AcceptConnAsync() )
-		{
-			pNetConnTCP->m_ConnState = NetConnTCP::CS_Connected;
-			break;
-		}
-
-		// Give up our time slice
-		Sleep( 50 );
-	}
-	
-	if( !pNetConnTCP->m_Conn.IsValid() )
-		pNetConnTCP->m_ConnState = NetConnTCP::CS_Invalid;
-
-	return 0;
-}
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,30 +55,34 @@ DWORD WINAPI WaitForTCPConn( void* pVoidNetConnTCP )
 ///
 ///	\param UNNAMED A pointer to conext sensitive data
 ///
-///	Update the connections to receive messages if needed.
+///	Update the connections to receive messages if needed. The thread sleeps in the network event
+///	loop until a connection's socket is ready and then hands the event to the connection, so a
+///	message is received as soon as it arrives and the thread does not run while the network is
+///	idle.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void NetworkMgr::UpdateThread( void* )
 {
 	NetworkMgr& networkMgr = NetworkMgr::Get();
-	networkMgr.m_ReadThreadActive = true;
+	std::vector<NetEvent> events;
 	while( !networkMgr.m_IsTerminated )
 	{
+		// Wait until a socket is ready or the manager is shut down
+		NetEventLoop::Get().Wait( -1, events );
+
 		// Lock the active connection list
 		EnterCriticalSection( &m_ActiveConnCritSec );
 
-		// Go through the active connections
-		for( ConnList::iterator iterConn = networkMgr.m_ActiveConns.begin(); iterConn != networkMgr.m_ActiveConns.end(); ++iterConn )
+		// Go through the events, skipping those of connections closed since the wait returned
+		for( uint32 eventIndex = 0; eventIndex < events.size(); ++eventIndex )
 		{
-			if( (*iterConn)->IsValid() )
-				(*iterConn)->ReceiveData();
+			const NetEvent& netEvent = events[ eventIndex ];
+			if( std::find( networkMgr.m_ActiveConns.begin(), networkMgr.m_ActiveConns.end(), netEvent.pConn ) != networkMgr.m_ActiveConns.end() )
+				netEvent.pConn->HandleSocketEvent( netEvent );
 		}
 
 		// Unlock the critical section
 		LeaveCriticalSection( &m_ActiveConnCritSec );
-
-		// Wait a bit (50ms being 20 updates per second)
-		Sleep( 50 );
 	}
 
 	networkMgr.m_ReadThreadActive = false;
@@ -137,12 +102,18 @@ bool NetworkMgr::Init()
 {
 	// Clear the flag just in case
 	m_IsTerminated = false;
-	g_CloseAllThreads = false;
 
 	// Initialize the socket manager
 	if( !SocketMgr::Get().Init() )
 		return false;
 
+	// Create the event loop the update thread waits in
+	if( !NetEventLoop::Get().Init() )
+	{
+		SocketMgr::Get().Term();
+		return false;
+	}
+
 	HttpRequestMgr::Init();
 
 	// Store the local IP
@@ -151,17 +122,17 @@ bool NetworkMgr::Init()
 	// Create the active connection mutex
 	InitializeCriticalSection( &m_ActiveConnCritSec );
 
-	// Create the thread to update connections
-	//if( CreateThread( NULL, 0, UpdateThread, NULL, 0, NULL ) == NULL )
-	/*
-	if( _beginthread(UpdateThread, 0, 0 ) == 1 )
+	// Create the thread to update connections, it is flagged as active first so Term waits for it
+	m_ReadThreadActive = true;
+	if( _beginthread( UpdateThread, 0, 0 ) == -1 )
 	{
+		m_ReadThreadActive = false;
 		DeleteCriticalSection( &m_ActiveConnCritSec );
+		NetEventLoop::Get().Term();
 		SocketMgr::Get().Term();
 		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to create thread for NetworkMgr for updating active connections." );
 		return false;
 	}
-	*/
 
 	// Return success
 	return true;
@@ -170,9 +141,9 @@ bool NetworkMgr::Init()
 /// Shutdown the network manager and free any resources
 void NetworkMgr::Term()
 {
-	// Flag the end for threads
+	// Flag the end for threads and wake the update thread to see it
 	m_IsTerminated = true;
-	g_CloseAllThreads = true;
+	NetEventLoop::Get().Wake();
 	while( m_ReadThreadActive )
 		Sleep( 5 );
 
@@ -188,6 +159,8 @@ void NetworkMgr::Term()
 	}
 	m_ActiveConns.clear();
 
+	NetEventLoop::Get().Term();
+
 	// Shutdown the network manager
 	SocketMgr::Get().Term();
 }
@@ -237,6 +210,8 @@ NetConnLAN* NetworkMgr::CreateLANBroadcastConn( uint16 sendToPort, uint16 listen
 		EnterCriticalSection( &m_ActiveConnCritSec );
 		m_ActiveConns.push_back( pLANConn );
 		LeaveCriticalSection( &m_ActiveConnCritSec );
+
+		NetEventLoop::Get().WatchSocket( pLANConn->m_RecvConn.GetSocket(), NetEventLoop::EF_Read, pLANConn );
 	}
 
 	return pLANConn;
@@ -255,6 +230,8 @@ NetConnLAN* NetworkMgr::CreateLANListenConn( uint16 listenPort )
 		EnterCriticalSection( &m_ActiveConnCritSec );
 		m_ActiveConns.push_back( pLANConn );
 		LeaveCriticalSection( &m_ActiveConnCritSec );
+
+		NetEventLoop::Get().WatchSocket( pLANConn->m_RecvConn.GetSocket(), NetEventLoop::EF_Read, pLANConn );
 	}
 
 	return pLANConn;
@@ -285,7 +262,10 @@ NetConnTCP* NetworkMgr::ConnectToTCPConn( IPAddress connIP, uint16 connPort )
 	// Connect to the passed-in address
 	pTCPConn->m_Conn = SocketMgr::Get().ConnectToTCPSync( connIP, connPort );
 	if( pTCPConn->m_Conn.IsConnected() )
+	{
+		pTCPConn->m_Conn.SetNonBlocking();
 		pTCPConn->m_ConnState = NetConnTCP::CS_Connected;
+	}
 
 	// Start the thread that will listen for the connection
 	//if( CreateThread( NULL, 0, ::ConnectTCPConn, pTCPConn, 0, NULL ) == NULL )
@@ -296,6 +276,9 @@ NetConnTCP* NetworkMgr::ConnectToTCPConn( IPAddress connIP, uint16 connPort )
 		EnterCriticalSection( &m_ActiveConnCritSec );
 		m_ActiveConns.push_back( pTCPConn );
 		LeaveCriticalSection( &m_ActiveConnCritSec );
+
+		if( pTCPConn->m_ConnState == NetConnTCP::CS_Connected )
+			NetEventLoop::Get().WatchSocket( pTCPConn->m_Conn.GetSocket(), NetEventLoop::EF_Read, pTCPConn );
 	}
 
 	return pTCPConn;
@@ -309,15 +292,18 @@ NetConnTCP* NetworkMgr::WaitForTCPConn( uint16 listenPort, uint16 portRange )
 	pTCPConn->m_Conn = SocketMgr::Get().CreateListenTCP( listenPort, portRange );
 	pTCPConn->m_ConnPort = pTCPConn->m_Conn.GetBoundPort();
 
-	// Start the thread that will listen for the connection
-	if( CreateThread( NULL, 0, ::WaitForTCPConn, pTCPConn, 0, 0 ) == NULL )
-		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to create thread to listen for TCP connection." );
+	// Listen for the connection, the update thread accepts it when the listening socket is ready
+	if( pTCPConn->m_Conn.IsValid() && pTCPConn->m_Conn.Listen() )
+		pTCPConn->m_ConnState = NetConnTCP::CS_Listening;
 
 	if( pTCPConn )
 	{
 		EnterCriticalSection( &m_ActiveConnCritSec );
 		m_ActiveConns.push_back( pTCPConn );
 		LeaveCriticalSection( &m_ActiveConnCritSec );
+
+		if( pTCPConn->m_ConnState == NetConnTCP::CS_Listening )
+			NetEventLoop::Get().WatchSocket( pTCPConn->m_Conn.GetSocket(), NetEventLoop::EF_Read, pTCPConn );
 	}
 
 	return pTCPConn;
@@ -349,8 +335,31 @@ void NetworkMgr::TestFirewall()
 }
 
 
-/// Register a network message
-void NetworkMgr::RegisterNetMsg( uint32 msgID, MsgCreateFunc pFunc )
+/// Get the number of times the update thread woke up, to measure how often it runs
+uint32 NetworkMgr::GetNumUpdateWakeUps() const
+{
+	return NetEventLoop::Get().GetNumWakeUps();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetworkMgr::RegisterNetMsg  Public
+///
+///	\param msgID The type ID of the message
+///	\param pFunc The function that creates the message from its data
+///	\param pEncodeFunc The function that writes the data of the messages in the message's set,
+///						such as the switch generated by NetMsgGen, or NULL
+///	\param pDecodeFunc The function that creates the messages in the message's set from their
+///						data, or NULL
+///
+///	Register a network message. The encode and decode functions are only used for this ID, so
+///	sets of messages with overlapping IDs can not take over each other's messages, and they are
+///	tried first so the message is handled by straight-line code instead of virtual calls. A
+///	message they do not handle falls back to its StoreInBuffer and the creation function.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void NetworkMgr::RegisterNetMsg( uint32 msgID, MsgCreateFunc pFunc, MsgEncodeFunc pEncodeFunc, MsgDecodeFunc pDecodeFunc )
 {
 	// If the message is already registered
 	if( m_MsgCreateMap.find( msgID ) != m_MsgCreateMap.end() )
@@ -361,8 +370,65 @@ void NetworkMgr::RegisterNetMsg( uint32 msgID, MsgCreateFunc pFunc )
 	// Else store the creation function
 	else
 		m_MsgCreateMap.insert( std::pair< uint32, MsgCreateFunc>( msgID, pFunc ) );
+
+	// Message IDs are sent as 16-bit values
+	if( msgID > 0xFFFF )
+		return;
+
+	// Store the encode and decode functions, replacing any from a previous registration
+	if( msgID >= m_MsgEncodeFuncs.size() )
+	{
+		if( !pEncodeFunc && !pDecodeFunc )
+			return;
+		m_MsgEncodeFuncs.resize( msgID + 1, 0 );
+		m_MsgDecodeFuncs.resize( msgID + 1, 0 );
+	}
+	m_MsgEncodeFuncs[ msgID ] = pEncodeFunc;
+	m_MsgDecodeFuncs[ msgID ] = pDecodeFunc;
 }
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetworkMgr::StoreMsg  Public
+///
+///	\param msgID The type ID of the message
+///	\param msg The message to store
+///	\param dataOut The buffer to write the message's data into
+///	\returns False if the message does not fit in the buffer, otherwise true
+///
+///	Write a message's data into a buffer using its registered encode function, or the message's
+///	own StoreInBuffer if it has none. The buffer throws if it is overflowed, which is caught here
+///	so the connections sending the message can release their locks and drop the message.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool NetworkMgr::StoreMsg( uint16 msgID, const NetMsg& msg, NetDataBlockOut& dataOut )
+{
+	if( msgID < m_MsgEncodeFuncs.size() && m_MsgEncodeFuncs[ msgID ] )
+	{
+		uint8* pOut = dataOut.GetCurData();
+		uint8* pOutEnd = m_MsgEncodeFuncs[ msgID ]( msgID, msg, pOut, pOut + dataOut.GetRemainingBytes() );
+		if( pOutEnd )
+		{
+			dataOut.Skip( (uint32)(pOutEnd - pOut) );
+			return true;
+		}
+	}
+
+	try
+	{
+		msg.StoreInBuffer( dataOut );
+	}
+	catch( ... )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Network message %u is too large to send.", (uint32)msgID );
+		return false;
+	}
+
+	return true;
+}
+
+
 /// Create a message from data received over the network
 NetMsg* NetworkMgr::CreateMsgFromData( NetDataBlock dataBlock, IPAddress senderIP, uint16 senderPort )
 {
@@ -376,20 +442,46 @@ NetMsg* NetworkMgr::CreateMsgFromData( NetDataBlock dataBlock, IPAddress senderI
 	// The next 16-bit value is the message ID
 	uint16 msgID = dataBlock.ReadUint16();
 
-	// Get the callback function
-	MsgCreateMap::iterator iterFunc = m_MsgCreateMap.find( msgID );
-	if( iterFunc == m_MsgCreateMap.end() )
-		return 0;
+	return CreateMsg( msgID, dataBlock, senderIP, senderPort );
+}
 
-	// Create the message
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  NetworkMgr::CreateMsg  Public
+///
+///	\param msgID The type ID of the message
+///	\param dataBlock The message's data
+///	\param senderIP The address of the computer that sent the message
+///	\param senderPort The port the message was sent from
+///	\returns The message, or NULL if the type is not registered or the data is bad
+///
+///	Create a message of a registered type from its data.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+NetMsg* NetworkMgr::CreateMsg( uint16 msgID, NetDataBlock dataBlock, IPAddress senderIP, uint16 senderPort )
+{
+	// Try the decoding function first
 	NetMsg* pRetMsg = 0;
-	try
-	{
-		pRetMsg = iterFunc->second( dataBlock );
-	}
-	catch( ... )
+	if( msgID < m_MsgDecodeFuncs.size() && m_MsgDecodeFuncs[ msgID ] )
+		pRetMsg = m_MsgDecodeFuncs[ msgID ]( msgID, dataBlock.GetCurData(), dataBlock.GetCurData() + dataBlock.GetRemainingBytes() );
+
+	if( !pRetMsg )
 	{
-		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Bad network data received." );
+		// Get the callback function
+		MsgCreateMap::iterator iterFunc = m_MsgCreateMap.find( msgID );
+		if( iterFunc == m_MsgCreateMap.end() )
+			return 0;
+
+		// Create the message
+		try
+		{
+			pRetMsg = iterFunc->second( dataBlock );
+		}
+		catch( ... )
+		{
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Bad network data received." );
+		}
 	}
 
 	// If a valid message was created then store the sender's address
@@ -18,6 +18,7 @@
 #include <iostream>
 #include "Base/MsgLogger.h"
 #include "../NetworkMgr.h"
+#include "NetEventLoop.h"
 using namespace std;
 
 
@@ -85,6 +86,9 @@ NetMsg* SocketConnectionBase::ReceiveDataWait()
 
 void SocketConnectionBase::Close()
 {
+	// Stop watching the socket before its handle can be reused
+	NetEventLoop::Get().UnwatchSocket( m_Socket );
+
 	if( m_Socket != 0 )
 		closesocket( m_Socket );
 	m_Socket = 0;
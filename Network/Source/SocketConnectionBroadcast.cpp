@@ -14,6 +14,7 @@
 #include "SocketMgr.h"
 #include "NetDefines.h"
 #include "../IPAddress.h"
+#include "../NetworkMgr.h"
 #include "Base/MsgLogger.h"
 using namespace std;
 
@@ -40,9 +41,11 @@ bool SocketConnectionBroadcast::SendData( const NetMsg* pMsg )
 	// Store the message count
 	NetDataBlockOut dataOut( m_SendBuffer, NetDefines::MSG_BUFFER_SIZE );
 	uint16 msgCount = 0;
+	const uint16 msgID = pMsg->GetMsgTypeID();
 	dataOut.WriteVal16( msgCount );
-	dataOut.WriteVal16( pMsg->GetMsgTypeID() );
-	pMsg->StoreInBuffer( dataOut );
+	dataOut.WriteVal16( msgID );
+	if( !NetworkMgr::Get().StoreMsg( msgID, *pMsg, dataOut ) )
+		return false;
 
 	// Send the message
 	if( sendto( m_Socket, (const char*)m_SendBuffer, (int)dataOut.GetCurPosition(), 0, (sockaddr*)&toAddress, (int)sizeof(toAddress) ) == SOCKET_ERROR )
@@ -18,12 +18,17 @@
 #include <iostream>
 #include "Base/MsgLogger.h"
 #include "../NetworkMgr.h"
+#include "NetEventLoop.h"
 using namespace std;
 
 
 /// The constructor to initialize from a socket
 SocketConnectionTCP:: SocketConnectionTCP( SOCKET socket, uint16 boundPort ) : m_BoundPort( boundPort ),
-														m_IsListening( false )
+														m_IsListening( false ),
+														m_PeerPort( 0 ),
+														m_OpenBatchOffset( NO_OPEN_BATCH ),
+														m_OpenBatchMsgCount( 0 ),
+														m_RecvLen( 0 )
 {
 	m_Socket = socket;
 }
@@ -80,7 +85,14 @@ void SocketConnectionTCP::AcceptConnSync()
 		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to accept TCP connection : %s", NetDefines::GetWinsockErrorDesc(WSAGetLastError()) );
 	else
 	{
+		// Only one player joins a game, so close the listening socket and use the accepted one
+		NetEventLoop::Get().UnwatchSocket( m_Socket );
+		closesocket( m_Socket );
+		m_IsListening = false;
+
 		m_Socket = acceptSocket;
+		SetPeer( IPAddress( (uint32)sockAddr.sin_addr.S_un.S_addr ), ntohs( sockAddr.sin_port ) );
+		SetNonBlocking();
 		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Accepted TCP connection" );
 	}
 }
@@ -121,37 +133,267 @@ bool SocketConnectionTCP::AcceptConnAsync()
 	return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SocketConnectionTCP::SendData  Public
+///
+///	\param pMsg The message to send
+///	\returns False if the connection is not open or the message is too large, otherwise true
+///
+///	Add a message to the open batch, starting a new batch if there is none or the message does
+///	not fit. The batches are sent by SendPendingData once the socket can be written to, so the
+///	messages sent until then go out in one write.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
 bool SocketConnectionTCP::SendData( const NetMsg* pMsg )
 {
 	if( m_Socket == 0 || !pMsg )
 		return false;
 
-	// Fill in the send buffer
+	// Fill in the send buffer with the message's length, type ID and data
+	const uint16 msgID = pMsg->GetMsgTypeID();
 	NetDataBlockOut dataOut( m_SendBuffer, NetDefines::MSG_BUFFER_SIZE );
-	uint16 msgCount = 0;
-	dataOut.WriteVal16( msgCount );
-	dataOut.WriteVal16( pMsg->GetMsgTypeID() );
-	pMsg->StoreInBuffer( dataOut );
+	dataOut.WriteVal16( 0 );
+	dataOut.WriteVal16( msgID );
+	if( !NetworkMgr::Get().StoreMsg( msgID, *pMsg, dataOut ) )
+		return false;
+	const uint32 msgLen = dataOut.GetCurPosition();
+	NetDataBlockOut lenOut( m_SendBuffer, sizeof(uint16) );
+	lenOut.WriteVal16( (uint16)(msgLen - sizeof(uint16)) );
 
-	// Send the message
-	if( send( m_Socket, (const char*)m_SendBuffer, (int)dataOut.GetCurPosition(), 0 ) == SOCKET_ERROR )
+	// Start a new batch if there is no open batch or the message does not fit in it
+	if( m_OpenBatchOffset != NO_OPEN_BATCH
+		&& (m_PendingSend.size() - m_OpenBatchOffset - sizeof(uint16)) + msgLen > MAX_BATCH_LEN )
+		m_OpenBatchOffset = NO_OPEN_BATCH;
+	if( m_OpenBatchOffset == NO_OPEN_BATCH )
+	{
+		m_OpenBatchOffset = (uint32)m_PendingSend.size();
+		m_OpenBatchMsgCount = 0;
+		m_PendingSend.resize( m_PendingSend.size() + BATCH_HEADER_SIZE );
+	}
+
+	// Add the message and update the batch's length and message count
+	m_PendingSend.insert( m_PendingSend.end(), m_SendBuffer, m_SendBuffer + msgLen );
+	++m_OpenBatchMsgCount;
+
+	NetDataBlockOut headerOut( &m_PendingSend[ m_OpenBatchOffset ], BATCH_HEADER_SIZE );
+	headerOut.WriteVal16( (uint16)(m_PendingSend.size() - m_OpenBatchOffset - sizeof(uint16)) );
+	headerOut.WriteVal16( m_OpenBatchMsgCount );
+	
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SocketConnectionTCP::SendPendingData  Public
+///
+///	\returns False if the connection failed, otherwise true even if some data is still waiting
+///
+///	Send as much of the waiting batches as the socket takes. The open batch is closed first since
+///	part of it may be sent. This is called when the network event loop finds the socket can be
+///	written to.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SocketConnectionTCP::SendPendingData()
+{
+	if( m_Socket == 0 )
+		return false;
+	if( m_PendingSend.empty() )
+		return true;
+
+	m_OpenBatchOffset = NO_OPEN_BATCH;
+
+	int bytesSent = send( m_Socket, (const char*)&m_PendingSend[0], (int)m_PendingSend.size(), 0 );
+	if( bytesSent == SOCKET_ERROR )
 	{
 		int errorCode = WSAGetLastError();
+		if( errorCode == WSAEWOULDBLOCK )
+			return true;
+
 		if( errorCode == WSAENOTCONN )
 		{
 			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Lost TCP connection" );
 		}
 		else
 			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to send data on TCP socket: %s", NetDefines::GetWinsockErrorDesc(errorCode) );
-		
 		return false;
 	}
-	
+
+	m_PendingSend.erase( m_PendingSend.begin(), m_PendingSend.begin() + bytesSent );
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SocketConnectionTCP::ReceiveMessages  Public
+///
+///	\param msgs The queue to add the received messages to
+///	\returns False if the connection closed or received bad data, otherwise true
+///
+///	Read all of the data waiting on the socket and create the messages of each whole batch that
+///	has arrived, keeping the rest until the remainder of its batch arrives. The socket does not
+///	block, so this returns right away if there is nothing to read. If the other computer closed
+///	the connection then this connection is closed too, after the messages that arrived before it
+///	closed are created, otherwise the network event loop would report the socket as readable
+///	forever.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SocketConnectionTCP::ReceiveMessages( NetMsgQueue& msgs )
+{
+	if( m_Socket == 0 )
+		return false;
+
+	// Read until the socket has no more data
+	bool isConnLost = false;
+	for( ;; )
+	{
+		if( m_RecvStream.size() - m_RecvLen < RECV_CHUNK_SIZE )
+			m_RecvStream.resize( m_RecvLen + RECV_CHUNK_SIZE );
+
+		const int bytesFree = (int)(m_RecvStream.size() - m_RecvLen);
+		int bytesRead = recv( m_Socket, (char*)&m_RecvStream[ m_RecvLen ], bytesFree, 0 );
+		if( bytesRead == SOCKET_ERROR )
+		{
+			int errorCode = WSAGetLastError();
+			if( errorCode == WSAEWOULDBLOCK )
+				break;
+
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to receive data : %s", NetDefines::GetWinsockErrorDesc(errorCode) );
+			isConnLost = true;
+			break;
+		}
+
+		// If the other computer closed the connection
+		if( bytesRead == 0 )
+		{
+			MSG_LOGGER_OUT( MsgLogger::MI_Note, L"TCP connection closed by the other computer" );
+			isConnLost = true;
+			break;
+		}
+
+		m_RecvLen += (uint32)bytesRead;
+		if( bytesRead < bytesFree )
+			break;
+	}
+
+	// Create the messages of the whole batches
+	uint32 readOffset = 0;
+	while( m_RecvLen - readOffset >= sizeof(uint16) )
+	{
+		NetDataBlock lenBlock( &m_RecvStream[ readOffset ], sizeof(uint16) );
+		const uint32 batchLen = lenBlock.ReadUint16();
+		if( m_RecvLen - readOffset - sizeof(uint16) < batchLen )
+			break;
+
+		if( !ReadBatch( &m_RecvStream[ readOffset + sizeof(uint16) ], batchLen, msgs ) )
+		{
+			MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Bad network data received." );
+			Close();
+			return false;
+		}
+		readOffset += sizeof(uint16) + batchLen;
+	}
+
+	// Move the start of the next batch to the front
+	if( readOffset > 0 )
+	{
+		m_RecvLen -= readOffset;
+		if( m_RecvLen > 0 )
+			memmove( &m_RecvStream[0], &m_RecvStream[ readOffset ], m_RecvLen );
+	}
+
+	if( isConnLost )
+	{
+		Close();
+		return false;
+	}
+
 	return true;
 }
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SocketConnectionTCP::ReadBatch  Protected
+///
+///	\param pBatchData The batch's data after its length
+///	\param batchLen The number of bytes in the batch after its length
+///	\param msgs The queue to add the messages to
+///	\returns False if the batch's lengths do not match its data, otherwise true
+///
+///	Create the messages in a batch. Messages of unknown types are skipped.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SocketConnectionTCP::ReadBatch( uint8* pBatchData, uint32 batchLen, NetMsgQueue& msgs )
+{
+	if( batchLen < sizeof(uint16) )
+		return false;
+
+	NetDataBlock countBlock( pBatchData, sizeof(uint16) );
+	const uint16 msgCount = countBlock.ReadUint16();
+
+	uint32 readOffset = sizeof(uint16);
+	for( uint16 msgIndex = 0; msgIndex < msgCount; ++msgIndex )
+	{
+		if( batchLen - readOffset < MSG_HEADER_SIZE )
+			return false;
+
+		// Get the message's length and type ID
+		NetDataBlock headerBlock( pBatchData + readOffset, MSG_HEADER_SIZE );
+		const uint32 msgLen = headerBlock.ReadUint16();
+		const uint16 msgID = headerBlock.ReadUint16();
+		if( msgLen < sizeof(uint16) || batchLen - readOffset - sizeof(uint16) < msgLen )
+			return false;
+
+		NetDataBlock msgBlock( pBatchData + readOffset + MSG_HEADER_SIZE, msgLen - sizeof(uint16) );
+		NetMsg* pMsg = NetworkMgr::Get().CreateMsg( msgID, msgBlock, m_PeerIP, m_PeerPort );
+		if( pMsg )
+			msgs.Push( pMsg );
+
+		readOffset += sizeof(uint16) + msgLen;
+	}
+
+	return readOffset == batchLen;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SocketConnectionTCP::ReceiveDataWait  Public
+///
+///	\returns The message that was received, or NULL if there was none or the connection closed
+///
+///	Receive a message from the socket. The rest of the messages in the batches that arrived are
+///	returned by the following calls.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+NetMsg* SocketConnectionTCP::ReceiveDataWait()
+{
+	if( m_ReceivedMsgs.IsEmpty() )
+		ReceiveMessages( m_ReceivedMsgs );
+	return m_ReceivedMsgs.Pop();
+}
+
+
+/// Make socket calls return instead of waiting
+void SocketConnectionTCP::SetNonBlocking()
+{
+	if( m_Socket == 0 )
+		return;
+
+	u_long isNonBlocking = 1;
+	if( ioctlsocket( m_Socket, FIONBIO, &isNonBlocking ) == SOCKET_ERROR )
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to make TCP socket non-blocking : %s", NetDefines::GetWinsockErrorDesc(WSAGetLastError()) );
+}
+
 void SocketConnectionTCP::Close()
 {
 	SocketConnectionBase::Close();
 	m_IsListening = false;
+	m_PendingSend.clear();
+	m_OpenBatchOffset = NO_OPEN_BATCH;
+	m_RecvStream.clear();
+	m_RecvLen = 0;
 }
\ No newline at end of file
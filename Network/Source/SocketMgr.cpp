@@ -222,7 +222,9 @@ SocketConnectionTCP SocketMgr::ConnectToTCPSync( IPAddress foreignIP, uint16 for
 	else
 		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Connected TCP connection" );
 
-	return SocketConnectionTCP( sock );
+	SocketConnectionTCP retConn( sock );
+	retConn.SetPeer( foreignIP, foreignPort );
+	return retConn;
 }
 
 
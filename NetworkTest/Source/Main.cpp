@@ -26,6 +26,11 @@
 #include "Base/TraceAssist.h"
 #include "Network/NetworkMgr.h"
 #include "Network/NetMsg.h"
+#include "Network/NetConnTCP.h"
+#include "Network/NetMsgPool.h"
+#include "GamePlay/GameNetMsgsCheck.h"
+#include <vector>
+#include <new>
 
 
 
@@ -42,6 +47,9 @@ static const wchar_t* PROG_NAME = L"Prime Time Network Test";
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 static LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 void MainLoop();
+void RunLoopbackStressTest();
+void RunPingPongBenchmark();
+void RunGameNetMsgChecks();
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +191,152 @@ public:
 };
 
 
+/// A message with a sequence number and a payload whose bytes are derived from it, so the receiver
+/// can check that every message arrives whole and in order
+class StressNetMsg : public NetMsg
+{
+public:
+	uint32 m_SeqNum;
+	std::vector<uint8> m_Payload;
+
+	StressNetMsg() : m_SeqNum( 0 )
+	{}
+
+	/// Fill in the sequence number and payload, reusing the payload's memory
+	void Set( uint32 seqNum, uint32 payloadLen )
+	{
+		m_SeqNum = seqNum;
+		m_Payload.resize( payloadLen );
+		for( uint32 byteIndex = 0; byteIndex < payloadLen; ++byteIndex )
+			m_Payload[byteIndex] = GetPayloadByte( seqNum, byteIndex );
+	}
+
+	/// Get the expected value of a payload byte
+	static uint8 GetPayloadByte( uint32 seqNum, uint32 byteIndex ) { return (uint8)(seqNum * 31 + byteIndex); }
+
+	static NetMsg* CreateMsg( NetDataBlock dataBlock )
+	{
+		StressNetMsg* pRetMsg = NetMsgPool<StressNetMsg>::Get().Alloc();
+		try
+		{
+			pRetMsg->m_SeqNum = dataBlock.ReadUint32();
+			pRetMsg->m_Payload.resize( dataBlock.ReadUint16() );
+			for( uint32 byteIndex = 0; byteIndex < pRetMsg->m_Payload.size(); ++byteIndex )
+				pRetMsg->m_Payload[byteIndex] = dataBlock.ReadUint8();
+		}
+		catch( ... )
+		{
+			NetMsg::Release( pRetMsg );
+			throw;
+		}
+		return pRetMsg;
+	}
+
+	/// Fill in a buffer with the message data
+	virtual uint32 StoreInBuffer( NetDataBlockOut& dataOut ) const
+	{
+		dataOut.WriteVal32( m_SeqNum );
+		dataOut.WriteVal16( (uint16)m_Payload.size() );
+		for( uint32 byteIndex = 0; byteIndex < m_Payload.size(); ++byteIndex )
+			dataOut.WriteVal8( m_Payload[byteIndex] );
+		return sizeof(uint32) + sizeof(uint16) + (uint32)m_Payload.size();
+	}
+
+	/// Get the message type ID
+	virtual uint16 GetMsgTypeID() const { return 11; }
+};
+
+
+/// Checks that the stress test messages arrive whole and in order
+class StressMsgChecker : public NetMsgHandler
+{
+public:
+	uint32 m_NumReceived;
+	uint32 m_NumBad;
+
+	StressMsgChecker() : m_NumReceived( 0 ),
+						m_NumBad( 0 )
+	{}
+
+	virtual void HandleNetMsg( const NetMsg& msg )
+	{
+		const StressNetMsg& stressMsg = static_cast<const StressNetMsg&>( msg );
+		if( msg.GetMsgTypeID() != 11 || stressMsg.m_SeqNum != m_NumReceived )
+			++m_NumBad;
+		else
+		{
+			for( uint32 byteIndex = 0; byteIndex < stressMsg.m_Payload.size(); ++byteIndex )
+			{
+				if( stressMsg.m_Payload[byteIndex] != StressNetMsg::GetPayloadByte( m_NumReceived, byteIndex ) )
+				{
+					++m_NumBad;
+					break;
+				}
+			}
+		}
+
+		++m_NumReceived;
+	}
+};
+
+
+/// Sends each message it is handed back over a connection, used by the ping-pong benchmark
+class EchoMsgHandler : public NetMsgHandler
+{
+public:
+	NetConnTCP* m_pConn;
+	uint32 m_NumEchoed;
+
+	EchoMsgHandler( NetConnTCP* pConn ) : m_pConn( pConn ),
+										m_NumEchoed( 0 )
+	{}
+
+	virtual void HandleNetMsg( const NetMsg& msg )
+	{
+		m_pConn->SendNetMsg( &msg );
+		++m_NumEchoed;
+	}
+};
+
+
+/// Records the sequence number of the last echoed message, used by the ping-pong benchmark
+class PongMsgHandler : public NetMsgHandler
+{
+public:
+	uint32 m_LastSeqNum;
+	uint32 m_NumReceived;
+
+	PongMsgHandler() : m_LastSeqNum( 0 ),
+						m_NumReceived( 0 )
+	{}
+
+	virtual void HandleNetMsg( const NetMsg& msg )
+	{
+		if( msg.GetMsgTypeID() == 11 )
+			m_LastSeqNum = static_cast<const StressNetMsg&>( msg ).m_SeqNum;
+		++m_NumReceived;
+	}
+};
+
+
+/// The number of heap allocations made, counted to measure how often receiving messages allocates
+static volatile LONG g_NumHeapAllocs = 0;
+
+void* operator new( size_t size )
+{
+	InterlockedIncrement( &g_NumHeapAllocs );
+	void* pMem = malloc( size > 0 ? size : 1 );
+	if( !pMem )
+		throw std::bad_alloc();
+	return pMem;
+}
+
+void operator delete( void* pMem )
+{
+	free( pMem );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  MainLoop()  Global
@@ -193,6 +347,7 @@ public:
 void MainLoop()
 {
 	NetworkMgr::Get().RegisterNetMsg( 10, TestNetMsg::CreateMsg );
+	NetworkMgr::Get().RegisterNetMsg( 11, StressNetMsg::CreateMsg );
 
 	GameMgr gameMgr;
 	if( !gameMgr.Init() )
@@ -244,6 +399,227 @@ void MainLoop()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ConnectOverLoopback()  Global
+///
+///	\param port The port to listen on, or the first of the ports to try
+///	\param pListenConn The accepting end of the connection
+///	\param pSendConn The connecting end of the connection
+///	\returns True if both ends connected, false if they failed and have been freed
+///
+///	Connect to ourselves over TCP and wait for the connection to be accepted.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ConnectOverLoopback( uint16 port, NetConnTCP*& pListenConn, NetConnTCP*& pSendConn )
+{
+	pListenConn = NetworkMgr::Get().WaitForTCPConn( port, 10 );
+	pSendConn = NetworkMgr::Get().ConnectToTCPConn( IPAddress( "127.0.0.1" ), pListenConn->GetListenPort() );
+	for( uint32 waitIndex = 0; waitIndex < 200 && pListenConn->GetConnState() == NetConnTCP::CS_Listening; ++waitIndex )
+		Sleep( 10 );
+	if( pListenConn->GetConnState() == NetConnTCP::CS_Connected && pSendConn->GetConnState() == NetConnTCP::CS_Connected )
+		return true;
+
+	NetworkMgr::Get().CloseConnection( pSendConn );
+	NetworkMgr::Get().CloseConnection( pListenConn );
+	delete pSendConn;
+	delete pListenConn;
+	pSendConn = 0;
+	pListenConn = 0;
+	return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RunLoopbackStressTest()  Global
+///
+///	Connect to ourselves over TCP and push bursts of mixed-size messages through the connection,
+///	checking that each one arrives whole and in order even though TCP splits and merges them.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunLoopbackStressTest()
+{
+	const uint16 STRESS_PORT = 12350;
+	const uint32 NUM_MSGS = 100000;
+	const uint32 MAX_BURST = 32;
+
+	// Connect to ourselves and wait for the connection to be accepted
+	NetConnTCP* pListenConn = 0;
+	NetConnTCP* pSendConn = 0;
+	if( !ConnectOverLoopback( STRESS_PORT, pListenConn, pSendConn ) )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Stress test failed to connect over loopback." );
+		return;
+	}
+
+	LARGE_INTEGER timerFreq, startTime, endTime;
+	QueryPerformanceFrequency( &timerFreq );
+	QueryPerformanceCounter( &startTime );
+
+	// Each tick send a burst of messages, mostly small with some large ones, and then handle what
+	// has arrived. The allocations are counted over the second half of the messages, once the
+	// pools and buffers have grown to fit the traffic.
+	StressNetMsg stressMsg;
+	StressMsgChecker checker;
+	uint32 numSent = 0;
+	LONG steadyStartAllocs = 0;
+	uint32 steadyStartMsgs = 0;
+	while( checker.m_NumReceived < NUM_MSGS && checker.m_NumBad == 0 && pListenConn->IsValid() && pSendConn->IsValid() )
+	{
+		const uint32 burstSize = (uint32)rand() % MAX_BURST;
+		for( uint32 burstIndex = 0; burstIndex < burstSize && numSent < NUM_MSGS; ++burstIndex )
+		{
+			const uint32 sizeType = (uint32)rand() % 100;
+			uint32 payloadLen = (uint32)rand() % 16;
+			if( sizeType >= 95 )
+				payloadLen = (uint32)rand() % 1000;
+			else if( sizeType >= 70 )
+				payloadLen = (uint32)rand() % 200;
+
+			stressMsg.Set( numSent++, payloadLen );
+			pSendConn->SendNetMsg( &stressMsg );
+		}
+
+		pListenConn->DispatchMessages( checker );
+		if( steadyStartMsgs == 0 && checker.m_NumReceived >= NUM_MSGS / 2 )
+		{
+			steadyStartMsgs = checker.m_NumReceived;
+			steadyStartAllocs = g_NumHeapAllocs;
+		}
+
+		Sleep( 0 );
+	}
+
+	QueryPerformanceCounter( &endTime );
+	float elapsedSecs = (float)(endTime.QuadPart - startTime.QuadPart) / (float)timerFreq.QuadPart;
+
+	if( checker.m_NumReceived == NUM_MSGS && checker.m_NumBad == 0 )
+	{
+		const uint32 numSteadyMsgs = checker.m_NumReceived - steadyStartMsgs;
+		const float allocsPerMsg = (float)(g_NumHeapAllocs - steadyStartAllocs) / (float)numSteadyMsgs;
+		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Stress test passed, %u messages in %.2f seconds.", checker.m_NumReceived, elapsedSecs );
+		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"%u messages allocated by the pools, %.3f heap allocations per message over the last %u messages.", NetMsgPoolBase::GetNumMsgsAllocated(), allocsPerMsg, numSteadyMsgs );
+	}
+	else
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Stress test failed, %u of %u messages received with %u bad.", checker.m_NumReceived, NUM_MSGS, checker.m_NumBad );
+
+	NetworkMgr::Get().CloseConnection( pSendConn );
+	NetworkMgr::Get().CloseConnection( pListenConn );
+	delete pSendConn;
+	delete pListenConn;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RunPingPongBenchmark()  Global
+///
+///	Measure the network latency and idle cost. A small message is sent back and forth over a
+///	loopback connection and the round trip times are logged, then the connection is left idle
+///	and the number of times the network update thread woke up is logged, which should be close to
+///	zero since the thread only wakes for socket events.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunPingPongBenchmark()
+{
+	const uint16 PING_PORT = 12360;
+	const uint32 NUM_ROUND_TRIPS = 10000;
+	const DWORD IDLE_MS = 5000;
+	const DWORD ROUND_TRIP_TIMEOUT_MS = 1000;
+
+	NetConnTCP* pListenConn = 0;
+	NetConnTCP* pSendConn = 0;
+	if( !ConnectOverLoopback( PING_PORT, pListenConn, pSendConn ) )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Ping-pong benchmark failed to connect over loopback." );
+		return;
+	}
+
+	LARGE_INTEGER timerFreq, startTime, sendTime, recvTime;
+	QueryPerformanceFrequency( &timerFreq );
+	const double ticksToMicrosecs = 1000000.0 / (double)timerFreq.QuadPart;
+
+	// Send one message at a time and wait for it to be echoed back before sending the next. The
+	// main thread spins so the time measured is the network's and not the scheduler's.
+	StressNetMsg pingMsg;
+	EchoMsgHandler echoer( pListenConn );
+	PongMsgHandler ponger;
+	double minMicrosecs = 0.0, maxMicrosecs = 0.0;
+	const uint32 startWakeUps = NetworkMgr::Get().GetNumUpdateWakeUps();
+	QueryPerformanceCounter( &startTime );
+	recvTime = startTime;
+	uint32 roundTripIndex = 0;
+	for( ; roundTripIndex < NUM_ROUND_TRIPS; ++roundTripIndex )
+	{
+		pingMsg.Set( roundTripIndex, 8 );
+		QueryPerformanceCounter( &sendTime );
+		pSendConn->SendNetMsg( &pingMsg );
+
+		const DWORD waitStartMS = GetTickCount();
+		while( ponger.m_NumReceived <= roundTripIndex && GetTickCount() - waitStartMS < ROUND_TRIP_TIMEOUT_MS )
+		{
+			pListenConn->DispatchMessages( echoer );
+			pSendConn->DispatchMessages( ponger );
+		}
+		if( ponger.m_NumReceived <= roundTripIndex || ponger.m_LastSeqNum != roundTripIndex )
+			break;
+
+		QueryPerformanceCounter( &recvTime );
+		const double microsecs = (double)(recvTime.QuadPart - sendTime.QuadPart) * ticksToMicrosecs;
+		if( roundTripIndex == 0 || microsecs < minMicrosecs )
+			minMicrosecs = microsecs;
+		if( microsecs > maxMicrosecs )
+			maxMicrosecs = microsecs;
+	}
+	const double totalMicrosecs = (double)(recvTime.QuadPart - startTime.QuadPart) * ticksToMicrosecs;
+	const uint32 pingWakeUps = NetworkMgr::Get().GetNumUpdateWakeUps() - startWakeUps;
+
+	if( roundTripIndex == NUM_ROUND_TRIPS )
+	{
+		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Ping-pong benchmark, %u round trips averaging %.1f us (min %.1f us, max %.1f us).", NUM_ROUND_TRIPS, totalMicrosecs / (double)NUM_ROUND_TRIPS, minMicrosecs, maxMicrosecs );
+		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"The network update thread woke up %.2f times per round trip.", (double)pingWakeUps / (double)NUM_ROUND_TRIPS );
+	}
+	else
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Ping-pong benchmark failed after %u of %u round trips.", roundTripIndex, NUM_ROUND_TRIPS );
+
+	// Leave the connections open with no traffic and count how often the update thread wakes
+	const uint32 idleStartWakeUps = NetworkMgr::Get().GetNumUpdateWakeUps();
+	Sleep( IDLE_MS );
+	const uint32 idleWakeUps = NetworkMgr::Get().GetNumUpdateWakeUps() - idleStartWakeUps;
+	MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Idle benchmark, the network update thread woke up %u times in %u seconds with a connection open.", idleWakeUps, (uint32)(IDLE_MS / 1000) );
+
+	NetworkMgr::Get().CloseConnection( pSendConn );
+	NetworkMgr::Get().CloseConnection( pListenConn );
+	delete pSendConn;
+	delete pListenConn;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  RunGameNetMsgChecks()  Global
+///
+///	Run the checks NetMsgGen generated for the game messages' encoding with a new seed, and then
+///	the encoding benchmark. The results are logged.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunGameNetMsgChecks()
+{
+	const uint32 NUM_CHECK_ITERATIONS = 10000;
+	const uint32 NUM_BENCHMARK_ITERATIONS = 1000000;
+
+	const uint64 seed = TCBase::RandomGen::GenerateSeed();
+	const uint32 numFailures = CheckGameNetMsgs( seed, NUM_CHECK_ITERATIONS );
+	if( numFailures == 0 )
+		MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Game message checks passed with seed %llu.", (unsigned long long)seed );
+	else
+		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Game message checks failed %u times with seed %llu.", numFailures, (unsigned long long)seed );
+
+	BenchmarkGameNetMsgs( seed, NUM_BENCHMARK_ITERATIONS );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //	WindowProc()  Global
@@ -278,6 +654,18 @@ LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			{
 				NetworkMgr::Get().WaitForTCPConn( 12344 );
 			}
+			else if( (char)wParam == 's' )
+			{
+				RunLoopbackStressTest();
+			}
+			else if( (char)wParam == 'p' )
+			{
+				RunPingPongBenchmark();
+			}
+			else if( (char)wParam == 'g' )
+			{
+				RunGameNetMsgChecks();
+			}
 		}
 		return 0;
 
@@ -29,6 +29,38 @@
 //-------------------------------------------------------------------------------------------------
 class ApplicationSFML : public ApplicationBase
 {
+public:
+
+	/// The timing statistics for the main loop
+	struct FrameStats
+	{
+		/// The total number of game simulation ticks run
+		uint32 totalTicks;
+
+		/// The number of simulation ticks run during the last frame
+		uint32 lastFrameTicks;
+
+		/// The number of simulation ticks skipped because frames took too long to keep up
+		uint32 droppedTicks;
+
+		/// The length of the last frame in seconds
+		float32 lastFrameTime;
+
+		/// The smoothed length of a frame in seconds
+		float32 avgFrameTime;
+
+		/// The longest frame in seconds
+		float32 maxFrameTime;
+
+		FrameStats() : totalTicks( 0 ),
+						lastFrameTicks( 0 ),
+						droppedTicks( 0 ),
+						lastFrameTime( 0.0f ),
+						avgFrameTime( 0.0f ),
+						maxFrameTime( 0.0f )
+		{}
+	};
+
 private:
 
 	/// The window handle
@@ -42,12 +74,21 @@ private:
     /// The amount of time, in seconds, to display what display mode we're using
     float _timeToShowDisplayMode;
 
+	/// The frame time that has not yet been consumed by game simulation ticks
+	float32 _tickAccumulator;
+
+	/// The main loop timing statistics
+	FrameStats _frameStats;
+
 	/// Toggle between windowed and full-screen
 	void ToggleFullScreen() {}
 
 	/// Draw the scene
 	void Draw();
 
+	/// Run the game simulation ticks that fit in the elapsed frame time
+	void UpdateGameTicks( float32 frameTime );
+
 	/// Handle a SFML app event
 	void HandleEvent( const sf::Event& curEvent );
 
@@ -60,7 +101,8 @@ private:
 	ApplicationSFML() : _pRenderWindow( 0 ),
                         _activeDisplayMode( GraphicsMgrBase::DM_NormalFill ),
                         _targetDisplayMode( GraphicsMgrBase::DM_NormalFill ),
-                        _timeToShowDisplayMode( 0.0f )
+                        _timeToShowDisplayMode( 0.0f ),
+						_tickAccumulator( 0.0f )
 	{}
 
 public:
@@ -81,6 +123,9 @@ public:
 	virtual void Run();
 
 	const sf::RenderWindow* GetRenderWindow() const { return _pRenderWindow; }
+
+	/// Get the main loop timing statistics
+	const FrameStats& GetFrameStats() const { return _frameStats; }
 #ifdef _DEBUG
 	/// Run the game
 	void Run_Dbg() {}
@@ -36,6 +36,9 @@ private:
 	/// The application instance
 	HINSTANCE m_hInstance;
 
+	/// The frame time that has not yet been consumed by game simulation ticks
+	float32 m_TickAccumulator;
+
 	
 	/// Toggle between windowed and full-screen
 	void ToggleFullScreen();
@@ -43,6 +46,9 @@ private:
 	/// Draw the scene
 	void Draw();
 
+	/// Run the game simulation ticks that fit in the elapsed frame time
+	void UpdateGameTicks( float32 frameTime );
+
 	/// Register a window class
 	bool RegisterWindowClass();
 
@@ -54,7 +60,8 @@ private:
 
 	/// The default constructor
 	ApplicationWin() : m_hWnd( 0 ),
-					m_hInstance( 0 )
+					m_hInstance( 0 ),
+					m_TickAccumulator( 0.0f )
 	{}
 
 public:
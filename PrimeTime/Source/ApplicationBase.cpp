@@ -6,6 +6,7 @@
 #include "Graphics2D/GraphicsMgr.h"
 #ifdef WIN32
 #include "Network/NetworkMgr.h"
+#include "GamePlay/GameNetMsgs.h"
 #endif
 #include "Network/HttpRequestMgr.h"
 #include "GamePlay/PlayerProfile.h"
@@ -154,6 +155,9 @@ bool ApplicationBase::InitGameMgrs( const TCBase::ParamList& cmdLineParams, cons
 	MSG_LOGGER_OUT( MsgLogger::MI_Note, L"Initializing network manager..." );
 	if( !NetworkMgr::Get().Init() )
 		MSG_LOGGER_OUT( MsgLogger::MI_Error, L"Failed to initialize the network manager." );
+
+	// Register the game messages along with the generated encode and decode switches
+	RegisterGameNetMsgs();
 #else
 	HttpRequestMgr::Init();
 #endif
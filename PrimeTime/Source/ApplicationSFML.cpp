@@ -26,7 +26,17 @@ GraphicsMgrBase* g_pGraphicsMgr = 0;
 static GUIMgr& g_GUIMgr = GUIMgr::Get();
 const std::string PROG_NAME("Prime Time");
 
-const float SLEEP_TIME = 0.0078125f;
+/// The shortest time a frame may take. Vertical sync normally paces the frames, but if the driver
+/// ignores it then the rest of the frame is slept off so the CPU isn't hogged. This is short
+/// enough to not miss a refresh on a 240Hz display.
+const float32 MIN_FRAME_TIME = 0.004f;
+
+/// The most simulation ticks run in one frame, any time beyond this is dropped so a long stall,
+/// like dragging the window, doesn't cause a burst of catch-up ticks
+const uint32 MAX_TICKS_PER_FRAME = 30;
+
+/// The weight of the newest frame in the smoothed frame time
+const float32 FRAME_TIME_SMOOTHING = 0.05f;
 
 extern void DisplayFatalErrorMsg( const wchar_t* szMsg );
 
@@ -67,6 +77,12 @@ void ApplicationSFML::Run()
 		float frameTime = _clock.restart().asSeconds();
 		s_LastFrameTime = frameTime;
 
+		// Update the frame statistics
+		_frameStats.lastFrameTime = frameTime;
+		_frameStats.avgFrameTime += (frameTime - _frameStats.avgFrameTime) * FRAME_TIME_SMOOTHING;
+		if( frameTime > _frameStats.maxFrameTime )
+			_frameStats.maxFrameTime = frameTime;
+
         if( _timeToShowDisplayMode > 0.0f )
             _timeToShowDisplayMode -= frameTime;
 
@@ -77,8 +93,7 @@ void ApplicationSFML::Run()
 		AudioMgr::Get().Update( frameTime );
 
 		// If the game is running then update it then draw it
-		if( GameMgr::Get().IsPlaying() )
-			GameMgr::Get().Update( frameTime );
+		UpdateGameTicks( frameTime );
 
         if( _activeDisplayMode != _targetDisplayMode )
             GoToTargetDisplayMode();
@@ -88,13 +103,55 @@ void ApplicationSFML::Run()
 #endif
 		Draw();
 
-		// Don't hog the cpu
-		sf::sleep( sf::seconds( SLEEP_TIME ) );
+		// Don't hog the cpu if vertical sync isn't limiting the frame rate
+		float32 frameWorkTime = _clock.getElapsedTime().asSeconds();
+		if( frameWorkTime < MIN_FRAME_TIME )
+			sf::sleep( sf::seconds( MIN_FRAME_TIME - frameWorkTime ) );
 	}
 
 	_pRenderWindow->close();
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  ApplicationSFML::UpdateGameTicks  Private
+///
+///	\param frameTime The elapsed frame time in seconds
+///
+///	Update the game in fixed size ticks so the block movement is the same at any frame rate. The
+///	time left over is stored for the next frame and used to blend the drawn block positions.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ApplicationSFML::UpdateGameTicks( float32 frameTime )
+{
+	_frameStats.lastFrameTicks = 0;
+
+	if( !GameMgr::Get().IsPlaying() )
+	{
+		_tickAccumulator = 0.0f;
+		return;
+	}
+
+	_tickAccumulator += frameTime;
+	while( _tickAccumulator >= GameDefines::SIM_TICK_TIME && GameMgr::Get().IsPlaying() )
+	{
+		// If the simulation can't keep up then drop the remaining time
+		if( _frameStats.lastFrameTicks == MAX_TICKS_PER_FRAME )
+		{
+			uint32 numDropped = (uint32)(_tickAccumulator / GameDefines::SIM_TICK_TIME);
+			_frameStats.droppedTicks += numDropped;
+			_tickAccumulator -= (float32)numDropped * GameDefines::SIM_TICK_TIME;
+			break;
+		}
+
+		GameMgr::Get().Update( GameDefines::SIM_TICK_TIME );
+		_tickAccumulator -= GameDefines::SIM_TICK_TIME;
+		++_frameStats.lastFrameTicks;
+		++_frameStats.totalTicks;
+	}
+
+	GameMgr::Get().SetTickBlend( _tickAccumulator / GameDefines::SIM_TICK_TIME );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //  ApplicationSFML::Draw  Private
 ///
@@ -132,7 +189,12 @@ void ApplicationSFML::Draw()
 
 #ifdef SHOW_FPS
 		// Display the frames per second
-		swprintf_s( sFPS, FPS_BUF_SIZE, L"FPS: %d", (int)(1.0f / g_fpsFrameTime) );
+		swprintf_s( sFPS, FPS_BUF_SIZE, L"FPS: %d  Avg: %.1fms  Max: %.1fms  Ticks: %u  Dropped: %u",
+					(int)(1.0f / g_fpsFrameTime),
+					_frameStats.avgFrameTime * 1000.0f,
+					_frameStats.maxFrameTime * 1000.0f,
+					_frameStats.lastFrameTicks,
+					_frameStats.droppedTicks );
         
         g_pFpsText->setString( sf::String( sFPS ) );
         
@@ -189,6 +251,9 @@ void SetWindowDisplay(sf::RenderWindow* pWindow, GraphicsMgrBase::EDisplayMode d
         pWindow->create( sf::VideoMode(1024, 768, 32), PROG_NAME, sf::Style::Titlebar | sf::Style::Close, winSettings );
         break;
     }
+
+    // Let the display pace the frames
+    pWindow->setVerticalSyncEnabled( true );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
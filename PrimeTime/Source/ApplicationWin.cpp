@@ -47,6 +47,7 @@ static LPTSTR CLASS_NAME = L"PrimeTime";
 static LPTSTR PROG_NAME = L"Prime Time";
 static LPTSTR MSGBOX_CAPTION = L"Prime Time: Math Adventure";
 const DWORD SLEEP_TIME = 10;
+const uint32 MAX_TICKS_PER_FRAME = 30;
 const DWORD WINSTYLE_FULLSCREEN = WS_MAXIMIZE | WS_POPUP | WS_VISIBLE;
 const DWORD WINSTYLE_WINDOWED = WS_CAPTION | WS_SYSMENU | WS_CLIPCHILDREN | WS_BORDER;
 
@@ -229,6 +230,45 @@ void ApplicationWin::Draw()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ApplicationWin::UpdateGameTicks  Private
+///
+///	\param frameTime The elapsed frame time in seconds
+///
+///	Update the game in fixed size ticks so the block movement is the same at any frame rate. The
+///	time left over is stored for the next frame and used to blend the drawn block positions.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ApplicationWin::UpdateGameTicks( float32 frameTime )
+{
+	if( !GameMgr::Get().IsPlaying() )
+	{
+		m_TickAccumulator = 0.0f;
+		return;
+	}
+
+	m_TickAccumulator += frameTime;
+	uint32 numTicks = 0;
+	while( m_TickAccumulator >= GameDefines::SIM_TICK_TIME && GameMgr::Get().IsPlaying() )
+	{
+		// If the simulation can't keep up then drop the remaining time
+		if( numTicks == MAX_TICKS_PER_FRAME )
+		{
+			uint32 numDropped = (uint32)(m_TickAccumulator / GameDefines::SIM_TICK_TIME);
+			m_TickAccumulator -= (float32)numDropped * GameDefines::SIM_TICK_TIME;
+			break;
+		}
+
+		GameMgr::Get().Update( GameDefines::SIM_TICK_TIME );
+		m_TickAccumulator -= GameDefines::SIM_TICK_TIME;
+		++numTicks;
+	}
+
+	GameMgr::Get().SetTickBlend( m_TickAccumulator / GameDefines::SIM_TICK_TIME );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  ApplicationWin::Run  Public
@@ -295,9 +335,8 @@ void ApplicationWin::Run()
 		// Update the audio manager
 		AudioMgr::Get().Update( frameTime );
 
-		// If the game is running then update it then draw it
-		if( GameMgr::Get().IsPlaying() )
-			GameMgr::Get().Update( frameTime );
+		// If the game is running then update it in fixed ticks then draw it
+		UpdateGameTicks( frameTime );
 
 		Draw();
 
@@ -407,8 +446,7 @@ void ApplicationWin::Run_Dbg()
 		// Update the user interface
 		g_GUIMgr.Update( frameTime );
 
-		if( GameMgr::Get().IsPlaying() )
-			GameMgr::Get().Update( frameTime );
+		UpdateGameTicks( frameTime );
 
 		AudioMgr::Get().Update( frameTime );
 
@@ -20,6 +20,7 @@
 #include <map>
 #include "Base/FourCC.h"
 #include "Base/ISerializer.h"
+#include "Base/CriticalSection.h"
 #include "Graphics2D/RefSprite.h"
 #include "Graphics2D/TCImage.h"
 #include "Graphics2D/TCFont.h"
@@ -39,6 +40,10 @@ typedef Resource* (CreateFunc)( ResourceID, DataBlock* );
 
 	This class defines the resource manager that is used to load resources and free resources,
 	such as images and sounds rather than memory blocks.
+
+	Resource lookups are guarded by a lock so headless games simulated on several threads can
+	request resources. The handles returned are not reference counted atomically, so games on
+	other threads should only run when no resources are loaded, as in the simulator.
 */
 //-------------------------------------------------------------------------------------------------
 class ResourceMgr
@@ -119,6 +124,9 @@ private:
 	/// The map of resource type to create function
 	ResCreateMap m_ResCreateFuncs;
 
+	/// The lock held while a resource is looked up or loaded
+	TCBase::CriticalSection m_ResourceLock;
+
 	/// Find all resources in the local directory
 	void FindResources();
 
@@ -128,6 +136,9 @@ private:
 	/// Load a resource for use
 	Resource* GetResource( ResourceID resID, bool forceReload = false );
 
+	/// Find a loaded resource or load it, the resource lock must be held
+	Resource* FindOrLoadResource( ResourceID resID, bool forceReload );
+
 	/// The constructor is private because this class uses the singleton pattern
 	ResourceMgr(){}
 
@@ -507,10 +507,33 @@ void ResourceMgr::RecreateImageResources()
 ///						loaded data is used
 ///	\returns A pointer to the resource being retrieved or NULL on failure
 ///
-///	Retrieve an already active resource or load a new one.
+///	Retrieve an already active resource or load a new one, holding the resource lock.
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 Resource* ResourceMgr::GetResource( ResourceID resID, bool forceReload )
+{
+	m_ResourceLock.Enter();
+	Resource* pRes = FindOrLoadResource( resID, forceReload );
+	m_ResourceLock.Leave();
+
+	return pRes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	ResourceMgr::FindOrLoadResource()  Private
+///
+///	\param resID The ID of the resource to retrieve
+///	\param forceReload True to ensure the resource is reloaded from file, otherwise the currently
+///						loaded data is used
+///	\returns A pointer to the resource being retrieved or NULL on failure
+///
+///	Retrieve an already active resource or load a new one. The caller must hold the resource
+///	lock.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+Resource* ResourceMgr::FindOrLoadResource( ResourceID resID, bool forceReload )
 {
 	// Determine if the resource ID is known
 	std::vector<KnownResourceItem>::size_type resIndex = ResIDToIndex( resID );